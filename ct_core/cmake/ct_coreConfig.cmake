@@ -9,6 +9,9 @@ get_target_property(ct_core_INCLUDE_DIRS ct_core INTERFACE_INCLUDE_DIRECTORIES)
 get_property(ct_core_LIB TARGET ct_plot PROPERTY LOCATION)
 list(APPEND ct_core_LIBRARIES ${ct_core_LIB})
 
+# templates for generated code, e.g. ADCodegenLinearizer::generateCode()
+get_filename_component(ct_core_CODEGEN_TEMPLATE_DIR "${CMAKE_CURRENT_LIST_DIR}/../templates" ABSOLUTE)
+
 # Required for catkin_simple to link against these libraries
 set(ct_core_FOUND_CATKIN_PROJECT true)
 
@@ -0,0 +1,35 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+// clang-format off
+
+#include "TestDiscreteNonlinearSystemLinearizedDouble.h"
+
+namespace ct {
+namespace core {
+namespace generated {
+
+const TestDiscreteNonlinearSystemLinearizedDouble::state_matrix_t& TestDiscreteNonlinearSystemLinearizedDouble::getDerivativeState(
+    const state_vector_t& x,
+    const control_vector_t& u,
+    const int t)
+{
+    double* jac = dFdx_.data();
+    Eigen::Matrix<double, 2 + 1, 1> x_in;
+    x_in << x, u;
+
+        jac[0] = 1 + 100. * x_in[2];
+    jac[1] = x_in[1] * x_in[1];
+    jac[3] = x_in[0] * x_in[1] + x_in[0] * x_in[1];
+
+
+    return dFdx_;
+}
+
+} // namespace generated
+} // namespace core
+} // namespace ct
+
+// clang-format on
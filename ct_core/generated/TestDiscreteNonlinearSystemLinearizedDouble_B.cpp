@@ -0,0 +1,33 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+// clang-format off
+
+#include "TestDiscreteNonlinearSystemLinearizedDouble.h"
+
+namespace ct {
+namespace core {
+namespace generated {
+
+const TestDiscreteNonlinearSystemLinearizedDouble::state_control_matrix_t& TestDiscreteNonlinearSystemLinearizedDouble::getDerivativeControl(
+    const state_vector_t& x,
+    const control_vector_t& u,
+    const int t)
+{
+    double* jac = dFdu_.data();
+    Eigen::Matrix<double, 2 + 1, 1> x_in;
+    x_in << x, u;
+
+        jac[0] = 100. * x_in[0];
+
+
+    return dFdu_;
+}
+
+} // namespace generated
+} // namespace core
+} // namespace ct
+
+// clang-format on
@@ -0,0 +1,39 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+// clang-format off
+
+#include "TestDiscreteNonlinearSystemLinearizedFloat.h"
+
+namespace ct {
+namespace core {
+namespace generated {
+
+void TestDiscreteNonlinearSystemLinearizedFloat::getDerivatives(
+    state_matrix_t& A,
+    state_control_matrix_t& B,
+    const state_vector_t& x,
+    const control_vector_t& u,
+    const int t)
+{
+    float* jac = dFdxu_.data();
+    Eigen::Matrix<float, 2 + 1, 1> x_in;
+    x_in << x, u;
+
+        jac[0] = 1 + 100. * x_in[2];
+    jac[1] = x_in[1] * x_in[1];
+    jac[3] = x_in[0] * x_in[1] + x_in[0] * x_in[1];
+    jac[4] = 100. * x_in[0];
+
+
+    A = dFdxu_.leftCols<2>();
+    B = dFdxu_.rightCols<1>();
+}
+
+} // namespace generated
+} // namespace core
+} // namespace ct
+
+// clang-format on
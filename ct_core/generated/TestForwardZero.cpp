@@ -0,0 +1,30 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+// clang-format off
+
+#include "TestForwardZero.h"
+
+namespace ct {
+namespace core {
+namespace generated {
+
+
+TestForwardZero::OUT_TYPE TestForwardZero::forwardZero(const Eigen::VectorXd& x_in)
+{
+    double* forwardZero = eval_.data();
+
+        forwardZero[0] = 2. * x_in[0] * x_in[0] + 3. * x_in[0] - x_in[1] * x_in[2];
+    forwardZero[1] = 3. + x_in[1] + x_in[2];
+
+
+    return eval_;
+}
+
+} // namespace generated
+} // namespace core
+} // namespace ct
+
+// clang-format on
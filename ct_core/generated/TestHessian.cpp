@@ -0,0 +1,32 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+// clang-format off
+
+#include "TestHessian.h"
+
+namespace ct {
+namespace core {
+namespace generated {
+
+
+TestHessian::HES_TYPE TestHessian::hessian(const Eigen::VectorXd& x_in, const Eigen::VectorXd& w_in)
+{
+    double* hes = hessian_.data();
+
+        hes[0] = w_in[0] * 2. + w_in[0] * 2.;
+    hes[5] = 0 - w_in[0];
+    // variable duplicates: 1
+    hes[7] = hes[5];
+
+
+    return hessian_;
+}
+
+} // namespace generated
+} // namespace core
+} // namespace ct
+
+// clang-format on
@@ -0,0 +1,46 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <ct/core/math/Derivatives.h>
+
+namespace ct {
+namespace core {
+namespace generated {
+
+class TestHessian : public core::Derivatives<3, 2, double>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<double, 3, 3> HES_TYPE;
+    typedef Eigen::Matrix<double, 3, 1> X_TYPE;
+
+    TestHessian()
+    {
+        hessian_.setZero();
+        v_.fill(0.0);
+    };
+
+    TestHessian(const TestHessian& other)
+    {
+        hessian_.setZero();
+        v_.fill(0.0);
+    }
+
+    virtual ~TestHessian(){};
+
+    TestHessian* clone() const override { return new TestHessian(*this); }
+    HES_TYPE hessian(const Eigen::VectorXd& x_in, const Eigen::VectorXd& w_in) override;
+
+private:
+    HES_TYPE hessian_;
+    std::array<double, 0> v_;
+};
+
+}  // namespace generated
+}  // namespace core
+}  // namespace ct
@@ -0,0 +1,34 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+// clang-format off
+
+#include "TestJacobian.h"
+
+namespace ct {
+namespace core {
+namespace generated {
+
+
+TestJacobian::JAC_TYPE TestJacobian::jacobian(const Eigen::VectorXd& x_in)
+{
+    double* jac = jac_.data();
+
+        jac[0] = 3. + 2. * x_in[0] + x_in[0] * 2.;
+    jac[2] = -1 * x_in[2];
+    jac[4] = -1 * x_in[1];
+    // dependent variables without operations
+    jac[3] = 1;
+    jac[5] = 1;
+
+
+    return jac_;
+}
+
+} // namespace generated
+} // namespace core
+} // namespace ct
+
+// clang-format on
@@ -0,0 +1,46 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <ct/core/math/Derivatives.h>
+
+namespace ct {
+namespace core {
+namespace generated {
+
+class TestJacobian : public core::Derivatives<3, 2, double>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<double, 2, 3> JAC_TYPE;
+    typedef Eigen::Matrix<double, 3, 1> X_TYPE;
+
+    TestJacobian()
+    {
+        jac_.setZero();
+        v_.fill(0.0);
+    };
+
+    TestJacobian(const TestJacobian& other)
+    {
+        jac_.setZero();
+        v_.fill(0.0);
+    }
+
+    virtual ~TestJacobian(){};
+
+    TestJacobian* clone() const override { return new TestJacobian(*this); }
+    JAC_TYPE jacobian(const Eigen::VectorXd& x_in) override;
+
+private:
+    JAC_TYPE jac_;
+    std::array<double, 0> v_;
+};
+
+}  // namespace generated
+}  // namespace core
+}  // namespace ct
@@ -0,0 +1,77 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+// clang-format off
+
+#include "TestNonlinearSystemLinearized.h"
+
+namespace ct {
+namespace core {
+namespace generated {
+
+
+const TestNonlinearSystemLinearized::state_matrix_t& TestNonlinearSystemLinearized::getDerivativeState(
+    const state_vector_t& x,
+    const control_vector_t& u,
+    const double t)
+{
+    double* jac = dFdx_.data();
+    Eigen::Matrix<double, 2 + 1, 1> x_in;
+    x_in << x, u;
+
+        jac[2] = x_in[0] + x_in[2];
+    jac[3] = -200. - 300. * x_in[2];
+    // dependent variables without operations
+    jac[0] = x_in[1];
+
+
+    return dFdx_;
+}
+
+const TestNonlinearSystemLinearized::state_control_matrix_t& TestNonlinearSystemLinearized::getDerivativeControl(
+    const state_vector_t& x,
+    const control_vector_t& u,
+    const double t)
+{
+    double* jac = dFdu_.data();
+    Eigen::Matrix<double, 2 + 1, 1> x_in;
+    x_in << x, u;
+
+        jac[1] = 100. - 300. * x_in[1];
+    // dependent variables without operations
+    jac[0] = x_in[1];
+
+
+    return dFdu_;
+}
+
+void TestNonlinearSystemLinearized::getDerivatives(
+    state_matrix_t& A,
+    state_control_matrix_t& B,
+    const state_vector_t& x,
+    const control_vector_t& u,
+    const double t)
+{
+    double* jac = dFdxu_.data();
+    Eigen::Matrix<double, 2 + 1, 1> x_in;
+    x_in << x, u;
+
+        jac[2] = x_in[0] + x_in[2];
+    jac[3] = -200. - 300. * x_in[2];
+    jac[5] = 100. - 300. * x_in[1];
+    // dependent variables without operations
+    jac[0] = x_in[1];
+    jac[4] = x_in[1];
+
+
+    A = dFdxu_.leftCols<2>();
+    B = dFdxu_.rightCols<1>();
+}
+
+} // namespace generated
+} // namespace core
+} // namespace ct
+
+// clang-format on
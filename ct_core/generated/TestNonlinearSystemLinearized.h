@@ -0,0 +1,71 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <ct/core/core.h>
+
+namespace ct {
+namespace core {
+namespace generated {
+
+class TestNonlinearSystemLinearized : public ct::core::LinearSystem<2, 1, double>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef ct::core::LinearSystem<2, 1, double> Base;
+
+    typedef typename Base::state_vector_t state_vector_t;
+    typedef typename Base::control_vector_t control_vector_t;
+    typedef typename Base::state_matrix_t state_matrix_t;
+    typedef typename Base::state_control_matrix_t state_control_matrix_t;
+
+    TestNonlinearSystemLinearized(const ct::core::SYSTEM_TYPE& type = ct::core::SYSTEM_TYPE::GENERAL)
+        : ct::core::LinearSystem<2, 1>(type)
+    {
+        initialize();
+    }
+
+    TestNonlinearSystemLinearized(const TestNonlinearSystemLinearized& other) { initialize(); }
+    virtual ~TestNonlinearSystemLinearized(){};
+
+    virtual TestNonlinearSystemLinearized* clone() const override { return new TestNonlinearSystemLinearized; }
+    virtual const state_matrix_t& getDerivativeState(const state_vector_t& x,
+        const control_vector_t& u,
+        const double t = double(0.0)) override;
+
+    virtual const state_control_matrix_t& getDerivativeControl(const state_vector_t& x,
+        const control_vector_t& u,
+        const double t = double(0.0)) override;
+
+    virtual void getDerivatives(state_matrix_t& A,
+        state_control_matrix_t& B,
+        const state_vector_t& x,
+        const control_vector_t& u,
+        const double t = double(0.0)) override;
+
+private:
+    void initialize()
+    {
+        dFdx_.setZero();
+        dFdu_.setZero();
+        dFdxu_.setZero();
+        vX_.fill(0.0);
+        vU_.fill(0.0);
+        vXU_.fill(0.0);
+    }
+
+    state_matrix_t dFdx_;
+    state_control_matrix_t dFdu_;
+    Eigen::Matrix<double, 2, 2 + 1> dFdxu_;
+    std::array<double, 0> vX_;
+    std::array<double, 0> vU_;
+    std::array<double, 0> vXU_;
+};
+
+}  // namespace generated
+}  // namespace core
+}  // namespace ct
@@ -0,0 +1,79 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ct {
+namespace core {
+
+//! A read-only memory mapping of a file
+/*!
+ * Maps a whole file into memory. The pages are loaded on demand by the operating system and shared between all
+ * processes which map the same file. The mapping starts at a page boundary, hence offsets in the file which are a
+ * multiple of the required alignment yield aligned pointers.
+ */
+class MappedFile
+{
+public:
+    //! maps the given file, throws if it cannot be opened or mapped
+    MappedFile(const std::string& filename) : data_(nullptr), size_(0)
+    {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("MappedFile: cannot open " + filename + ": " + std::strerror(errno));
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("MappedFile: cannot stat " + filename + ": " + std::strerror(errno));
+        }
+        size_ = static_cast<size_t>(st.st_size);
+
+        if (size_ > 0)
+        {
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("MappedFile: cannot map " + filename + ": " + std::strerror(errno));
+            }
+            data_ = static_cast<const char*>(data);
+        }
+
+        // the mapping stays valid after closing the descriptor
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        if (data_)
+            ::munmap(const_cast<char*>(data_), size_);
+    }
+
+    //! pointer to the first byte of the file
+    const char* data() const { return data_; }
+    //! size of the file in bytes
+    size_t size() const { return size_; }
+private:
+    const char* data_;
+    size_t size_;
+};
+
+}  // namespace core
+}  // namespace ct
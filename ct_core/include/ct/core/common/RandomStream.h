@@ -0,0 +1,200 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace ct {
+namespace core {
+
+//! Counter-based random number generator
+/*!
+ * Implements the Philox4x32-10 generator of Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (2011).
+ * The random numbers are a function of the seed, the stream index and a block counter only, hence every stream
+ * reproduces the same sequence no matter which thread draws it. Distinct streams, e.g. one per Monte Carlo run,
+ * are statistically independent without any shared state.
+ *
+ * Numbers are generated in blocks of four. The bulk methods fillUniform() and fillGaussian() evaluate many blocks
+ * at once in loops which the compiler can vectorize.
+ *
+ * Unit test \ref NoiseTest.cpp illustrates the use of RandomStream
+ */
+class RandomStream
+{
+public:
+    //! Constructor
+    /*!
+	 * @param seed global seed, e.g. of a Monte Carlo study
+	 * @param stream index of the stream, e.g. the run index
+	 */
+    RandomStream(uint64_t seed = 0, uint64_t stream = 0) { reset(seed, stream); }
+    //! restarts the sequence of the given stream
+    void reset(uint64_t seed, uint64_t stream)
+    {
+        key_ = {{uint32_t(seed), uint32_t(seed >> 32)}};
+        stream_ = stream;
+        block_ = 0;
+        bufferPos_ = 4;
+    }
+
+    //! fills out with uniformly distributed random numbers in (0, 1)
+    void fillUniform(double* out, size_t n)
+    {
+        size_t i = 0;
+        for (; i < n && bufferPos_ < 4; i++)
+            out[i] = toUniform(buffer_[bufferPos_++]);
+
+        uint32_t blocks[4 * CHUNK];
+        while (n - i >= 4)
+        {
+            const size_t nBlocks = std::min((n - i) / 4, size_t(CHUNK));
+            generate(blocks, nBlocks);
+            for (size_t j = 0; j < 4 * nBlocks; j++)
+                out[i + j] = toUniform(blocks[j]);
+            i += 4 * nBlocks;
+        }
+
+        for (; i < n; i++)
+        {
+            if (bufferPos_ == 4)
+            {
+                generate(buffer_.data(), 1);
+                bufferPos_ = 0;
+            }
+            out[i] = toUniform(buffer_[bufferPos_++]);
+        }
+    }
+
+    //! fills out with standard normally distributed random numbers, using the Box-Muller transform
+    void fillGaussian(double* out, size_t n)
+    {
+        double u[2 * CHUNK];
+        for (size_t i = 0; i < n; i += 2 * CHUNK)
+        {
+            const size_t nPairs = (std::min(n - i, size_t(2 * CHUNK)) + 1) / 2;
+            fillUniform(u, 2 * nPairs);
+            for (size_t j = 0; j < nPairs; j++)
+            {
+                const double r = std::sqrt(-2.0 * std::log(u[2 * j]));
+                const double phi = 2.0 * M_PI * u[2 * j + 1];
+                out[i + 2 * j] = r * std::cos(phi);
+                if (i + 2 * j + 1 < n)
+                    out[i + 2 * j + 1] = r * std::sin(phi);
+            }
+        }
+    }
+
+    //! generates a single uniformly distributed random variable in (0, 1)
+    double uniform()
+    {
+        double value;
+        fillUniform(&value, 1);
+        return value;
+    }
+
+    //! generates a single standard normally distributed random variable
+    double gaussian()
+    {
+        double value;
+        fillGaussian(&value, 1);
+        return value;
+    }
+
+    //! Vector of uniformly distributed random variables
+    /*!
+	 * @param mean the mean of the uniform distribution
+	 * @param r the half-width of the distribution
+	 */
+    template <size_t size>
+    Eigen::Matrix<double, size, 1> uniform(double mean = 0.0, double r = 1.0)
+    {
+        Eigen::Matrix<double, size, 1> noise;
+        fillUniform(noise.data(), size);
+        return noise.array() * (2.0 * r) + (mean - r);
+    }
+
+    //! Vector of normally distributed random variables
+    /*!
+	 * @param mean the mean of the Gaussian distribution
+	 * @param standardDeviation the standard deviation of the distribution
+	 */
+    template <size_t size>
+    Eigen::Matrix<double, size, 1> gaussian(double mean = 0.0, double standardDeviation = 1.0)
+    {
+        Eigen::Matrix<double, size, 1> noise;
+        fillGaussian(noise.data(), size);
+        return noise.array() * standardDeviation + mean;
+    }
+
+    //! computes nBlocks blocks of four 32 bit random numbers, starting at the current block counter
+    void generate(uint32_t* out, size_t nBlocks)
+    {
+        for (size_t offset = 0; offset < nBlocks; offset += CHUNK)
+        {
+            const size_t n = std::min(nBlocks - offset, size_t(CHUNK));
+
+            // the counters are stored per word, such that the rounds run over all blocks at once
+            uint32_t c0[CHUNK], c1[CHUNK], c2[CHUNK], c3[CHUNK];
+            for (size_t j = 0; j < n; j++)
+            {
+                const uint64_t block = block_ + offset + j;
+                c0[j] = uint32_t(block);
+                c1[j] = uint32_t(block >> 32);
+                c2[j] = uint32_t(stream_);
+                c3[j] = uint32_t(stream_ >> 32);
+            }
+
+            uint32_t k0 = key_[0];
+            uint32_t k1 = key_[1];
+            for (size_t round = 0; round < 10; round++)
+            {
+                for (size_t j = 0; j < n; j++)
+                {
+                    const uint64_t p0 = uint64_t(M0) * c0[j];
+                    const uint64_t p1 = uint64_t(M1) * c2[j];
+                    c0[j] = uint32_t(p1 >> 32) ^ c1[j] ^ k0;
+                    c1[j] = uint32_t(p1);
+                    c2[j] = uint32_t(p0 >> 32) ^ c3[j] ^ k1;
+                    c3[j] = uint32_t(p0);
+                }
+                k0 += W0;
+                k1 += W1;
+            }
+
+            for (size_t j = 0; j < n; j++)
+            {
+                out[4 * (offset + j)] = c0[j];
+                out[4 * (offset + j) + 1] = c1[j];
+                out[4 * (offset + j) + 2] = c2[j];
+                out[4 * (offset + j) + 3] = c3[j];
+            }
+        }
+        block_ += nBlocks;
+    }
+
+private:
+    //! maps a 32 bit integer to the open interval (0, 1)
+    static double toUniform(uint32_t value) { return (double(value) + 0.5) * (1.0 / 4294967296.0); }
+    static const size_t CHUNK = 16;  //!< number of blocks evaluated at once
+
+    static const uint32_t M0 = 0xD2511F53;  //!< round multipliers
+    static const uint32_t M1 = 0xCD9E8D57;
+    static const uint32_t W0 = 0x9E3779B9;  //!< key increments (Weyl sequence)
+    static const uint32_t W1 = 0xBB67AE85;
+
+    std::array<uint32_t, 2> key_;
+    uint64_t stream_;
+    uint64_t block_;
+
+    std::array<uint32_t, 4> buffer_;
+    size_t bufferPos_;
+};
+
+}  // namespace core
+}  // namespace ct
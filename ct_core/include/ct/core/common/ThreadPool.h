@@ -0,0 +1,207 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace ct {
+namespace core {
+
+//! A fixed set of worker threads which execute parallel loops
+/*!
+ * The workers are launched once in the constructor and sleep while there is no work. parallelFor() distributes
+ * the indices of a loop dynamically over the workers and the calling thread, such that a pool can be reused for
+ * many short parallel sections without the cost of spawning threads.
+ *
+ * Only one parallelFor() may run at a time on a pool instance.
+ *
+ * On Linux, the workers can optionally be pinned to fixed cores, such that data of a loop index which is
+ * repeatedly processed by the same worker stays in its cache. Only cores in the affinity mask of the process are
+ * used, and pools which are created after each other continue on the next cores rather than stacking their
+ * workers on the same ones.
+ */
+class ThreadPool
+{
+public:
+    //! Constructor
+    /*!
+	 * @param nThreads total number of threads executing a loop, including the calling thread
+	 * @param pinThreads pin every worker to one core, the calling thread is not pinned. Ignored on non-Linux systems.
+	 */
+    ThreadPool(size_t nThreads = std::thread::hardware_concurrency(), bool pinThreads = false)
+        : nThreads_(std::max<size_t>(nThreads, 1)),
+          shutdown_(false),
+          jobId_(0),
+          nBusy_(0),
+          fun_(nullptr),
+          nIndices_(0),
+          next_(0)
+    {
+        for (size_t i = 0; i < nThreads_ - 1; i++)
+            workers_.push_back(std::thread(&ThreadPool::work, this));
+
+        if (pinThreads)
+            pinWorkers();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    //! Destructor, joins all workers
+    ~ThreadPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            shutdown_ = true;
+        }
+        wakeUp_.notify_all();
+
+        for (size_t i = 0; i < workers_.size(); i++)
+            workers_[i].join();
+    }
+
+    //! Calls fun(i) for i = 0 ... n-1 and returns when all calls have finished
+    /*!
+	 * The calls are executed concurrently in arbitrary order. If a call throws, the remaining indices are still
+	 * processed and the first exception is rethrown.
+	 */
+    void parallelFor(size_t n, const std::function<void(size_t)>& fun)
+    {
+        if (n == 0)
+            return;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            fun_ = &fun;
+            nIndices_ = n;
+            next_ = 0;
+            nBusy_ = workers_.size();
+            exception_ = nullptr;
+            jobId_++;
+        }
+        wakeUp_.notify_all();
+
+        processIndices();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [this] { return nBusy_ == 0; });
+        fun_ = nullptr;
+
+        if (exception_)
+            std::rethrow_exception(exception_);
+    }
+
+    //! total number of threads executing a loop, including the calling thread
+    size_t getNumThreads() const { return nThreads_; }
+
+private:
+    //! pins every worker to the next allowed core, wrapping around if there are more threads than cores
+    void pinWorkers()
+    {
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0)
+        {
+            std::cerr << "WARNING: ThreadPool: could not get the affinity mask, workers are not pinned." << std::endl;
+            return;
+        }
+
+        std::vector<int> cores;
+        for (int core = 0; core < CPU_SETSIZE; core++)
+            if (CPU_ISSET(core, &allowed))
+                cores.push_back(core);
+
+        // shared by all pools, the first core is left to the calling thread
+        static std::atomic_size_t nextCore(1);
+
+        for (size_t i = 0; i < workers_.size(); i++)
+        {
+            const int core = cores[nextCore++ % cores.size()];
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(core, &cpuSet);
+            const int error = pthread_setaffinity_np(workers_[i].native_handle(), sizeof(cpu_set_t), &cpuSet);
+            if (error != 0)
+                std::cerr << "WARNING: ThreadPool: could not pin worker " << i << " to core " << core << ", error "
+                          << error << std::endl;
+        }
+#endif
+    }
+
+    //! main function of the workers
+    void work()
+    {
+        size_t jobIdLocal = 0;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeUp_.wait(lock, [this, jobIdLocal] { return shutdown_ || jobId_ != jobIdLocal; });
+                if (shutdown_)
+                    return;
+                jobIdLocal = jobId_;
+            }
+
+            processIndices();
+
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                nBusy_--;
+            }
+            finished_.notify_all();
+        }
+    }
+
+    //! take indices of the current loop until all are taken
+    void processIndices()
+    {
+        for (size_t i = next_++; i < nIndices_; i = next_++)
+        {
+            try
+            {
+                (*fun_)(i);
+            } catch (...)
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (!exception_)
+                    exception_ = std::current_exception();
+            }
+        }
+    }
+
+    size_t nThreads_;
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable finished_;
+    bool shutdown_;
+    size_t jobId_;
+    size_t nBusy_;
+
+    const std::function<void(size_t)>* fun_;
+    size_t nIndices_;
+    std::atomic_size_t next_;
+    std::exception_ptr exception_;
+};
+
+}  // namespace core
+}  // namespace ct
@@ -0,0 +1,505 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ct/core/common/MappedFile.h>
+#include <ct/core/types/arrays/DiscreteArrayView.h>
+
+#include "PolicyFileFormat.h"
+
+namespace ct {
+namespace core {
+
+//! Time stamps of an entry in a policy file
+/*!
+ * Looks up the greatest time stamp less or equal to an enquiry time, with the same conventions as Interpolation.
+ * For equally spaced time stamps the lookup is O(1), otherwise it is a binary search.
+ */
+template <typename SCALAR>
+class TimeGridView
+{
+public:
+    TimeGridView() : t_(nullptr), n_(0), uniform_(false), t0_(0), dt_(0) {}
+    TimeGridView(const SCALAR* t, size_t n, bool uniform, SCALAR t0, SCALAR dt)
+        : t_(t), n_(n), uniform_(uniform), t0_(t0), dt_(dt)
+    {
+    }
+
+    //! number of time stamps
+    size_t size() const { return n_; }
+    //! time stamp i
+    SCALAR operator[](size_t i) const { return t_[i]; }
+    //! view on the first n time stamps
+    TimeGridView head(size_t n) const { return TimeGridView(t_, n, uniform_, t0_, dt_); }
+    //! index of the greatest time stamp less or equal to t, clamped to the valid range
+    size_t findIndex(const SCALAR& t) const
+    {
+        if (n_ == 0)
+            throw std::runtime_error("TimeGridView: no time stamps");
+
+        if (t < t_[0])
+            return 0;
+
+        size_t i;
+        if (uniform_)
+        {
+            i = std::min(static_cast<size_t>(std::floor((t - t0_) / dt_)), n_ - 1);
+            // correct round-off w.r.t. the stored time stamps
+            if (i + 1 < n_ && t_[i + 1] <= t)
+                i++;
+            else if (i > 0 && t_[i] > t)
+                i--;
+        }
+        else
+            i = std::upper_bound(t_, t_ + n_, t) - t_ - 1;
+
+        return i;
+    }
+
+    //! interpolates data given at the time stamps, like Interpolation::interpolate()
+    template <class T>
+    T interpolate(const DiscreteArrayView<T>& data, const SCALAR& t, InterpolationType type) const
+    {
+        if (n_ == 1 || t < t_[0])
+            return data.front();
+
+        const size_t i = findIndex(t);
+        if (i == n_ - 1)
+            return data.back();
+
+        if (type == InterpolationType::ZOH)
+            return data[i];
+
+        const SCALAR alpha = (t - t_[i + 1]) / (t_[i] - t_[i + 1]);
+        return alpha * data[i] + (1 - alpha) * data[i + 1];
+    }
+
+    //! copies the time stamps into a time array
+    tpl::TimeArray<SCALAR> toArray() const
+    {
+        tpl::TimeArray<SCALAR> time(n_);
+        std::copy(t_, t_ + n_, time.toImplementation().begin());
+        return time;
+    }
+
+private:
+    const SCALAR* t_;
+    size_t n_;
+    bool uniform_;
+    SCALAR t0_;
+    SCALAR dt_;
+};
+
+
+//! A zero-copy view on a state feedback policy stored in a PolicyLibrary
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class PolicyView
+{
+public:
+    typedef StateVector<STATE_DIM, SCALAR> state_vector_t;
+    typedef ControlVector<CONTROL_DIM, SCALAR> control_vector_t;
+    typedef FeedbackMatrix<STATE_DIM, CONTROL_DIM, SCALAR> feedback_matrix_t;
+
+    PolicyView() : interpolationType_(ZOH) {}
+    PolicyView(const DiscreteArrayView<state_vector_t>& x_ref,
+        const DiscreteArrayView<control_vector_t>& uff,
+        const DiscreteArrayView<feedback_matrix_t>& K,
+        const TimeGridView<SCALAR>& time,
+        InterpolationType interpolationType)
+        : x_ref_(x_ref), uff_(uff), K_(K), time_(time), interpolationType_(interpolationType)
+    {
+    }
+
+    //! evaluates the policy at time t, gives the same result as StateFeedbackController::computeControl()
+    void computeControl(const state_vector_t& state, const SCALAR& t, control_vector_t& controlAction) const
+    {
+        const TimeGridView<SCALAR> tshort = time_.head(uff_.size());
+        controlAction = tshort.interpolate(uff_, t, interpolationType_) +
+                        tshort.interpolate(K_, t, interpolationType_) *
+                            (state - time_.interpolate(x_ref_, t, interpolationType_));
+    }
+
+    //! evaluates the policy at time index n
+    void computeControl(const state_vector_t& state, const int n, control_vector_t& controlAction) const
+    {
+        controlAction = uff_[n] + K_[n] * (state - x_ref_[n]);
+    }
+
+    //! copies the policy into a StateFeedbackController
+    StateFeedbackController<STATE_DIM, CONTROL_DIM, SCALAR> toController() const
+    {
+        StateFeedbackController<STATE_DIM, CONTROL_DIM, SCALAR> controller;
+        controller.update(x_ref_.toArray(), uff_.toArray(), K_.toArray(), time_.toArray());
+        controller.getReferenceStateTrajectory().setInterpolationType(interpolationType_);
+        controller.getFeedforwardTrajectory().setInterpolationType(interpolationType_);
+        controller.getFeedbackTrajectory().setInterpolationType(interpolationType_);
+        return controller;
+    }
+
+    const DiscreteArrayView<state_vector_t>& x_ref() const { return x_ref_; }
+    const DiscreteArrayView<control_vector_t>& uff() const { return uff_; }
+    const DiscreteArrayView<feedback_matrix_t>& K() const { return K_; }
+    //! the time stamps of the reference state, the feedforward and feedback use all but the last
+    const TimeGridView<SCALAR>& time() const { return time_; }
+    InterpolationType getInterpolationType() const { return interpolationType_; }
+private:
+    DiscreteArrayView<state_vector_t> x_ref_;
+    DiscreteArrayView<control_vector_t> uff_;
+    DiscreteArrayView<feedback_matrix_t> K_;
+    TimeGridView<SCALAR> time_;
+    InterpolationType interpolationType_;
+};
+
+
+//! A zero-copy view on a trajectory stored in a PolicyLibrary
+template <class T, typename SCALAR = double>
+class TrajectoryView
+{
+public:
+    TrajectoryView() : interpolationType_(ZOH) {}
+    TrajectoryView(const DiscreteArrayView<T>& data, const TimeGridView<SCALAR>& time, InterpolationType type)
+        : data_(data), time_(time), interpolationType_(type)
+    {
+    }
+
+    //! evaluates the trajectory at time t, gives the same result as DiscreteTrajectoryBase::eval()
+    T eval(const SCALAR& t) const { return time_.interpolate(data_, t, interpolationType_); }
+    size_t size() const { return data_.size(); }
+    typename DiscreteArrayView<T>::ConstMap operator[](size_t i) const { return data_[i]; }
+    //! copies the trajectory into a DiscreteTrajectoryBase
+    DiscreteTrajectoryBase<T, Eigen::aligned_allocator<T>, SCALAR> toTrajectory() const
+    {
+        return DiscreteTrajectoryBase<T, Eigen::aligned_allocator<T>, SCALAR>(
+            time_.toArray(), data_.toArray(), interpolationType_);
+    }
+
+    const DiscreteArrayView<T>& getDataArray() const { return data_; }
+    const TimeGridView<SCALAR>& getTimeArray() const { return time_; }
+private:
+    DiscreteArrayView<T> data_;
+    TimeGridView<SCALAR> time_;
+    InterpolationType interpolationType_;
+};
+
+
+//! Writes state feedback policies and trajectories into a binary policy file
+/*!
+ * Entries are collected in memory and written at once by write(). The resulting file can be memory-mapped by
+ * PolicyLibrary. See policy_file for the layout.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class PolicyFileWriter
+{
+public:
+    typedef StateFeedbackController<STATE_DIM, CONTROL_DIM, SCALAR> Policy_t;
+
+    //! adds a policy, throws if the name is taken or too long or the array sizes do not match the time stamps
+    void addPolicy(const std::string& name, const Policy_t& policy)
+    {
+        if (policy.x_ref().size() != policy.time().size() || policy.uff().size() != policy.K().size() ||
+            policy.uff().size() > policy.time().size())
+            throw std::runtime_error("PolicyFileWriter: array sizes of policy '" + name + "' do not match");
+
+        Entry& entry = createEntry(name, policy_file::POLICY, policy.time(),
+            policy.getFeedforwardTrajectory().getInterpolationType());
+        addArray(entry, 0, policy.x_ref());
+        addArray(entry, 1, policy.uff());
+        addArray(entry, 2, policy.K());
+    }
+
+    //! adds a trajectory of fixed-size Eigen matrices, throws if the name is taken or too long or the sizes differ
+    template <class T, class Alloc>
+    void addTrajectory(const std::string& name, const DiscreteTrajectoryBase<T, Alloc, SCALAR>& trajectory)
+    {
+        if (trajectory.getDataArray().size() != trajectory.getTimeArray().size())
+            throw std::runtime_error("PolicyFileWriter: data and time of trajectory '" + name + "' differ in size");
+
+        Entry& entry = createEntry(
+            name, policy_file::TRAJECTORY, trajectory.getTimeArray(), trajectory.getInterpolationType());
+        addArray(entry, 0, trajectory.getDataArray());
+    }
+
+    //! number of entries added so far
+    size_t size() const { return entries_.size(); }
+    //! writes all entries to a file, throws if the file cannot be written
+    void write(const std::string& filename) const
+    {
+        using namespace policy_file;
+
+        // compute the layout, the index is sorted by name
+        std::vector<EntryHeader> index;
+        uint64_t offset = aligned(sizeof(FileHeader) + entries_.size() * sizeof(EntryHeader));
+        for (const auto& e : entries_)
+        {
+            EntryHeader header = e.second.header;
+            ArrayHeader* arrays[4] = {&header.time, &header.data[0], &header.data[1], &header.data[2]};
+            const std::vector<SCALAR>* values[4] = {&e.second.time, &e.second.data[0], &e.second.data[1],
+                &e.second.data[2]};
+            for (size_t i = 0; i < 4; i++)
+            {
+                arrays[i]->offset = values[i]->empty() ? 0 : offset;
+                offset = aligned(offset + values[i]->size() * sizeof(SCALAR));
+            }
+            index.push_back(header);
+        }
+
+        FileHeader fileHeader;
+        std::memset(&fileHeader, 0, sizeof(fileHeader));
+        std::memcpy(fileHeader.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        fileHeader.version = FILE_VERSION;
+        fileHeader.scalarType = ScalarTypeOf<SCALAR>::value;
+        fileHeader.stateDim = STATE_DIM;
+        fileHeader.controlDim = CONTROL_DIM;
+        fileHeader.nEntries = entries_.size();
+        fileHeader.indexOffset = sizeof(FileHeader);
+        fileHeader.fileSize = offset;
+
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw std::runtime_error("PolicyFileWriter: cannot open " + filename);
+
+        out.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+        out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(EntryHeader));
+
+        for (const auto& e : entries_)
+        {
+            const std::vector<SCALAR>* values[4] = {&e.second.time, &e.second.data[0], &e.second.data[1],
+                &e.second.data[2]};
+            for (size_t i = 0; i < 4; i++)
+            {
+                if (values[i]->empty())
+                    continue;
+                pad(out);
+                out.write(reinterpret_cast<const char*>(values[i]->data()), values[i]->size() * sizeof(SCALAR));
+            }
+        }
+        pad(out);
+
+        if (!out)
+            throw std::runtime_error("PolicyFileWriter: error writing " + filename);
+    }
+
+private:
+    struct Entry
+    {
+        policy_file::EntryHeader header;
+        std::vector<SCALAR> time;
+        std::vector<SCALAR> data[3];
+    };
+
+    Entry& createEntry(const std::string& name,
+        policy_file::EntryType type,
+        const tpl::TimeArray<SCALAR>& time,
+        InterpolationType interpolationType)
+    {
+        if (name.empty() || name.size() > policy_file::MAX_NAME_LENGTH)
+            throw std::runtime_error("PolicyFileWriter: invalid entry name '" + name + "'");
+        if (entries_.count(name))
+            throw std::runtime_error("PolicyFileWriter: duplicate entry name '" + name + "'");
+        if (time.size() == 0)
+            throw std::runtime_error("PolicyFileWriter: entry '" + name + "' is empty");
+
+        Entry& entry = entries_[name];
+        std::memset(&entry.header, 0, sizeof(entry.header));
+        std::strncpy(entry.header.name, name.c_str(), policy_file::MAX_NAME_LENGTH);
+        entry.header.type = type;
+        entry.header.interpolationType = interpolationType;
+        entry.header.time = {0, time.size(), 1, 1};
+        entry.time.assign(time.begin(), time.end());
+
+        // equally spaced time stamps allow a lookup in O(1)
+        entry.header.t0 = time.front();
+        entry.header.dt = time.size() > 1 ? (time.back() - time.front()) / (time.size() - 1) : 0.0;
+        entry.header.uniformTime = entry.header.dt > 0.0;
+        for (size_t i = 1; i < time.size() && entry.header.uniformTime; i++)
+        {
+            const double expected = entry.header.t0 + i * entry.header.dt;
+            entry.header.uniformTime = std::abs(time[i] - expected) <= 1e-6 * entry.header.dt;
+        }
+
+        return entry;
+    }
+
+    template <class T, class Alloc>
+    void addArray(Entry& entry, size_t i, const DiscreteArray<T, Alloc>& array)
+    {
+        const size_t elementSize = T::RowsAtCompileTime * T::ColsAtCompileTime;
+        entry.header.data[i] = {0, array.size(), T::RowsAtCompileTime, T::ColsAtCompileTime};
+        entry.data[i].resize(array.size() * elementSize);
+        typedef Eigen::Map<typename DiscreteArrayView<T>::PlainMatrix> Map_t;
+        for (size_t k = 0; k < array.size(); k++)
+            Map_t(entry.data[i].data() + k * elementSize) = array[k];
+    }
+
+    static void pad(std::ofstream& out)
+    {
+        static const char zeros[policy_file::ALIGNMENT] = {};
+        const uint64_t position = out.tellp();
+        out.write(zeros, policy_file::aligned(position) - position);
+    }
+
+    std::map<std::string, Entry> entries_;
+};
+
+
+//! A library of state feedback policies and trajectories, memory-mapped from a binary policy file
+/*!
+ * Opening a library maps the file and builds a hash map of the entry names, no data is read. Policies and
+ * trajectories are returned as views into the mapping and are only valid while the library exists.
+ * Lookup by name and, for equally spaced time stamps, evaluation at a given time are O(1).
+ *
+ * The file has to be written by PolicyFileWriter with the same dimensions and scalar type.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class PolicyLibrary
+{
+public:
+    typedef PolicyView<STATE_DIM, CONTROL_DIM, SCALAR> PolicyView_t;
+
+    //! maps the file and checks its header and index, throws if the file is invalid
+    PolicyLibrary(const std::string& filename) : file_(filename)
+    {
+        using namespace policy_file;
+
+        if (file_.size() < sizeof(FileHeader))
+            throw std::runtime_error("PolicyLibrary: " + filename + " is not a policy file");
+
+        header_ = reinterpret_cast<const FileHeader*>(file_.data());
+        if (std::memcmp(header_->magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+            throw std::runtime_error("PolicyLibrary: " + filename + " is not a policy file");
+        if (header_->version != FILE_VERSION)
+            throw std::runtime_error("PolicyLibrary: unsupported version " + std::to_string(header_->version) +
+                                     " of " + filename);
+        if (header_->scalarType != ScalarTypeOf<SCALAR>::value)
+            throw std::runtime_error("PolicyLibrary: scalar type of " + filename + " does not match");
+        if (header_->stateDim != STATE_DIM || header_->controlDim != CONTROL_DIM)
+            throw std::runtime_error("PolicyLibrary: dimensions of " + filename + " do not match");
+        if (header_->fileSize != file_.size() ||
+            header_->indexOffset + header_->nEntries * sizeof(EntryHeader) > file_.size())
+            throw std::runtime_error("PolicyLibrary: " + filename + " is truncated");
+
+        index_ = reinterpret_cast<const EntryHeader*>(file_.data() + header_->indexOffset);
+        nameToEntry_.reserve(header_->nEntries);
+        for (size_t i = 0; i < header_->nEntries; i++)
+        {
+            const EntryHeader& e = index_[i];
+            const std::string name = entryName(e);
+            const ArrayHeader* arrays[4] = {&e.time, &e.data[0], &e.data[1], &e.data[2]};
+            for (const ArrayHeader* a : arrays)
+                if (!arrayFits(*a))
+                    throw std::runtime_error("PolicyLibrary: invalid array in entry " + name);
+
+            // the reference state has one element per time stamp, feedforward and feedback may omit the last one
+            const bool sizesOk = (e.type == POLICY) ? e.data[0].count == e.time.count &&
+                                                          e.data[1].count == e.data[2].count &&
+                                                          e.data[1].count <= e.time.count
+                                                    : e.data[0].count == e.time.count;
+            if (!sizesOk)
+                throw std::runtime_error("PolicyLibrary: array sizes of entry " + name + " do not match");
+
+            nameToEntry_[name] = i;
+        }
+    }
+
+    //! number of entries
+    size_t size() const { return nameToEntry_.size(); }
+    //! true if an entry with the given name exists
+    bool contains(const std::string& name) const { return nameToEntry_.count(name) > 0; }
+    //! the names of all entries, sorted
+    std::vector<std::string> names() const
+    {
+        std::vector<std::string> result;
+        for (size_t i = 0; i < header_->nEntries; i++)
+            result.push_back(entryName(index_[i]));
+        return result;
+    }
+
+    //! returns a view on the policy with the given name, throws if it does not exist
+    PolicyView_t getPolicy(const std::string& name) const
+    {
+        const policy_file::EntryHeader& e = findEntry(name, policy_file::POLICY);
+        return PolicyView_t(makeView<typename PolicyView_t::state_vector_t>(e.data[0]),
+            makeView<typename PolicyView_t::control_vector_t>(e.data[1]),
+            makeView<typename PolicyView_t::feedback_matrix_t>(e.data[2]), makeTimeGrid(e),
+            static_cast<InterpolationType>(e.interpolationType));
+    }
+
+    //! returns a view on the trajectory with the given name, throws if it does not exist or the type does not match
+    template <class T>
+    TrajectoryView<T, SCALAR> getTrajectory(const std::string& name) const
+    {
+        const policy_file::EntryHeader& e = findEntry(name, policy_file::TRAJECTORY);
+        return TrajectoryView<T, SCALAR>(
+            makeView<T>(e.data[0]), makeTimeGrid(e), static_cast<InterpolationType>(e.interpolationType));
+    }
+
+    //! evaluates the policy with the given name at time t
+    void computeControl(const std::string& name,
+        const typename PolicyView_t::state_vector_t& state,
+        const SCALAR& t,
+        typename PolicyView_t::control_vector_t& controlAction) const
+    {
+        getPolicy(name).computeControl(state, t, controlAction);
+    }
+
+private:
+    //! the name of an entry, also if the stored name is not zero-terminated
+    static std::string entryName(const policy_file::EntryHeader& e)
+    {
+        return std::string(e.name, strnlen(e.name, policy_file::MAX_NAME_LENGTH + 1));
+    }
+
+    //! true if the array is aligned and lies within the file, without overflowing the size computation
+    bool arrayFits(const policy_file::ArrayHeader& a) const
+    {
+        if (a.offset % policy_file::ALIGNMENT != 0 || a.offset > file_.size())
+            return false;
+        const uint64_t elementSize = uint64_t(a.rows) * uint64_t(a.cols) * sizeof(SCALAR);
+        return a.count == 0 || elementSize == 0 || a.count <= (file_.size() - a.offset) / elementSize;
+    }
+
+    const policy_file::EntryHeader& findEntry(const std::string& name, policy_file::EntryType type) const
+    {
+        auto it = nameToEntry_.find(name);
+        if (it == nameToEntry_.end())
+            throw std::runtime_error("PolicyLibrary: no entry '" + name + "'");
+        const policy_file::EntryHeader& e = index_[it->second];
+        if (e.type != type)
+            throw std::runtime_error("PolicyLibrary: entry '" + name + "' has a different type");
+        return e;
+    }
+
+    template <class T>
+    DiscreteArrayView<T> makeView(const policy_file::ArrayHeader& a) const
+    {
+        if (a.rows != T::RowsAtCompileTime || a.cols != T::ColsAtCompileTime)
+            throw std::runtime_error("PolicyLibrary: element size of the stored array does not match");
+        return DiscreteArrayView<T>(reinterpret_cast<const SCALAR*>(file_.data() + a.offset), a.count);
+    }
+
+    TimeGridView<SCALAR> makeTimeGrid(const policy_file::EntryHeader& e) const
+    {
+        return TimeGridView<SCALAR>(reinterpret_cast<const SCALAR*>(file_.data() + e.time.offset), e.time.count,
+            e.uniformTime != 0, SCALAR(e.t0), SCALAR(e.dt));
+    }
+
+    MappedFile file_;
+    const policy_file::FileHeader* header_;
+    const policy_file::EntryHeader* index_;
+    std::unordered_map<std::string, size_t> nameToEntry_;
+};
+
+}  // namespace core
+}  // namespace ct
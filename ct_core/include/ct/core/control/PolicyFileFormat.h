@@ -0,0 +1,103 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace ct {
+namespace core {
+
+/*!
+ * \brief Layout of the binary policy files written by PolicyFileWriter and read by PolicyLibrary
+ *
+ * A file starts with a FileHeader, followed by an index of nEntries EntryHeaders sorted by name, followed by the
+ * data. Every entry is either a state feedback policy or a trajectory and refers to up to four arrays: the time
+ * stamps and up to three data arrays. An array holds count matrices of size rows x cols, stored column-major and
+ * without padding between the matrices.
+ *
+ * Every array starts at an offset which is a multiple of 64 bytes, hence all data is cache-line aligned when the
+ * file is memory-mapped and can be accessed in place. Values are stored in host byte order.
+ */
+namespace policy_file {
+
+static const uint32_t FILE_VERSION = 1;
+static const char FILE_MAGIC[8] = {'C', 'T', 'P', 'O', 'L', 'I', 'C', 'Y'};
+static const size_t MAX_NAME_LENGTH = 63;
+static const size_t ALIGNMENT = 64;
+
+//! the kind of an entry
+enum EntryType : uint32_t
+{
+    POLICY = 0,     //!< a state feedback controller, the arrays are x_ref, uff and K
+    TRAJECTORY = 1  //!< a discrete trajectory, the first array is the data
+};
+
+//! the scalar type of all data in a file
+enum ScalarType : uint32_t
+{
+    DOUBLE = 0,
+    FLOAT = 1
+};
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t scalarType;
+    uint32_t stateDim;
+    uint32_t controlDim;
+    uint64_t nEntries;
+    uint64_t indexOffset;  //!< offset of the first EntryHeader
+    uint64_t fileSize;     //!< total size of the file, used to detect truncated files
+    uint64_t reserved[2];
+};
+
+struct ArrayHeader
+{
+    uint64_t offset;  //!< offset of the first element from the start of the file
+    uint64_t count;   //!< number of matrices
+    uint32_t rows;
+    uint32_t cols;
+};
+
+struct EntryHeader
+{
+    char name[MAX_NAME_LENGTH + 1];  //!< zero-terminated entry name
+    uint32_t type;
+    uint32_t interpolationType;
+    uint32_t uniformTime;  //!< 1 if the time stamps are equally spaced, allows lookup by time in O(1)
+    uint32_t reserved;
+    double t0;
+    double dt;
+    ArrayHeader time;
+    ArrayHeader data[3];
+};
+
+static_assert(sizeof(FileHeader) % 8 == 0, "policy file headers need to preserve 8 byte alignment");
+static_assert(sizeof(EntryHeader) % 8 == 0, "policy file headers need to preserve 8 byte alignment");
+
+//! rounds a number of bytes up to the next multiple of ALIGNMENT
+inline uint64_t aligned(uint64_t bytes)
+{
+    return (bytes + ALIGNMENT - 1) & ~uint64_t(ALIGNMENT - 1);
+}
+
+template <typename SCALAR>
+struct ScalarTypeOf;
+template <>
+struct ScalarTypeOf<double>
+{
+    static const uint32_t value = DOUBLE;
+};
+template <>
+struct ScalarTypeOf<float>
+{
+    static const uint32_t value = FLOAT;
+};
+
+}  // namespace policy_file
+}  // namespace core
+}  // namespace ct
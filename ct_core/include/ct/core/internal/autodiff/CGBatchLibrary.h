@@ -0,0 +1,88 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#if CPPAD_CG_SYSTEM_LINUX
+#include <dlfcn.h>
+#endif
+
+namespace ct {
+namespace core {
+namespace internal {
+
+//! A just-in-time compiled library of batched functions
+/*!
+ * Compiles C source code, e.g. generated with CGHelpers::generateBatchedSource(), into a shared library and loads
+ * it. All functions in the library share the signature of function_t. The library file is removed once it is
+ * loaded, the code stays mapped until the instance is destroyed.
+ */
+class CGBatchLibrary
+{
+public:
+    //! signature of a batched function: inputs, weights (may be unused), outputs and temporary variables
+    typedef void (*function_t)(const double* x_in, const double* w_in, double* out, double* v_);
+
+    /*!
+     * @param source C source code of the library
+     * @param libName unique name of the library
+     * @param compiler compiler instance, its flags determine the instruction set the code is compiled for
+     * @param saveSource if true, the source code is kept in the folder "sources_<libName>"
+     */
+    CGBatchLibrary(const std::string& source,
+        const std::string& libName,
+        CppAD::cg::AbstractCCompiler<double>& compiler,
+        bool saveSource = false)
+        : handle_(nullptr)
+    {
+#if CPPAD_CG_SYSTEM_LINUX
+        if (saveSource)
+        {
+            compiler.setSaveToDiskFirst(true);
+            compiler.setSourcesFolder("sources_" + libName);
+        }
+
+        const std::string libFile = "./" + libName + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+        compiler.compileSources({{libName + ".c", source}}, true);
+        compiler.buildDynamic(libFile);
+        compiler.cleanup();
+
+        handle_ = dlopen(libFile.c_str(), RTLD_NOW | RTLD_LOCAL);
+        std::remove(libFile.c_str());
+        if (handle_ == nullptr)
+            throw std::runtime_error("CGBatchLibrary: failed to load " + libFile + ": " + dlerror());
+#else
+        throw std::runtime_error("CGBatchLibrary: loading dynamic libraries only supported in Linux.");
+#endif
+    }
+
+    CGBatchLibrary(const CGBatchLibrary&) = delete;
+    CGBatchLibrary& operator=(const CGBatchLibrary&) = delete;
+
+    ~CGBatchLibrary()
+    {
+#if CPPAD_CG_SYSTEM_LINUX
+        if (handle_)
+            dlclose(handle_);
+#endif
+    }
+
+    //! look up a function by name, returns nullptr if the library does not contain it
+    function_t getFunction(const std::string& name) const
+    {
+#if CPPAD_CG_SYSTEM_LINUX
+        return reinterpret_cast<function_t>(dlsym(handle_, name.c_str()));
+#else
+        return nullptr;
+#endif
+    }
+
+private:
+    void* handle_;  //!< handle of the loaded library
+};
+
+}  // namespace internal
+}  // namespace core
+}  // namespace ct
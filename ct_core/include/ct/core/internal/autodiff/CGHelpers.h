@@ -6,6 +6,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #pragma once
 
 #include "SparsityPattern.h"
+#include <regex>
 #include <cppad/local/jacobian.hpp>
 
 namespace ct {
@@ -42,6 +43,9 @@ public:
 	 * @param jacName name of the Jacobian variable in the source code
 	 * @param inputName name of the independent (input) variable of the Jacobian
 	 * @param tempName name of temporary variables (i.e. an array / vector)
+	 * @param scalarName name of the primitive type in the source code
+	 * @param dense if true, the entries of the pattern are written to their position in the column-major
+	 *        Range x Domain Jacobian instead of being written consecutively in the order of the pattern
 	 * @return generated C source code
 	 * @tparam AD_SCALAR Auto-Diff scalar type which is either a normal AD type or a codegen type
    * @tparam SCALAR underlying primitive type
@@ -56,7 +60,8 @@ public:
         std::string jacName = "jac",
         std::string inputName = "x_in",
         std::string tempName = "v_",
-        std::string scalarName = "double")
+        std::string scalarName = "double",
+        bool dense = false)
     {
         CppAD::cg::CodeHandler<SCALAR> codeHandler;
 
@@ -79,6 +84,19 @@ public:
             f.SparseJacobianForward(
                 input, pattern.sparsity(), pattern.row(), pattern.col(), jac, pattern.workJacobian());
 
+        if (dense)
+        {
+            // entries outside the pattern are constant zero and are skipped if ignoreZero is set
+            const size_t m = f.Range();
+            CppAD::vector<AD_SCALAR> jacDense(m * n);
+            for (size_t i = 0; i < m * n; i++)
+                jacDense[i] = AD_SCALAR(0);
+            for (size_t k = 0; k < pattern.row().size(); k++)
+                jacDense[pattern.col()[k] * m + pattern.row()[k]] = jac[k];
+            jac.clear();
+            jac = jacDense;
+        }
+
         CppAD::cg::LanguageC<SCALAR> langC(scalarName, 4);
         langC.setIgnoreZeroDepAssign(ignoreZero);
         CppAD::cg::LangCDefaultVariableNameGenerator<SCALAR> nameGen(jacName, inputName, tempName);
@@ -217,7 +235,7 @@ public:
         CppAD::cg::LanguageC<double> langC("double", 4);
         langC.setIgnoreZeroDepAssign(ignoreZero);
         CppAD::cg::LangCDefaultVariableNameGenerator<double> nameGenTmp(jacName, inputName, tempName);
-        CppAD::cg::LangCDefaultHessianVarNameGenerator<double> nameGen(&nameGenTmp, "w_in", m);
+        CppAD::cg::LangCDefaultHessianVarNameGenerator<double> nameGen(&nameGenTmp, "w_in", n);
 
         std::ostringstream code;
         codeHandler.generateCode(code, langC, hes, nameGen);
@@ -229,6 +247,45 @@ public:
     }
 
 
+    //! turns generated scalar code into code evaluating several points at once
+    /*!
+	 * Rewrites source code generated by one of the methods above such that it evaluates "width" points at once.
+	 * All arrays referenced by the code are expected to be lane-interleaved, i.e. element i of point l is stored
+	 * at index i * width + l. Every access name[i] of the given arrays is replaced by name[i * width + lane] and
+	 * the code is wrapped in a loop over the lanes. Since the loop body is straight-line code with unit-stride
+	 * accesses, the compiler can map each lane to a SIMD lane.
+	 *
+	 * @param code scalar source code
+	 * @param width number of points evaluated at once
+	 * @param arrays names of all arrays in the code, e.g. inputs, outputs and temporary variables
+	 * @return source code of the loop over all lanes
+	 */
+    static std::string generateBatchedSource(const std::string& code,
+        const size_t width,
+        const std::vector<std::string>& arrays)
+    {
+        std::string names;
+        for (const std::string& name : arrays)
+            names += (names.empty() ? "" : "|") + name;
+        const std::regex access("\\b(" + names + ")\\[([0-9]+)\\]");
+
+        std::ostringstream batched;
+        batched << "#pragma omp simd\n";
+        batched << "for (int lane = 0; lane < " << width << "; lane++) {\n";
+
+        std::string::const_iterator last = code.begin();
+        for (std::sregex_iterator it(code.begin(), code.end(), access); it != std::sregex_iterator(); ++it)
+        {
+            const std::smatch& match = *it;
+            batched << std::string(last, match[0].first) << match[1] << "["
+                    << std::stoul(match[2]) * width << " + lane]";
+            last = match[0].second;
+        }
+        batched << std::string(last, code.end()) << "}\n";
+
+        return batched.str();
+    }
+
     //! replaces all occurrences of a (sub-)string in a string with a replacement string
     /*!
 	 *
@@ -28,6 +28,8 @@ public:
     typedef Eigen::Matrix<double, OUT_DIM, 1> OUT_TYPE;  //!< function output vector type
     typedef Eigen::Matrix<double, OUT_DIM, IN_DIM> JAC_TYPE;
     typedef Eigen::Matrix<double, IN_DIM, IN_DIM> HES_TYPE;
+    typedef std::vector<JAC_TYPE, Eigen::aligned_allocator<JAC_TYPE>> JAC_ARRAY_TYPE;  //!< Jacobians of several points
+    typedef std::vector<HES_TYPE, Eigen::aligned_allocator<HES_TYPE>> HES_ARRAY_TYPE;  //!< Hessians of several points
 
     Derivatives(){};
 
@@ -61,6 +63,36 @@ public:
         throw std::runtime_error("JACOBIAN EVALUATION NOT IMPLEMENTED FOR THIS TYPE OF DERIVATIVE");
     }
 
+    /**
+     * @brief      Evaluates the method at several points
+     *
+     * @param[in]  x     The points of evaluation, one per column
+     * @param[out] y     The evaluations, one per column
+     */
+    virtual void forwardZeroBatch(const Eigen::MatrixXd& x, Eigen::MatrixXd& y)
+    {
+        for (int k = 0; k < x.cols(); k++)
+        {
+            OUT_TYPE yk = forwardZero(x.col(k));
+            if (k == 0)
+                y.resize(yk.rows(), x.cols());
+            y.col(k) = yk;
+        }
+    }
+
+    /**
+     * @brief      Evaluates the jacobian at several points
+     *
+     * @param[in]  x     The points of evaluation, one per column
+     * @param[out] jac   The evaluated jacobians, one per point
+     */
+    virtual void jacobianBatch(const Eigen::MatrixXd& x, JAC_ARRAY_TYPE& jac)
+    {
+        jac.resize(x.cols());
+        for (int k = 0; k < x.cols(); k++)
+            jac[k] = jacobian(x.col(k));
+    }
+
     /**
      * @brief      Returns the evaluated jacobian in sparse format
      *
@@ -105,6 +137,20 @@ public:
         throw std::runtime_error("HESSIAN EVALUATION NOT IMPLEMENTED FOR THIS TYPE OF DERIVATIVE");
     }
 
+    /**
+     * @brief      Evaluates the weighted sum of hessians at several points
+     *
+     * @param[in]  x       The points of evaluation, one per column
+     * @param[in]  lambda  The weights of the sum, one column per point
+     * @param[out] hes     The evaluated hessians, one per point
+     */
+    virtual void hessianBatch(const Eigen::MatrixXd& x, const Eigen::MatrixXd& lambda, HES_ARRAY_TYPE& hes)
+    {
+        hes.resize(x.cols());
+        for (int k = 0; k < x.cols(); k++)
+            hes[k] = hessian(x.col(k), lambda.col(k));
+    }
+
     /**
      * @brief      Returns the weighted sum of hessian of the problem in sparse
      *             format
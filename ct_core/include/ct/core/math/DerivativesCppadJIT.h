@@ -7,6 +7,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <ct/core/types/AutoDiff.h>
 #include <ct/core/internal/autodiff/CGHelpers.h>
+#include <ct/core/internal/autodiff/CGBatchLibrary.h>
 #include <ct/core/math/Derivatives.h>
 #include <ct/core/math/DerivativesCppadSettings.h>
 
@@ -49,6 +50,8 @@ public:
 
     using FUN_TYPE_CG = std::function<OUT_TYPE_CG(const IN_TYPE_CG&)>;  //!< function type
     using DerivativesBase = Derivatives<IN_DIM, OUT_DIM>;
+    using JAC_ARRAY_TYPE = typename DerivativesBase::JAC_ARRAY_TYPE;
+    using HES_ARRAY_TYPE = typename DerivativesBase::HES_ARRAY_TYPE;
 
     /**
      * @brief      Contructs the derivatives for codegeneration using a
@@ -63,7 +66,16 @@ public:
      *                        template parameter IN_DIM is -1 (dynamic)
      */
     DerivativesCppadJIT(FUN_TYPE_CG& f, int inputDim = IN_DIM, int outputDim = OUT_DIM)
-        : DerivativesBase(), cgStdFun_(f), inputDim_(inputDim), outputDim_(outputDim), compiled_(false), libName_("")
+        : DerivativesBase(),
+          cgStdFun_(f),
+          inputDim_(inputDim),
+          outputDim_(outputDim),
+          compiled_(false),
+          libName_(""),
+          batchWidth_(0),
+          forwardZeroBatch_(nullptr),
+          jacobianBatch_(nullptr),
+          hessianBatch_(nullptr)
     {
         update(f, inputDim, outputDim);
     }
@@ -81,13 +93,40 @@ public:
           compiled_(arg.compiled_),
           libName_(arg.libName_)
     {
-        cgCppadFun_ = arg.cgCppadFun_;
+        copyBatch(arg);
+        if (arg.cgCppadFun_)
+        {
+            cgCppadFun_ = std::make_shared<CppAD::ADFun<CG_VALUE_TYPE>>();
+            *cgCppadFun_ = *arg.cgCppadFun_;
+        }
         if (compiled_)
         {
             dynamicLib_ = internal::CGHelpers::loadDynamicLibCppad<double>(libName_);
             model_ =
                 std::shared_ptr<CppAD::cg::GenericModel<double>>(dynamicLib_->model("DerivativesCppad" + libName_));
         }
+        copySparsity(arg);
+    }
+
+    /*!
+     * @brief shared copy constructor, see cloneShared()
+     * @param arg instance to share tape and library with
+     */
+    DerivativesCppadJIT(const DerivativesCppadJIT& arg, bool /*share*/)
+        : DerivativesBase(arg),
+          cgStdFun_(arg.cgStdFun_),
+          inputDim_(arg.inputDim_),
+          outputDim_(arg.outputDim_),
+          cgCppadFun_(arg.cgCppadFun_),
+          compiled_(arg.compiled_),
+          libName_(arg.libName_),
+          dynamicLib_(arg.dynamicLib_)
+    {
+        copyBatch(arg);
+        if (compiled_)
+            model_ =
+                std::shared_ptr<CppAD::cg::GenericModel<double>>(dynamicLib_->model("DerivativesCppad" + libName_));
+        copySparsity(arg);
     }
 
 
@@ -112,6 +151,9 @@ public:
             libName_ = "";
             dynamicLib_ = nullptr;
             model_ = nullptr;
+            batchLib_ = nullptr;
+            forwardZeroBatch_ = jacobianBatch_ = hessianBatch_ = nullptr;
+            batchWidth_ = 0;
         }
     }
 
@@ -119,6 +161,19 @@ public:
     virtual ~DerivativesCppadJIT() = default;
     //! deep cloning of Jacobian
     DerivativesCppadJIT* clone() const { return new DerivativesCppadJIT<IN_DIM, OUT_DIM>(*this); }
+    /*!
+     * @brief shallow cloning for concurrent evaluation
+     *
+     * The clone shares the recorded tape and the loaded library with this instance. Only the model, which holds
+     * the input and output buffers of the generated code, is instantiated anew. Hence clones can be evaluated
+     * concurrently from different threads at the cost of a few buffers each. Calling update() on a clone
+     * re-records into a tape owned by the clone and does not affect the others.
+     */
+    DerivativesCppadJIT* cloneShared() const
+    {
+        return new DerivativesCppadJIT<IN_DIM, OUT_DIM>(*this, true);
+    }
+
     virtual OUT_TYPE_D forwardZero(const Eigen::VectorXd& x)
     {
         if (compiled_)
@@ -253,6 +308,79 @@ public:
             throw std::runtime_error("Error: Compile the library first by calling compileJIT(..)");
     }
 
+    /*!
+     * @brief evaluates the function at several points
+     *
+     * Uses the batched library if it was compiled (see DerivativesCppadSettings::createBatch_), which evaluates
+     * batchWidth_ points per call. Otherwise falls back to evaluating the points one by one.
+     */
+    virtual void forwardZeroBatch(const Eigen::MatrixXd& x, Eigen::MatrixXd& y) override
+    {
+        if (!forwardZeroBatch_)
+            return DerivativesBase::forwardZeroBatch(x, y);
+
+        const int W = batchWidth_;
+        y.resize(outputDim_, x.cols());
+        for (int k0 = 0; k0 < x.cols(); k0 += W)
+        {
+            const int n = packBatch(x, k0, xBatch_);
+            forwardZeroBatch_(xBatch_.data(), nullptr, yBatch_.data(), vBatch_.data());
+            for (int lane = 0; lane < n; lane++)
+                for (int i = 0; i < outputDim_; i++)
+                    y(i, k0 + lane) = yBatch_[i * W + lane];
+        }
+    }
+
+    //! evaluates the Jacobian at several points, see forwardZeroBatch()
+    virtual void jacobianBatch(const Eigen::MatrixXd& x, JAC_ARRAY_TYPE& jac) override
+    {
+        if (!jacobianBatch_)
+            return DerivativesBase::jacobianBatch(x, jac);
+
+        const int W = batchWidth_;
+        const int nEntries = outputDim_ * inputDim_;
+        jac.resize(x.cols());
+        for (int k0 = 0; k0 < x.cols(); k0 += W)
+        {
+            const int n = packBatch(x, k0, xBatch_);
+            jacobianBatch_(xBatch_.data(), nullptr, jacBatch_.data(), vBatch_.data());
+            for (int lane = 0; lane < n; lane++)
+            {
+                JAC_TYPE_D& jk = jac[k0 + lane];
+                jk.resize(outputDim_, inputDim_);
+                for (int e = 0; e < nEntries; e++)
+                    jk.data()[e] = jacBatch_[e * W + lane];
+            }
+        }
+    }
+
+    //! evaluates the weighted sum of Hessians at several points, see forwardZeroBatch()
+    virtual void hessianBatch(const Eigen::MatrixXd& x, const Eigen::MatrixXd& lambda, HES_ARRAY_TYPE& hes) override
+    {
+        if (!hessianBatch_)
+            return DerivativesBase::hessianBatch(x, lambda, hes);
+
+        const int W = batchWidth_;
+        const int nEntries = inputDim_ * inputDim_;
+        hes.resize(x.cols());
+        for (int k0 = 0; k0 < x.cols(); k0 += W)
+        {
+            const int n = packBatch(x, k0, xBatch_);
+            packBatch(lambda, k0, wBatch_);
+            hessianBatch_(xBatch_.data(), wBatch_.data(), hesBatch_.data(), vBatch_.data());
+            for (int lane = 0; lane < n; lane++)
+            {
+                HES_TYPE_D& hk = hes[k0 + lane];
+                hk.resize(inputDim_, inputDim_);
+                for (int e = 0; e < nEntries; e++)
+                    hk.data()[e] = hesBatch_[e * W + lane];
+            }
+        }
+    }
+
+    //! number of points evaluated per call of the batched functions, 0 if they are not compiled
+    size_t getBatchWidth() const { return batchWidth_; }
+
     //! get Jacobian sparsity pattern
     /*!
      * Auto-Diff automatically detects the sparsity pattern of the Jacobian. This method returns the pattern.
@@ -372,7 +500,7 @@ public:
 
         libName_ = libName + uniqueID;
 
-        CppAD::cg::ModelCSourceGen<double> cgen(cgCppadFun_, "DerivativesCppad" + libName_);
+        CppAD::cg::ModelCSourceGen<double> cgen(*cgCppadFun_, "DerivativesCppad" + libName_);
 
         cgen.setMultiThreading(settings.multiThreading_);
         cgen.setCreateForwardZero(settings.createForwardZero_);
@@ -421,6 +549,9 @@ public:
         if (verbose)
             std::cout << "DerivativesCppadJIT: successfully compiled " << libName_ << std::endl;
 
+        if (settings.createBatch_)
+            compileBatchJIT(settings, verbose);
+
         if (model_->isJacobianSparsityAvailable())
         {
             model_->JacobianSparsity(sparsityRowsJacobian_, sparsityColsJacobian_);
@@ -484,7 +615,163 @@ protected:
 
         fCodeGen.optimize();
 
-        cgCppadFun_ = fCodeGen;
+        cgCppadFun_ = std::make_shared<CppAD::ADFun<CG_VALUE_TYPE>>();
+        *cgCppadFun_ = fCodeGen;
+    }
+
+    //! generates, compiles and loads the batched variants of the functions enabled in the settings
+    /*!
+     * The generated scalar code is rewritten to operate on lane-interleaved arrays, see
+     * CGHelpers::generateBatchedSource(), and compiled with DerivativesCppadSettings::batchCompileFlags_, by
+     * default for the host's instruction set, such that the compiler can evaluate the lanes with SIMD instructions.
+     */
+    void compileBatchJIT(const DerivativesCppadSettings& settings, bool verbose)
+    {
+        if (!settings.parametersOk())
+            throw std::runtime_error("DerivativesCppadJIT: batch width needs to be positive.");
+
+        const size_t W = settings.batchWidth_;
+        const size_t n = inputDim_;
+        const size_t m = outputDim_;
+
+        std::ostringstream source;
+        source << "#include <math.h>\n\n";
+        size_t maxTempVarCount = 0;
+        size_t tempVarCount = 0;
+
+        if (settings.createForwardZero_)
+        {
+            std::string code =
+                internal::CGHelpers::generateForwardZeroSource(*cgCppadFun_, tempVarCount, true, "y", "x_in", "v_");
+            writeBatchedFunction(source, "forward_zero_batch", "y",
+                internal::CGHelpers::generateBatchedSource(code, W, {"x_in", "y", "v_"}));
+            maxTempVarCount = std::max(maxTempVarCount, tempVarCount);
+        }
+        if (settings.createJacobian_)
+        {
+            Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> sparsity;
+            sparsity.setOnes(n, m);
+            internal::SparsityPattern pattern;
+            pattern.initPattern(sparsity);
+            std::string code = internal::CGHelpers::generateJacobianSource(
+                *cgCppadFun_, pattern, n * m, tempVarCount, m < n, true, "jac", "x_in", "v_");
+            writeBatchedFunction(source, "jacobian_batch", "jac",
+                internal::CGHelpers::generateBatchedSource(code, W, {"x_in", "jac", "v_"}));
+            maxTempVarCount = std::max(maxTempVarCount, tempVarCount);
+        }
+        if (settings.createHessian_)
+        {
+            Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> sparsity;
+            sparsity.setOnes(n, n);
+            internal::SparsityPattern pattern;
+            pattern.initPattern(sparsity);
+            std::string code = internal::CGHelpers::generateHessianSource(
+                *cgCppadFun_, pattern, n * n, tempVarCount, true, "hes", "x_in", "v_");
+            writeBatchedFunction(source, "hessian_batch", "hes",
+                internal::CGHelpers::generateBatchedSource(code, W, {"x_in", "w_in", "hes", "v_"}));
+            maxTempVarCount = std::max(maxTempVarCount, tempVarCount);
+        }
+
+        if (verbose)
+            std::cout << "DerivativesCppadJIT: compiling batched functions of " << libName_ << " for " << W
+                      << " points per call ..." << std::endl;
+
+        std::vector<std::string> flags;
+        std::istringstream flagStream(settings.batchCompileFlags_);
+        for (std::string flag; flagStream >> flag;)
+            flags.push_back(flag);
+        const std::string batchLibName = libName_ + "_batch";
+        if (settings.compiler_ == DerivativesCppadSettings::CLANG)
+        {
+            CppAD::cg::ClangCompiler<double> compiler;
+            compiler.setCompileFlags(flags);
+            compiler.setTemporaryFolder("cppad_temp" + batchLibName);
+            batchLib_ = std::make_shared<internal::CGBatchLibrary>(
+                source.str(), batchLibName, compiler, settings.generateSourceCode_);
+        }
+        else
+        {
+            CppAD::cg::GccCompiler<double> compiler;
+            compiler.setCompileFlags(flags);
+            compiler.setTemporaryFolder("cppad_temp" + batchLibName);
+            batchLib_ = std::make_shared<internal::CGBatchLibrary>(
+                source.str(), batchLibName, compiler, settings.generateSourceCode_);
+        }
+
+        forwardZeroBatch_ = batchLib_->getFunction("forward_zero_batch");
+        jacobianBatch_ = batchLib_->getFunction("jacobian_batch");
+        hessianBatch_ = batchLib_->getFunction("hessian_batch");
+        batchWidth_ = W;
+        allocateBatchBuffers(maxTempVarCount);
+    }
+
+    //! writes the C function evaluating a batch, all functions share the signature internal::CGBatchLibrary::function_t
+    static void writeBatchedFunction(std::ostream& source,
+        const std::string& name,
+        const std::string& outName,
+        const std::string& body)
+    {
+        source << "void " << name << "(const double* restrict x_in, const double* restrict w_in, double* restrict "
+               << outName << ", double* restrict v_) {\n"
+               << body << "}\n\n";
+    }
+
+    //! allocates the lane-interleaved buffers, the output buffers are zero since the code skips zero entries
+    void allocateBatchBuffers(const size_t maxTempVarCount)
+    {
+        xBatch_.assign(inputDim_ * batchWidth_, 0.0);
+        wBatch_.assign(outputDim_ * batchWidth_, 0.0);
+        yBatch_.assign(outputDim_ * batchWidth_, 0.0);
+        jacBatch_.assign(outputDim_ * inputDim_ * batchWidth_, 0.0);
+        hesBatch_.assign(inputDim_ * inputDim_ * batchWidth_, 0.0);
+        vBatch_.assign(std::max(maxTempVarCount, size_t(1)) * batchWidth_, 0.0);
+    }
+
+    //! copies the points k0, ..., k0 + batchWidth_ - 1 into a lane-interleaved buffer
+    /*!
+     * If fewer points are left, the remaining lanes repeat the last point such that all lanes compute valid numbers.
+     * @return number of points copied
+     */
+    int packBatch(const Eigen::MatrixXd& x, const int k0, std::vector<double>& buffer) const
+    {
+        const int W = batchWidth_;
+        const int n = std::min(W, int(x.cols()) - k0);
+        for (int lane = 0; lane < W; lane++)
+        {
+            const int k = k0 + std::min(lane, n - 1);
+            for (int i = 0; i < x.rows(); i++)
+                buffer[i * W + lane] = x(i, k);
+        }
+        return n;
+    }
+
+    //! share the batched library of another instance and allocate own buffers
+    void copyBatch(const DerivativesCppadJIT& arg)
+    {
+        batchLib_ = arg.batchLib_;
+        batchWidth_ = arg.batchWidth_;
+        forwardZeroBatch_ = arg.forwardZeroBatch_;
+        jacobianBatch_ = arg.jacobianBatch_;
+        hessianBatch_ = arg.hessianBatch_;
+        xBatch_ = arg.xBatch_;
+        wBatch_ = arg.wBatch_;
+        yBatch_ = arg.yBatch_;
+        jacBatch_ = arg.jacBatch_;
+        hesBatch_ = arg.hesBatch_;
+        vBatch_ = arg.vBatch_;
+    }
+
+    //! copy the sparsity patterns determined at compile time
+    void copySparsity(const DerivativesCppadJIT& arg)
+    {
+        sparsityRowsJacobian_ = arg.sparsityRowsJacobian_;
+        sparsityColsJacobian_ = arg.sparsityColsJacobian_;
+        sparsityRowsHessian_ = arg.sparsityRowsHessian_;
+        sparsityColsHessian_ = arg.sparsityColsHessian_;
+        sparsityRowsJacobianEigen_ = arg.sparsityRowsJacobianEigen_;
+        sparsityColsJacobianEigen_ = arg.sparsityColsJacobianEigen_;
+        sparsityRowsHessianEigen_ = arg.sparsityRowsHessianEigen_;
+        sparsityColsHessianEigen_ = arg.sparsityColsHessianEigen_;
     }
 
     std::function<OUT_TYPE_CG(const IN_TYPE_CG&)> cgStdFun_;  //! the function
@@ -492,7 +779,7 @@ protected:
     int inputDim_;   //! function input dimension
     int outputDim_;  //! function output dimension
 
-    CppAD::ADFun<CG_VALUE_TYPE> cgCppadFun_;  //!  auto-diff function
+    std::shared_ptr<CppAD::ADFun<CG_VALUE_TYPE>> cgCppadFun_;  //!  auto-diff function, shared by cloneShared()
 
     bool compiled_;        //! flag if Jacobian is compiled
     std::string libName_;  //! a unique name for this library
@@ -511,6 +798,14 @@ protected:
     CppAD::cg::ClangCompiler<double> compilerClang_;
     std::shared_ptr<CppAD::cg::DynamicLib<double>> dynamicLib_;  //! dynamic library to load after compilation
     std::shared_ptr<CppAD::cg::GenericModel<double>> model_;     //! the model
+
+    std::shared_ptr<internal::CGBatchLibrary> batchLib_;  //! library with the batched functions, shared by clones
+    size_t batchWidth_;                                   //! number of points per call of a batched function
+    internal::CGBatchLibrary::function_t forwardZeroBatch_;
+    internal::CGBatchLibrary::function_t jacobianBatch_;
+    internal::CGBatchLibrary::function_t hessianBatch_;
+    //! lane-interleaved inputs, outputs and temporary variables of the batched functions
+    std::vector<double> xBatch_, wBatch_, yBatch_, jacBatch_, hesBatch_, vBatch_;
 };
 
 } /* namespace core */
@@ -7,6 +7,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <iostream>
 #include <map>
+#include <string>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/info_parser.hpp>
 
@@ -40,7 +41,10 @@ public:
           createSparseHessian_(false),
           maxAssignements_(20000),
           compiler_(GCC),
-          generateSourceCode_(false)
+          generateSourceCode_(false),
+          createBatch_(false),
+          batchWidth_(4),
+          batchCompileFlags_("-O3 -march=native -fopenmp-simd")
     {
     }
 
@@ -56,6 +60,9 @@ public:
     size_t maxAssignements_;
     CompilerType compiler_;
     bool generateSourceCode_;
+    bool createBatch_;   //!< additionally generate batched variants of the functions enabled above
+    size_t batchWidth_;  //!< number of points evaluated per call of a batched function, e.g. 4 for AVX2
+    std::string batchCompileFlags_;  //!< whitespace separated compiler flags of the batched library
     /**
      * @brief      Prints out settings
      */
@@ -88,6 +95,11 @@ public:
 
         if (generateSourceCode_)
             std::cout << "Generating and saving Source Code" << std::endl;
+        if (createBatch_)
+        {
+            std::cout << "Generating batched functions evaluating " << batchWidth_ << " points per call" << std::endl;
+            std::cout << "Compiling batched functions with " << batchCompileFlags_ << std::endl;
+        }
     }
 
     /**
@@ -95,7 +107,7 @@ public:
      *
      * @return     Returns true of the parameters are ok
      */
-    bool parametersOk() const { return true; }
+    bool parametersOk() const { return batchWidth_ > 0; }
     /**
      * @brief      Loads the settings from a .info file
      *
@@ -119,6 +131,9 @@ public:
         createSparseHessian_ = pt.get<bool>(ns + ".CreateSparseHessian");
         maxAssignements_ = pt.get<unsigned int>(ns + ".MaxAssignements");
         generateSourceCode_ = pt.get<bool>(ns + ".GenerateSourceCode");
+        createBatch_ = pt.get<bool>(ns + ".CreateBatch", createBatch_);
+        batchWidth_ = pt.get<unsigned int>(ns + ".BatchWidth", batchWidth_);
+        batchCompileFlags_ = pt.get<std::string>(ns + ".BatchCompileFlags", batchCompileFlags_);
 
         std::string compilerStr = pt.get<std::string>(ns + ".Compiler");
 
@@ -7,9 +7,12 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <thread>
 #include <memory>
+#include <vector>
 
+#include <ct/core/common/ThreadPool.h>
 #include <ct/core/types/Time.h>
 #include <ct/core/types/StateVector.h>
 #include <ct/core/integration/Integrator.h>
@@ -23,6 +26,10 @@ namespace core {
  * This runs two threads - one that integrates the controlled system by applying the defined control,
  * and one that updates the control if needed.
  *
+ * Alternatively, simulateEventDriven() runs the closed loop in the calling thread against a virtual clock. The
+ * simulation is then not bound to real time and reproducible, see simulateEventDrivenBatch() for running many
+ * simulations in parallel.
+ *
  * @tparam CONTROLLED_SYSTEM the controlled system that we wish to simulate
  */
 template <class CONTROLLED_SYSTEM>
@@ -94,9 +101,103 @@ public:
             control_thread_.join();
     }
 
+    //! simulates the closed loop in the calling thread, advancing a virtual clock instead of waiting for the wall clock
+    /*!
+     * System integration and controller updates are interleaved by a single scheduler. At the control instants
+     * k * control_dt, the controller is updated with the current state and applied through finishSystemIteration().
+     * Without compute delay, the simulation is deterministic and runs as fast as integration and controller allow.
+     *
+     * @param duration simulated time
+     * @param intType integration type
+     * @param modelComputeDelay if true, the measured wall time of finishControllerIteration() delays the application
+     * of the new controller. The system keeps running with the previous controller meanwhile, control instants which
+     * pass during the computation are skipped.
+     */
+    void simulateEventDriven(Time duration,
+        const IntegrationType& intType = IntegrationType::EULERCT,
+        bool modelComputeDelay = false)
+    {
+        try
+        {
+            stop_ = false;
+            x_ = x0_;
+
+            Integrator<STATE_DIM> integrator(system_, intType);
+            const Time tolerance = 1e-6 * sim_dt_;
+            Time sim_time = 0.0;
+            size_t k = 0;
+
+            while (sim_time < duration - tolerance && !stop_)
+            {
+                prepareControllerIteration(sim_time);
+                auto start = std::chrono::high_resolution_clock::now();
+                finishControllerIteration(sim_time);
+                const Time delay =
+                    modelComputeDelay
+                        ? std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count()
+                        : 0.0;
+
+                if (delay > 0.0)
+                {
+                    integrateUntil(integrator, sim_time, std::min(sim_time + delay, duration));
+                    if (sim_time >= duration - tolerance)
+                        break;
+                }
+                finishSystemIteration(sim_time);
+
+                // next control instant, at the earliest once the controller has been applied
+                k = std::max(k + 1, size_t(std::ceil(sim_time / control_dt_ - 1e-9)));
+                integrateUntil(integrator, sim_time, std::min(k * control_dt_, duration));
+            }
+        } catch (std::exception& e)
+        {
+            std::cout << e.what() << std::endl;
+            throw(std::runtime_error("Control Simulator failed."));
+        }
+    }
+
+    //! runs the event-driven simulations of several simulators in parallel
+    /*!
+     * The simulators are distributed over a ThreadPool, hence each simulator needs its own system and controller
+     * instances. Without compute delay, the results do not depend on the number of threads. If a simulation throws,
+     * the remaining ones are still run and the first exception is rethrown.
+     *
+     * @param simulators the simulators, initialized with their initial states
+     * @param duration simulated time
+     * @param intType integration type
+     * @param modelComputeDelay see simulateEventDriven()
+     * @param nThreads number of threads
+     */
+    template <class SIMULATOR>
+    static void simulateEventDrivenBatch(const std::vector<std::shared_ptr<SIMULATOR>>& simulators,
+        Time duration,
+        const IntegrationType& intType = IntegrationType::EULERCT,
+        bool modelComputeDelay = false,
+        size_t nThreads = std::thread::hardware_concurrency())
+    {
+        ThreadPool pool(std::max(size_t(1), std::min(nThreads, simulators.size())));
+        pool.parallelFor(simulators.size(),
+            [&](size_t i) { simulators[i]->simulateEventDriven(duration, intType, modelComputeDelay); });
+    }
+
     //! stops the simulation
     void stop() { stop_ = true; }
 protected:
+    //! integrates the state from sim_time to t_end in steps of sim_dt_, the last step is shortened to hit t_end
+    void integrateUntil(Integrator<STATE_DIM>& integrator, Time& sim_time, Time t_end)
+    {
+        const Time interval = t_end - sim_time;
+        const int nSteps = int(interval / sim_dt_ + 1e-6);
+        if (nSteps > 0)
+            integrator.integrate_n_steps(x_, sim_time, nSteps, sim_dt_);
+
+        const Time residue = interval - nSteps * sim_dt_;
+        if (residue > 1e-6 * sim_dt_)
+            integrator.integrate_n_steps(x_, sim_time + nSteps * sim_dt_, 1, residue);
+
+        sim_time = t_end;
+    }
+
     //! run by the thread that simulates the system
     virtual void simulateSystem(Time duration, const IntegrationType& intType = IntegrationType::EULERCT)
     {
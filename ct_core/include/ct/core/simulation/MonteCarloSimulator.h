@@ -0,0 +1,379 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ct/core/types/Time.h>
+#include <ct/core/types/StateVector.h>
+#include <ct/core/types/ControlVector.h>
+#include <ct/core/integration/Integrator.h>
+#include <ct/core/control/continuous_time/Controller.h>
+#include <ct/core/common/RandomStream.h>
+#include <ct/core/common/ThreadPool.h>
+
+namespace ct {
+namespace core {
+
+//! Streaming mean, variance and extrema of a scalar quantity (Welford's algorithm)
+class RunningStatistics
+{
+public:
+    RunningStatistics() { reset(); }
+    void reset()
+    {
+        count_ = 0;
+        mean_ = 0.0;
+        m2_ = 0.0;
+        min_ = std::numeric_limits<double>::infinity();
+        max_ = -std::numeric_limits<double>::infinity();
+    }
+
+    //! adds a sample
+    void add(double value)
+    {
+        count_++;
+        const double delta = value - mean_;
+        mean_ += delta / count_;
+        m2_ += delta * (value - mean_);
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    size_t count() const { return count_; }
+    double mean() const { return mean_; }
+    //! sample variance, zero for less than two samples
+    double variance() const { return count_ > 1 ? m2_ / (count_ - 1) : 0.0; }
+    double standardDeviation() const { return std::sqrt(variance()); }
+    double min() const { return min_; }
+    double max() const { return max_; }
+private:
+    size_t count_;
+    double mean_;
+    double m2_;
+    double min_;
+    double max_;
+};
+
+//! result of a single Monte Carlo run
+struct MonteCarloRunResult
+{
+    double cost = 0.0;                 //!< accumulated stage cost plus terminal cost
+    double constraintViolation = 0.0;  //!< maximum constraint violation along the run
+    bool failed = false;               //!< the run diverged, met the failure condition or threw
+};
+
+//! aggregated results of a Monte Carlo study
+struct MonteCarloStatistics
+{
+    size_t nRuns = 0;      //!< number of runs
+    size_t nFailed = 0;    //!< number of failed runs
+    size_t nViolated = 0;  //!< number of successful runs which violate the constraints beyond the tolerance
+
+    RunningStatistics cost;                 //!< cost of the successful runs
+    RunningStatistics constraintViolation;  //!< maximum constraint violation of the successful runs
+
+    double failureRate() const { return nRuns > 0 ? double(nFailed) / nRuns : 0.0; }
+    double violationRate() const { return nRuns > 0 ? double(nViolated) / nRuns : 0.0; }
+};
+
+//! Monte Carlo evaluation of a closed-loop system
+/*!
+ * Runs many closed-loop simulations of a system and controller subject to random perturbations, e.g. of the
+ * initial state, model parameters or controller parameters. The runs are distributed over a thread pool, every
+ * worker simulates its own clone of the system. The controller is cloned from the nominal controller for every run,
+ * such that the internal state of a controller (e.g. the warm start of an MPC) does not carry over between runs.
+ * An MPC can be evaluated by a controller which solves the optimal control problem inside computeControl().
+ *
+ * Each run draws its perturbations from its own counter-based RandomStream, seeded with the study seed and the run
+ * index. The runs are processed in batches and their results are aggregated in run order, such that the statistics
+ * are reproducible and independent of the number of threads. Only the per-run scalar results of one batch are
+ * stored, not the trajectories.
+ *
+ * @tparam CONTROLLED_SYSTEM the controlled system that we wish to evaluate
+ */
+template <class CONTROLLED_SYSTEM>
+class MonteCarloSimulator
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static const size_t STATE_DIM = CONTROLLED_SYSTEM::STATE_DIM;
+    static const size_t CONTROL_DIM = CONTROLLED_SYSTEM::CONTROL_DIM;
+
+    typedef Controller<STATE_DIM, CONTROL_DIM> Controller_t;
+
+    //! settings of a Monte Carlo study
+    struct Settings
+    {
+        size_t nRuns = 1000;                                     //!< number of runs
+        Time duration = 1.0;                                     //!< simulated time per run
+        Time dt = 0.01;                                          //!< integration step
+        IntegrationType integrationType = IntegrationType::RK4;  //!< integrator
+        uint64_t seed = 0;                                       //!< seed of the random streams
+        size_t nThreads = std::thread::hardware_concurrency();   //!< number of threads
+        size_t batchSize = 256;                                  //!< number of runs aggregated at once
+        double constraintTolerance = 1e-6;                       //!< violations above count as violated run
+    };
+
+    /*!
+     * Perturbs a run: modifies the initial state and the system or controller parameters. It is called before every
+     * run on the system clone of the worker which executes it, hence it has to set all perturbed system quantities
+     * rather than modify them incrementally. The controller is a fresh clone of the nominal controller.
+     */
+    typedef std::function<void(size_t run,
+        RandomStream& random,
+        StateVector<STATE_DIM>& x0,
+        CONTROLLED_SYSTEM& system,
+        Controller_t& controller)>
+        Perturbation_t;
+    //! a function of the state, control and time, used for stage cost and constraint violation
+    typedef std::function<double(const StateVector<STATE_DIM>& x, const ControlVector<CONTROL_DIM>& u, Time t)>
+        StageFunction_t;
+    //! terminal cost
+    typedef std::function<double(const StateVector<STATE_DIM>& x)> TerminalCost_t;
+    //! returns true if the run failed, e.g. if the state left the region of interest
+    typedef std::function<bool(const StateVector<STATE_DIM>& x, Time t)> FailureCondition_t;
+    //! called for every run in run order, e.g. for custom statistics
+    typedef std::function<void(size_t run, const MonteCarloRunResult& result)> RunCallback_t;
+
+    /*!
+     * @param system the nominal system
+     * @param controller the nominal controller
+     * @param settings settings of the study
+     */
+    MonteCarloSimulator(std::shared_ptr<CONTROLLED_SYSTEM> system,
+        std::shared_ptr<Controller_t> controller,
+        const Settings& settings)
+        : system_(system), controller_(controller), settings_(settings)
+    {
+        if (settings_.dt <= 0 || settings_.duration < 0)
+            throw std::runtime_error("MonteCarloSimulator: step size must be positive and duration non-negative.");
+    }
+
+    //! constructor with default settings
+    MonteCarloSimulator(std::shared_ptr<CONTROLLED_SYSTEM> system, std::shared_ptr<Controller_t> controller)
+        : MonteCarloSimulator(system, controller, Settings())
+    {
+    }
+
+    void setPerturbation(const Perturbation_t& perturbation) { perturbation_ = perturbation; }
+    //! the stage cost is integrated over the run with the integration step, using the control applied in each step
+    void setStageCost(const StageFunction_t& stageCost) { stageCost_ = stageCost; }
+    void setTerminalCost(const TerminalCost_t& terminalCost) { terminalCost_ = terminalCost; }
+    //! non-negative measure of the constraint violation, its maximum along the run is recorded
+    void setConstraintViolation(const StageFunction_t& violation) { constraintViolation_ = violation; }
+    void setFailureCondition(const FailureCondition_t& failure) { failure_ = failure; }
+    void setRunCallback(const RunCallback_t& callback) { runCallback_ = callback; }
+    Settings& settings() { return settings_; }
+
+    //! runs the study from the nominal initial state x0
+    MonteCarloStatistics simulate(const StateVector<STATE_DIM>& x0)
+    {
+        ThreadPool pool(std::max(size_t(1), std::min(settings_.nThreads, settings_.nRuns)));
+        createWorkers(pool.getNumThreads());
+
+        MonteCarloStatistics statistics;
+        const size_t batchSize = std::max(size_t(1), settings_.batchSize);
+        std::vector<MonteCarloRunResult> results(batchSize);
+
+        for (size_t first = 0; first < settings_.nRuns; first += batchSize)
+        {
+            const size_t n = std::min(batchSize, settings_.nRuns - first);
+            pool.parallelFor(n, [&](size_t i) {
+                Worker& worker = acquireWorker();
+                results[i] = simulateRun(first + i, x0, worker);
+                releaseWorker(worker);
+            });
+
+            for (size_t i = 0; i < n; i++)
+            {
+                accumulate(results[i], statistics);
+                if (runCallback_)
+                    runCallback_(first + i, results[i]);
+            }
+        }
+
+        return statistics;
+    }
+
+    //! simulates a single run in the calling thread, e.g. to inspect an outlier of a study
+    MonteCarloRunResult simulateRun(size_t run, const StateVector<STATE_DIM>& x0)
+    {
+        createWorkers(1);
+        return simulateRun(run, x0, *workers_[0]);
+    }
+
+private:
+    //! forwards to the controller of the current run and records the control at the start of an integration step
+    class RecordingController : public Controller_t
+    {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        RecordingController() : recording_(false) {}
+        RecordingController* clone() const override { return new RecordingController(*this); }
+        void computeControl(const StateVector<STATE_DIM>& state, const Time& t, ControlVector<CONTROL_DIM>& u) override
+        {
+            controller_->computeControl(state, t, u);
+            if (recording_)
+            {
+                recorded_ = u;
+                recording_ = false;
+            }
+        }
+
+        ControlMatrix<CONTROL_DIM> getDerivativeU0(const StateVector<STATE_DIM>& state, const Time time) override
+        {
+            return controller_->getDerivativeU0(state, time);
+        }
+
+        //! the next control computed is recorded, the explicit integrators evaluate the step start first
+        void record() { recording_ = true; }
+        //! false if no control was computed since record()
+        bool hasRecorded() const { return !recording_; }
+        const ControlVector<CONTROL_DIM>& recorded() const { return recorded_; }
+        std::shared_ptr<Controller_t> controller_;
+
+    private:
+        bool recording_;
+        ControlVector<CONTROL_DIM> recorded_;
+    };
+
+    //! clone of the system used by one thread at a time, the controller is replaced for every run
+    struct Worker
+    {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        Worker(std::shared_ptr<CONTROLLED_SYSTEM> s, IntegrationType type, size_t i)
+            : system(s), controller(new RecordingController()), integrator(s, type), index(i)
+        {
+            system->setController(controller);
+        }
+
+        std::shared_ptr<CONTROLLED_SYSTEM> system;
+        std::shared_ptr<RecordingController> controller;
+        Integrator<STATE_DIM> integrator;
+        size_t index;
+    };
+
+    void createWorkers(size_t nWorkers)
+    {
+        workers_.clear();
+        freeWorkers_.clear();
+        for (size_t i = 0; i < nWorkers; i++)
+        {
+            std::shared_ptr<CONTROLLED_SYSTEM> system(static_cast<CONTROLLED_SYSTEM*>(system_->clone()));
+            workers_.emplace_back(new Worker(system, settings_.integrationType, i));
+            freeWorkers_.push_back(i);
+        }
+    }
+
+    Worker& acquireWorker()
+    {
+        std::unique_lock<std::mutex> lock(workerMutex_);
+        const size_t i = freeWorkers_.back();
+        freeWorkers_.pop_back();
+        return *workers_[i];
+    }
+
+    void releaseWorker(const Worker& worker)
+    {
+        std::unique_lock<std::mutex> lock(workerMutex_);
+        freeWorkers_.push_back(worker.index);
+    }
+
+    MonteCarloRunResult simulateRun(size_t run, const StateVector<STATE_DIM>& x0, Worker& worker)
+    {
+        MonteCarloRunResult result;
+        try
+        {
+            RandomStream random(settings_.seed, run);
+            StateVector<STATE_DIM> x = x0;
+            worker.controller->controller_.reset(controller_->clone());
+            if (perturbation_)
+                perturbation_(run, random, x, *worker.system, *worker.controller->controller_);
+
+            StateVector<STATE_DIM> xStart;
+            ControlVector<CONTROL_DIM> u;
+            const size_t nSteps = size_t(std::round(settings_.duration / settings_.dt));
+            for (size_t k = 0; k < nSteps; k++)
+            {
+                const Time t = k * settings_.dt;
+                xStart = x;
+                worker.controller->record();
+                worker.integrator.integrate_n_steps(x, t, 1, settings_.dt);
+
+                if (stageCost_ || constraintViolation_)
+                {
+                    // evaluate the controller only if the integrator did not, e.g. for a first-same-as-last stepper
+                    if (worker.controller->hasRecorded())
+                        u = worker.controller->recorded();
+                    else
+                        worker.controller->computeControl(xStart, t, u);
+                    if (stageCost_)
+                        result.cost += settings_.dt * stageCost_(xStart, u, t);
+                    if (constraintViolation_)
+                        result.constraintViolation =
+                            std::max(result.constraintViolation, constraintViolation_(xStart, u, t));
+                }
+
+                if (!x.allFinite() || (failure_ && failure_(x, t + settings_.dt)))
+                {
+                    result.failed = true;
+                    return result;
+                }
+            }
+
+            if (terminalCost_)
+                result.cost += terminalCost_(x);
+            result.failed = !std::isfinite(result.cost);
+        } catch (...)
+        {
+            result.failed = true;
+        }
+        return result;
+    }
+
+    void accumulate(const MonteCarloRunResult& result, MonteCarloStatistics& statistics) const
+    {
+        statistics.nRuns++;
+        if (result.failed)
+        {
+            statistics.nFailed++;
+            return;
+        }
+        statistics.cost.add(result.cost);
+        statistics.constraintViolation.add(result.constraintViolation);
+        if (result.constraintViolation > settings_.constraintTolerance)
+            statistics.nViolated++;
+    }
+
+    std::shared_ptr<CONTROLLED_SYSTEM> system_;
+    std::shared_ptr<Controller_t> controller_;
+    Settings settings_;
+
+    Perturbation_t perturbation_;
+    StageFunction_t stageCost_;
+    TerminalCost_t terminalCost_;
+    StageFunction_t constraintViolation_;
+    FailureCondition_t failure_;
+    RunCallback_t runCallback_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<size_t> freeWorkers_;
+    std::mutex workerMutex_;
+};
+
+}  // namespace core
+}  // namespace ct
@@ -150,6 +150,25 @@ public:
         return dFdu_;
     }
 
+    //! get both Jacobians with a single evaluation of the generated code
+    /*!
+     * \warning Call compileJIT() before calling this function.
+     *
+     * @param A Jacobian wrt state
+     * @param B Jacobian wrt input
+     * @param x state to linearize at
+     * @param u control to linearize at
+     * @param t time
+     */
+    void getDerivatives(state_matrix_t& A,
+        state_control_matrix_t& B,
+        const state_vector_t& x,
+        const control_vector_t& u,
+        const SCALAR t = SCALAR(0.0)) override
+    {
+        linearizer_.getDerivatives(A, B, x, u, t);
+    }
+
     //! compile just-in-time
     /*!
 	 * Generates the source code, compiles it and dynamically loads the resulting library.
@@ -161,8 +180,9 @@ public:
     //! generates source code and saves it to file
     /*!
      * This generates source code for computing the system linearization and saves it to file. This
-     * function uses a template file in which it replaces two placeholders, each identified as the
-     * string "AUTOGENERATED_CODE_PLACEHOLDER"
+     * function uses a template file in which it replaces three placeholders, each identified as the
+     * string "AUTOGENERATED_CODE_PLACEHOLDER". Besides A and B, the generated LinearSystem evaluates
+     * both Jacobians in getDerivatives() from a single operation graph, sharing all common subexpressions.
      *
      * @param systemName name of the resulting LinearSystem class
      * @param outputDir output directory
@@ -180,11 +200,12 @@ public:
         bool useReverse = false,
         bool ignoreZero = true)
     {
-        std::string codeJacA, codeJacB;
+        std::string codeJacA, codeJacB, codeJacAB;
         linearizer_.generateCode(codeJacA, codeJacB, useReverse, ignoreZero);
+        linearizer_.generateFusedCode(codeJacAB, useReverse, ignoreZero);
 
-        writeCodeFile(
-            templateDir, outputDir, systemName, ns1, ns2, codeJacA, codeJacB, "AUTOGENERATED_CODE_PLACEHOLDER");
+        writeCodeFile(templateDir, outputDir, systemName, ns1, ns2, codeJacA, codeJacB, codeJacAB,
+            "AUTOGENERATED_CODE_PLACEHOLDER");
     }
 
     //! accessor to the linearizer, e.g. for testing
@@ -200,6 +221,7 @@ private:
      * @param ns2 second layer namespace
      * @param codeJacA code for state Jacobian A
      * @param codeJacB code for input Jacobian B
+     * @param codeJacAB code for the stacked Jacobian [A, B]
      * @param codePlaceholder placeholder to search for and to be replaced with code
      */
     void writeCodeFile(const std::string& templateDir,
@@ -209,6 +231,7 @@ private:
         const std::string& ns2,
         const std::string& codeJacA,
         const std::string& codeJacB,
+        const std::string& codeJacAB,
         const std::string& codePlaceholder)
     {
         std::cout << "Generating linear system..." << std::endl;
@@ -226,7 +249,10 @@ private:
 
         internal::CGHelpers::replaceOnce(header, "MAX_COUNT_STATE", std::to_string(maxTempVarCountState));
         internal::CGHelpers::replaceOnce(header, "MAX_COUNT_CONTROL", std::to_string(maxTempVarCountControl));
+        internal::CGHelpers::replaceOnce(
+            header, "MAX_COUNT_FUSED", std::to_string(linearizer_.getMaxTempVarCountFused()));
 
+        internal::CGHelpers::replaceOnce(source, codePlaceholder + "_JAC_AB", codeJacAB);
         internal::CGHelpers::replaceOnce(source, codePlaceholder + "_JAC_A", codeJacA);
         internal::CGHelpers::replaceOnce(source, codePlaceholder + "_JAC_B", codeJacB);
 
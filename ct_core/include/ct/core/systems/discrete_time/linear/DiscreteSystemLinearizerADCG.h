@@ -170,8 +170,7 @@ public:
         state_matrix_t& A,
         state_control_matrix_t& B) override
     {
-        dFdx_ = linearizer_.getDerivativeState(x, u, n);
-        dFdu_ = linearizer_.getDerivativeControl(x, u, n);
+        linearizer_.getDerivatives(dFdx_, dFdu_, x, u, n);
 
         A = dFdx_;
         B = dFdu_;
@@ -188,8 +187,9 @@ public:
     //! generates source code and saves it to file
     /*!
      * This generates source code for computing the system linearization and saves it to file. This
-     * function uses a template file in which it replaces two placeholders, each identified as the
-     * string "AUTOGENERATED_CODE_PLACEHOLDER"
+     * function uses template files in which it replaces three placeholders, each identified as the
+     * string "AUTOGENERATED_CODE_PLACEHOLDER". The generated system evaluates A and B in getAandB()
+     * from a single operation graph, sharing all common subexpressions.
      *
      * @param systemName name of the resulting LinearSystem class
      * @param outputDir output directory
@@ -207,11 +207,12 @@ public:
         bool useReverse = false,
         bool ignoreZero = true)
     {
-        std::string codeJacA, codeJacB;
+        std::string codeJacA, codeJacB, codeJacAB;
         linearizer_.generateCode(codeJacA, codeJacB, useReverse, ignoreZero);
+        linearizer_.generateFusedCode(codeJacAB, useReverse, ignoreZero);
 
-        writeCodeFile(
-            templateDir, outputDir, systemName, ns1, ns2, codeJacA, codeJacB, "AUTOGENERATED_CODE_PLACEHOLDER");
+        writeCodeFile(templateDir, outputDir, systemName, ns1, ns2, codeJacA, codeJacB, codeJacAB,
+            "AUTOGENERATED_CODE_PLACEHOLDER");
     }
 
     //! accessor to the linearizer, e.g. for testing
@@ -227,6 +228,7 @@ private:
      * @param ns2 second layer namespace
      * @param codeJacA code for state Jacobian A
      * @param codeJacB code for input Jacobian B
+     * @param codeJacAB code for the stacked Jacobian [A, B]
      * @param codePlaceholder placeholder to search for and to be replaced with code
      */
     void writeCodeFile(const std::string& templateDir,
@@ -236,6 +238,7 @@ private:
         const std::string& ns2,
         const std::string& codeJacA,
         const std::string& codeJacB,
+        const std::string& codeJacAB,
         const std::string& codePlaceholder)
     {
         std::cout << "Generating discrete linear system..." << std::endl;
@@ -246,22 +249,28 @@ private:
         std::string header = internal::CGHelpers::parseFile(templateDir + "/DiscreteLinearSystem.tpl.h");
         std::string sourceA = internal::CGHelpers::parseFile(templateDir + "/DiscreteLinearSystem.tplA.cpp");
         std::string sourceB = internal::CGHelpers::parseFile(templateDir + "/DiscreteLinearSystem.tplB.cpp");
+        std::string sourceAB = internal::CGHelpers::parseFile(templateDir + "/DiscreteLinearSystem.tplAB.cpp");
 
         const std::string scalarName(linearizer_.getOutScalarType());
 
         replaceSizesAndNames(header, systemName, scalarName, ns1, ns2);
         replaceSizesAndNames(sourceA, systemName, scalarName, ns1, ns2);
         replaceSizesAndNames(sourceB, systemName, scalarName, ns1, ns2);
+        replaceSizesAndNames(sourceAB, systemName, scalarName, ns1, ns2);
 
         internal::CGHelpers::replaceOnce(header, "MAX_COUNT_STATE", std::to_string(maxTempVarCountState));
         internal::CGHelpers::replaceOnce(header, "MAX_COUNT_CONTROL", std::to_string(maxTempVarCountControl));
+        internal::CGHelpers::replaceOnce(
+            header, "MAX_COUNT_FUSED", std::to_string(linearizer_.getMaxTempVarCountFused()));
 
         internal::CGHelpers::replaceOnce(sourceA, codePlaceholder + "_JAC_A", codeJacA);
         internal::CGHelpers::replaceOnce(sourceB, codePlaceholder + "_JAC_B", codeJacB);
+        internal::CGHelpers::replaceOnce(sourceAB, codePlaceholder + "_JAC_AB", codeJacAB);
 
         internal::CGHelpers::writeFile(outputDir + "/" + systemName + ".h", header);
         internal::CGHelpers::writeFile(outputDir + "/" + systemName + "_A.cpp", sourceA);
         internal::CGHelpers::writeFile(outputDir + "/" + systemName + "_B.cpp", sourceB);
+        internal::CGHelpers::writeFile(outputDir + "/" + systemName + "_AB.cpp", sourceAB);
 
 
         std::cout << "... Done! Successfully generated discrete linear system" << std::endl;
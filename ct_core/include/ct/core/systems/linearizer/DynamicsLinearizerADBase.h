@@ -59,9 +59,10 @@ public:
     //! copy constructor
     DynamicsLinearizerADBase(const DynamicsLinearizerADBase& arg) : dynamics_fct_(arg.dynamics_fct_)
     {
+        f_ = arg.f_;
         setupSparsityA();
         setupSparsityB();
-        f_ = arg.f_;
+        setupSparsityAB();
     }
 
     template <typename T = std::string>  // do not use this template argument
@@ -93,6 +94,7 @@ protected:
         recordTerms();
         setupSparsityA();
         setupSparsityB();
+        setupSparsityAB();
     }
 
     //! record the model
@@ -152,11 +154,36 @@ protected:
         sparsityB_.clearWork();
     }
 
+    //! setup the sparsity of the stacked Jacobian from the structure of the recorded dynamics
+    void setupSparsityAB()
+    {
+        // the derivative is a STATE_DIM*(STATE_DIM+CONTROL_DIM) Matrix:
+        // dF/dx = [ A, B ]^T
+        // only entries which structurally depend on the inputs are part of the pattern
+        const size_t n = STATE_DIM + CONTROL_DIM;
+        CppAD::vector<bool> identity(n * n);
+        for (size_t i = 0; i < n * n; i++)
+            identity[i] = (i % (n + 1) == 0);
+
+        // row-major STATE_DIM x n pattern of the Jacobian
+        CppAD::vector<bool> jacSparsity = f_.ForSparseJac(n, identity);
+        f_.size_forward_bool(0);
+
+        Eigen::Matrix<bool, STATE_DIM + CONTROL_DIM, STATE_DIM> sparsity;
+        for (size_t i = 0; i < STATE_DIM; i++)
+            for (size_t j = 0; j < n; j++)
+                sparsity(j, i) = jacSparsity[i * n + j];
+
+        sparsityAB_.initPattern(sparsity);
+        sparsityAB_.clearWork();
+    }
+
     dynamics_fct_t dynamics_fct_;                  //!< function handle to system dynamics
     CppAD::ADFun<typename SCALAR::value_type> f_;  //!< Auto-Diff function
 
-    SparsityPattern sparsityA_;  //!< sparsity pattern of the state Jacobian
-    SparsityPattern sparsityB_;  //!< sparsity pattern of the input Jacobian
+    SparsityPattern sparsityA_;   //!< sparsity pattern of the state Jacobian
+    SparsityPattern sparsityB_;   //!< sparsity pattern of the input Jacobian
+    SparsityPattern sparsityAB_;  //!< structural sparsity pattern of the stacked Jacobian [A, B]
 };
 
 }  // namespace internal
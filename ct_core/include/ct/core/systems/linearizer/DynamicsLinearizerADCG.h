@@ -57,13 +57,14 @@ public:
           compiled_(false),
           cacheJac_(cacheJac),
           maxTempVarCountState_(0),
-          maxTempVarCountControl_(0)
+          maxTempVarCountControl_(0),
+          maxTempVarCountFused_(0)
     {
     }
 
-    //! copy constructor
+    //! copy constructor, copies the recorded model instead of recording it again
     DynamicsLinearizerADCG(const DynamicsLinearizerADCG& rhs)
-        : Base(rhs.dynamics_fct_),
+        : Base(rhs),
           dynamics_fct_(rhs.dynamics_fct_),
           dFdx_(rhs.dFdx_),
           dFdu_(rhs.dFdu_),
@@ -73,7 +74,8 @@ public:
           compiled_(rhs.compiled_),
           cacheJac_(rhs.cacheJac_),
           maxTempVarCountState_(rhs.maxTempVarCountState_),
-          maxTempVarCountControl_(rhs.maxTempVarCountControl_)
+          maxTempVarCountControl_(rhs.maxTempVarCountControl_),
+          maxTempVarCountFused_(rhs.maxTempVarCountFused_)
     {
         if (compiled_)
         {
@@ -131,6 +133,33 @@ public:
         return dFdu_;
     }
 
+    //! compute both Jacobians with a single evaluation of the generated code
+    /*!
+     * \warning Call compileJIT() before calling this function
+     *
+     * @param A Jacobian w.r.t. state
+     * @param B Jacobian w.r.t. control
+     * @param x state to linearize at
+     * @param u control to linearize at
+     * @param t time
+     */
+    void getDerivatives(state_matrix_t& A,
+        state_control_matrix_t& B,
+        const state_vector_t& x,
+        const control_vector_t& u,
+        const OUT_SCALAR t = 0.0)
+    {
+        if (!compiled_)
+            throw std::runtime_error(
+                "Called getDerivatives on ADCodegenLinearizer before compiling. Call 'compile()' before");
+
+        if (!cacheJac_ || (x != x_at_cache_ || u != u_at_cache_))
+            computeJacobian(x, u);
+
+        A = dFdx_;
+        B = dFdu_;
+    }
+
     //! compile just-in-time
     /*!
     * Generates the source code, compiles it and dynamically loads the resulting library.
@@ -205,6 +234,27 @@ public:
             Base::getOutScalarType());
     }
 
+    //! generates source code for the stacked Jacobian [A, B]
+    /*!
+     * Generates the code of both Jacobians as a single operation graph, such that all subexpressions shared
+     * between A and B are computed only once. The code writes the STATE_DIM x (STATE_DIM + CONTROL_DIM) matrix
+     * [A, B] in column-major order to "jac", i.e. A followed by B. Only the entries in the structural sparsity
+     * pattern of the dynamics are differentiated, all other entries are left untouched and have to be zero
+     * in "jac".
+     *
+     * @param[out] codeJacAB string with the generated code for the stacked matrix [A, B]
+     * @param[in]  useReverse if true, uses Auto-Diff reverse mode
+     * @param[in]  ignoreZero if true, zero entries are not assigned zero
+     */
+    void generateFusedCode(std::string& codeJacAB, bool useReverse = false, bool ignoreZero = true)
+    {
+        this->sparsityAB_.clearWork();
+        size_t jacDimension = this->sparsityAB_.row().size();
+        codeJacAB = internal::CGHelpers::generateJacobianSource<typename SCALAR::value_type, OUT_SCALAR>(this->f_,
+            this->sparsityAB_, jacDimension, maxTempVarCountFused_, useReverse, ignoreZero, "jac", "x_in", "vXU_",
+            Base::getOutScalarType(), true);
+    }
+
     //! accessor to maxTempVarCount variables
     void getMaxTempVarCount(size_t& maxTempVarCountState, size_t& maxTempVarCountControl) const
     {
@@ -212,6 +262,9 @@ public:
         maxTempVarCountControl = maxTempVarCountControl_;
     }
 
+    //! accessor to the number of temporary variables in the source code of the stacked Jacobian
+    size_t getMaxTempVarCountFused() const { return maxTempVarCountFused_; }
+
     //! retrieve the dynamic library, e.g. for testing purposes
     const std::shared_ptr<CppAD::cg::DynamicLib<OUT_SCALAR>> getDynamicLib() const { return dynamicLib_; }
 protected:
@@ -259,6 +312,7 @@ protected:
 
     size_t maxTempVarCountState_;    //!< number of temporary variables in the source code of the state Jacobian
     size_t maxTempVarCountControl_;  //!< number of temporary variables in the source code of the input Jacobian
+    size_t maxTempVarCountFused_;    //!< number of temporary variables in the source code of the stacked Jacobian
 };
 
 }  // namespace core
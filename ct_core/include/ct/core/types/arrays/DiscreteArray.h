@@ -7,6 +7,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <vector>
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
 
 namespace ct {
 namespace core {
@@ -30,12 +32,12 @@ public:
     typedef typename std::vector<T, Alloc>::const_iterator const_iterator;  //!< const iterator
 
     //! default constructor
-    DiscreteArray() : Base(Alloc()){};
+    DiscreteArray() : Base(Alloc()), offset_(0){};
 
     //! move constructor
-    DiscreteArray(const DiscreteArray&& other) : Base(static_cast<const Base&&>(other)) {}
+    DiscreteArray(const DiscreteArray&& other) : Base(other.begin(), other.end()), offset_(0) {}
     //! copy constructor
-    DiscreteArray(const DiscreteArray& other) : Base(static_cast<const Base&>(other)){};
+    DiscreteArray(const DiscreteArray& other) : Base(other.begin(), other.end()), offset_(0){};
 
     //! resize constructor
     /*!
@@ -43,7 +45,7 @@ public:
 	 * @param n length of array
 	 * @param value default value
 	 */
-    DiscreteArray(int n, const T& value = T()) : Base(n, value){};
+    DiscreteArray(int n, const T& value = T()) : Base(n, value), offset_(0){};
 
     //! copy constructor
     /*!
@@ -51,7 +53,7 @@ public:
 	 * @param first iterator to first element
 	 * @param last iterator to last element
 	 */
-    DiscreteArray(iterator first, iterator last) : Base(first, last){};
+    DiscreteArray(iterator first, iterator last) : Base(first, last), offset_(0){};
 
     //! copy constructor
     /*!
@@ -59,29 +61,66 @@ public:
 	 * @param first iterator to first element
 	 * @param last iterator to last element
 	 */
-    DiscreteArray(const_iterator first, const_iterator last) : Base(first, last){};
+    DiscreteArray(const_iterator first, const_iterator last) : Base(first, last), offset_(0){};
 
     //! destructor
     virtual ~DiscreteArray(){};
 
-    using Base::operator[];
-    using Base::at;
     using Base::back;
-    using Base::begin;
-    using Base::clear;
     using Base::end;
-    using Base::front;
     using Base::pop_back;
     using Base::push_back;
-    using Base::reserve;
-    using Base::resize;
-    using Base::size;
+
+    //! access an element (no bounds check)
+    T& operator[](const size_t i) { return Base::operator[](i + offset_); }
+    //! access an element (no bounds check)
+    const T& operator[](const size_t i) const { return Base::operator[](i + offset_); }
+    //! access an element with bounds check
+    T& at(const size_t i)
+    {
+        if (i >= size())
+            throw std::out_of_range("DiscreteArray::at: index out of range");
+        return Base::operator[](i + offset_);
+    }
+    //! access an element with bounds check
+    const T& at(const size_t i) const
+    {
+        if (i >= size())
+            throw std::out_of_range("DiscreteArray::at: index out of range");
+        return Base::operator[](i + offset_);
+    }
+    //! iterator to the first element
+    iterator begin() { return Base::begin() + offset_; }
+    //! iterator to the first element
+    const_iterator begin() const { return Base::begin() + offset_; }
+    //! get the first element
+    T& front() { return Base::operator[](offset_); }
+    //! get the first element
+    const T& front() const { return Base::operator[](offset_); }
+    //! number of elements
+    size_t size() const { return Base::size() - offset_; }
+    //! resize the array, new elements are appended at the back
+    void resize(const size_t n) { Base::resize(n + offset_); }
+    //! resize the array, new elements are appended at the back and set to value
+    void resize(const size_t n, const T& value) { Base::resize(n + offset_, value); }
+    //! reserve memory for n elements
+    void reserve(const size_t n) { Base::reserve(n + offset_); }
+    //! remove all elements
+    void clear()
+    {
+        Base::clear();
+        offset_ = 0;
+    }
 
     //! swaps the content of two arrays
     /*!
 	 * @param other reference to the other array
 	 */
-    void swap(DiscreteArray& other) { Base::swap(static_cast<Base&>(other)); }
+    void swap(DiscreteArray& other)
+    {
+        Base::swap(static_cast<Base&>(other));
+        std::swap(offset_, other.offset_);
+    }
     //!< assignment operator
     DiscreteArray<T, Alloc>& operator=(const DiscreteArray<T, Alloc>& rhs)
     {
@@ -89,7 +128,8 @@ public:
         if (this == &rhs)
             return *this;
 
-        Base::operator=(static_cast<const Base&>(rhs));
+        Base::assign(rhs.begin(), rhs.end());
+        offset_ = 0;
 
         return *this;
     }
@@ -157,11 +197,24 @@ public:
     }
 
     //! returns the underlying std::vector
-    Base& toImplementation() { return *this; }
-    //! returns the underlying std::vector
-    const Base& toImplementation() const { return *this; }
-    //! erase an element from the front
-    void eraseFront(const size_t N) { this->erase(this->begin(), this->begin() + N); }
+    Base& toImplementation()
+    {
+        compact();
+        return *this;
+    }
+    //! returns a copy of the elements as std::vector
+    Base toImplementation() const { return Base(begin(), end()); }
+    //! erase N elements from the front
+    /*!
+	 * The erased elements are only released once they outnumber the remaining ones, such that erasing is amortized
+	 * O(N) instead of moving all remaining elements each time.
+	 */
+    void eraseFront(const size_t N)
+    {
+        offset_ += std::min(N, size());
+        if (offset_ >= size())
+            compact();
+    }
     //! sets all elements to a constant.
     void setConstant(const T& data) { std::fill(this->begin(), this->end(), data); }
     //! add an offset to each element
@@ -169,6 +222,16 @@ public:
     {
         std::for_each(this->begin(), this->end(), [&](T& val) { val += offset; });
     }
+
+private:
+    //! release the elements erased from the front
+    void compact()
+    {
+        Base::erase(Base::begin(), Base::begin() + offset_);
+        offset_ = 0;
+    }
+
+    size_t offset_;  //!< number of elements erased from the front but not yet released
 };
 
 } /* namespace core */
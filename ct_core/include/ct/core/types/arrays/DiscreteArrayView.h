@@ -0,0 +1,70 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "DiscreteArray.h"
+
+namespace ct {
+namespace core {
+
+//! A read-only view on a discrete array of fixed-size Eigen matrices stored in external memory
+/*!
+ * The elements are stored contiguously and column-major without padding, e.g. in a memory-mapped file.
+ * Accessing an element returns an Eigen::Map, no data is copied. The view does not own the memory, which
+ * has to outlive the view.
+ *
+ * \tparam T fixed-size Eigen matrix type of the elements, e.g. StateVector<STATE_DIM>
+ */
+template <class T>
+class DiscreteArrayView
+{
+public:
+    typedef T value_type;
+    typedef typename T::Scalar Scalar;
+    typedef Eigen::Matrix<Scalar, T::RowsAtCompileTime, T::ColsAtCompileTime> PlainMatrix;
+    typedef Eigen::Map<const PlainMatrix> ConstMap;
+
+    static const size_t elementSize = T::RowsAtCompileTime * T::ColsAtCompileTime;
+
+    //! default constructor, creates an empty view
+    DiscreteArrayView() : data_(nullptr), size_(0) {}
+    //! creates a view on n elements starting at data
+    DiscreteArrayView(const Scalar* data, size_t n) : data_(data), size_(n) {}
+    //! number of elements
+    size_t size() const { return size_; }
+    //! true if the view contains no elements
+    bool empty() const { return size_ == 0; }
+    //! access element i without copying
+    ConstMap operator[](size_t i) const { return ConstMap(data_ + i * elementSize); }
+    //! access element i with bounds check
+    ConstMap at(size_t i) const
+    {
+        if (i >= size_)
+            throw std::out_of_range("DiscreteArrayView: index out of range");
+        return (*this)[i];
+    }
+
+    ConstMap front() const { return (*this)[0]; }
+    ConstMap back() const { return (*this)[size_ - 1]; }
+    //! pointer to the first scalar of the first element
+    const Scalar* data() const { return data_; }
+    //! copies the viewed elements into a discrete array
+    DiscreteArray<T> toArray() const
+    {
+        DiscreteArray<T> array;
+        array.reserve(size_);
+        for (size_t i = 0; i < size_; i++)
+            array.push_back((*this)[i]);
+        return array;
+    }
+
+private:
+    const Scalar* data_;
+    size_t size_;
+};
+
+}  // namespace core
+}  // namespace ct
@@ -113,6 +113,8 @@ public:
 	 * @param type new interpolation strategy
 	 */
     void setInterpolationType(const InterpolationType& type) { interp_.changeInterpolationType(type); }
+    //! get the interpolation type
+    InterpolationType getInterpolationType() const { return interp_.getInterpolationType(); }
     //! set timestamps
     /*!
 	 * @param time new time stamps
@@ -188,11 +190,29 @@ public:
         data_.push_back(data);
     }
 
-    //! Remove the last data and time pair
-    void pop_back()
+    //! Append N copies of the last element, equally spaced by dt
+    /*!
+	 * Extends the trajectory at the back with a constant value, allocating at most once.
+	 * @param N		number of elements to append
+	 * @param dt	time spacing of the appended elements
+	 */
+    void extend(const size_t& N, const SCALAR& dt)
+    {
+        const size_t n = data_.size();
+        const SCALAR tf = time_.back();
+        const T last = data_.back();
+        data_.resize(n + N, last);
+        time_.resize(n + N);
+        for (size_t i = 1; i <= N; i++)
+            time_[n + i - 1] = tf + i * dt;
+    }
+
+    //! Remove the last N data and time pairs
+    void pop_back(const size_t& N = 1)
     {
-        time_.pop_back();
-        data_.pop_back();
+        const size_t n = data_.size() - std::min(N, data_.size());
+        time_.resize(n);
+        data_.resize(n);
     }
 
     //! Erase front elements and optionally shift the trajectory in time
@@ -207,6 +227,19 @@ public:
         shiftTime(dt);
     }
 
+    //! Erase front elements and move the remaining data onto the existing time grid
+    /*!
+	 * Data point i+N takes the time stamp of data point i and the last N time stamps are removed. On an equally
+	 * spaced time grid this is equivalent to eraseFront(N, N * dt), but it does not rewrite the time stamps and
+	 * costs O(N) instead of O(size()).
+	 * @param N		number of elements to erase from the front
+	 */
+    void dropFront(const size_t& N)
+    {
+        data_.eraseFront(N);
+        time_.resize(data_.size());
+    }
+
     //! Clear the trajectory
     void clear()
     {
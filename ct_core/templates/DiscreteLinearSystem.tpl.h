@@ -40,11 +40,7 @@ public:
         state_matrix_t& A,
         state_control_matrix_t& B) override
     {
-        getDerivativeState(x, u, n);
-        getDerivativeControl(x, u, n);
-
-        A = dFdx_;
-        B = dFdu_;
+        getDerivatives(A, B, x, u, n);
     }
 
     virtual const state_matrix_t& getDerivativeState(const state_vector_t& x,
@@ -55,19 +51,30 @@ public:
         const control_vector_t& u,
         const int t = 0);
 
+    //! evaluates A and B together, all subexpressions shared by both are computed once
+    void getDerivatives(state_matrix_t& A,
+        state_control_matrix_t& B,
+        const state_vector_t& x,
+        const control_vector_t& u,
+        const int t = 0);
+
 private:
     void initialize()
     {
         dFdx_.setZero();
         dFdu_.setZero();
+        dFdxu_.setZero();
         vX_.fill(0.0);
         vU_.fill(0.0);
+        vXU_.fill(0.0);
     }
 
     state_matrix_t dFdx_;
     state_control_matrix_t dFdu_;
+    Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM + CONTROL_DIM> dFdxu_;
     std::array<SCALAR, MAX_COUNT_STATE> vX_;
     std::array<SCALAR, MAX_COUNT_CONTROL> vU_;
+    std::array<SCALAR, MAX_COUNT_FUSED> vXU_;
 };
 
 }  // namespace NS2
@@ -0,0 +1,35 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+// clang-format off
+
+#include "LINEAR_SYSTEM_NAME.h"
+
+namespace ct {
+namespace NS1 {
+namespace NS2 {
+
+void LINEAR_SYSTEM_NAME::getDerivatives(
+    state_matrix_t& A,
+    state_control_matrix_t& B,
+    const state_vector_t& x,
+    const control_vector_t& u,
+    const int t)
+{
+    SCALAR* jac = dFdxu_.data();
+    Eigen::Matrix<SCALAR, STATE_DIM + CONTROL_DIM, 1> x_in;
+    x_in << x, u;
+
+    AUTOGENERATED_CODE_PLACEHOLDER_JAC_AB
+
+    A = dFdxu_.leftCols<STATE_DIM>();
+    B = dFdxu_.rightCols<CONTROL_DIM>();
+}
+
+} // namespace NS2
+} // namespace NS1
+} // namespace ct
+
+// clang-format on
@@ -40,6 +40,23 @@ const LINEAR_SYSTEM_NAME::state_control_matrix_t& LINEAR_SYSTEM_NAME::getDerivat
     return dFdu_;
 }
 
+void LINEAR_SYSTEM_NAME::getDerivatives(
+    state_matrix_t& A,
+    state_control_matrix_t& B,
+    const state_vector_t& x,
+    const control_vector_t& u,
+    const SCALAR t)
+{
+    SCALAR* jac = dFdxu_.data();
+    Eigen::Matrix<SCALAR, STATE_DIM + CONTROL_DIM, 1> x_in;
+    x_in << x, u;
+
+    AUTOGENERATED_CODE_PLACEHOLDER_JAC_AB
+
+    A = dFdxu_.leftCols<STATE_DIM>();
+    B = dFdxu_.rightCols<CONTROL_DIM>();
+}
+
 } // namespace NS2
 } // namespace NS1
 } // namespace ct
@@ -41,19 +41,29 @@ public:
         const control_vector_t& u,
         const SCALAR t = SCALAR(0.0)) override;
 
+    virtual void getDerivatives(state_matrix_t& A,
+        state_control_matrix_t& B,
+        const state_vector_t& x,
+        const control_vector_t& u,
+        const SCALAR t = SCALAR(0.0)) override;
+
 private:
     void initialize()
     {
         dFdx_.setZero();
         dFdu_.setZero();
+        dFdxu_.setZero();
         vX_.fill(0.0);
         vU_.fill(0.0);
+        vXU_.fill(0.0);
     }
 
     state_matrix_t dFdx_;
     state_control_matrix_t dFdu_;
+    Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM + CONTROL_DIM> dFdxu_;
     std::array<SCALAR, MAX_COUNT_STATE> vX_;
     std::array<SCALAR, MAX_COUNT_CONTROL> vU_;
+    std::array<SCALAR, MAX_COUNT_FUSED> vXU_;
 };
 
 }  // namespace NS2
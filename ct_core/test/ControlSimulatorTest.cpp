@@ -0,0 +1,174 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/core/core.h>
+
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+//! the simulator requires the scalar type of the system
+class Oscillator : public SecondOrderSystem
+{
+public:
+    using SCALAR = double;
+
+    Oscillator() : SecondOrderSystem(10.0, 0.1) {}
+    Oscillator* clone() const override { return new Oscillator(*this); }
+};
+
+/*!
+ * Sampled-data state feedback u = -K x, the control computed at a control instant is held until the next one
+ */
+class SampledFeedbackSimulator : public ControlSimulator<Oscillator>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    SampledFeedbackSimulator(Time sim_dt, Time control_dt, const StateVector<2>& x0, double computeTime = 0.0)
+        : ControlSimulator<Oscillator>(sim_dt, control_dt, x0, std::shared_ptr<Oscillator>(new Oscillator)),
+          computeTime_(computeTime)
+    {
+        K_ << 1.0, 0.2;
+        controller_.reset(new ConstantController<2, 1>());
+        system_->setController(controller_);
+    }
+
+    void finishSystemIteration(Time sim_time) override
+    {
+        system_->setController(newController_);
+        applicationTimes_.push_back(sim_time);
+    }
+
+    void finishControllerIteration(Time sim_time) override
+    {
+        if (computeTime_ > 0.0)
+            std::this_thread::sleep_for(std::chrono::duration<double>(computeTime_));
+        newController_.reset(new ConstantController<2, 1>());
+        newController_->setControl(-K_ * x_);
+        controllerTimes_.push_back(sim_time);
+    }
+
+    const StateVector<2>& getState() const { return x_; }
+    const std::vector<Time>& getControllerTimes() const { return controllerTimes_; }
+    const std::vector<Time>& getApplicationTimes() const { return applicationTimes_; }
+private:
+    double computeTime_;
+    Eigen::Matrix<double, 1, 2> K_;
+    std::shared_ptr<ConstantController<2, 1>> newController_;
+    std::vector<Time> controllerTimes_;
+    std::vector<Time> applicationTimes_;
+};
+
+
+/*!
+ * The event-driven simulation matches a manually scheduled sampled-data loop and does not run in real time
+ */
+TEST(ControlSimulatorTest, EventDrivenMatchesSampledLoop)
+{
+    const Time sim_dt = 0.001;
+    const Time control_dt = 0.01;
+    const Time duration = 5.0;
+    StateVector<2> x0;
+    x0 << 1.0, -0.5;
+
+    SampledFeedbackSimulator simulator(sim_dt, control_dt, x0);
+    auto start = std::chrono::steady_clock::now();
+    simulator.simulateEventDriven(duration, IntegrationType::RK4);
+    const double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_LT(wallTime, duration);
+
+    // reference
+    std::shared_ptr<Oscillator> system(new Oscillator);
+    std::shared_ptr<ConstantController<2, 1>> controller(new ConstantController<2, 1>());
+    system->setController(controller);
+    Integrator<2> integrator(system, IntegrationType::RK4);
+    Eigen::Matrix<double, 1, 2> K;
+    K << 1.0, 0.2;
+
+    StateVector<2> x = x0;
+    const size_t nControl = 500;
+    for (size_t k = 0; k < nControl; k++)
+    {
+        controller->setControl(-K * x);
+        integrator.integrate_n_steps(x, k * control_dt, 10, sim_dt);
+    }
+
+    ASSERT_EQ(simulator.getControllerTimes().size(), nControl);
+    ASSERT_EQ(simulator.getApplicationTimes().size(), nControl);
+    for (size_t k = 0; k < nControl; k++)
+    {
+        ASSERT_NEAR(simulator.getControllerTimes()[k], k * control_dt, 1e-12);
+        ASSERT_NEAR(simulator.getApplicationTimes()[k], k * control_dt, 1e-12);
+    }
+    ASSERT_LT((simulator.getState() - x).norm(), 1e-12);
+
+    // running again reproduces the result exactly
+    StateVector<2> xFirst = simulator.getState();
+    SampledFeedbackSimulator repeated(sim_dt, control_dt, x0);
+    repeated.simulateEventDriven(duration, IntegrationType::RK4);
+    ASSERT_EQ(repeated.getState(), xFirst);
+}
+
+/*!
+ * A modeled compute delay postpones the application of the controller and skips control instants
+ */
+TEST(ControlSimulatorTest, ComputeDelay)
+{
+    const Time control_dt = 0.01;
+    const double computeTime = 0.025;
+    StateVector<2> x0;
+    x0 << 1.0, -0.5;
+
+    SampledFeedbackSimulator simulator(0.001, control_dt, x0, computeTime);
+    simulator.simulateEventDriven(0.5, IntegrationType::EULERCT, true);
+
+    const std::vector<Time>& controllerTimes = simulator.getControllerTimes();
+    const std::vector<Time>& applicationTimes = simulator.getApplicationTimes();
+    ASSERT_GT(controllerTimes.size(), 1u);
+    ASSERT_LE(controllerTimes.size(), 17u);  // one controller every 3 control instants
+    for (size_t k = 0; k < applicationTimes.size(); k++)
+    {
+        // controllers start on the control grid, after the previous one has been applied
+        const double n = controllerTimes[k] / control_dt;
+        ASSERT_NEAR(n, std::round(n), 1e-9);
+        ASSERT_GE(applicationTimes[k] - controllerTimes[k], computeTime);
+        if (k + 1 < controllerTimes.size())
+        {
+            ASSERT_GE(controllerTimes[k + 1], applicationTimes[k]);
+        }
+    }
+}
+
+/*!
+ * Parallel simulations give the same results as sequential ones
+ */
+TEST(ControlSimulatorTest, Batch)
+{
+    const size_t nSimulations = 16;
+    std::vector<std::shared_ptr<SampledFeedbackSimulator>> simulators;
+    StateVectorArray<2> initialStates;
+    for (size_t i = 0; i < nSimulations; i++)
+    {
+        initialStates.push_back(StateVector<2>::Random());
+        simulators.emplace_back(new SampledFeedbackSimulator(0.001, 0.01, initialStates.back()));
+    }
+
+    ControlSimulator<Oscillator>::simulateEventDrivenBatch(simulators, 2.0, IntegrationType::RK4, false, 4);
+
+    for (size_t i = 0; i < nSimulations; i++)
+    {
+        SampledFeedbackSimulator sequential(0.001, 0.01, initialStates[i]);
+        sequential.simulateEventDriven(2.0, IntegrationType::RK4);
+        ASSERT_EQ(simulators[i]->getState(), sequential.getState());
+        ASSERT_EQ(simulators[i]->getControllerTimes().size(), 200u);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -181,6 +181,54 @@ TEST(DiscreteArrayTest, DivisionTest)
 }
 
 
+TEST(DiscreteArrayTest, EraseFrontTest)
+{
+    const size_t nEl = 20;
+    ScalarArray<double> array;
+    for (size_t i = 0; i < nEl; i++)
+        array.push_back(i);
+
+    // erase repeatedly and extend at the back, as the MPC policy shift does
+    double first = 0.0;
+    for (size_t cycle = 0; cycle < 30; cycle++)
+    {
+        const size_t N = 1 + cycle % 3;
+        array.eraseFront(N);
+        first += N;
+        for (size_t i = 0; i < N; i++)
+            array.push_back(array.back() + 1.0);
+
+        ASSERT_EQ(array.size(), nEl);
+        ASSERT_EQ(array.front(), first);
+        ASSERT_EQ(*array.begin(), first);
+        for (size_t i = 0; i < nEl; i++)
+        {
+            ASSERT_EQ(array[i], first + i);
+            ASSERT_EQ(array.at(i), first + i);
+        }
+        ASSERT_THROW(array.at(nEl), std::out_of_range);
+
+        // copies, assignments and the underlying vector only contain the remaining elements
+        const ScalarArray<double> copy = array;
+        ScalarArray<double> assigned;
+        assigned = array;
+        ASSERT_EQ(copy.size(), nEl);
+        ASSERT_EQ(assigned.size(), nEl);
+        ASSERT_EQ(copy.toImplementation().front(), first);
+        ASSERT_EQ(assigned.front(), first);
+    }
+
+    ASSERT_EQ(array.toImplementation().size(), nEl);
+    ASSERT_EQ(array.toImplementation().front(), first);
+
+    array.resize(5);
+    ASSERT_EQ(array.size(), 5u);
+    ASSERT_EQ(array.back(), first + 4);
+
+    array.eraseFront(10);
+    ASSERT_EQ(array.size(), 0u);
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,229 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/core/core.h>
+
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+typedef MonteCarloSimulator<SecondOrderSystem> Simulator;
+typedef ConstantStateFeedbackController<2, 1> FeedbackController;
+
+/*!
+ * An oscillator with perturbed initial state, natural frequency and feedback gain. A part of the runs fails on
+ * purpose, the control is bounded.
+ */
+std::shared_ptr<Simulator> createStudy(size_t nThreads, size_t batchSize)
+{
+    std::shared_ptr<SecondOrderSystem> system(new SecondOrderSystem(10.0, 0.1));
+    std::shared_ptr<FeedbackController> controller(new FeedbackController());
+
+    Simulator::Settings settings;
+    settings.nRuns = 500;
+    settings.duration = 2.0;
+    settings.dt = 0.01;
+    settings.seed = 1234;
+    settings.nThreads = nThreads;
+    settings.batchSize = batchSize;
+
+    std::shared_ptr<Simulator> simulator(new Simulator(system, controller, settings));
+
+    simulator->setPerturbation([](size_t run, RandomStream& random, StateVector<2>& x0, SecondOrderSystem& system,
+        Simulator::Controller_t& controller) {
+        if (random.uniform() < 0.1)
+            throw std::runtime_error("controller failed");
+
+        x0 += random.gaussian<2>(0.0, 0.2);
+        system.setDynamics(10.0 + random.uniform(), 0.1);
+
+        FeedbackMatrix<2, 1> K;
+        K << -0.5 - random.uniform(), -0.2;
+        static_cast<FeedbackController&>(controller).updateControlLaw(
+            ControlVector<1>::Zero(), StateVector<2>::Zero(), K);
+    });
+    simulator->setStageCost([](const StateVector<2>& x, const ControlVector<1>& u, Time t) {
+        return x.squaredNorm() + 0.1 * u.squaredNorm();
+    });
+    simulator->setTerminalCost([](const StateVector<2>& x) { return 10.0 * x.squaredNorm(); });
+    simulator->setConstraintViolation([](const StateVector<2>& x, const ControlVector<1>& u, Time t) {
+        return std::max(0.0, std::abs(u(0)) - 1.0);
+    });
+
+    return simulator;
+}
+
+/*!
+ * The statistics do not depend on the number of threads and the batch size
+ */
+TEST(MonteCarloSimulatorTest, Reproducible)
+{
+    StateVector<2> x0;
+    x0 << 1.0, 0.0;
+
+    std::vector<MonteCarloRunResult> serialResults;
+    std::shared_ptr<Simulator> serial = createStudy(1, 500);
+    serial->setRunCallback([&](size_t run, const MonteCarloRunResult& result) {
+        ASSERT_EQ(run, serialResults.size());
+        serialResults.push_back(result);
+    });
+    MonteCarloStatistics reference = serial->simulate(x0);
+
+    std::vector<MonteCarloRunResult> parallelResults;
+    std::shared_ptr<Simulator> parallel = createStudy(4, 37);
+    parallel->setRunCallback([&](size_t run, const MonteCarloRunResult& result) {
+        ASSERT_EQ(run, parallelResults.size());
+        parallelResults.push_back(result);
+    });
+    MonteCarloStatistics statistics = parallel->simulate(x0);
+
+    ASSERT_EQ(statistics.nRuns, 500u);
+    ASSERT_EQ(statistics.nRuns, reference.nRuns);
+    ASSERT_EQ(statistics.nFailed, reference.nFailed);
+    ASSERT_EQ(statistics.nViolated, reference.nViolated);
+    ASSERT_EQ(statistics.cost.mean(), reference.cost.mean());
+    ASSERT_EQ(statistics.cost.variance(), reference.cost.variance());
+    ASSERT_EQ(statistics.constraintViolation.max(), reference.constraintViolation.max());
+
+    size_t nFailed = 0;
+    for (size_t i = 0; i < serialResults.size(); i++)
+    {
+        ASSERT_EQ(serialResults[i].failed, parallelResults[i].failed);
+        ASSERT_EQ(serialResults[i].cost, parallelResults[i].cost);
+        nFailed += serialResults[i].failed;
+    }
+    ASSERT_EQ(nFailed, statistics.nFailed);
+
+    // about 10% of the runs fail on purpose, the control bound is violated at the start of most runs
+    ASSERT_GT(statistics.failureRate(), 0.05);
+    ASSERT_LT(statistics.failureRate(), 0.15);
+    ASSERT_GT(statistics.nViolated, 0u);
+    ASSERT_GT(statistics.cost.standardDeviation(), 0.0);
+
+    // a single run can be reproduced, e.g. to inspect it
+    for (size_t run : {0, 17, 499})
+    {
+        MonteCarloRunResult result = serial->simulateRun(run, x0);
+        ASSERT_EQ(result.failed, serialResults[run].failed);
+        ASSERT_EQ(result.cost, serialResults[run].cost);
+    }
+}
+
+//! a PI controller whose integral state persists between calls, counts its evaluations
+class IntegralController : public Simulator::Controller_t
+{
+public:
+    IntegralController() : integral_(0.0), nCalls_(0) {}
+    IntegralController* clone() const override { return new IntegralController(*this); }
+    void computeControl(const StateVector<2>& state, const Time& t, ControlVector<1>& controlAction) override
+    {
+        integral_ += 1e-3 * state(0);
+        nCalls_++;
+        controlAction(0) = -state(0) - 0.5 * state(1) - integral_;
+    }
+
+    double integral_;
+    size_t nCalls_;
+};
+
+/*!
+ * A controller with internal state starts every run from the nominal controller, hence a run does not depend on
+ * the runs simulated before it on the same worker. The stage cost uses the control applied by the integrator.
+ */
+TEST(MonteCarloSimulatorTest, StatefulController)
+{
+    std::shared_ptr<SecondOrderSystem> system(new SecondOrderSystem(10.0, 0.1));
+    std::shared_ptr<IntegralController> controller(new IntegralController());
+
+    Simulator::Settings settings;
+    settings.nRuns = 40;
+    settings.duration = 1.0;
+    settings.dt = 0.01;
+    settings.integrationType = IntegrationType::RK4;
+
+    std::vector<MonteCarloRunResult> results;
+    size_t nCalls = 0;
+    for (size_t nThreads : {1, 3})
+    {
+        settings.nThreads = nThreads;
+        settings.batchSize = 7;
+        Simulator simulator(system, controller, settings);
+        simulator.setPerturbation([&](size_t run, RandomStream& random, StateVector<2>& x0,
+            SecondOrderSystem& system, Simulator::Controller_t& c) {
+            IntegralController& integral = static_cast<IntegralController&>(c);
+            ASSERT_EQ(integral.integral_, 0.0);
+            ASSERT_EQ(integral.nCalls_, 0u);
+            x0 += random.gaussian<2>(0.0, 0.2);
+        });
+        simulator.setStageCost([](const StateVector<2>& x, const ControlVector<1>& u, Time t) {
+            return x.squaredNorm() + u.squaredNorm();
+        });
+
+        std::vector<MonteCarloRunResult> runResults(settings.nRuns);
+        simulator.setRunCallback([&](size_t run, const MonteCarloRunResult& result) { runResults[run] = result; });
+        simulator.simulate(StateVector<2>::Ones());
+
+        if (results.empty())
+            results = runResults;
+        for (size_t i = 0; i < settings.nRuns; i++)
+        {
+            ASSERT_FALSE(runResults[i].failed);
+            ASSERT_EQ(runResults[i].cost, results[i].cost);
+        }
+
+        // a single run gives the same result as within the study
+        for (size_t run : {0, 13, 39})
+            ASSERT_EQ(simulator.simulateRun(run, StateVector<2>::Ones()).cost, results[run].cost);
+
+        // the nominal controller is never evaluated
+        nCalls = controller->nCalls_;
+    }
+    ASSERT_EQ(nCalls, 0u);
+
+    // the stage cost does not evaluate the controller in addition to the four stages of RK4
+    settings.nThreads = 1;
+    settings.nRuns = 1;
+    Simulator single(system, controller, settings);
+    const IntegralController* runController = nullptr;
+    size_t nSteps = 0;
+    single.setPerturbation([&](size_t run, RandomStream& random, StateVector<2>& x0, SecondOrderSystem& system,
+        Simulator::Controller_t& c) { runController = static_cast<const IntegralController*>(&c); });
+    single.setStageCost([&](const StateVector<2>& x, const ControlVector<1>& u, Time t) {
+        nSteps++;
+        EXPECT_EQ(runController->nCalls_, 4 * nSteps);
+        return u.squaredNorm();
+    });
+    single.simulateRun(0, StateVector<2>::Ones());
+    ASSERT_EQ(nSteps, 100u);
+}
+
+/*!
+ * Diverging runs are detected
+ */
+TEST(MonteCarloSimulatorTest, Failure)
+{
+    std::shared_ptr<SecondOrderSystem> system(new SecondOrderSystem(10.0, 0.1));
+    FeedbackMatrix<2, 1> K;
+    K << 0.0, 50.0;  // destabilizing
+    std::shared_ptr<FeedbackController> controller(
+        new FeedbackController(ControlVector<1>::Zero(), StateVector<2>::Zero(), K));
+
+    Simulator::Settings settings;
+    settings.nRuns = 20;
+    settings.duration = 10.0;
+    Simulator simulator(system, controller, settings);
+    simulator.setFailureCondition([](const StateVector<2>& x, Time t) { return x.norm() > 1e3; });
+
+    MonteCarloStatistics statistics = simulator.simulate(StateVector<2>::Ones());
+    ASSERT_EQ(statistics.nFailed, 20u);
+    ASSERT_EQ(statistics.failureRate(), 1.0);
+    ASSERT_EQ(statistics.cost.count(), 0u);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -103,6 +103,56 @@ TEST(NoiseTest, quantizationNoiseTest)
 }
 
 
+TEST(NoiseTest, randomStreamTest)
+{
+    // known answer of Philox4x32-10 for zero counter and key
+    RandomStream zero(0, 0);
+    uint32_t block[4];
+    zero.generate(block, 1);
+    ASSERT_EQ(block[0], 0x6627e8d5u);
+    ASSERT_EQ(block[1], 0xe169c58du);
+    ASSERT_EQ(block[2], 0xbc57ac4cu);
+    ASSERT_EQ(block[3], 0x9b00dbd8u);
+
+    // drawing in bulk and one by one gives the same sequence
+    const size_t nSamples = 100003;
+    std::vector<double> bulk(nSamples);
+    RandomStream stream(42, 7);
+    stream.fillUniform(bulk.data(), 3);
+    stream.fillUniform(bulk.data() + 3, nSamples - 3);
+
+    RandomStream scalar(42, 7);
+    for (size_t i = 0; i < nSamples; i++)
+        ASSERT_EQ(bulk[i], scalar.uniform());
+
+    // other streams give other sequences
+    RandomStream other(42, 8);
+    ASSERT_NE(bulk[0], other.uniform());
+
+    // moments of the uniform and Gaussian distributions
+    double mean = 0.0, variance = 0.0;
+    for (size_t i = 0; i < nSamples; i++)
+    {
+        ASSERT_GT(bulk[i], 0.0);
+        ASSERT_LT(bulk[i], 1.0);
+        mean += bulk[i] / nSamples;
+        variance += (bulk[i] - 0.5) * (bulk[i] - 0.5) / nSamples;
+    }
+    ASSERT_NEAR(mean, 0.5, 0.01);
+    ASSERT_NEAR(variance, 1.0 / 12.0, 0.01);
+
+    std::vector<double> gaussian(nSamples);
+    stream.fillGaussian(gaussian.data(), nSamples);
+    mean = variance = 0.0;
+    for (size_t i = 0; i < nSamples; i++)
+    {
+        mean += gaussian[i] / nSamples;
+        variance += gaussian[i] * gaussian[i] / nSamples;
+    }
+    ASSERT_NEAR(mean, 0.0, 0.02);
+    ASSERT_NEAR(variance, 1.0, 0.02);
+}
+
 /*!
  *  \example NoiseTest.cpp
  *
@@ -0,0 +1,253 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+
+#include <ct/core/core.h>
+
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+const size_t state_dim = 4;
+const size_t control_dim = 2;
+
+typedef StateFeedbackController<state_dim, control_dim> Policy;
+
+const std::string filename = "PolicyFileTest.ctp";
+
+//! a random policy with N stages
+Policy createRandomPolicy(size_t N, double dt, double t0, InterpolationType type)
+{
+    StateVectorArray<state_dim> x_ref;
+    ControlVectorArray<control_dim> uff;
+    FeedbackArray<state_dim, control_dim> K;
+    for (size_t i = 0; i < N; i++)
+    {
+        x_ref.push_back(StateVector<state_dim>::Random());
+        uff.push_back(ControlVector<control_dim>::Random());
+        K.push_back(FeedbackMatrix<state_dim, control_dim>::Random());
+    }
+    x_ref.push_back(StateVector<state_dim>::Random());
+
+    Policy policy;
+    policy.update(x_ref, uff, K, TimeArray(dt, N + 1, t0));
+    policy.getReferenceStateTrajectory().setInterpolationType(type);
+    policy.getFeedforwardTrajectory().setInterpolationType(type);
+    policy.getFeedbackTrajectory().setInterpolationType(type);
+    return policy;
+}
+
+/*!
+ * Write policies and read them back, the views have to match the original policies without copying data
+ */
+TEST(PolicyFileTest, WriteAndReadPolicies)
+{
+    Policy policyZoh = createRandomPolicy(100, 0.01, 0.3, ZOH);
+    Policy policyLin = createRandomPolicy(57, 0.1, -1.0, LIN);
+
+    PolicyFileWriter<state_dim, control_dim> writer;
+    writer.addPolicy("zoh", policyZoh);
+    writer.addPolicy("lin", policyLin);
+    ASSERT_THROW(writer.addPolicy("zoh", policyZoh), std::runtime_error);
+    writer.write(filename);
+
+    PolicyLibrary<state_dim, control_dim> library(filename);
+    ASSERT_EQ(library.size(), 2);
+    ASSERT_TRUE(library.contains("zoh"));
+    ASSERT_FALSE(library.contains("foo"));
+    ASSERT_EQ(library.names(), std::vector<std::string>({"lin", "zoh"}));
+
+    for (Policy* policy : {&policyZoh, &policyLin})
+    {
+        auto view = library.getPolicy(policy == &policyZoh ? "zoh" : "lin");
+
+        ASSERT_EQ(view.x_ref().size(), policy->x_ref().size());
+        ASSERT_EQ(view.uff().size(), policy->uff().size());
+        ASSERT_EQ(view.K().size(), policy->K().size());
+        for (size_t i = 0; i < view.uff().size(); i++)
+        {
+            ASSERT_EQ(view.x_ref()[i], policy->x_ref()[i]);
+            ASSERT_EQ(view.uff()[i], policy->uff()[i]);
+            ASSERT_EQ(view.K()[i], policy->K()[i]);
+            ASSERT_EQ(view.time()[i], policy->time()[i]);
+        }
+
+        // the data is accessed in place and cache-line aligned
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(view.K().data()) % 64, 0);
+
+        // evaluate the policy at arbitrary times, also outside the time horizon
+        const double t0 = policy->time().front();
+        const double tf = policy->time().back();
+        for (size_t i = 0; i < 1000; i++)
+        {
+            const double t = t0 - 0.1 + (tf - t0 + 0.2) * i / 999.0;
+            StateVector<state_dim> x = StateVector<state_dim>::Random();
+            ControlVector<control_dim> uView, uPolicy;
+            view.computeControl(x, t, uView);
+            policy->computeControl(x, t, uPolicy);
+            ASSERT_LT((uView - uPolicy).norm(), 1e-12);
+        }
+
+        // the time stamps themselves
+        for (size_t i = 0; i < policy->uff().size(); i++)
+        {
+            StateVector<state_dim> x = StateVector<state_dim>::Random();
+            ControlVector<control_dim> uView, uPolicy;
+            view.computeControl(x, policy->time()[i], uView);
+            policy->computeControl(x, policy->time()[i], uPolicy);
+            ASSERT_LT((uView - uPolicy).norm(), 1e-12);
+        }
+
+        // copy back into a controller
+        Policy copy = view.toController();
+        for (size_t i = 0; i < copy.uff().size(); i++)
+        {
+            ASSERT_EQ(copy.uff()[i], policy->uff()[i]);
+            ASSERT_EQ(copy.K()[i], policy->K()[i]);
+        }
+        ASSERT_EQ(copy.getFeedforwardTrajectory().getInterpolationType(), view.getInterpolationType());
+    }
+
+    std::remove(filename.c_str());
+}
+
+/*!
+ * Trajectories with non-uniform time stamps
+ */
+TEST(PolicyFileTest, Trajectories)
+{
+    const size_t N = 200;
+    TimeArray time(N);
+    StateVectorArray<state_dim> data(N, StateVector<state_dim>::Zero());
+    time[0] = 0.0;
+    for (size_t i = 0; i < N; i++)
+    {
+        if (i > 0)
+            time[i] = time[i - 1] + 0.01 + 0.01 * std::abs(std::sin(double(i)));
+        data[i].setRandom();
+    }
+    StateTrajectory<state_dim> trajectory(time, data, LIN);
+    FeedbackTrajectory<state_dim, control_dim> gains(
+        FeedbackArray<state_dim, control_dim>(N, FeedbackMatrix<state_dim, control_dim>::Random()), 0.1, 0.0);
+
+    PolicyFileWriter<state_dim, control_dim> writer;
+    writer.addTrajectory("x", trajectory);
+    writer.addTrajectory("K", gains);
+    writer.write(filename);
+
+    PolicyLibrary<state_dim, control_dim> library(filename);
+    auto view = library.getTrajectory<StateVector<state_dim>>("x");
+    ASSERT_EQ(view.size(), N);
+    for (size_t i = 0; i < 1000; i++)
+    {
+        const double t = -0.1 + (time.back() + 0.2) * i / 999.0;
+        ASSERT_LT((view.eval(t) - trajectory.eval(t)).norm(), 1e-12);
+    }
+
+    auto gainView = library.getTrajectory<FeedbackMatrix<state_dim, control_dim>>("K");
+    ASSERT_EQ(gainView[N - 1], gains[N - 1]);
+    ASSERT_EQ(gainView.toTrajectory().getDataArray()[3], gains[3]);
+
+    // data and time stamps have to match
+    StateTrajectory<state_dim> invalidTrajectory(trajectory);
+    invalidTrajectory.getDataArray().pop_back();
+    ASSERT_THROW(writer.addTrajectory("invalid", invalidTrajectory), std::runtime_error);
+
+    // wrong type or element size
+    ASSERT_THROW(library.getPolicy("x"), std::runtime_error);
+    ASSERT_THROW(library.getTrajectory<ControlVector<control_dim>>("x"), std::runtime_error);
+    ASSERT_THROW(library.getTrajectory<StateVector<state_dim>>("y"), std::runtime_error);
+
+    std::remove(filename.c_str());
+}
+
+/*!
+ * Invalid files are rejected
+ */
+TEST(PolicyFileTest, InvalidFiles)
+{
+    PolicyFileWriter<state_dim, control_dim> writer;
+    writer.addPolicy("p", createRandomPolicy(10, 0.1, 0.0, ZOH));
+    writer.write(filename);
+
+    // dimensions and scalar type have to match
+    ASSERT_THROW((PolicyLibrary<state_dim + 1, control_dim>(filename)), std::runtime_error);
+    ASSERT_THROW((PolicyLibrary<state_dim, control_dim, float>(filename)), std::runtime_error);
+
+    // wrong version
+    {
+        std::fstream f(filename, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(offsetof(policy_file::FileHeader, version));
+        uint32_t version = policy_file::FILE_VERSION + 1;
+        f.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+    ASSERT_THROW((PolicyLibrary<state_dim, control_dim>(filename)), std::runtime_error);
+
+    // corrupted array headers of the entry
+    const size_t entryOffset = sizeof(policy_file::FileHeader);
+    auto writeField = [&](size_t offset, uint64_t value) {
+        writer.write(filename);
+        std::fstream f(filename, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(entryOffset + offset);
+        f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    const size_t xRefHeader = offsetof(policy_file::EntryHeader, data);
+    writeField(xRefHeader + offsetof(policy_file::ArrayHeader, count), 10);  // one reference state short
+    ASSERT_THROW((PolicyLibrary<state_dim, control_dim>(filename)), std::runtime_error);
+    writeField(xRefHeader + offsetof(policy_file::ArrayHeader, count), uint64_t(1) << 61);  // size overflows
+    ASSERT_THROW((PolicyLibrary<state_dim, control_dim>(filename)), std::runtime_error);
+
+    // truncated file
+    writer.write(filename);
+    ASSERT_EQ(truncate(filename.c_str(), 200), 0);
+    ASSERT_THROW((PolicyLibrary<state_dim, control_dim>(filename)), std::runtime_error);
+
+    // missing file
+    std::remove(filename.c_str());
+    ASSERT_THROW((PolicyLibrary<state_dim, control_dim>(filename)), std::runtime_error);
+}
+
+/*!
+ * A library with many policies, opening it does not read the data
+ */
+TEST(PolicyFileTest, LargeLibrary)
+{
+    const size_t nPolicies = 500;
+    const size_t N = 1000;
+
+    PolicyFileWriter<state_dim, control_dim> writer;
+    Policy policy = createRandomPolicy(N, 0.001, 0.0, ZOH);
+    for (size_t i = 0; i < nPolicies; i++)
+        writer.addPolicy("policy_" + std::to_string(i), policy);
+    writer.write(filename);
+
+    auto start = std::chrono::steady_clock::now();
+    PolicyLibrary<state_dim, control_dim> library(filename);
+    const double openTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    ControlVector<control_dim> u, uSum = ControlVector<control_dim>::Zero();
+    const StateVector<state_dim> x = StateVector<state_dim>::Zero();
+    for (size_t i = 0; i < 100000; i++)
+    {
+        library.computeControl("policy_" + std::to_string(i % nPolicies), x, 0.001 * (i % N), u);
+        uSum += u;
+    }
+    const double lookupTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ASSERT_TRUE(uSum.allFinite());
+    std::cout << "opened " << nPolicies << " policies with " << N << " stages in " << 1e3 * openTime
+              << " ms, lookup by name and time: " << 1e9 * lookupTime / 100000 << " ns" << std::endl;
+
+    std::remove(filename.c_str());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -189,6 +189,67 @@ TEST(HessianCGTest, JITHessianTest)
 }
 
 
+/*!
+ * Test the batched evaluation of several points per call against the evaluation point by point
+ */
+TEST(JacobianCGTest, JITBatchTest)
+{
+    try
+    {
+        typename derivativesCppadJIT::FUN_TYPE_CG f = testFunction<derivativesCppadJIT::CG_SCALAR>;
+
+        for (size_t width : {4, 8})
+        {
+            derivativesCppadJIT derivatives(f);
+
+            DerivativesCppadSettings settings;
+            settings.createForwardZero_ = true;
+            settings.createJacobian_ = true;
+            settings.createHessian_ = true;
+            settings.createBatch_ = true;
+            settings.batchWidth_ = width;
+            derivatives.compileJIT(settings, "batchTestLib");
+            ASSERT_EQ(derivatives.getBatchWidth(), width);
+
+            // the number of points is not a multiple of the batch width
+            const int nPoints = 3 * width + 1;
+            Eigen::MatrixXd x = Eigen::MatrixXd::Random(inDim, nPoints);
+            Eigen::MatrixXd w = Eigen::MatrixXd::Random(outDim, nPoints);
+
+            Eigen::MatrixXd y;
+            derivativesCppadJIT::JAC_ARRAY_TYPE jac;
+            derivativesCppadJIT::HES_ARRAY_TYPE hes;
+            derivatives.forwardZeroBatch(x, y);
+            derivatives.jacobianBatch(x, jac);
+            derivatives.hessianBatch(x, w, hes);
+
+            // a shared clone evaluates with its own buffers
+            std::shared_ptr<derivativesCppadJIT> clone(derivatives.cloneShared());
+            derivativesCppadJIT::JAC_ARRAY_TYPE jacClone;
+            clone->jacobianBatch(x, jacClone);
+
+            ASSERT_EQ(y.cols(), nPoints);
+            ASSERT_EQ(jac.size(), nPoints);
+            ASSERT_EQ(hes.size(), nPoints);
+            for (int k = 0; k < nPoints; k++)
+            {
+                Eigen::Matrix<double, inDim, 1> xk = x.col(k);
+                Eigen::Matrix<double, outDim, 1> wk = w.col(k);
+                ASSERT_LT((y.col(k) - testFunction(xk)).array().abs().maxCoeff(), 1e-10);
+                ASSERT_LT((jac[k] - jacobianCheck(xk)).array().abs().maxCoeff(), 1e-10);
+                ASSERT_LT((jacClone[k] - jacobianCheck(xk)).array().abs().maxCoeff(), 1e-10);
+                ASSERT_LT((hes[k] - hessianCheck(xk, wk)).array().abs().maxCoeff(), 1e-10);
+                ASSERT_LT((jac[k] - derivatives.jacobian(xk)).array().abs().maxCoeff(), 1e-12);
+            }
+        }
+    } catch (std::exception& e)
+    {
+        std::cout << "Exception thrown: " << e.what() << std::endl;
+        ASSERT_TRUE(false);
+    }
+}
+
+
 /*!
  * Test cloning of JIT compiled libraries
  */
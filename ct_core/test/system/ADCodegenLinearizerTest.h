@@ -66,12 +66,20 @@ TEST(ADCodegenLinearizerTest, JITCompilationTest)
         A_type A_adCloned = adLinearizerClone->getDerivativeState(x, u, t);
         B_type B_adCloned = adLinearizerClone->getDerivativeControl(x, u, t);
 
+        // both Jacobians at once
+        A_type A_fused;
+        B_type B_fused;
+        adLinearizer.getDerivatives(A_fused, B_fused, x, u, t);
+
         // verify the result
         ASSERT_LT((A_system - A_ad).array().abs().maxCoeff(), 1e-5);
         ASSERT_LT((B_system - B_ad).array().abs().maxCoeff(), 1e-5);
 
         ASSERT_LT((A_system - A_adCloned).array().abs().maxCoeff(), 1e-5);
         ASSERT_LT((B_system - B_adCloned).array().abs().maxCoeff(), 1e-5);
+
+        ASSERT_EQ(A_fused, A_ad);
+        ASSERT_EQ(B_fused, B_ad);
     }
 }
 
@@ -7,6 +7,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <ct/rbd/rbd.h>
 #include <ct/rbd/state/JointState.h>
 
+#include <chrono>
 #include <gtest/gtest.h>
 
 TEST(Irb4600IKTest, IKFastTest)
@@ -38,6 +39,77 @@ TEST(Irb4600IKTest, IKFastTest)
     }
 }
 
+TEST(Irb4600IKTest, IKFastBatchTest)
+{
+    using IKSolver = ct::rbd::Irb4600InverseKinematics<double>;
+    using JointPosition_t = IKSolver::JointPosition_t;
+
+    // a smooth joint trajectory and the corresponding end-effector poses
+    const size_t nPoses = 20000;
+    IKSolver::JointPositionsVector_t jointTrajectory(nPoses);
+    IKSolver::RigidBodyPoseVector_t poses(nPoses);
+    for (size_t k = 0; k < nPoses; k++)
+    {
+        double t = 10.0 * k / nPoses;
+        for (size_t j = 0; j < 6; j++)
+            jointTrajectory[k](j) = 0.4 * std::sin(t + j);
+
+        Eigen::Vector3d ee_pos;
+        Eigen::Matrix<double, 3, 3, Eigen::RowMajor> ee_rot;
+        irb4600_ik::ComputeFk(jointTrajectory[k].data(), ee_pos.data(), ee_rot.data());
+        poses[k].position().toImplementation() = ee_pos;
+        poses[k].setFromRotationMatrix(kindr::RotationMatrix<double>(ee_rot));
+    }
+
+    // reference: independent single-pose solves returning all branches
+    IKSolver ikSolver;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t k = 0; k < nPoses; k++)
+    {
+        IKSolver::JointPositionsVector_t solutions;
+        ikSolver.computeInverseKinematics(solutions, poses[k]);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double singleRate = nPoses / std::chrono::duration<double>(end - start).count();
+
+    // sequential batch, warm-started from the previous solution
+    IKSolver::JointPositionsVector_t batchSolutions;
+    std::vector<bool> success;
+    start = std::chrono::high_resolution_clock::now();
+    size_t nSuccess = ikSolver.computeInverseKinematicsBatch(batchSolutions, success, poses, jointTrajectory[0]);
+    end = std::chrono::high_resolution_clock::now();
+    double batchRate = nPoses / std::chrono::duration<double>(end - start).count();
+
+    ASSERT_EQ(nSuccess, nPoses);
+
+    // the warm start keeps the solver on the branch of the original trajectory
+    for (size_t k = 0; k < nPoses; k++)
+        ASSERT_LT((batchSolutions[k] - jointTrajectory[k]).norm(), 1e-3);
+
+    // parallel batch with one solver per thread, at least four segments such that the seeding is exercised
+    const size_t nThreads = std::max(std::thread::hardware_concurrency(), 4u);
+    std::vector<std::shared_ptr<ct::rbd::InverseKinematicsBase<6, double>>> solvers;
+    for (size_t i = 0; i < nThreads; i++)
+        solvers.push_back(std::shared_ptr<IKSolver>(new IKSolver));
+    ct::rbd::InverseKinematicsBatchSolver<6, double> batchSolver(solvers);
+
+    IKSolver::JointPositionsVector_t parallelSolutions;
+    start = std::chrono::high_resolution_clock::now();
+    nSuccess = batchSolver.solve(parallelSolutions, success, poses, jointTrajectory[0]);
+    end = std::chrono::high_resolution_clock::now();
+    double parallelRate = nPoses / std::chrono::duration<double>(end - start).count();
+
+    ASSERT_EQ(nSuccess, nPoses);
+
+    // the seeded segments reproduce the sequential solution
+    for (size_t k = 0; k < nPoses; k++)
+        ASSERT_LT((parallelSolutions[k] - batchSolutions[k]).norm(), 1e-9);
+
+    std::cout << "IKFast single pose solves:     " << singleRate << " poses/s" << std::endl;
+    std::cout << "IKFast warm-started batch:     " << batchRate << " poses/s" << std::endl;
+    std::cout << "IKFast parallel batch (" << nThreads << " threads): " << parallelRate << " poses/s" << std::endl;
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -1,11 +1,15 @@
 /*!
  * \example NLOC_boxConstrained.cpp
  *
- * This example shows how to use box constraints alongside NLOC and requires HPIPM to be installed
- * The unconstrained Riccati backward-pass is replaced by a high-performance interior-point
- * constrained linear-quadratic Optimal Control solver.
+ * This example shows how to use box constraints alongside NLOC. The unconstrained Riccati backward-pass is replaced
+ * - by a box-constrained Riccati backward-pass, which solves a small box-constrained QP per stage (box-DDP),
+ * - by the dense condensing interior-point LQ solver, for comparison
+ * - if HPIPM is installed, by a high-performance interior-point constrained linear-quadratic Optimal Control solver.
  *
  */
+
+#include <chrono>
+
 #include <ct/optcon/optcon.h>
 #include "exampleDir.h"
 #include "plotResultsOscillator.h"
@@ -112,8 +116,7 @@ int main(int argc, char** argv)
     ilqr_settings.max_iterations = 10;
     ilqr_settings.nThreads = 4;
     ilqr_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::ILQR;
-    ilqr_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::HPIPM_SOLVER;  // solve LQ-problems using HPIPM
-    ilqr_settings.lqoc_solver_settings.num_lqoc_iterations = 10;                // number of riccati sub-iterations
+    ilqr_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::BOX_RICCATI_SOLVER;  // box-constrained Riccati
     ilqr_settings.printSummary = true;
 
 
@@ -138,12 +141,46 @@ int main(int argc, char** argv)
 
 
     // STEP 3: solve the optimal control problem
+    auto start = std::chrono::steady_clock::now();
     iLQR.solve();
+    std::chrono::duration<double, std::milli> timeBoxRiccati = std::chrono::steady_clock::now() - start;
 
 
     // STEP 4: retrieve the solution
     ct::core::StateFeedbackController<state_dim, control_dim> solution = iLQR.getSolution();
 
+    std::cout << "box-constrained Riccati solver: " << iLQR.getBackend()->iteration() << " iterations, "
+              << timeBoxRiccati.count() << " ms, cost " << iLQR.getBackend()->getCost() << std::endl;
+
+    // STEP 5: for comparison, solve the same problem with the dense condensing interior-point LQ solver
+    ilqr_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::CONDENSING_SOLVER;
+
+    NLOptConSolver<state_dim, control_dim> iLQRCondensing(optConProblem, ilqr_settings);
+    iLQRCondensing.setInitialGuess(initController);
+
+    start = std::chrono::steady_clock::now();
+    iLQRCondensing.solve();
+    std::chrono::duration<double, std::milli> timeCondensing = std::chrono::steady_clock::now() - start;
+
+    std::cout << "condensing solver: " << iLQRCondensing.getBackend()->iteration() << " iterations, "
+              << timeCondensing.count() << " ms, cost " << iLQRCondensing.getBackend()->getCost() << std::endl;
+
+#ifdef HPIPM
+    // STEP 6: for comparison, solve the same problem with the interior-point LQ solver
+    ilqr_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::HPIPM_SOLVER;  // solve LQ-problems using HPIPM
+    ilqr_settings.lqoc_solver_settings.num_lqoc_iterations = 10;                // number of riccati sub-iterations
+
+    NLOptConSolver<state_dim, control_dim> iLQRHPIPM(optConProblem, ilqr_settings);
+    iLQRHPIPM.setInitialGuess(initController);
+
+    start = std::chrono::steady_clock::now();
+    iLQRHPIPM.solve();
+    std::chrono::duration<double, std::milli> timeHPIPM = std::chrono::steady_clock::now() - start;
+
+    std::cout << "HPIPM: " << iLQRHPIPM.getBackend()->iteration() << " iterations, " << timeHPIPM.count()
+              << " ms, cost " << iLQRHPIPM.getBackend()->getCost() << std::endl;
+#endif
+
     // let's plot the output
     plotResultsOscillator<state_dim, control_dim>(solution.x_ref(), solution.uff(), solution.time());
 }
@@ -1,12 +1,16 @@
 /*!
  * \example NLOC_generalConstrained.cpp
  *
- * This example shows how to use general constraints alongside NLOC and requires HPIPM to be installed
- * The unconstrained Riccati backward-pass is replaced by a high-performance interior-point
- * constrained linear-quadratic Optimal Control solver.
+ * This example shows how to use general constraints alongside NLOC. The constraints are handled in two ways:
+ * - by an augmented Lagrangian, which keeps the LQ subproblems unconstrained such that they can be solved by the
+ *   Riccati solver,
+ * - by constrained LQ subproblems, solved by the dense condensing interior-point LQ solver and, if HPIPM is installed,
+ *   by a high-performance sparse interior-point constrained linear-quadratic Optimal Control solver.
  *
  */
 
+#include <chrono>
+
 #include <ct/optcon/optcon.h>
 #include "exampleDir.h"
 #include "plotResultsOscillator.h"
@@ -151,12 +155,12 @@ int main(int argc, char** argv)
     nloc_settings.dt = 0.001;  // the control discretization in [sec]
     nloc_settings.integrator = ct::core::IntegrationType::EULERCT;
     nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
-    nloc_settings.max_iterations = 10;
+    nloc_settings.max_iterations = 50;
     nloc_settings.min_cost_improvement = 1e-4;
     nloc_settings.nThreads = 1;
     nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
-    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::HPIPM_SOLVER;  // solve LQ-problems using HPIPM
-    nloc_settings.lqoc_solver_settings.num_lqoc_iterations = 10;                // number of riccati sub-iterations
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;  // solve LQ-problems by Riccati
+    nloc_settings.augmentedLagrangianSettings.active = true;  // general constraints enter the cost
     nloc_settings.lineSearchSettings.active = false;
     nloc_settings.lineSearchSettings.debugPrint = false;
     nloc_settings.printSummary = true;
@@ -183,11 +187,47 @@ int main(int argc, char** argv)
 
 
     // STEP 3: solve the optimal control problem
+    auto start = std::chrono::steady_clock::now();
     nloc.solve();
+    std::chrono::duration<double, std::milli> timeAL = std::chrono::steady_clock::now() - start;
 
     // STEP 4: retrieve the solution
     ct::core::StateFeedbackController<state_dim, control_dim> solution = nloc.getSolution();
 
+    std::cout << "augmented Lagrangian with Riccati solver: " << nloc.getBackend()->iteration() << " iterations, "
+              << timeAL.count() << " ms, cost " << nloc.getBackend()->getCost() << std::endl;
+
+    // STEP 5: for comparison, solve the same problem with constrained LQ subproblems, using the dense condensing
+    // interior-point LQ solver
+    nloc_settings.augmentedLagrangianSettings.active = false;
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::CONDENSING_SOLVER;
+
+    NLOptConSolver<state_dim, control_dim> nlocCondensing(optConProblem, nloc_settings);
+    nlocCondensing.setInitialGuess(initController);
+
+    start = std::chrono::steady_clock::now();
+    nlocCondensing.solve();
+    std::chrono::duration<double, std::milli> timeCondensing = std::chrono::steady_clock::now() - start;
+
+    std::cout << "condensing solver: " << nlocCondensing.getBackend()->iteration() << " iterations, "
+              << timeCondensing.count() << " ms, cost " << nlocCondensing.getBackend()->getCost() << std::endl;
+
+#ifdef HPIPM
+    // STEP 6: the same with the sparse interior-point LQ solver HPIPM
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::HPIPM_SOLVER;  // solve LQ-problems using HPIPM
+    nloc_settings.lqoc_solver_settings.num_lqoc_iterations = 10;                // number of riccati sub-iterations
+
+    NLOptConSolver<state_dim, control_dim> nlocHPIPM(optConProblem, nloc_settings);
+    nlocHPIPM.setInitialGuess(initController);
+
+    start = std::chrono::steady_clock::now();
+    nlocHPIPM.solve();
+    std::chrono::duration<double, std::milli> timeHPIPM = std::chrono::steady_clock::now() - start;
+
+    std::cout << "HPIPM: " << nlocHPIPM.getBackend()->iteration() << " iterations, " << timeHPIPM.count()
+              << " ms, cost " << nlocHPIPM.getBackend()->getCost() << std::endl;
+#endif
+
     // plot the output
     plotResultsOscillator<state_dim, control_dim>(solution.x_ref(), solution.uff(), solution.time());
 }
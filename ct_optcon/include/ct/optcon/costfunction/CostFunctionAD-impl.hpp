@@ -32,7 +32,8 @@ CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionAD(const CostFunctio
     : CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>(arg),
       stateControlTime_(arg.stateControlTime_),
       intermediateFun_(arg.intermediateFun_),
-      finalFun_(arg.finalFun_)
+      finalFun_(arg.finalFun_),
+      batchSettings_(arg.batchSettings_)
 {
     intermediateTerms_.resize(arg.intermediateTerms_.size());
     finalTerms_.resize(arg.finalTerms_.size());
@@ -49,6 +50,20 @@ CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionAD(const CostFunctio
     finalCostCodegen_ = std::shared_ptr<JacCG>(arg.finalCostCodegen_->clone());
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionAD(const CostFunctionAD& arg, bool share)
+    : CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>(arg, share),
+      stateControlTime_(arg.stateControlTime_),
+      intermediateTerms_(arg.intermediateTerms_),
+      finalTerms_(arg.finalTerms_),
+      intermediateFun_(arg.intermediateFun_),
+      finalFun_(arg.finalFun_),
+      batchSettings_(arg.batchSettings_)
+{
+    intermediateCostCodegen_ = std::shared_ptr<JacCG>(arg.intermediateCostCodegen_->cloneShared());
+    finalCostCodegen_ = std::shared_ptr<JacCG>(arg.finalCostCodegen_->cloneShared());
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionAD(const std::string& filename, bool verbose)
     : CostFunctionAD()  //! @warning the delegating constructor in the initializer list is required to call the initial routine in CostFunctionAD()
@@ -67,6 +82,12 @@ CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>* CostFunctionAD<STATE_DIM, CONTRO
     return new CostFunctionAD(*this);
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>* CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::cloneShared() const
+{
+    return new CostFunctionAD(*this, true);
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::initialize()
 {
@@ -88,9 +109,20 @@ void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::initialize()
     settings.createHessian_ = true;
 
     finalCostCodegen_->compileJIT(settings, "finalCosts");
+
+    // optionally batched, the intermediate costs are evaluated over the whole horizon
+    settings.createBatch_ = batchSettings_.createBatch_;
+    settings.batchWidth_ = batchSettings_.batchWidth_;
+    settings.batchCompileFlags_ = batchSettings_.batchCompileFlags_;
     intermediateCostCodegen_->compileJIT(settings, "intermediateCosts");
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::setBatchSettings(const core::DerivativesCppadSettings& settings)
+{
+    batchSettings_ = settings;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::addIntermediateADTerm(
     std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>> term,
@@ -318,6 +350,44 @@ CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeTerminal()
     return hesTot.template block<CONTROL_DIM, STATE_DIM>(STATE_DIM, 0) + this->stateControlDerivativeTerminalBase();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::intermediateDerivativesHorizon(
+    const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+    const SCALAR& dt,
+    const size_t firstIndex,
+    const size_t lastIndex,
+    core::StateVectorArray<STATE_DIM, SCALAR>& dx,
+    core::StateMatrixArray<STATE_DIM, SCALAR>& dxx,
+    core::ControlVectorArray<CONTROL_DIM, SCALAR>& du,
+    core::ControlMatrixArray<CONTROL_DIM, SCALAR>& duu,
+    core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& dux)
+{
+    // analytical terms, also fills the horizon workspace
+    this->intermediateDerivativesHorizonBase(x, u, dt, firstIndex, lastIndex, dx, dxx, du, duu, dux);
+
+    if (intermediateTerms_.empty())
+        return;
+
+    const size_t nStages = lastIndex - firstIndex + 1;
+    stateControlTimeHorizon_.resize(STATE_DIM + CONTROL_DIM + 1, nStages);
+    stateControlTimeHorizon_ << this->xHorizon_, this->uHorizon_, this->tHorizon_.transpose();
+
+    Eigen::MatrixXd w = Eigen::MatrixXd::Ones(1, nStages);
+    intermediateCostCodegen_->jacobianBatch(stateControlTimeHorizon_, jacHorizon_);
+    intermediateCostCodegen_->hessianBatch(stateControlTimeHorizon_, w, hesHorizon_);
+
+    for (size_t i = 0; i < nStages; i++)
+    {
+        const size_t k = firstIndex + i;
+        dx[k] += jacHorizon_[i].template leftCols<STATE_DIM>().transpose();
+        du[k] += jacHorizon_[i].template block<1, CONTROL_DIM>(0, STATE_DIM).transpose();
+        dxx[k] += hesHorizon_[i].template block<STATE_DIM, STATE_DIM>(0, 0);
+        duu[k] += hesHorizon_[i].template block<CONTROL_DIM, CONTROL_DIM>(STATE_DIM, STATE_DIM);
+        dux[k] += hesHorizon_[i].template block<CONTROL_DIM, STATE_DIM>(STATE_DIM, 0);
+    }
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 std::shared_ptr<ct::optcon::
         TermBase<STATE_DIM, CONTROL_DIM, SCALAR, typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::CGScalar>>
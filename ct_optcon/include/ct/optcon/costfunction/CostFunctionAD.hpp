@@ -74,6 +74,16 @@ public:
 	 */
     CostFunctionAD(const CostFunctionAD& arg);
 
+    /**
+	 * \brief Shallow cloning for concurrent evaluation
+	 *
+	 * The clone shares the auto-diff terms, the recorded tapes and the compiled libraries with this instance.
+	 * Only the models of the compiled libraries are instantiated per clone. Analytical terms are copied with
+	 * TermBase::cloneShared().
+	 * @return pointer to clone
+	 */
+    CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>* cloneShared() const override;
+
 
     /**
 	 * \brief Destructor
@@ -87,6 +97,16 @@ public:
 	 */
     virtual void initialize() override;
 
+    /**
+	 * @brief      Enables batched code for the intermediate auto-diff terms, see intermediateDerivativesHorizon()
+	 *
+	 * Only DerivativesCppadSettings::createBatch_, batchWidth_ and batchCompileFlags_ are used. Batching is
+	 * disabled by default, it has to be set before initialize() is called.
+	 *
+	 * @param[in]  settings  The batch settings
+	 */
+    void setBatchSettings(const core::DerivativesCppadSettings& settings);
+
     /**
 	 * \brief Add an intermediate, auto-differentiable term
 	 *
@@ -133,6 +153,24 @@ public:
     control_state_matrix_t stateControlDerivativeIntermediate() override;
     control_state_matrix_t stateControlDerivativeTerminal() override;
 
+    /*!
+     * \brief First and second derivatives of the intermediate cost at all stages in [firstIndex, lastIndex]
+     *
+     * If batching is enabled, see setBatchSettings(), the auto-diff terms are evaluated with the batched generated
+     * code, which computes the derivatives of several stages per call. The analytical terms are evaluated term by
+     * term over the horizon.
+     */
+    void intermediateDerivativesHorizon(const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const SCALAR& dt,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        core::StateVectorArray<STATE_DIM, SCALAR>& dx,
+        core::StateMatrixArray<STATE_DIM, SCALAR>& dxx,
+        core::ControlVectorArray<CONTROL_DIM, SCALAR>& du,
+        core::ControlMatrixArray<CONTROL_DIM, SCALAR>& duu,
+        core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& dux) override;
+
     std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>> getIntermediateADTermById(const size_t id);
 
     std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>> getFinalADTermById(const size_t id);
@@ -144,6 +182,9 @@ public:
 
 
 private:
+    //! shared copy constructor, see cloneShared()
+    CostFunctionAD(const CostFunctionAD& arg, bool share);
+
     MatrixCg evaluateIntermediateCg(const Eigen::Matrix<CGScalar, STATE_DIM + CONTROL_DIM + 1, 1>& stateInputTime);
     MatrixCg evaluateTerminalCg(const Eigen::Matrix<CGScalar, STATE_DIM + CONTROL_DIM + 1, 1>& stateInputTime);
 
@@ -162,6 +203,14 @@ private:
     //! cppad functions
     typename JacCG::FUN_TYPE_CG intermediateFun_;
     typename JacCG::FUN_TYPE_CG finalFun_;
+
+    //! batch settings of the intermediate cost library
+    core::DerivativesCppadSettings batchSettings_;
+
+    //! workspace of the horizon evaluation, stages in columns
+    Eigen::MatrixXd stateControlTimeHorizon_;
+    typename JacCG::JAC_ARRAY_TYPE jacHorizon_;
+    typename JacCG::HES_ARRAY_TYPE hesHorizon_;
 };
 
 }  // namespace optcon
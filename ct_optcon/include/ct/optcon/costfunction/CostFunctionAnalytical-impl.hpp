@@ -19,6 +19,13 @@ CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionAnalytical(c
 {
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionAnalytical(const CostFunctionAnalytical& arg,
+    bool share)
+    : CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>(arg, share)
+{
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionAnalytical(const std::string& filename,
     bool verbose)
@@ -33,6 +40,13 @@ CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>* CostFunctionAnalytical<S
     return new CostFunctionAnalytical(*this);
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>* CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::cloneShared()
+    const
+{
+    return new CostFunctionAnalytical(*this, true);
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::~CostFunctionAnalytical()
 {
@@ -173,5 +187,30 @@ CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeTe
     return this->stateControlDerivativeTerminalBase();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+SCALAR CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateIntermediateHorizon(
+    const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+    const SCALAR& dt)
+{
+    return this->evaluateIntermediateHorizonBase(x, u, dt);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::intermediateDerivativesHorizon(
+    const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+    const SCALAR& dt,
+    const size_t firstIndex,
+    const size_t lastIndex,
+    core::StateVectorArray<STATE_DIM, SCALAR>& dx,
+    core::StateMatrixArray<STATE_DIM, SCALAR>& dxx,
+    core::ControlVectorArray<CONTROL_DIM, SCALAR>& du,
+    core::ControlMatrixArray<CONTROL_DIM, SCALAR>& duu,
+    core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& dux)
+{
+    this->intermediateDerivativesHorizonBase(x, u, dt, firstIndex, lastIndex, dx, dxx, du, duu, dux);
+}
+
 }  // namespace optcon
 }  // namespace ct
@@ -63,6 +63,12 @@ public:
 	 */
     CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>* clone() const;
 
+    /**
+	 * Cloning for concurrent evaluation, the terms share their immutable data with this cost function
+	 * @return base pointer to clone
+	 */
+    CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>* cloneShared() const override;
+
     /**
 	 * Destructor
 	 */
@@ -86,9 +92,26 @@ public:
     control_state_matrix_t stateControlDerivativeIntermediate() override;
     control_state_matrix_t stateControlDerivativeTerminal() override;
 
+    SCALAR evaluateIntermediateHorizon(const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const SCALAR& dt) override;
+
+    void intermediateDerivativesHorizon(const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const SCALAR& dt,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        core::StateVectorArray<STATE_DIM, SCALAR>& dx,
+        core::StateMatrixArray<STATE_DIM, SCALAR>& dxx,
+        core::ControlVectorArray<CONTROL_DIM, SCALAR>& du,
+        core::ControlMatrixArray<CONTROL_DIM, SCALAR>& duu,
+        core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& dux) override;
+
     void loadFromConfigFile(const std::string& filename, bool verbose = false) override;
 
 private:
+    //! shared copy constructor, see cloneShared()
+    CostFunctionAnalytical(const CostFunctionAnalytical& arg, bool share);
 };
 
 }  // namespace optcon
@@ -36,11 +36,41 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionQuadratic(con
     }
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionQuadratic(const CostFunctionQuadratic& arg,
+    bool share)
+    : CostFunction<STATE_DIM, CONTROL_DIM, SCALAR>(arg),
+      eps_(arg.eps_),
+      doubleSidedDerivative_(arg.doubleSidedDerivative_)
+{
+    intermediateCostAnalytical_.resize(arg.intermediateCostAnalytical_.size());
+    finalCostAnalytical_.resize(arg.finalCostAnalytical_.size());
+
+    for (size_t i = 0; i < arg.intermediateCostAnalytical_.size(); i++)
+    {
+        intermediateCostAnalytical_[i] = std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR>>(
+            arg.intermediateCostAnalytical_[i]->cloneShared());
+    }
+
+    for (size_t i = 0; i < arg.finalCostAnalytical_.size(); i++)
+    {
+        finalCostAnalytical_[i] =
+            std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR>>(arg.finalCostAnalytical_[i]->cloneShared());
+    }
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::~CostFunctionQuadratic()
 {
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>* CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::cloneShared()
+    const
+{
+    return clone();
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::addIntermediateADTerm(
     std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR, ct::core::ADCGScalar>> term,
@@ -86,6 +116,47 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeTer
     throw std::runtime_error("stateControlDerivativeTerminal() not implemented");
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+SCALAR CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateIntermediateHorizon(
+    const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+    const SCALAR& dt)
+{
+    SCALAR y = SCALAR(0.0);
+
+    for (size_t k = 0; k < u.size(); k++)
+    {
+        this->setCurrentStateAndControl(x[k], u[k], dt * k);
+        y += this->evaluateIntermediate();
+    }
+
+    return y;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::intermediateDerivativesHorizon(
+    const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+    const SCALAR& dt,
+    const size_t firstIndex,
+    const size_t lastIndex,
+    core::StateVectorArray<STATE_DIM, SCALAR>& dx,
+    core::StateMatrixArray<STATE_DIM, SCALAR>& dxx,
+    core::ControlVectorArray<CONTROL_DIM, SCALAR>& du,
+    core::ControlMatrixArray<CONTROL_DIM, SCALAR>& duu,
+    core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& dux)
+{
+    for (size_t k = firstIndex; k <= lastIndex; k++)
+    {
+        this->setCurrentStateAndControl(x[k], u[k], dt * k);
+        dx[k] = this->stateDerivativeIntermediate();
+        dxx[k] = this->stateSecondDerivativeIntermediate();
+        du[k] = this->controlDerivativeIntermediate();
+        duu[k] = this->controlSecondDerivativeIntermediate();
+        dux[k] = this->stateControlDerivativeIntermediate();
+    }
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::updateReferenceState(const state_vector_t& x_ref)
 {
@@ -110,7 +181,7 @@ void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::updateReferenceContr
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 bool CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateDerivativeIntermediateTest(bool verbose)
 {
-    state_vector_t derivative = stateDerivativeIntermediate();
+    state_vector_t derivative = this->stateDerivativeIntermediate();
     state_vector_t derivativeNd = stateDerivativeIntermediateNumDiff();
 
     if (verbose)
@@ -123,7 +194,7 @@ bool CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateDerivativeInter
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 bool CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::controlDerivativeIntermediateTest(bool verbose)
 {
-    control_vector_t derivative = controlDerivativeIntermediate();
+    control_vector_t derivative = this->controlDerivativeIntermediate();
     control_vector_t derivativeNd = controlDerivativeIntermediateNumDiff();
 
     if (verbose)
@@ -310,13 +381,13 @@ SCALAR CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateIntermedia
 {
     SCALAR y = SCALAR(0.0);
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
             continue;
         }
-        y += it->computeActivation(this->t_) * it->eval(this->x_, this->u_, this->t_);
+        y += it->eval(this->x_, this->u_, this->t_);
     }
 
     return y;
@@ -328,7 +399,7 @@ SCALAR CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateTerminalBa
 {
     SCALAR y = SCALAR(0.0);
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         y += it->evaluate(this->x_, this->u_, this->t_);
 
     return y;
@@ -342,7 +413,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateDerivativeIntermedia
     state_vector_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
@@ -362,7 +433,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateDerivativeTerminalBa
     state_vector_t derivative;
     derivative.setZero();
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         derivative += it->stateDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
@@ -375,7 +446,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateSecondDerivativeInte
     state_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
@@ -394,7 +465,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateSecondDerivativeTerm
     state_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         derivative += it->stateSecondDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
@@ -408,7 +479,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::controlDerivativeIntermed
     control_vector_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
@@ -427,7 +498,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::controlDerivativeTerminal
     control_vector_t derivative;
     derivative.setZero();
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         derivative += it->controlDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
@@ -441,7 +512,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::controlSecondDerivativeIn
     control_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
@@ -460,7 +531,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::controlSecondDerivativeTe
     control_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         derivative += it->controlSecondDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
@@ -474,7 +545,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeInt
     control_state_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
@@ -493,11 +564,123 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeTer
     control_state_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         derivative += it->stateControlDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+SCALAR CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateIntermediateHorizonBase(
+    const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+    const SCALAR& dt)
+{
+    if (u.size() == 0)
+        return SCALAR(0.0);
+
+    setHorizon(x, u, dt, 0, u.size() - 1);
+
+    costHorizon_.setZero(u.size());
+    for (const auto& it : this->intermediateCostAnalytical_)
+    {
+        if (!computeHorizonActivation(*it))
+        {
+            continue;
+        }
+        it->evaluateHorizon(xHorizon_, uHorizon_, tHorizon_, activationHorizon_, costHorizon_);
+    }
+
+    return costHorizon_.sum();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::intermediateDerivativesHorizonBase(
+    const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+    const SCALAR& dt,
+    const size_t firstIndex,
+    const size_t lastIndex,
+    core::StateVectorArray<STATE_DIM, SCALAR>& dx,
+    core::StateMatrixArray<STATE_DIM, SCALAR>& dxx,
+    core::ControlVectorArray<CONTROL_DIM, SCALAR>& du,
+    core::ControlMatrixArray<CONTROL_DIM, SCALAR>& duu,
+    core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& dux)
+{
+    setHorizon(x, u, dt, firstIndex, lastIndex);
+
+    const size_t nStages = lastIndex - firstIndex + 1;
+    dxHorizon_.setZero(STATE_DIM, nStages);
+    duHorizon_.setZero(CONTROL_DIM, nStages);
+    dxxHorizon_.resize(nStages);
+    duuHorizon_.resize(nStages);
+    duxHorizon_.resize(nStages);
+    for (size_t i = 0; i < nStages; i++)
+    {
+        dxxHorizon_[i].setZero();
+        duuHorizon_[i].setZero();
+        duxHorizon_[i].setZero();
+    }
+
+    for (const auto& it : this->intermediateCostAnalytical_)
+    {
+        if (!computeHorizonActivation(*it))
+        {
+            continue;
+        }
+        it->firstDerivativesHorizon(xHorizon_, uHorizon_, tHorizon_, activationHorizon_, dxHorizon_, duHorizon_);
+        it->secondDerivativesHorizon(
+            xHorizon_, uHorizon_, tHorizon_, activationHorizon_, dxxHorizon_, duuHorizon_, duxHorizon_);
+    }
+
+    for (size_t i = 0; i < nStages; i++)
+    {
+        dx[firstIndex + i] = dxHorizon_.col(i);
+        dxx[firstIndex + i] = dxxHorizon_[i];
+        du[firstIndex + i] = duHorizon_.col(i);
+        duu[firstIndex + i] = duuHorizon_[i];
+        dux[firstIndex + i] = duxHorizon_[i];
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::setHorizon(
+    const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+    const SCALAR& dt,
+    const size_t firstIndex,
+    const size_t lastIndex)
+{
+    const size_t nStages = lastIndex - firstIndex + 1;
+    xHorizon_.resize(STATE_DIM, nStages);
+    uHorizon_.resize(CONTROL_DIM, nStages);
+    tHorizon_.resize(nStages);
+    for (size_t i = 0; i < nStages; i++)
+    {
+        xHorizon_.col(i) = x[firstIndex + i];
+        uHorizon_.col(i) = u[firstIndex + i];
+        tHorizon_(i) = dt * (firstIndex + i);
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+bool CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::computeHorizonActivation(
+    TermBase<STATE_DIM, CONTROL_DIM, SCALAR>& term)
+{
+    bool active = false;
+    activationHorizon_.resize(tHorizon_.size());
+    for (int i = 0; i < tHorizon_.size(); i++)
+    {
+        if (term.isActiveAtTime(tHorizon_(i)))
+        {
+            activationHorizon_(i) = term.computeActivation(tHorizon_(i));
+            active = true;
+        }
+        else
+            activationHorizon_(i) = SCALAR(0.0);
+    }
+    return active;
+}
+
 }  // namespace optcon
 }  // namespace ct
@@ -57,6 +57,17 @@ public:
 	 */
     virtual CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>* clone() const = 0;
 
+    /**
+	 * \brief Clones the cost function for concurrent evaluation
+	 *
+	 * Derived cost functions may share immutable data (e.g. compiled derivatives and the terms they were
+	 * recorded from) between the returned instance and this one, such that only evaluation buffers are duplicated.
+	 * The returned instance can be evaluated concurrently to this one, but modifying shared terms affects both.
+	 * Defaults to a deep copy, see clone().
+	 * @return
+	 */
+    virtual CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>* cloneShared() const;
+
     /**
 	 * Destructor
 	 */
@@ -156,6 +167,39 @@ public:
 	 */
     virtual control_state_matrix_t stateControlDerivativeTerminal();
 
+    /**
+	 * \brief Evaluates the intermediate cost along a trajectory
+	 *
+	 * Returns the sum of evaluateIntermediate() over the stages k = 0 ... u.size()-1 evaluated at (x[k], u[k], k*dt).
+	 * The result is not scaled by dt. Cost functions made of analytical terms evaluate every term on all stages at
+	 * once, see TermBase::evaluateHorizon(). Overwrites the current state, control and time.
+	 * @param x state trajectory, at least as long as u
+	 * @param u control trajectory
+	 * @param dt sampling time
+	 * @return sum of the intermediate costs
+	 */
+    virtual SCALAR evaluateIntermediateHorizon(const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const SCALAR& dt);
+
+    /**
+	 * \brief Computes the intermediate cost derivatives of the stages firstIndex ... lastIndex
+	 *
+	 * The derivatives of stage k are evaluated at (x[k], u[k], k*dt) and written to index k of the output arrays,
+	 * which need to hold at least lastIndex+1 elements. The derivatives are not scaled by dt. Overwrites the current
+	 * state, control and time.
+	 */
+    virtual void intermediateDerivativesHorizon(const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const SCALAR& dt,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        core::StateVectorArray<STATE_DIM, SCALAR>& dx,
+        core::StateMatrixArray<STATE_DIM, SCALAR>& dxx,
+        core::ControlVectorArray<CONTROL_DIM, SCALAR>& du,
+        core::ControlMatrixArray<CONTROL_DIM, SCALAR>& duu,
+        core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& dux);
+
     //! update the reference state for intermediate cost terms
     virtual void updateReferenceState(const state_vector_t& x_ref);
 
@@ -183,6 +227,9 @@ public:
     virtual void initialize();
 
 protected:
+    //! shared copy constructor, copies the analytical terms with TermBase::cloneShared(), see cloneShared()
+    CostFunctionQuadratic(const CostFunctionQuadratic& arg, bool share);
+
     //! evaluate intermediate analytical cost terms
     SCALAR evaluateIntermediateBase();
 
@@ -219,6 +266,33 @@ protected:
     //! evaluate terminal analytical control mixed state control derivatives
     control_state_matrix_t stateControlDerivativeTerminalBase();
 
+    //! evaluate intermediate analytical cost terms on all stages of a trajectory at once
+    SCALAR evaluateIntermediateHorizonBase(const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const SCALAR& dt);
+
+    //! evaluate intermediate analytical derivatives on the stages firstIndex ... lastIndex at once
+    void intermediateDerivativesHorizonBase(const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const SCALAR& dt,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        core::StateVectorArray<STATE_DIM, SCALAR>& dx,
+        core::StateMatrixArray<STATE_DIM, SCALAR>& dxx,
+        core::ControlVectorArray<CONTROL_DIM, SCALAR>& du,
+        core::ControlMatrixArray<CONTROL_DIM, SCALAR>& duu,
+        core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& dux);
+
+    //! copy the stages firstIndex ... lastIndex into the horizon workspace
+    void setHorizon(const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const SCALAR& dt,
+        const size_t firstIndex,
+        const size_t lastIndex);
+
+    //! compute the activation of a term on all horizon stages, returns false if it is inactive on all of them
+    bool computeHorizonActivation(TermBase<STATE_DIM, CONTROL_DIM, SCALAR>& term);
+
     //! compute the state derivative by numerical differentiation (can be used for testing)
     state_vector_t stateDerivativeIntermediateNumDiff();
 
@@ -236,6 +310,20 @@ protected:
 
     /** list of final cost terms for which analytic derivatives are available */
     std::vector<std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR>>> finalCostAnalytical_;
+
+    typedef TermBase<STATE_DIM, CONTROL_DIM, SCALAR> term_t;
+
+    //! workspace of the horizon evaluations, stages in columns
+    typename term_t::state_horizon_t xHorizon_;
+    typename term_t::control_horizon_t uHorizon_;
+    typename term_t::scalar_horizon_t tHorizon_;
+    typename term_t::scalar_horizon_t activationHorizon_;
+    typename term_t::scalar_horizon_t costHorizon_;
+    typename term_t::state_horizon_t dxHorizon_;
+    typename term_t::control_horizon_t duHorizon_;
+    typename term_t::state_matrix_horizon_t dxxHorizon_;
+    typename term_t::control_matrix_horizon_t duuHorizon_;
+    typename term_t::control_state_matrix_horizon_t duxHorizon_;
 };
 
 
@@ -27,6 +27,13 @@ TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::~TermBase()
 {
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>* TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::cloneShared()
+    const
+{
+    return clone();
+}
+
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 SCALAR_EVAL TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::eval(
@@ -122,6 +129,82 @@ TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateControlDerivative(
         "or implement the analytical derivatives manually.");
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    scalar_horizon_t& cost)
+{
+    for (int k = 0; k < X.cols(); k++)
+    {
+        if (w(k) == SCALAR_EVAL(0.0))
+            continue;
+        cost(k) += w(k) * evaluateStage(X.col(k), U.col(k), t(k), std::is_same<SCALAR, SCALAR_EVAL>());
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::firstDerivativesHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    state_horizon_t& dX,
+    control_horizon_t& dU)
+{
+    for (int k = 0; k < X.cols(); k++)
+    {
+        if (w(k) == SCALAR_EVAL(0.0))
+            continue;
+        const core::StateVector<STATE_DIM, SCALAR_EVAL> x = X.col(k);
+        const core::ControlVector<CONTROL_DIM, SCALAR_EVAL> u = U.col(k);
+        dX.col(k) += w(k) * stateDerivative(x, u, t(k));
+        dU.col(k) += w(k) * controlDerivative(x, u, t(k));
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::secondDerivativesHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    state_matrix_horizon_t& ddX,
+    control_matrix_horizon_t& ddU,
+    control_state_matrix_horizon_t& ddUX)
+{
+    for (int k = 0; k < X.cols(); k++)
+    {
+        if (w(k) == SCALAR_EVAL(0.0))
+            continue;
+        const core::StateVector<STATE_DIM, SCALAR_EVAL> x = X.col(k);
+        const core::ControlVector<CONTROL_DIM, SCALAR_EVAL> u = U.col(k);
+        ddX[k] += w(k) * stateSecondDerivative(x, u, t(k));
+        ddU[k] += w(k) * controlSecondDerivative(x, u, t(k));
+        ddUX[k] += w(k) * stateControlDerivative(x, u, t(k));
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+SCALAR_EVAL TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateStage(
+    const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1>& x,
+    const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
+    const SCALAR_EVAL& t,
+    std::true_type)
+{
+    return evaluate(x, u, t);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+SCALAR_EVAL TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateStage(
+    const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1>& x,
+    const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
+    const SCALAR_EVAL& t,
+    std::false_type)
+{
+    throw std::runtime_error(
+        "The cost function term " + name_ + " is an auto-diff term and cannot be evaluated on the horizon.");
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::loadConfigFile(const std::string& filename,
     const std::string& termName,
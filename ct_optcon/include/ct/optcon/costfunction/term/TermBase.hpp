@@ -43,6 +43,14 @@ public:
     typedef Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, CONTROL_DIM> control_matrix_double_t;
     typedef Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, STATE_DIM> control_state_matrix_double_t;
 
+    //! horizon data in structure-of-arrays layout, column k holds stage k
+    typedef Eigen::Matrix<SCALAR_EVAL, STATE_DIM, Eigen::Dynamic> state_horizon_t;
+    typedef Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, Eigen::Dynamic> control_horizon_t;
+    typedef Eigen::Matrix<SCALAR_EVAL, Eigen::Dynamic, 1> scalar_horizon_t;
+    typedef ct::core::DiscreteArray<state_matrix_t> state_matrix_horizon_t;
+    typedef ct::core::DiscreteArray<control_matrix_t> control_matrix_horizon_t;
+    typedef ct::core::DiscreteArray<control_state_matrix_t> control_state_matrix_horizon_t;
+
     /**
 	 * \brief Default constructor
 	 * @param name Name of the term
@@ -61,6 +69,14 @@ public:
 	 */
     virtual TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>* clone() const = 0;
 
+    /**
+	 * \brief Copy term for concurrent evaluation
+	 *
+	 * The copy may share immutable data (e.g. reference trajectories) with this term. Defaults to clone().
+	 * @return
+	 */
+    virtual TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>* cloneShared() const;
+
     /**
 	 * \brief Destructor
 	 */
@@ -145,6 +161,42 @@ public:
         const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
         const SCALAR_EVAL& t);
 
+    /**
+	 * @brief      Evaluates the term for a whole horizon at once
+	 *
+	 * Adds w(k) * evaluate(X.col(k), U.col(k), t(k)) to cost(k). Stages with zero weight are skipped. The default
+	 * implementation loops over the stages, terms with closed-form expressions override it with column-wise
+	 * operations on the whole horizon.
+	 *
+	 * @param[in]  X     the states, one column per stage
+	 * @param[in]  U     the controls, one column per stage
+	 * @param[in]  t     the stage times
+	 * @param[in]  w     the stage weights, usually the time activation
+	 * @param      cost  the weighted stage costs get added here
+	 */
+    virtual void evaluateHorizon(const state_horizon_t& X,
+        const control_horizon_t& U,
+        const scalar_horizon_t& t,
+        const scalar_horizon_t& w,
+        scalar_horizon_t& cost);
+
+    //! adds the weighted first order derivatives of all stages to the columns of dX and dU, see evaluateHorizon()
+    virtual void firstDerivativesHorizon(const state_horizon_t& X,
+        const control_horizon_t& U,
+        const scalar_horizon_t& t,
+        const scalar_horizon_t& w,
+        state_horizon_t& dX,
+        control_horizon_t& dU);
+
+    //! adds the weighted second order derivatives of stage k to ddX[k], ddU[k] and ddUX[k], see evaluateHorizon()
+    virtual void secondDerivativesHorizon(const state_horizon_t& X,
+        const control_horizon_t& U,
+        const scalar_horizon_t& t,
+        const scalar_horizon_t& w,
+        state_matrix_horizon_t& ddX,
+        control_matrix_horizon_t& ddU,
+        control_state_matrix_horizon_t& ddUX);
+
     //! load this term from a configuration file
     virtual void loadConfigFile(const std::string& filename, const std::string& termName, bool verbose = false);
 
@@ -174,6 +226,17 @@ public:
 
     //! retrieve this term's current reference state
     virtual Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1> getReferenceState() const;
+
+private:
+    //! evaluate() on SCALAR_EVAL arguments, only available if the term is not an auto-diff term
+    SCALAR_EVAL evaluateStage(const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1>& x,
+        const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
+        const SCALAR_EVAL& t,
+        std::true_type);
+    SCALAR_EVAL evaluateStage(const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1>& x,
+        const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
+        const SCALAR_EVAL& t,
+        std::false_type);
 };
 
 }  // namespace optcon
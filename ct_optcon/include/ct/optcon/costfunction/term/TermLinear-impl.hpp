@@ -106,6 +106,40 @@ TermLinear<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateControlDerivative(
     return control_state_matrix_t::Zero();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermLinear<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    scalar_horizon_t& cost)
+{
+    cost.array() += w.array() * ((a_.transpose() * X + b_.transpose() * U).transpose().array() + c_);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermLinear<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::firstDerivativesHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    state_horizon_t& dX,
+    control_horizon_t& dU)
+{
+    dX.noalias() += a_ * w.transpose();
+    dU.noalias() += b_ * w.transpose();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermLinear<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::secondDerivativesHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    state_matrix_horizon_t& ddX,
+    control_matrix_horizon_t& ddU,
+    control_state_matrix_horizon_t& ddUX)
+{
+    // all second order derivatives are zero
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 void TermLinear<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::loadConfigFile(const std::string& filename,
     const std::string& termName,
@@ -28,6 +28,15 @@ public:
     typedef Eigen::Matrix<SCALAR_EVAL, STATE_DIM, STATE_DIM> state_matrix_double_t;
     typedef Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, CONTROL_DIM> control_matrix_double_t;
     typedef Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, STATE_DIM> control_state_matrix_double_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::state_horizon_t state_horizon_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::control_horizon_t control_horizon_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::scalar_horizon_t scalar_horizon_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::state_matrix_horizon_t
+        state_matrix_horizon_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::control_matrix_horizon_t
+        control_matrix_horizon_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::control_state_matrix_horizon_t
+        control_state_matrix_horizon_t;
 
     TermLinear(const core::StateVector<STATE_DIM, SCALAR_EVAL> a,
         core::ControlVector<CONTROL_DIM, SCALAR_EVAL> b,
@@ -69,6 +78,27 @@ public:
         const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
         const SCALAR_EVAL& t) override;
 
+    void evaluateHorizon(const state_horizon_t& X,
+        const control_horizon_t& U,
+        const scalar_horizon_t& t,
+        const scalar_horizon_t& w,
+        scalar_horizon_t& cost) override;
+
+    void firstDerivativesHorizon(const state_horizon_t& X,
+        const control_horizon_t& U,
+        const scalar_horizon_t& t,
+        const scalar_horizon_t& w,
+        state_horizon_t& dX,
+        control_horizon_t& dU) override;
+
+    void secondDerivativesHorizon(const state_horizon_t& X,
+        const control_horizon_t& U,
+        const scalar_horizon_t& t,
+        const scalar_horizon_t& w,
+        state_matrix_horizon_t& ddX,
+        control_matrix_horizon_t& ddU,
+        control_state_matrix_horizon_t& ddUX) override;
+
     void loadConfigFile(const std::string& filename,
         const std::string& termName,
         bool verbose = false) override;  // virtual function for data loading
@@ -16,14 +16,20 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::TermQuadTracking(
     const bool trackControlTrajectory)
     : Q_(Q),
       R_(R),
-      x_traj_ref_(stateSplineType),
-      u_traj_ref_(controlSplineType),
+      x_traj_ref_(std::make_shared<const state_trajectory_t>(stateSplineType)),
+      u_traj_ref_(std::make_shared<const control_trajectory_t>(controlSplineType)),
+      x_interp_(stateSplineType),
+      u_interp_(controlSplineType),
       trackControlTrajectory_(trackControlTrajectory)
 {
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::TermQuadTracking()
+    : x_traj_ref_(std::make_shared<const state_trajectory_t>()),
+      u_traj_ref_(std::make_shared<const control_trajectory_t>()),
+      x_interp_(x_traj_ref_->getInterpolationType()),
+      u_interp_(u_traj_ref_->getInterpolationType())
 {
     // default values
     Q_.setIdentity();
@@ -34,11 +40,28 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::TermQuadTracking(
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::TermQuadTracking(
     const TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>& arg)
+    : TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>(arg),
+      Q_(arg.Q_),
+      R_(arg.R_),
+      x_traj_ref_(std::make_shared<const state_trajectory_t>(*arg.x_traj_ref_)),
+      u_traj_ref_(std::make_shared<const control_trajectory_t>(*arg.u_traj_ref_)),
+      x_interp_(arg.x_interp_),
+      u_interp_(arg.u_interp_),
+      trackControlTrajectory_(arg.trackControlTrajectory_)
+{
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::TermQuadTracking(
+    const TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>& arg,
+    bool share)
     : TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>(arg),
       Q_(arg.Q_),
       R_(arg.R_),
       x_traj_ref_(arg.x_traj_ref_),
       u_traj_ref_(arg.u_traj_ref_),
+      x_interp_(arg.x_interp_),
+      u_interp_(arg.u_interp_),
       trackControlTrajectory_(arg.trackControlTrajectory_)
 {
 }
@@ -55,6 +78,13 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::clone() const
     return new TermQuadTracking(*this);
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>*
+TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::cloneShared() const
+{
+    return new TermQuadTracking(*this, true);
+}
+
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::setWeights(const state_matrix_double_t& Q,
@@ -69,8 +99,29 @@ void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::setStateAndC
     const core::StateTrajectory<STATE_DIM>& xTraj,
     const core::ControlTrajectory<CONTROL_DIM>& uTraj)
 {
-    x_traj_ref_ = xTraj;
-    u_traj_ref_ = uTraj;
+    // replace instead of modifying the references, which may be shared with other copies
+    x_traj_ref_ = std::make_shared<const state_trajectory_t>(xTraj);
+    u_traj_ref_ = std::make_shared<const control_trajectory_t>(uTraj);
+    x_interp_.changeInterpolationType(xTraj.getInterpolationType());
+    u_interp_.changeInterpolationType(uTraj.getInterpolationType());
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+core::StateVector<STATE_DIM, SCALAR_EVAL> TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::xRef(
+    const SCALAR_EVAL& t)
+{
+    core::StateVector<STATE_DIM, SCALAR_EVAL> x;
+    x_interp_.interpolate(x_traj_ref_->getTimeArray(), x_traj_ref_->getDataArray(), t, x);
+    return x;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+core::ControlVector<CONTROL_DIM, SCALAR_EVAL> TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::uRef(
+    const SCALAR_EVAL& t)
+{
+    core::ControlVector<CONTROL_DIM, SCALAR_EVAL> u;
+    u_interp_.interpolate(u_traj_ref_->getTimeArray(), u_traj_ref_->getDataArray(), t, u);
+    return u;
 }
 
 
@@ -90,7 +141,7 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateDerivative(
     const ct::core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
     const SCALAR_EVAL& t)
 {
-    Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1> xDiff = x - x_traj_ref_.eval(t);
+    Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1> xDiff = x - xRef(t);
 
     return xDiff.transpose() * Q_.transpose() + xDiff.transpose() * Q_;
 }
@@ -115,7 +166,7 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::controlDerivative
     Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1> uDiff;
 
     if (trackControlTrajectory_)
-        uDiff = u - u_traj_ref_.eval(t);
+        uDiff = u - uRef(t);
     else
         uDiff = u;
 
@@ -142,6 +193,76 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateControlDeriv
     return control_state_matrix_t::Zero();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    scalar_horizon_t& cost)
+{
+    state_horizon_t xDiff;
+    control_horizon_t uDiff;
+    computeDeviations(X, U, t, xDiff, uDiff);
+
+    cost.array() += w.array() * ((Q_ * xDiff).cwiseProduct(xDiff).colwise().sum() +
+                                    (R_ * uDiff).cwiseProduct(uDiff).colwise().sum())
+                                    .transpose()
+                                    .array();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::firstDerivativesHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    state_horizon_t& dX,
+    control_horizon_t& dU)
+{
+    state_horizon_t xDiff;
+    control_horizon_t uDiff;
+    computeDeviations(X, U, t, xDiff, uDiff);
+
+    dX.noalias() += (Q_ + Q_.transpose()) * xDiff * w.asDiagonal();
+    dU.noalias() += (R_ + R_.transpose()) * uDiff * w.asDiagonal();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::secondDerivativesHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    state_matrix_horizon_t& ddX,
+    control_matrix_horizon_t& ddU,
+    control_state_matrix_horizon_t& ddUX)
+{
+    const state_matrix_t Qsym = Q_ + Q_.transpose();
+    const control_matrix_t Rsym = R_ + R_.transpose();
+    for (int k = 0; k < X.cols(); k++)
+    {
+        if (w(k) == SCALAR_EVAL(0.0))
+            continue;
+        ddX[k] += w(k) * Qsym;
+        ddU[k] += w(k) * Rsym;
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::computeDeviations(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    state_horizon_t& xDiff,
+    control_horizon_t& uDiff)
+{
+    xDiff = X;
+    uDiff = U;
+    for (int k = 0; k < X.cols(); k++)
+    {
+        xDiff.col(k) -= xRef(t(k));
+        if (trackControlTrajectory_)
+            uDiff.col(k) -= uRef(t(k));
+    }
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::loadConfigFile(const std::string& filename,
     const std::string& termName,
@@ -28,6 +28,18 @@ public:
     typedef Eigen::Matrix<SCALAR_EVAL, STATE_DIM, STATE_DIM> state_matrix_double_t;
     typedef Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, CONTROL_DIM> control_matrix_double_t;
     typedef Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, STATE_DIM> control_state_matrix_double_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::state_horizon_t state_horizon_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::control_horizon_t control_horizon_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::scalar_horizon_t scalar_horizon_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::state_matrix_horizon_t
+        state_matrix_horizon_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::control_matrix_horizon_t
+        control_matrix_horizon_t;
+    typedef typename TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::control_state_matrix_horizon_t
+        control_state_matrix_horizon_t;
+
+    typedef ct::core::StateTrajectory<STATE_DIM, SCALAR_EVAL> state_trajectory_t;
+    typedef ct::core::ControlTrajectory<CONTROL_DIM, SCALAR_EVAL> control_trajectory_t;
 
     TermQuadTracking();
 
@@ -43,6 +55,9 @@ public:
 
     TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>* clone() const override;
 
+    //! copy which shares the reference trajectories with this term, see TermBase::cloneShared()
+    TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>* cloneShared() const override;
+
     void setWeights(const state_matrix_double_t& Q, const control_matrix_double_t& R);
 
     void setStateAndControlReference(const core::StateTrajectory<STATE_DIM>& xTraj,
@@ -72,20 +87,65 @@ public:
         const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
         const SCALAR_EVAL& t) override;
 
+    void evaluateHorizon(const state_horizon_t& X,
+        const control_horizon_t& U,
+        const scalar_horizon_t& t,
+        const scalar_horizon_t& w,
+        scalar_horizon_t& cost) override;
+
+    void firstDerivativesHorizon(const state_horizon_t& X,
+        const control_horizon_t& U,
+        const scalar_horizon_t& t,
+        const scalar_horizon_t& w,
+        state_horizon_t& dX,
+        control_horizon_t& dU) override;
+
+    void secondDerivativesHorizon(const state_horizon_t& X,
+        const control_horizon_t& U,
+        const scalar_horizon_t& t,
+        const scalar_horizon_t& w,
+        state_matrix_horizon_t& ddX,
+        control_matrix_horizon_t& ddU,
+        control_state_matrix_horizon_t& ddUX) override;
+
     virtual void loadConfigFile(const std::string& filename,
         const std::string& termName,
         bool verbose = false) override;
 
 protected:
+    //! shared copy constructor, see cloneShared()
+    TermQuadTracking(const TermQuadTracking& arg, bool share);
+
+    //! evaluates the reference trajectories
+    core::StateVector<STATE_DIM, SCALAR_EVAL> xRef(const SCALAR_EVAL& t);
+    core::ControlVector<CONTROL_DIM, SCALAR_EVAL> uRef(const SCALAR_EVAL& t);
+
+    //! stacks the deviations from the reference trajectories at the stage times t
+    void computeDeviations(const state_horizon_t& X,
+        const control_horizon_t& U,
+        const scalar_horizon_t& t,
+        state_horizon_t& xDiff,
+        control_horizon_t& uDiff);
+
     template <typename SC>
     SC evalLocal(const Eigen::Matrix<SC, STATE_DIM, 1>& x, const Eigen::Matrix<SC, CONTROL_DIM, 1>& u, const SC& t);
 
     state_matrix_t Q_;
     control_matrix_t R_;
 
-    // the reference trajectories to be tracked
-    ct::core::StateTrajectory<STATE_DIM, SCALAR_EVAL> x_traj_ref_;
-    ct::core::ControlTrajectory<CONTROL_DIM, SCALAR_EVAL> u_traj_ref_;
+    // the reference trajectories to be tracked. They are never modified in place, hence they can be shared.
+    std::shared_ptr<const state_trajectory_t> x_traj_ref_;
+    std::shared_ptr<const control_trajectory_t> u_traj_ref_;
+
+    // interpolation of the references, keeps the last index and is therefore owned by every copy
+    ct::core::Interpolation<core::StateVector<STATE_DIM, SCALAR_EVAL>,
+        Eigen::aligned_allocator<core::StateVector<STATE_DIM, SCALAR_EVAL>>,
+        SCALAR_EVAL>
+        x_interp_;
+    ct::core::Interpolation<core::ControlVector<CONTROL_DIM, SCALAR_EVAL>,
+        Eigen::aligned_allocator<core::ControlVector<CONTROL_DIM, SCALAR_EVAL>>,
+        SCALAR_EVAL>
+        u_interp_;
 
     // Option whether the control trajectory deviation shall be penalized or not
     bool trackControlTrajectory_;
@@ -98,12 +158,12 @@ SC TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evalLocal(cons
     const Eigen::Matrix<SC, CONTROL_DIM, 1>& u,
     const SC& t)
 {
-    Eigen::Matrix<SC, STATE_DIM, 1> xDiff = x - x_traj_ref_.eval((SCALAR_EVAL)t).template cast<SC>();
+    Eigen::Matrix<SC, STATE_DIM, 1> xDiff = x - xRef((SCALAR_EVAL)t).template cast<SC>();
 
     Eigen::Matrix<SC, CONTROL_DIM, 1> uDiff;
 
     if (trackControlTrajectory_)
-        uDiff = u - u_traj_ref_.eval((SCALAR_EVAL)t).template cast<SC>();
+        uDiff = u - uRef((SCALAR_EVAL)t).template cast<SC>();
     else
         uDiff = u;
 
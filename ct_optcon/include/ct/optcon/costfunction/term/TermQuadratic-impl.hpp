@@ -190,6 +190,54 @@ TermQuadratic<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateControlDerivati
     return control_state_matrix_t::Zero();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermQuadratic<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    scalar_horizon_t& cost)
+{
+    const state_horizon_t xDiff = X.colwise() - x_ref_;
+    const control_horizon_t uDiff = U.colwise() - u_ref_;
+
+    cost.array() += w.array() * ((Q_ * xDiff).cwiseProduct(xDiff).colwise().sum() +
+                                    (R_ * uDiff).cwiseProduct(uDiff).colwise().sum())
+                                    .transpose()
+                                    .array();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermQuadratic<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::firstDerivativesHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    state_horizon_t& dX,
+    control_horizon_t& dU)
+{
+    dX.noalias() += (Q_ + Q_.transpose()) * (X.colwise() - x_ref_) * w.asDiagonal();
+    dU.noalias() += (R_ + R_.transpose()) * (U.colwise() - u_ref_) * w.asDiagonal();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermQuadratic<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::secondDerivativesHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    state_matrix_horizon_t& ddX,
+    control_matrix_horizon_t& ddU,
+    control_state_matrix_horizon_t& ddUX)
+{
+    const state_matrix_t Qsym = Q_ + Q_.transpose();
+    const control_matrix_t Rsym = R_ + R_.transpose();
+    for (int k = 0; k < X.cols(); k++)
+    {
+        if (w(k) == SCALAR_EVAL(0.0))
+            continue;
+        ddX[k] += w(k) * Qsym;
+        ddU[k] += w(k) * Rsym;
+    }
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 void TermQuadratic<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::loadConfigFile(const std::string& filename,
     const std::string& termName,
@@ -128,6 +128,63 @@ TermSmoothAbs<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateControlDerivati
     return control_state_matrix_t::Zero();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermSmoothAbs<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    scalar_horizon_t& cost)
+{
+    const auto xAbs = ((X.colwise() - x_ref_).array().square() + alphaSquared_).sqrt();
+    const auto uAbs = ((U.colwise() - u_ref_).array().square() + alphaSquared_).sqrt();
+
+    cost.array() +=
+        w.array() * ((a_.transpose() * xAbs.matrix()) + (b_.transpose() * uAbs.matrix())).transpose().array();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermSmoothAbs<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::firstDerivativesHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    state_horizon_t& dX,
+    control_horizon_t& dU)
+{
+    const Eigen::Array<SCALAR_EVAL, STATE_DIM, Eigen::Dynamic> xDiff = (X.colwise() - x_ref_).array();
+    const Eigen::Array<SCALAR_EVAL, CONTROL_DIM, Eigen::Dynamic> uDiff = (U.colwise() - u_ref_).array();
+
+    dX.array() += ((xDiff / (xDiff.square() + alphaSquared_).sqrt()).colwise() * a_.array()).rowwise() *
+                  w.transpose().array();
+    dU.array() += ((uDiff / (uDiff.square() + alphaSquared_).sqrt()).colwise() * b_.array()).rowwise() *
+                  w.transpose().array();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermSmoothAbs<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::secondDerivativesHorizon(const state_horizon_t& X,
+    const control_horizon_t& U,
+    const scalar_horizon_t& t,
+    const scalar_horizon_t& w,
+    state_matrix_horizon_t& ddX,
+    control_matrix_horizon_t& ddU,
+    control_state_matrix_horizon_t& ddUX)
+{
+    // the second order derivatives are diagonal, compute all diagonals at once
+    const Eigen::Array<SCALAR_EVAL, STATE_DIM, Eigen::Dynamic> xDiag =
+        (((X.colwise() - x_ref_).array().square() + alphaSquared_).pow(-1.5).colwise() * a_.array()) *
+        alphaSquared_;
+    const Eigen::Array<SCALAR_EVAL, CONTROL_DIM, Eigen::Dynamic> uDiag =
+        (((U.colwise() - u_ref_).array().square() + alphaSquared_).pow(-1.5).colwise() * b_.array()) *
+        alphaSquared_;
+
+    for (int k = 0; k < X.cols(); k++)
+    {
+        if (w(k) == SCALAR_EVAL(0.0))
+            continue;
+        ddX[k].diagonal() += w(k) * xDiag.col(k).matrix();
+        ddU[k].diagonal() += w(k) * uDiag.col(k).matrix();
+    }
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 void TermSmoothAbs<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::loadConfigFile(const std::string& filename,
     const std::string& termName,
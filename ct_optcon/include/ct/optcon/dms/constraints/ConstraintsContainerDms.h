@@ -11,6 +11,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <ct/optcon/dms/dms_core/DmsDimensions.h>
 #include <ct/optcon/dms/dms_core/OptVectorDms.h>
 #include <ct/optcon/dms/dms_core/ShotContainer.h>
+#include <ct/optcon/dms/dms_core/ShotScheduler.h>
 
 #include <ct/optcon/nlp/DiscreteConstraintBase.h>
 #include <ct/optcon/nlp/DiscreteConstraintContainerBase.h>
@@ -58,13 +59,15 @@ public:
 	 * @param[in]  constraintsFinal         The final constraints
 	 * @param[in]  x0                       The initial state
 	 * @param[in]  settings                 The dms settings
+	 * @param[in]  shotScheduler            The thread pool for the shots, OpenMP is used if not set
 	 */
     ConstraintsContainerDms(std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w,
         std::shared_ptr<tpl::TimeGrid<SCALAR>> timeGrid,
         std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotContainers,
         std::shared_ptr<ConstraintDiscretizer<STATE_DIM, CONTROL_DIM, SCALAR>> discretizedConstraints,
         const state_vector_t& x0,
-        const DmsSettings settings);
+        const DmsSettings settings,
+        std::shared_ptr<ShotScheduler> shotScheduler = nullptr);
 
     /**
 	 * @brief      Destructor
@@ -87,6 +90,10 @@ private:
 
     std::shared_ptr<InitStateConstraint<STATE_DIM, CONTROL_DIM, SCALAR>> c_init_;
     std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotContainers_;
+
+    std::shared_ptr<ShotScheduler> shotScheduler_;
+    ShotScheduler::Workload integrationWorkload_;
+    ShotScheduler::Workload sensitivityWorkload_;
 };
 
 #include "implementation/ConstraintsContainerDms-impl.h"
@@ -10,8 +10,9 @@ ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>::ConstraintsContainerDms
     std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotContainers,
     std::shared_ptr<ConstraintDiscretizer<STATE_DIM, CONTROL_DIM, SCALAR>> discretizedConstraints,
     const state_vector_t& x0,
-    const DmsSettings settings)
-    : settings_(settings), shotContainers_(shotContainers)
+    const DmsSettings settings,
+    std::shared_ptr<ShotScheduler> shotScheduler)
+    : settings_(settings), shotContainers_(shotContainers), shotScheduler_(shotScheduler)
 {
     c_init_ = std::shared_ptr<InitStateConstraint<STATE_DIM, CONTROL_DIM, SCALAR>>(
         new InitStateConstraint<STATE_DIM, CONTROL_DIM, SCALAR>(x0, w));
@@ -37,6 +38,13 @@ ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>::ConstraintsContainerDms
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>::prepareEvaluation()
 {
+    if (shotScheduler_)
+    {
+        shotScheduler_->run(shotContainers_.size(), integrationWorkload_,
+            [this](size_t shotNr) { return shotContainers_[shotNr]->integrateShot(); });
+        return;
+    }
+
 #pragma omp parallel for num_threads(settings_.nThreads_)
     for (auto shotContainer = shotContainers_.begin(); shotContainer < shotContainers_.end(); ++shotContainer)
     {
@@ -47,6 +55,13 @@ void ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>::prepareEvaluation(
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>::prepareJacobianEvaluation()
 {
+    if (shotScheduler_)
+    {
+        shotScheduler_->run(shotContainers_.size(), sensitivityWorkload_,
+            [this](size_t shotNr) { return shotContainers_[shotNr]->integrateSensitivities(); });
+        return;
+    }
+
 #pragma omp parallel for num_threads(settings_.nThreads_)
     for (auto shotContainer = shotContainers_.begin(); shotContainer < shotContainers_.end(); ++shotContainer)
     {
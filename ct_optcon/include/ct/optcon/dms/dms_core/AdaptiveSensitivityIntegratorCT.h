@@ -0,0 +1,434 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+
+/**
+ * @brief      Integrates a controlled system, its sensitivities and a cost
+ *             function with an adaptive Dormand-Prince 5(4) scheme
+ *
+ *             State, sensitivities and cost are integrated as one augmented
+ *             system in a single pass. The step size is controlled by the
+ *             error estimate of the state only, hence the accepted steps do
+ *             not depend on whether sensitivities or costs are requested:
+ *             for the same initial state, controls and initial step size, a
+ *             pass with sensitivities reproduces the states of a pass without.
+ *
+ *             The accepted steps are stored together with the coefficients of
+ *             the continuous extension of the scheme, such that the state can
+ *             be evaluated at any time of the integration interval.
+ *
+ * @tparam     STATE_DIM    The state dimension
+ * @tparam     CONTROL_DIM  The control dimension
+ * @tparam     SCALAR       The scalar type
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class AdaptiveSensitivityIntegratorCT
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    typedef ct::core::StateVector<STATE_DIM, SCALAR> state_vector;
+    typedef ct::core::ControlVector<CONTROL_DIM, SCALAR> control_vector;
+    typedef Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM> state_matrix;
+    typedef Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM> control_matrix;
+    typedef Eigen::Matrix<SCALAR, STATE_DIM, CONTROL_DIM> state_control_matrix;
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> augmented_vector;
+    typedef Eigen::Matrix<SCALAR, STATE_DIM, 5> dense_coefficients;
+
+
+    /**
+     * @brief      Constructor
+     *
+     * @param[in]  system        The controlled system
+     * @param[in]  linearSystem  The linearized system, used for the sensitivities
+     * @param[in]  absErrTol     The absolute error tolerance
+     * @param[in]  relErrTol     The relative error tolerance
+     */
+    AdaptiveSensitivityIntegratorCT(
+        const std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>>& system,
+        const std::shared_ptr<ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, SCALAR>>& linearSystem,
+        const SCALAR absErrTol,
+        const SCALAR relErrTol)
+        : controlledSystem_(system),
+          linearSystem_(linearSystem),
+          absErrTol_(absErrTol),
+          relErrTol_(relErrTol),
+          firstStepSize_(SCALAR(0.0)),
+          nRejectedSteps_(0)
+    {
+    }
+
+    /**
+     * @brief      Sets the cost function which gets integrated along the state
+     *
+     * @param[in]  costFun  The cost function
+     */
+    void setCostFunction(const std::shared_ptr<CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>> costFun)
+    {
+        costFunction_ = costFun;
+    }
+
+    /**
+     * @brief      Integrates the system from startTime to endTime
+     *
+     * @param[in]  x0                 The initial state
+     * @param[in]  startTime          The start time
+     * @param[in]  endTime            The end time
+     * @param[in]  dtInitial          The size of the first trial step
+     * @param[in]  sensitivities      Integrate the sensitivities with respect
+     *                                to the initial state and control
+     * @param[in]  sensitivityUf      Integrate the sensitivity with respect to
+     *                                the final control
+     * @param[in]  cost               Integrate the cost function, and its
+     *                                sensitivities if sensitivities is set
+     */
+    void integrate(const state_vector& x0,
+        const SCALAR startTime,
+        const SCALAR endTime,
+        const SCALAR dtInitial,
+        const bool sensitivities,
+        const bool sensitivityUf,
+        const bool cost)
+    {
+        if (cost && !costFunction_)
+            throw std::runtime_error("AdaptiveSensitivityIntegratorCT: no cost function set");
+
+        setLayout(sensitivities, sensitivityUf, cost);
+
+        augmented_vector z = augmented_vector::Zero(size_);
+        z.head(STATE_DIM) = x0;
+        if (sensitivities_)
+            mapSx(z).setIdentity();
+
+        stepTimes_.clear();
+        stepSizes_.clear();
+        denseCoefficients_.clear();
+        nRejectedSteps_ = 0;
+        firstStepSize_ = SCALAR(0.0);
+
+        SCALAR t = startTime;
+        SCALAR h = std::min(dtInitial, endTime - startTime);
+        SCALAR facMax = SCALAR(5.0);
+
+        computeDerivative(z, t, k1_);
+
+        while (endTime - t > SCALAR(1e-12) * std::max(SCALAR(1.0), std::abs(endTime)))
+        {
+            if (h < SCALAR(1e-14) * std::max(SCALAR(1.0), std::abs(t)))
+                throw std::runtime_error("AdaptiveSensitivityIntegratorCT: step size too small");
+
+            if (stepTimes_.size() + nRejectedSteps_ > maxNumSteps_)
+                throw std::runtime_error("AdaptiveSensitivityIntegratorCT: maximum number of steps exceeded");
+
+            // do not overshoot and avoid a tiny final step
+            if (t + SCALAR(1.01) * h >= endTime)
+                h = endTime - t;
+
+            doStep(z, t, h, zNew_);
+
+            const SCALAR err = errorNorm(z, zNew_, h);
+
+            if (err <= SCALAR(1.0))
+            {
+                storeStep(z, zNew_, t, h);
+
+                t += h;
+                z.swap(zNew_);
+                k1_.swap(k7_);  // first same as last
+
+                SCALAR fac = (err > SCALAR(0.0)) ? safety_ * std::pow(err, SCALAR(-0.2)) : facMax;
+                h *= std::min(facMax, std::max(facMin_, fac));
+                facMax = SCALAR(5.0);
+
+                if (stepTimes_.size() == 1)
+                    firstStepSize_ = h;
+            }
+            else
+            {
+                nRejectedSteps_++;
+                h *= std::max(facMin_, safety_ * std::pow(err, SCALAR(-0.2)));
+                facMax = SCALAR(1.0);  // no increase directly after a rejection
+            }
+        }
+
+        endTime_ = t;
+        zFinal_ = z;
+    }
+
+    /**
+     * @brief      Evaluates the continuous extension of the last integration
+     *
+     * @param[in]  t     The time, inside the last integration interval
+     *
+     * @return     The interpolated state
+     */
+    state_vector evaluateDenseOutput(const SCALAR t) const
+    {
+        if (stepTimes_.empty())
+            return zFinal_.head(STATE_DIM);
+
+        // find the last step starting before t
+        auto it = std::upper_bound(stepTimes_.begin(), stepTimes_.end(), t);
+        size_t i = (it == stepTimes_.begin()) ? 0 : (it - stepTimes_.begin()) - 1;
+
+        const SCALAR theta = std::min(SCALAR(1.0), std::max(SCALAR(0.0), (t - stepTimes_[i]) / stepSizes_[i]));
+        const SCALAR theta1 = SCALAR(1.0) - theta;
+        const dense_coefficients& r = denseCoefficients_[i];
+
+        return r.col(0) + theta * (r.col(1) + theta1 * (r.col(2) + theta * (r.col(3) + theta1 * r.col(4))));
+    }
+
+    //! the final state of the last integration
+    state_vector getState() const { return zFinal_.head(STATE_DIM); }
+    //! the sensitivity of the final state with respect to the initial state
+    state_matrix getdXdX0() const { return mapSx(zFinal_); }
+    //! the sensitivity of the final state with respect to the initial control
+    state_control_matrix getdXdU0() const { return mapSu0(zFinal_); }
+    //! the sensitivity of the final state with respect to the final control
+    state_control_matrix getdXdUf() const { return mapSuf(zFinal_); }
+    //! the integrated cost
+    SCALAR getCost() const { return zFinal_(offsetCost_); }
+    //! the sensitivity of the integrated cost with respect to the initial state
+    state_vector getCostdX0() const { return zFinal_.segment(offsetCostX0_, STATE_DIM); }
+    //! the sensitivity of the integrated cost with respect to the initial control
+    control_vector getCostdU0() const { return zFinal_.segment(offsetCostU0_, CONTROL_DIM); }
+    //! the sensitivity of the integrated cost with respect to the final control
+    control_vector getCostdUf() const { return zFinal_.segment(offsetCostUf_, CONTROL_DIM); }
+    //! the step size proposed after the first accepted step, a good first trial step for a similar integration
+    SCALAR getFirstStepSize() const { return firstStepSize_; }
+    //! the number of accepted steps of the last integration
+    size_t getNumAcceptedSteps() const { return stepTimes_.size(); }
+    //! the number of rejected steps of the last integration
+    size_t getNumRejectedSteps() const { return nRejectedSteps_; }
+    //! the end time of the last integration
+    SCALAR getEndTime() const { return endTime_; }
+
+private:
+    typedef Eigen::Map<state_matrix> state_matrix_map;
+    typedef Eigen::Map<const state_matrix> state_matrix_const_map;
+    typedef Eigen::Map<state_control_matrix> state_control_matrix_map;
+    typedef Eigen::Map<const state_control_matrix> state_control_matrix_const_map;
+
+    //! sets the offsets of the blocks in the augmented vector
+    void setLayout(const bool sensitivities, const bool sensitivityUf, const bool cost)
+    {
+        sensitivities_ = sensitivities;
+        sensitivityUf_ = sensitivities && sensitivityUf;
+        cost_ = cost;
+
+        size_t offset = STATE_DIM;
+        offsetSx_ = offset;
+        offset += sensitivities_ ? STATE_DIM * STATE_DIM : 0;
+        offsetSu0_ = offset;
+        offset += sensitivities_ ? STATE_DIM * CONTROL_DIM : 0;
+        offsetSuf_ = offset;
+        offset += sensitivityUf_ ? STATE_DIM * CONTROL_DIM : 0;
+        offsetCost_ = offset;
+        offset += cost_ ? 1 : 0;
+        offsetCostX0_ = offset;
+        offset += (cost_ && sensitivities_) ? STATE_DIM : 0;
+        offsetCostU0_ = offset;
+        offset += (cost_ && sensitivities_) ? CONTROL_DIM : 0;
+        offsetCostUf_ = offset;
+        offset += (cost_ && sensitivityUf_) ? CONTROL_DIM : 0;
+        size_ = offset;
+
+        for (augmented_vector* k : {&k1_, &k2_, &k3_, &k4_, &k5_, &k6_, &k7_, &zStage_, &zNew_})
+            k->resize(size_);
+    }
+
+    state_matrix_map mapSx(augmented_vector& z) const { return state_matrix_map(z.data() + offsetSx_); }
+    state_matrix_const_map mapSx(const augmented_vector& z) const
+    {
+        return state_matrix_const_map(z.data() + offsetSx_);
+    }
+    state_control_matrix_map mapSu0(augmented_vector& z) const
+    {
+        return state_control_matrix_map(z.data() + offsetSu0_);
+    }
+    state_control_matrix_const_map mapSu0(const augmented_vector& z) const
+    {
+        return state_control_matrix_const_map(z.data() + offsetSu0_);
+    }
+    state_control_matrix_map mapSuf(augmented_vector& z) const
+    {
+        return state_control_matrix_map(z.data() + offsetSuf_);
+    }
+    state_control_matrix_const_map mapSuf(const augmented_vector& z) const
+    {
+        return state_control_matrix_const_map(z.data() + offsetSuf_);
+    }
+
+    //! right hand side of the augmented system
+    void computeDerivative(const augmented_vector& z, const SCALAR t, augmented_vector& dz)
+    {
+        const state_vector x = z.head(STATE_DIM);
+
+        control_vector u;
+        controlledSystem_->getController()->computeControl(x, t, u);
+
+        state_vector dx;
+        controlledSystem_->computeControlledDynamics(x, t, u, dx);
+        dz.head(STATE_DIM) = dx;
+
+        control_matrix dUdU0;
+        control_matrix dUdUf;
+        if (sensitivities_)
+        {
+            const state_matrix A = linearSystem_->getDerivativeState(x, u, t);
+            const state_control_matrix B = linearSystem_->getDerivativeControl(x, u, t);
+            dUdU0 = controlledSystem_->getController()->getDerivativeU0(x, t);
+
+            mapSx(dz).noalias() = A * mapSx(z);
+            mapSu0(dz).noalias() = A * mapSu0(z) + B * dUdU0;
+
+            if (sensitivityUf_)
+            {
+                dUdUf = controlledSystem_->getController()->getDerivativeUf(x, t);
+                mapSuf(dz).noalias() = A * mapSuf(z) + B * dUdUf;
+            }
+        }
+
+        if (cost_)
+        {
+            costFunction_->setCurrentStateAndControl(x, u, t);
+            dz(offsetCost_) = costFunction_->evaluateIntermediate();
+
+            if (sensitivities_)
+            {
+                const state_vector dLdx = costFunction_->stateDerivativeIntermediate();
+                const control_vector dLdu = costFunction_->controlDerivativeIntermediate();
+
+                dz.segment(offsetCostX0_, STATE_DIM).noalias() = mapSx(z).transpose() * dLdx;
+                dz.segment(offsetCostU0_, CONTROL_DIM).noalias() =
+                    mapSu0(z).transpose() * dLdx + dUdU0.transpose() * dLdu;
+
+                if (sensitivityUf_)
+                    dz.segment(offsetCostUf_, CONTROL_DIM).noalias() =
+                        mapSuf(z).transpose() * dLdx + dUdUf.transpose() * dLdu;
+            }
+        }
+    }
+
+    //! one Dormand-Prince step, expects k1_ to hold the derivative at (z, t) and leaves the derivative at zNew in k7_
+    void doStep(const augmented_vector& z, const SCALAR t, const SCALAR h, augmented_vector& zNew)
+    {
+        zStage_ = z + h * (SCALAR(a21) * k1_);
+        computeDerivative(zStage_, t + SCALAR(c2) * h, k2_);
+        zStage_ = z + h * (SCALAR(a31) * k1_ + SCALAR(a32) * k2_);
+        computeDerivative(zStage_, t + SCALAR(c3) * h, k3_);
+        zStage_ = z + h * (SCALAR(a41) * k1_ + SCALAR(a42) * k2_ + SCALAR(a43) * k3_);
+        computeDerivative(zStage_, t + SCALAR(c4) * h, k4_);
+        zStage_ = z + h * (SCALAR(a51) * k1_ + SCALAR(a52) * k2_ + SCALAR(a53) * k3_ + SCALAR(a54) * k4_);
+        computeDerivative(zStage_, t + SCALAR(c5) * h, k5_);
+        zStage_ = z + h * (SCALAR(a61) * k1_ + SCALAR(a62) * k2_ + SCALAR(a63) * k3_ + SCALAR(a64) * k4_ +
+                              SCALAR(a65) * k5_);
+        computeDerivative(zStage_, t + h, k6_);
+        zNew = z + h * (SCALAR(a71) * k1_ + SCALAR(a73) * k3_ + SCALAR(a74) * k4_ + SCALAR(a75) * k5_ +
+                           SCALAR(a76) * k6_);
+        computeDerivative(zNew, t + h, k7_);
+    }
+
+    //! scaled RMS norm of the embedded error estimate of the state
+    SCALAR errorNorm(const augmented_vector& z, const augmented_vector& zNew, const SCALAR h) const
+    {
+        const state_vector err =
+            h * (SCALAR(e1) * k1_.head(STATE_DIM) + SCALAR(e3) * k3_.head(STATE_DIM) +
+                    SCALAR(e4) * k4_.head(STATE_DIM) + SCALAR(e5) * k5_.head(STATE_DIM) +
+                    SCALAR(e6) * k6_.head(STATE_DIM) + SCALAR(e7) * k7_.head(STATE_DIM));
+        const state_vector scale =
+            (absErrTol_ + relErrTol_ * z.head(STATE_DIM).cwiseAbs().cwiseMax(zNew.head(STATE_DIM).cwiseAbs()).array())
+                .matrix();
+
+        return std::sqrt(err.cwiseQuotient(scale).squaredNorm() / SCALAR(STATE_DIM));
+    }
+
+    //! stores an accepted step and the coefficients of its continuous extension
+    void storeStep(const augmented_vector& z, const augmented_vector& zNew, const SCALAR t, const SCALAR h)
+    {
+        const state_vector x = z.head(STATE_DIM);
+        const state_vector dx = zNew.head(STATE_DIM) - x;
+        const state_vector bspl = h * k1_.head(STATE_DIM) - dx;
+
+        dense_coefficients r;
+        r.col(0) = x;
+        r.col(1) = dx;
+        r.col(2) = bspl;
+        r.col(3) = dx - h * k7_.head(STATE_DIM) - bspl;
+        r.col(4) =
+            h * (SCALAR(d1) * k1_.head(STATE_DIM) + SCALAR(d3) * k3_.head(STATE_DIM) +
+                    SCALAR(d4) * k4_.head(STATE_DIM) + SCALAR(d5) * k5_.head(STATE_DIM) +
+                    SCALAR(d6) * k6_.head(STATE_DIM) + SCALAR(d7) * k7_.head(STATE_DIM));
+
+        stepTimes_.push_back(t);
+        stepSizes_.push_back(h);
+        denseCoefficients_.push_back(r);
+    }
+
+    // Dormand-Prince 5(4) tableau
+    static constexpr double c2 = 1.0 / 5.0, c3 = 3.0 / 10.0, c4 = 4.0 / 5.0, c5 = 8.0 / 9.0;
+    static constexpr double a21 = 1.0 / 5.0;
+    static constexpr double a31 = 3.0 / 40.0, a32 = 9.0 / 40.0;
+    static constexpr double a41 = 44.0 / 45.0, a42 = -56.0 / 15.0, a43 = 32.0 / 9.0;
+    static constexpr double a51 = 19372.0 / 6561.0, a52 = -25360.0 / 2187.0, a53 = 64448.0 / 6561.0,
+                            a54 = -212.0 / 729.0;
+    static constexpr double a61 = 9017.0 / 3168.0, a62 = -355.0 / 33.0, a63 = 46732.0 / 5247.0, a64 = 49.0 / 176.0,
+                            a65 = -5103.0 / 18656.0;
+    static constexpr double a71 = 35.0 / 384.0, a73 = 500.0 / 1113.0, a74 = 125.0 / 192.0, a75 = -2187.0 / 6784.0,
+                            a76 = 11.0 / 84.0;
+    // difference between the 5th and the embedded 4th order solution
+    static constexpr double e1 = 71.0 / 57600.0, e3 = -71.0 / 16695.0, e4 = 71.0 / 1920.0, e5 = -17253.0 / 339200.0,
+                            e6 = 22.0 / 525.0, e7 = -1.0 / 40.0;
+    // continuous extension
+    static constexpr double d1 = -12715105075.0 / 11282082432.0, d3 = 87487479700.0 / 32700410799.0,
+                            d4 = -10690763975.0 / 1880347072.0, d5 = 701980252875.0 / 199316789632.0,
+                            d6 = -1453857185.0 / 822651844.0, d7 = 69997945.0 / 29380423.0;
+
+    const SCALAR safety_ = SCALAR(0.9);
+    const SCALAR facMin_ = SCALAR(0.2);
+    const size_t maxNumSteps_ = 100000;
+
+    std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>> controlledSystem_;
+    std::shared_ptr<ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, SCALAR>> linearSystem_;
+    std::shared_ptr<CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>> costFunction_;
+
+    SCALAR absErrTol_;
+    SCALAR relErrTol_;
+
+    // layout of the augmented vector
+    bool sensitivities_ = false;
+    bool sensitivityUf_ = false;
+    bool cost_ = false;
+    size_t offsetSx_ = STATE_DIM;
+    size_t offsetSu0_ = STATE_DIM;
+    size_t offsetSuf_ = STATE_DIM;
+    size_t offsetCost_ = STATE_DIM;
+    size_t offsetCostX0_ = STATE_DIM;
+    size_t offsetCostU0_ = STATE_DIM;
+    size_t offsetCostUf_ = STATE_DIM;
+    size_t size_ = STATE_DIM;
+
+    // stages and workspace
+    augmented_vector k1_, k2_, k3_, k4_, k5_, k6_, k7_;
+    augmented_vector zStage_;
+    augmented_vector zNew_;
+
+    // result of the last integration
+    augmented_vector zFinal_;
+    SCALAR endTime_;
+    SCALAR firstStepSize_;
+    size_t nRejectedSteps_;
+    std::vector<SCALAR> stepTimes_;
+    std::vector<SCALAR> stepSizes_;
+    std::vector<dense_coefficients, Eigen::aligned_allocator<dense_coefficients>> denseCoefficients_;
+};
+
+}  // namespace optcon
+}  // namespace ct
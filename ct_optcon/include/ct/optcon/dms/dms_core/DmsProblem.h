@@ -17,6 +17,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <ct/optcon/dms/dms_core/cost_evaluator/CostEvaluatorSimple.h>
 #include <ct/optcon/dms/dms_core/cost_evaluator/CostEvaluatorFull.h>
 #include <ct/optcon/dms/dms_core/DmsSettings.h>
+#include <ct/optcon/dms/dms_core/ShotScheduler.h>
 
 #include <ct/optcon/nlp/Nlp.h>
 
@@ -116,6 +117,9 @@ public:
             discretizedConstraints_->setGeneralConstraints(generalConstraints.front());
 
 
+        if (settings_.useThreadPool_ && settings_.nThreads_ > 1)
+            shotScheduler_ = std::shared_ptr<ShotScheduler>(new ShotScheduler(settings_));
+
         for (size_t shotIdx = 0; shotIdx < settings_.N_; shotIdx++)
         {
             std::shared_ptr<ControllerDms<STATE_DIM, CONTROL_DIM, SCALAR>> newController(
@@ -144,8 +148,8 @@ public:
             case DmsSettings::FULL:
             {
                 this->costEvaluator_ = std::shared_ptr<CostEvaluatorFull<STATE_DIM, CONTROL_DIM, SCALAR>>(
-                    new CostEvaluatorFull<STATE_DIM, CONTROL_DIM, SCALAR>(
-                        costPtrs.front(), optVariablesDms_, controlSpliner_, shotContainers_, settings_));
+                    new CostEvaluatorFull<STATE_DIM, CONTROL_DIM, SCALAR>(costPtrs.front(), optVariablesDms_,
+                        controlSpliner_, shotContainers_, settings_, shotScheduler_));
                 break;
             }
             default:
@@ -153,8 +157,8 @@ public:
         }
 
         this->constraints_ = std::shared_ptr<ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>>(
-            new ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>(
-                optVariablesDms_, timeGrid_, shotContainers_, discretizedConstraints_, x0, settings_));
+            new ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>(optVariablesDms_, timeGrid_, shotContainers_,
+                discretizedConstraints_, x0, settings_, shotScheduler_));
 
         this->optVariables_->resizeConstraintVars(this->getConstraintsCount());
     }
@@ -386,7 +390,22 @@ public:
 	 *
 	 * @param[in]  tf    The new time horizon
 	 */
-    void changeTimeHorizon(const SCALAR tf) { timeGrid_->changeTimeHorizon(tf); }
+    void changeTimeHorizon(const SCALAR tf)
+    {
+        timeGrid_->changeTimeHorizon(tf);
+        invalidateShots();
+    }
+
+    /**
+	 * @brief      Discards the integration results of all shots kept by
+	 *             DmsSettings::skipUnchangedShots_, e.g. after the cost
+	 *             function changed
+	 */
+    void invalidateShots()
+    {
+        for (auto shotContainer : shotContainers_)
+            shotContainer->invalidate();
+    }
     /**
 	 * @brief      Updates the initial state
 	 *
@@ -394,10 +413,26 @@ public:
 	 */
     void changeInitialState(const state_vector_t& x0)
     {
-        // constraints_->changeInitialConstraint(x0);
+        std::static_pointer_cast<ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>>(this->constraints_)
+            ->changeInitialConstraint(x0);
         optVariablesDms_->changeInitialState(x0);
     }
 
+    /**
+	 * @brief      Uses the previous solution as initial guess for the next
+	 *             solve
+	 *
+	 * @param[in]  nShots  The number of shots the solution is shifted towards
+	 *                     the start of the horizon
+	 */
+    void prepareWarmStart(const size_t nShots)
+    {
+        if (nShots > 0)
+            optVariablesDms_->shiftSolution(nShots);
+        else
+            optVariablesDms_->setSolutionAsInitialGuess();
+    }
+
     /**
 	 * @brief      Prints the solution trajectories
 	 */
@@ -411,6 +446,7 @@ private:
     std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> optVariablesDms_;
     std::shared_ptr<SplinerBase<control_vector_t, SCALAR>> controlSpliner_;
     std::shared_ptr<tpl::TimeGrid<SCALAR>> timeGrid_;
+    std::shared_ptr<ShotScheduler> shotScheduler_;
 
     state_vector_array_t stateSolutionDense_;
     control_vector_array_t inputSolutionDense_;
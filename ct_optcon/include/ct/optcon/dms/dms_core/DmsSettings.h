@@ -37,6 +37,8 @@ public:
         : N_(30),
           T_(5),
           nThreads_(1),
+          useThreadPool_(false),
+          pinThreads_(false),
           splineType_(ZERO_ORDER_HOLD),
           costEvaluationType_(SIMPLE),
           objectiveType_(KEEP_TIME_AND_GRID),
@@ -44,21 +46,25 @@ public:
           integrationType_(RK4),
           dt_sim_(0.01),
           absErrTol_(1e-10),
-          relErrTol_(1e-10)
+          relErrTol_(1e-10),
+          skipUnchangedShots_(false)
     {
     }
 
     size_t N_;                                 // the number of shots
     double T_;                                 // the time horizon
     size_t nThreads_;                          // number of threads
+    bool useThreadPool_;                       // use a persistent thread pool instead of OpenMP for the shots
+    bool pinThreads_;                          // pin the threads of the pool to fixed cores (Linux only)
     SplineType_t splineType_;                  // spline interpolation type between the nodes
     CostEvaluationType_t costEvaluationType_;  // the the of costevaluator
     ObjectiveType_t objectiveType_;            // Timegrid optimization on(expensive) or off?
     double h_min_;                             // minimum admissible distance between two nodes in [sec]
     IntegrationType_t integrationType_;        // the integration type between the nodes
-    double dt_sim_;                            // and the corresponding integration timestep
+    double dt_sim_;                            // and the corresponding integration timestep, initial step for RK5
     double absErrTol_;                         // the absolute and relative integrator tolerances when using RK5
     double relErrTol_;
+    bool skipUnchangedShots_;                  // do not re-integrate shots whose decision variables did not change
 
     NlpSolverSettings solverSettings_;
     ct::core::DerivativesCppadSettings cppadSettings_;
@@ -72,11 +78,15 @@ public:
         std::cout << "Shooting intervals N : " << N_ << std::endl;
         std::cout << "Total Time horizon: " << T_ << "s" << std::endl;
         std::cout << "Number of threads: " << nThreads_ << std::endl;
+        std::cout << "Thread pool: " << useThreadPool_ << ", pinned: " << pinThreads_ << std::endl;
         std::cout << "Splinetype: " << splineToString[splineType_] << std::endl;
         std::cout << "Cost eval: " << costEvalToString[costEvaluationType_] << std::endl;
         std::cout << "Objective type: " << objTypeToString[objectiveType_] << std::endl;
         std::cout << "Integration type: " << integratorToString[integrationType_] << std::endl;
         std::cout << "Simulation timestep dt_sim: " << dt_sim_ << std::endl;
+        if (integrationType_ == RK5)
+            std::cout << "Integrator tolerances abs/rel: " << absErrTol_ << " / " << relErrTol_ << std::endl;
+        std::cout << "Skip unchanged shots: " << skipUnchangedShots_ << std::endl;
 
         std::cout << "=============================================================" << std::endl;
 
@@ -132,6 +142,8 @@ public:
         N_ = pt.get<unsigned int>(ns + ".N");
         T_ = pt.get<double>(ns + ".T");
         nThreads_ = pt.get<unsigned int>(ns + ".nThreads");
+        useThreadPool_ = pt.get<bool>(ns + ".UseThreadPool", false);
+        pinThreads_ = pt.get<bool>(ns + ".PinThreads", false);
         splineType_ = static_cast<SplineType_t>(pt.get<unsigned int>(ns + ".InterpolationType"));
         costEvaluationType_ = static_cast<CostEvaluationType_t>(pt.get<unsigned int>(ns + ".CostEvaluationType"));
         objectiveType_ = static_cast<ObjectiveType_t>(pt.get<unsigned int>(ns + ".ObjectiveType"));
@@ -141,6 +153,7 @@ public:
         dt_sim_ = pt.get<double>(ns + ".dt_sim");
         absErrTol_ = pt.get<double>(ns + ".AbsErrTol");
         relErrTol_ = pt.get<double>(ns + ".RelErrTol");
+        skipUnchangedShots_ = pt.get<bool>(ns + ".SkipUnchangedShots", false);
 
         solverSettings_.load(filename, verbose, ns + ".solver");  // todo bring in again
         cppadSettings_.load(filename, verbose, ns + ".cppad");
@@ -91,7 +91,7 @@ public:
 	 * @param[in]  settingsDms  The dms settings
 	 */
     DmsSolver(const ContinuousOptConProblem<STATE_DIM, CONTROL_DIM, SCALAR> problem, DmsSettings settingsDms)
-        : nlpSolver_(nullptr), settings_(settingsDms)
+        : nlpSolver_(nullptr), settings_(settingsDms), hasSolution_(false)
     {
         // Create system, linearsystem and costfunction instances
         this->setProblem(problem);
@@ -162,7 +162,29 @@ public:
         if (!nlpSolver_->isInitialized())
             nlpSolver_->configure(settings_.solverSettings_);
 
-        return nlpSolver_->solve();
+        hasSolution_ = nlpSolver_->solve();
+        return hasSolution_;
+    }
+
+    /**
+	 * @brief      Solves the problem again, warm started from the previous
+	 *             solution, e.g. after changeInitialState() in MPC-like
+	 *             repeated solves. Set the persistentSolver_ IPOPT setting to
+	 *             also keep the IPOPT instance, sparsity patterns and scaling.
+	 *
+	 * @param[in]  nShots  The number of shots the previous solution is shifted
+	 *                     towards the start of the horizon
+	 *
+	 * @return     Returns true if the solve succeeded
+	 */
+    bool resolve(const size_t nShots = 0)
+    {
+        if (!hasSolution_)
+            return solve();
+
+        dmsProblem_->prepareWarmStart(nShots);
+        hasSolution_ = nlpSolver_->resolve();
+        return hasSolution_;
     }
 
     const Policy_t& getSolution() override
@@ -211,6 +233,9 @@ public:
         if (cf)
             for (size_t i = 0; i < settings_.N_; i++)
                 this->getCostFunctionInstances()[i] = typename Base::OptConProblem_t::CostFunctionPtr_t(cf->clone());
+
+        if (dmsProblem_)
+            dmsProblem_->invalidateShots();
     }
 
     void changeNonlinearSystem(const typename Base::OptConProblem_t::DynamicsPtr_t& dyn) override
@@ -289,6 +314,7 @@ private:
     std::shared_ptr<DmsProblem<STATE_DIM, CONTROL_DIM, SCALAR>> dmsProblem_; /*!<The dms problem*/
     std::shared_ptr<tpl::NlpSolver<SCALAR>> nlpSolver_; /*!<The nlp solver for solving the dmsproblem*/
     DmsSettings settings_;                              /*!<The dms settings*/
+    bool hasSolution_;                                  /*!<The last solve succeeded, its solution can warm start*/
 
     Policy_t policy_; /*!<The solution container*/
 
@@ -41,6 +41,7 @@ public:
 
     typedef DmsDimensions<STATE_DIM, CONTROL_DIM, SCALAR> DIMENSIONS;
     typedef tpl::OptVector<SCALAR> Base;
+    typedef typename Base::VectorXs VectorXs;
 
     typedef typename DIMENSIONS::state_vector_t state_vector_t;
     typedef typename DIMENSIONS::control_vector_t control_vector_t;
@@ -150,6 +151,19 @@ public:
      */
     void changeDesiredState(const state_vector_t& xF);
 
+    /**
+     * @brief      Sets the previous solution, shifted towards the start of
+     *             the horizon, as initial guess for the next solve, e.g. if
+     *             the initial time advanced by some shots on an equidistant
+     *             time grid. The last pair is repeated at the end of the
+     *             horizon. The bound multipliers and the multipliers of the
+     *             initial state and continuity constraints are shifted alike.
+     *             The current initial state is kept.
+     *
+     * @param[in]  nShots  The number of shots to shift
+     */
+    void shiftSolution(const size_t nShots);
+
     /**
      * @brief      Returns the number of pairs 
      *
@@ -9,6 +9,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <functional>
 
 #include "SensitivityIntegratorCT.h"
+#include "AdaptiveSensitivityIntegratorCT.h"
 
 #include <ct/optcon/costfunction/CostFunctionQuadratic.hpp>
 
@@ -25,6 +26,17 @@ namespace optcon {
  * @brief      This class performs the state and the sensitivity integration on
  *             a shot
  *
+ *             With DmsSettings::RK5, the shot is integrated with an adaptive
+ *             Dormand-Prince scheme. The first step size of a shot is kept
+ *             across NLP iterations and the state trajectory at the dt_sim
+ *             grid is obtained from the continuous extension of the scheme.
+ *
+ *             With DmsSettings::skipUnchangedShots_, a shot whose initial
+ *             state, controls and time interval did not change since the
+ *             last update of the optimization vector keeps its previous
+ *             integration results. Call invalidate() if anything else the
+ *             results depend on changes, e.g. the cost function.
+ *
  * @tparam     STATE_DIM    The state dimension
  * @tparam     CONTROL_DIM  The control dimension
  */
@@ -79,6 +91,8 @@ public:
           timeGrid_(timeGrid),
           shotNr_(shotNr),
           settings_(settings),
+          checkedUpdateCount_(0),
+          inputVersion_(0),
           integrationCount_(0),
           costIntegrationCount_(0),
           sensIntegrationCount_(0),
@@ -86,7 +100,9 @@ public:
           cost_(SCALAR(0.0)),
           discreteQ_(state_vector_t::Zero()),
           discreteR_(control_vector_t::Zero()),
-          discreteRNext_(control_vector_t::Zero())
+          discreteRNext_(control_vector_t::Zero()),
+          dtAdaptive_(SCALAR(settings.dt_sim_)),
+          dtAdaptiveIterate_(SCALAR(settings.dt_sim_))
     {
         if (shotNr_ >= settings.N_)
             throw std::runtime_error("Dms Shot Integrator: shot index >= settings.N_ - check your settings.");
@@ -111,7 +127,8 @@ public:
             }
             case DmsSettings::RK5:
             {
-                throw std::runtime_error("Currently we do not support adaptive integrators in dms");
+                initializeAdaptiveIntegrator(std::is_floating_point<SCALAR>());
+                break;
             }
 
             default:
@@ -122,51 +139,99 @@ public:
         }
 
         tStart_ = timeGrid_->getShotStartTime(shotNr_);
-        // SCALAR t_shot_end = timeGrid_->getShotEndTime(shotNr_);
+        tEnd_ = timeGrid_->getShotEndTime(shotNr_);
 
         // +0.5 needed to avoid rounding errors from double to size_t
         nSteps_ = nIntegrationSteps;
         // std::cout << "shotNr_: " << shotNr_ << "\t nSteps: " << nSteps_ << std::endl;
 
-        integratorCT_->setLinearSystem(linearSystem_);
+        if (integratorAdaptive_)
+        {
+            if (settings_.costEvaluationType_ == DmsSettings::FULL)
+                integratorAdaptive_->setCostFunction(costFct_);
+        }
+        else
+        {
+            integratorCT_->setLinearSystem(linearSystem_);
 
-        if (settings_.costEvaluationType_ == DmsSettings::FULL)
-            integratorCT_->setCostFunction(costFct_);
+            if (settings_.costEvaluationType_ == DmsSettings::FULL)
+                integratorCT_->setCostFunction(costFct_);
+        }
     }
 
     /**
 	 * @brief      Performs the state integration between the shots
+	 *
+	 * @return     false if the result of a previous call was still valid
 	 */
-    void integrateShot()
+    bool integrateShot()
     {
-        if ((w_->getUpdateCount() != integrationCount_))
+        if ((updateInputVersion() != integrationCount_))
         {
-            integrationCount_ = w_->getUpdateCount();
+            updateTimeInterval(std::is_floating_point<SCALAR>());
+
+            if (integratorAdaptive_)
+            {
+                integrateAdaptive(false);
+                return true;
+            }
+
+            integrationCount_ = inputVersion_;
             state_vector_t initState = w_->getOptimizedState(shotNr_);
+            integratorCT_->clearSensitivities();
             integratorCT_->integrate(
                 initState, tStart_, nSteps_, SCALAR(settings_.dt_sim_), stateSubsteps_, timeSubsteps_);
+            return true;
         }
+        return false;
     }
 
-    void integrateCost()
+    /**
+	 * @brief      Integrates the cost along the shot
+	 *
+	 * @return     false if the result of a previous call was still valid
+	 */
+    bool integrateCost()
     {
-        if ((w_->getUpdateCount() != costIntegrationCount_))
+        if ((updateInputVersion() != costIntegrationCount_))
         {
-            costIntegrationCount_ = w_->getUpdateCount();
+            if (integratorAdaptive_)
+            {
+                // the cost is integrated along the state
+                integrateShot();
+                costIntegrationCount_ = inputVersion_;
+                cost_ = integratorAdaptive_->getCost();
+                return true;
+            }
+
+            costIntegrationCount_ = inputVersion_;
             integrateShot();
+            updateTimeInterval(std::is_floating_point<SCALAR>());
             cost_ = SCALAR(0.0);
             integratorCT_->integrateCost(cost_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
+            return true;
         }
+        return false;
     }
 
     /**
 	 * @brief      Performs the state and the sensitivity integration between the shots
+	 *
+	 * @return     false if the result of a previous call was still valid
 	 */
-    void integrateSensitivities()
+    bool integrateSensitivities()
     {
-        if ((w_->getUpdateCount() != sensIntegrationCount_))
+        if ((updateInputVersion() != sensIntegrationCount_))
         {
-            sensIntegrationCount_ = w_->getUpdateCount();
+            updateTimeInterval(std::is_floating_point<SCALAR>());
+
+            if (integratorAdaptive_)
+            {
+                integrateAdaptive(true);
+                return true;
+            }
+
+            sensIntegrationCount_ = inputVersion_;
             integrateShot();
             discreteA_.setIdentity();
             discreteB_.setZero();
@@ -179,15 +244,31 @@ public:
                 discreteBNext_.setZero();
                 integratorCT_->integrateSensitivityDUf(discreteBNext_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
             }
+            return true;
         }
+        return false;
     }
 
-    void integrateCostSensitivities()
+    /**
+	 * @brief      Integrates the cost sensitivities along the shot
+	 *
+	 * @return     false if the result of a previous call was still valid
+	 */
+    bool integrateCostSensitivities()
     {
-        if ((w_->getUpdateCount() != costSensIntegrationCount_))
+        if ((updateInputVersion() != costSensIntegrationCount_))
         {
-            costSensIntegrationCount_ = w_->getUpdateCount();
+            if (integratorAdaptive_)
+            {
+                // the cost sensitivities are integrated along the state sensitivities
+                integrateSensitivities();
+                costSensIntegrationCount_ = inputVersion_;
+                return true;
+            }
+
+            costSensIntegrationCount_ = inputVersion_;
             integrateSensitivities();
+            updateTimeInterval(std::is_floating_point<SCALAR>());
             discreteQ_.setZero();
             discreteR_.setZero();
             integratorCT_->integrateCostSensitivityDX0(discreteQ_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
@@ -198,16 +279,36 @@ public:
                 discreteRNext_.setZero();
                 integratorCT_->integrateCostSensitivityDUf(discreteRNext_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
             }
+            return true;
         }
+        return false;
     }
 
     void reset()
     {
+        if (!integratorCT_)
+            return;
+
+        // the caches of a skipped shot are needed to compute its sensitivities later
+        if (settings_.skipUnchangedShots_ && updateInputVersion() == integrationCount_)
+            return;
+
         integratorCT_->clearStates();
         integratorCT_->clearSensitivities();
         integratorCT_->clearLinearization();
     }
 
+    /**
+	 * @brief      Discards all integration results of this shot, e.g. after
+	 *             the cost function changed. Only needed with
+	 *             DmsSettings::skipUnchangedShots_.
+	 */
+    void invalidate()
+    {
+        inputVersion_++;
+        lastInputs_.resize(0);
+    }
+
     /**
 	 * @brief      Returns the integrated state
 	 *
@@ -317,8 +418,156 @@ public:
     // 	return costGradientHi_;
     // }
 
+    /**
+	 * @brief      Returns the adaptive integrator, only available with DmsSettings::RK5
+	 *
+	 * @return     The adaptive integrator
+	 */
+    const std::shared_ptr<AdaptiveSensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>>& getAdaptiveIntegrator()
+        const
+    {
+        return integratorAdaptive_;
+    }
+
 
 private:
+    void initializeAdaptiveIntegrator(std::true_type)
+    {
+        integratorAdaptive_ = std::allocate_shared<AdaptiveSensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>,
+            Eigen::aligned_allocator<AdaptiveSensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>>>(
+            Eigen::aligned_allocator<AdaptiveSensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>>(),
+            controlledSystem_, linearSystem_, SCALAR(settings_.absErrTol_), SCALAR(settings_.relErrTol_));
+    }
+
+    void initializeAdaptiveIntegrator(std::false_type)
+    {
+        throw std::runtime_error("Dms Shot Integrator: the adaptive integrator requires a floating point scalar type");
+    }
+
+    /**
+	 * @brief      Integrates the shot with the adaptive integrator and updates all
+	 *             results which are part of the integration
+	 *
+	 * @param[in]  sensitivities  Also integrate the sensitivities
+	 */
+    void integrateAdaptive(const bool sensitivities)
+    {
+        integrateAdaptive(sensitivities, std::is_floating_point<SCALAR>());
+    }
+
+    void integrateAdaptive(const bool sensitivities, std::false_type)
+    {
+        throw std::runtime_error("Dms Shot Integrator: the adaptive integrator requires a floating point scalar type");
+    }
+
+    void integrateAdaptive(const bool sensitivities, std::true_type)
+    {
+        // a new iterate starts from the step size memory, repeated passes of the
+        // same iterate reuse its first step such that they produce the same steps
+        if (integrationCount_ != inputVersion_)
+            dtAdaptiveIterate_ = dtAdaptive_;
+
+        const bool fullCost = (settings_.costEvaluationType_ == DmsSettings::FULL);
+        const bool splineLinear = (settings_.splineType_ == DmsSettings::PIECEWISE_LINEAR);
+
+        integratorAdaptive_->integrate(w_->getOptimizedState(shotNr_), tStart_, tEnd_, dtAdaptiveIterate_,
+            sensitivities, splineLinear, fullCost);
+        dtAdaptive_ = integratorAdaptive_->getFirstStepSize();
+
+        // sample the continuous extension on the dt_sim grid
+        stateSubsteps_.clear();
+        timeSubsteps_.clear();
+        for (size_t i = 0; i < nSteps_; i++)
+        {
+            const SCALAR t = tStart_ + i * SCALAR(settings_.dt_sim_);
+            stateSubsteps_.push_back(integratorAdaptive_->evaluateDenseOutput(t));
+            timeSubsteps_.push_back(t);
+        }
+        stateSubsteps_.push_back(integratorAdaptive_->getState());
+        timeSubsteps_.push_back(integratorAdaptive_->getEndTime());
+
+        integrationCount_ = inputVersion_;
+
+        if (fullCost)
+        {
+            cost_ = integratorAdaptive_->getCost();
+            costIntegrationCount_ = inputVersion_;
+        }
+
+        if (sensitivities)
+        {
+            discreteA_ = integratorAdaptive_->getdXdX0();
+            discreteB_ = integratorAdaptive_->getdXdU0();
+            if (splineLinear)
+                discreteBNext_ = integratorAdaptive_->getdXdUf();
+
+            sensIntegrationCount_ = inputVersion_;
+
+            if (fullCost)
+            {
+                discreteQ_ = integratorAdaptive_->getCostdX0();
+                discreteR_ = integratorAdaptive_->getCostdU0();
+                if (splineLinear)
+                    discreteRNext_ = integratorAdaptive_->getCostdUf();
+
+                costSensIntegrationCount_ = inputVersion_;
+            }
+        }
+    }
+
+    /**
+	 * @brief      Returns the version of the inputs of this shot. The version
+	 *             changes with every update of the optimization vector, unless
+	 *             DmsSettings::skipUnchangedShots_ is set and the initial state,
+	 *             the controls and the time interval of this shot are unchanged
+	 *
+	 * @return     The input version
+	 */
+    size_t updateInputVersion()
+    {
+        if (w_->getUpdateCount() != checkedUpdateCount_)
+        {
+            checkedUpdateCount_ = w_->getUpdateCount();
+
+            if (!settings_.skipUnchangedShots_ || inputsChanged(std::is_floating_point<SCALAR>()))
+                inputVersion_++;
+        }
+        return inputVersion_;
+    }
+
+    //! compares the decision variables and the time interval of this shot to the ones of the last check
+    bool inputsChanged(std::true_type)
+    {
+        const bool splineLinear = (settings_.splineType_ == DmsSettings::PIECEWISE_LINEAR);
+
+        Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> inputs(STATE_DIM + (splineLinear ? 2 : 1) * CONTROL_DIM + 2);
+        inputs.head(STATE_DIM) = w_->getOptimizedState(shotNr_);
+        inputs.segment(STATE_DIM, CONTROL_DIM) = w_->getOptimizedControl(shotNr_);
+        if (splineLinear)
+            inputs.segment(STATE_DIM + CONTROL_DIM, CONTROL_DIM) = w_->getOptimizedControl(shotNr_ + 1);
+        inputs(inputs.size() - 2) = timeGrid_->getShotStartTime(shotNr_);
+        inputs(inputs.size() - 1) = timeGrid_->getShotEndTime(shotNr_);
+
+        const bool changed = (inputs.size() != lastInputs_.size()) || (inputs != lastInputs_);
+        lastInputs_ = inputs;
+        return changed;
+    }
+
+    bool inputsChanged(std::false_type) { return true; }
+
+    //! reads the time interval of this shot from the time grid, which changes e.g. with the time horizon
+    void updateTimeInterval(std::true_type)
+    {
+        tStart_ = timeGrid_->getShotStartTime(shotNr_);
+        tEnd_ = timeGrid_->getShotEndTime(shotNr_);
+
+        // +0.5 needed to avoid rounding errors from double to size_t
+        nSteps_ = (tEnd_ - tStart_) / settings_.dt_sim_ + 0.5;
+    }
+
+    //! the time grid of the code generated problem is fixed, keep the interval from the constructor
+    void updateTimeInterval(std::false_type) {}
+
     std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>> controlledSystem_;
     std::shared_ptr<ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, SCALAR>> linearSystem_;
     std::shared_ptr<ct::optcon::CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>> costFct_;
@@ -329,6 +578,10 @@ private:
     const size_t shotNr_;
     const DmsSettings settings_;
 
+    size_t checkedUpdateCount_;
+    size_t inputVersion_;
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> lastInputs_;
+
     size_t integrationCount_;
     size_t costIntegrationCount_;
     size_t sensIntegrationCount_;
@@ -351,8 +604,12 @@ private:
     control_vector_t discreteRNext_;
 
     std::shared_ptr<SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>> integratorCT_;
+    std::shared_ptr<AdaptiveSensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>> integratorAdaptive_;
+    SCALAR dtAdaptive_;         // step size memory of the adaptive integrator
+    SCALAR dtAdaptiveIterate_;  // first step size of the current iterate
     size_t nSteps_;
     SCALAR tStart_;
+    SCALAR tEnd_;
 };
 
 }  // namespace optcon
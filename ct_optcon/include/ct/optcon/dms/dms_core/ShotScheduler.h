@@ -0,0 +1,99 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <ct/core/common/ThreadPool.h>
+
+#include <ct/optcon/dms/dms_core/DmsSettings.h>
+
+namespace ct {
+namespace optcon {
+
+/**
+ * @ingroup    DMS
+ *
+ * @brief      Distributes per-shot work of DMS over a persistent set of
+ *             threads
+ *
+ *             The threads are created once and reused for every evaluation
+ *             of the NLP. The shots are handed out dynamically, longest
+ *             first, where the duration of a shot is the one measured in the
+ *             last call with the same Workload which actually computed
+ *             the shot. This keeps the threads busy even if the integration
+ *             effort differs strongly between shots, e.g. with an adaptive
+ *             integrator.
+ */
+class ShotScheduler
+{
+public:
+    /**
+	 * @brief      The per-shot timings of one kind of work, e.g. the state
+	 *             integration. Every call site keeps its own workload.
+	 */
+    struct Workload
+    {
+        std::vector<double> durations;  // duration of every shot in the last call which computed it [s]
+        std::vector<size_t> order;      // the order in which the shots are handed out
+    };
+
+    ShotScheduler() = delete;
+
+    /**
+	 * @brief      Custom constructor
+	 *
+	 * @param[in]  settings  The dms settings
+	 */
+    ShotScheduler(const DmsSettings& settings) : threadPool_(settings.nThreads_, settings.pinThreads_) {}
+    /**
+	 * @brief      Calls fun(shotNr) for all shots and returns when all calls
+	 *             have finished
+	 *
+	 * @param[in]      nShots    The number of shots
+	 * @param[in, out] workload  The timings of the previous call, updated with the current ones
+	 * @param[in]      fun       The work for one shot, returns false if a
+	 *                           cached result was used. The duration of
+	 *                           such a call is not recorded.
+	 */
+    void run(size_t nShots, Workload& workload, const std::function<bool(size_t)>& fun)
+    {
+        if (workload.durations.size() != nShots)
+        {
+            workload.durations.assign(nShots, 0.0);
+            workload.order.resize(nShots);
+            std::iota(workload.order.begin(), workload.order.end(), 0);
+        }
+        else
+        {
+            // longest shot first, ties keep the natural order
+            std::stable_sort(workload.order.begin(), workload.order.end(),
+                [&workload](size_t a, size_t b) { return workload.durations[a] > workload.durations[b]; });
+        }
+
+        threadPool_.parallelFor(nShots, [&workload, &fun](size_t i) {
+            const size_t shotNr = workload.order[i];
+            auto start = std::chrono::steady_clock::now();
+            if (fun(shotNr))
+                workload.durations[shotNr] =
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        });
+    }
+
+    //! the number of threads including the calling thread
+    size_t getNumThreads() const { return threadPool_.getNumThreads(); }
+
+private:
+    core::ThreadPool threadPool_;
+};
+
+}  // namespace optcon
+}  // namespace ct
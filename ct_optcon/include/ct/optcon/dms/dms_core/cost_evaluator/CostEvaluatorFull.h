@@ -14,6 +14,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <ct/optcon/dms/dms_core/OptVectorDms.h>
 #include <ct/optcon/dms/dms_core/ShotContainer.h>
+#include <ct/optcon/dms/dms_core/ShotScheduler.h>
 #include <ct/optcon/nlp/DiscreteCostEvaluatorBase.h>
 
 
@@ -52,13 +53,20 @@ public:
 	 * @param[in]  controlSpliner  The control spliner
 	 * @param[in]  shotInt         The shot number
 	 * @param[in]  settings        The dms settings
+	 * @param[in]  shotScheduler   The thread pool for the shots, OpenMP is used if not set
 	 */
     CostEvaluatorFull(std::shared_ptr<ct::optcon::CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>> costFct,
         std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w,
         std::shared_ptr<SplinerBase<control_vector_t, SCALAR>> controlSpliner,
         std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotInt,
-        DmsSettings settings)
-        : costFct_(costFct), w_(w), controlSpliner_(controlSpliner), shotContainers_(shotInt), settings_(settings)
+        DmsSettings settings,
+        std::shared_ptr<ShotScheduler> shotScheduler = nullptr)
+        : costFct_(costFct),
+          w_(w),
+          controlSpliner_(controlSpliner),
+          shotContainers_(shotInt),
+          settings_(settings),
+          shotScheduler_(shotScheduler)
     {
     }
 
@@ -71,10 +79,18 @@ public:
     {
         SCALAR cost = SCALAR(0.0);
 
-#pragma omp parallel for num_threads(settings_.nThreads_)
-        for (auto shotContainer = shotContainers_.begin(); shotContainer < shotContainers_.end(); ++shotContainer)
+        if (shotScheduler_)
         {
-            (*shotContainer)->integrateCost();
+            shotScheduler_->run(shotContainers_.size(), costWorkload_,
+                [this](size_t shotNr) { return shotContainers_[shotNr]->integrateCost(); });
+        }
+        else
+        {
+#pragma omp parallel for num_threads(settings_.nThreads_)
+            for (auto shotContainer = shotContainers_.begin(); shotContainer < shotContainers_.end(); ++shotContainer)
+            {
+                (*shotContainer)->integrateCost();
+            }
         }
 
         for (auto shotContainer : shotContainers_)
@@ -91,12 +107,20 @@ public:
 
         assert(shotContainers_.size() == settings_.N_);
 
-// go through all shots, integrate the state trajectories and evaluate cost accordingly
-// intermediate costs
-#pragma omp parallel for num_threads(settings_.nThreads_)
-        for (auto shotContainer = shotContainers_.begin(); shotContainer < shotContainers_.end(); ++shotContainer)
+        // go through all shots, integrate the state trajectories and evaluate cost accordingly
+        // intermediate costs
+        if (shotScheduler_)
         {
-            (*shotContainer)->integrateCostSensitivities();
+            shotScheduler_->run(shotContainers_.size(), gradientWorkload_,
+                [this](size_t shotNr) { return shotContainers_[shotNr]->integrateCostSensitivities(); });
+        }
+        else
+        {
+#pragma omp parallel for num_threads(settings_.nThreads_)
+            for (auto shotContainer = shotContainers_.begin(); shotContainer < shotContainers_.end(); ++shotContainer)
+            {
+                (*shotContainer)->integrateCostSensitivities();
+            }
         }
 
         for (size_t shotNr = 0; shotNr < shotContainers_.size(); ++shotNr)
@@ -146,6 +170,10 @@ private:
     std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotContainers_;
 
     const DmsSettings settings_;
+
+    std::shared_ptr<ShotScheduler> shotScheduler_;
+    ShotScheduler::Workload costWorkload_;
+    ShotScheduler::Workload gradientWorkload_;
 };
 
 }  // namespace optcon
@@ -89,6 +89,34 @@ void OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::changeDesiredState(const stat
     this->x_.segment(s_index, STATE_DIM) = xF;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::shiftSolution(const size_t nShots)
+{
+    // shifts v by offset entries towards the start and fills the end with its last block
+    auto shift = [](const VectorXs& v, const size_t offset, const size_t blockSize) {
+        const size_t size = v.size();
+        VectorXs shifted(size);
+        shifted.head(size - offset) = v.tail(size - offset);
+        for (size_t i = size - offset; i < size; i += blockSize)
+            shifted.segment(i, blockSize) = v.tail(blockSize);
+        return shifted;
+    };
+
+    const size_t pairSize = STATE_DIM + CONTROL_DIM;
+    const size_t shots = std::min(nShots, numPairs_ - 1);
+
+    this->xInit_ = shift(this->x_, shots * pairSize, pairSize);
+    this->xInit_.segment(getStateIndex(0), STATE_DIM) = getOptimizedState(0);
+    this->zLow_ = shift(this->zLow_, shots * pairSize, pairSize);
+    this->zUpper_ = shift(this->zUpper_, shots * pairSize, pairSize);
+
+    // the initial state and continuity constraints come first, one state vector per pair
+    const size_t nStateConstraints = numPairs_ * STATE_DIM;
+    if (static_cast<size_t>(this->lambda_.size()) >= nStateConstraints)
+        this->lambda_.head(nStateConstraints) =
+            shift(this->lambda_.head(nStateConstraints), shots * STATE_DIM, STATE_DIM);
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::setInitGuess(const state_vector_t& x0,
     const state_vector_t& x_f,
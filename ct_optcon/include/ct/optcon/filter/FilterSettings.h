@@ -88,10 +88,21 @@ template <size_t STATE_DIM, typename SCALAR = double>
 struct SteadyStateKalmanFilterSettings
 {
     ct::core::StateVector<STATE_DIM> x0; /*!< Initial state estimate. */
-    size_t maxDAREIterations;            /*!< Max number of iteration for solving DARE. */
+    size_t maxDAREIterations;            /*!< Max number of doubling steps for solving DARE. */
+    double dareTolerance;                /*!< Relative convergence tolerance of the DARE solution. */
+    size_t maxWarmStartIterations;       /*!< Max number of warm-started fixed-point iterations, 0 disables. */
+    bool cacheGain;                      /*!< Reuse the gain while the linearization does not change. */
+    double gainCacheTolerance;           /*!< Max. change of the linearization for which the gain is reused. */
 
     //! default constructor
-    SteadyStateKalmanFilterSettings() : maxDAREIterations(1000u) {}
+    SteadyStateKalmanFilterSettings()
+        : maxDAREIterations(1000u),
+          dareTolerance(1e-6),
+          maxWarmStartIterations(10u),
+          cacheGain(false),
+          gainCacheTolerance(0.0)
+    {
+    }
     //! print the current settings
     void print() const
     {
@@ -99,6 +110,10 @@ struct SteadyStateKalmanFilterSettings
         std::cout << "=====================" << std::endl;
         std::cout << "x0:\n" << x0 << std::endl;
         std::cout << "maxDAREIterations:\t" << maxDAREIterations << std::endl;
+        std::cout << "dareTolerance:\t" << dareTolerance << std::endl;
+        std::cout << "maxWarmStartIterations:\t" << maxWarmStartIterations << std::endl;
+        std::cout << "cacheGain:\t" << cacheGain << std::endl;
+        std::cout << "gainCacheTolerance:\t" << gainCacheTolerance << std::endl;
         std::cout << "              =======" << std::endl;
         std::cout << std::endl;
     }
@@ -113,6 +128,10 @@ struct SteadyStateKalmanFilterSettings
         boost::property_tree::read_info(filename, pt);
 
         maxDAREIterations = pt.get<size_t>(ns + ".maxDAREIterations", 1000);
+        dareTolerance = pt.get<double>(ns + ".dareTolerance", 1e-6);
+        maxWarmStartIterations = pt.get<size_t>(ns + ".maxWarmStartIterations", 10);
+        cacheGain = pt.get<bool>(ns + ".cacheGain", false);
+        gainCacheTolerance = pt.get<double>(ns + ".gainCacheTolerance", 0.0);
         ct::core::loadMatrix(filename, "x0", x0, ns);
 
         if (verbose)
@@ -15,8 +15,18 @@ SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::SteadyState
     const state_matrix_t& Q,
     const output_matrix_t& R,
     const state_vector_t& x0,
-    size_t maxDAREIterations)
-    : Base(f, h, x0), Q_(Q), R_(R), maxDAREIterations_(maxDAREIterations)
+    size_t maxDAREIterations,
+    SCALAR dareTolerance)
+    : Base(f, h, x0),
+      Q_(Q),
+      R_(R),
+      maxDAREIterations_(maxDAREIterations),
+      dareTolerance_(dareTolerance),
+      maxWarmStartIterations_(10),
+      gainValid_(false),
+      cacheGain_(false),
+      gainCacheTolerance_(0.0),
+      numGainUpdates_(0)
 {
     P_.setZero();
 }
@@ -25,12 +35,21 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCAL
 SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::SteadyStateKalmanFilter(
     std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
     std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+    const state_matrix_t& Q,
+    const output_matrix_t& R,
     const SteadyStateKalmanFilterSettings<STATE_DIM, SCALAR>& sskf_settings)
     : Base(f, h, sskf_settings.x0),
-      Q_(sskf_settings.Q),
-      R_(sskf_settings.R),
-      maxDAREIterations_(sskf_settings.maxDAREIterations)
+      Q_(Q),
+      R_(R),
+      maxDAREIterations_(sskf_settings.maxDAREIterations),
+      dareTolerance_(sskf_settings.dareTolerance),
+      maxWarmStartIterations_(sskf_settings.maxWarmStartIterations),
+      gainValid_(false),
+      cacheGain_(sskf_settings.cacheGain),
+      gainCacheTolerance_(sskf_settings.gainCacheTolerance),
+      numGainUpdates_(0)
 {
+    P_.setZero();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
@@ -38,8 +57,8 @@ auto SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::predic
     const ct::core::Time& dt,
     const ct::core::Time& t) -> const state_vector_t&
 {
-    A_ = this->f_->computeDerivativeState(this->x_est_, u, t);
-    this->x_est_ = this->f_->computeDynamics(this->x_est_, u, t);
+    A_ = this->f_->computeDerivativeState(this->x_est_, u, dt, t);
+    this->x_est_ = this->f_->computeDynamics(this->x_est_, u, dt, t);
     return this->x_est_;
 }
 
@@ -49,27 +68,101 @@ auto SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::update
     const ct::core::Time& t) -> const state_vector_t&
 {
     ct::core::OutputStateMatrix<OUTPUT_DIM, STATE_DIM, SCALAR> dHdx = this->h_->computeDerivativeState(this->x_est_, t);
-    Eigen::Matrix<SCALAR, OUTPUT_DIM, STATE_DIM> K;
 
-    DARE<STATE_DIM, OUTPUT_DIM, SCALAR> dare;
-    try
-    {
-        P_ = dare.computeSteadyStateRiccatiMatrix(
-            Q_, R_, A_.transpose(), dHdx.transpose(), P_, K, false, 1e-6, maxDAREIterations_);
-    } catch (...)
+    bool recomputeGain = !cacheGain_ || !gainValid_ || (A_ - A_gain_).cwiseAbs().maxCoeff() > gainCacheTolerance_ ||
+                         (dHdx - dHdx_gain_).cwiseAbs().maxCoeff() > gainCacheTolerance_;
+
+    if (recomputeGain)
     {
-        throw;
+        if (numGainUpdates_ == 0 || !warmStartDARE(dHdx))
+            P_ = dare_.solveStructuredDoubling(
+                Q_, R_, A_.transpose(), dHdx.transpose(), K_, false, dareTolerance_, maxDAREIterations_);
+        A_gain_ = A_;
+        dHdx_gain_ = dHdx;
+        gainValid_ = true;
+        numGainUpdates_++;
     }
 
-    this->x_est_ -= K.transpose() * (y - this->h_->computeMeasurement(this->x_est_, t));
+    this->x_est_ -= K_.transpose() * (y - this->h_->computeMeasurement(this->x_est_, t));
     return this->x_est_;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+bool SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::warmStartDARE(
+    const ct::core::OutputStateMatrix<OUTPUT_DIM, STATE_DIM, SCALAR>& dHdx)
+{
+    // Riccati recursion P <- Q + A P A^T - K^T H K with H = R + C P C^T and K = -H^-1 C P A^T. The fixed-point
+    // iteration converges linearly, its step size underestimates the remaining error. The error is estimated from
+    // the observed contraction rate instead, diff_k * rate / (1 - rate).
+    state_matrix_t P = P_;
+    output_matrix_t H;
+    Eigen::Matrix<SCALAR, OUTPUT_DIM, STATE_DIM> K;
+    SCALAR diffPrev = SCALAR(0.0);
+    for (size_t i = 0; i < maxWarmStartIterations_; i++)
+    {
+        H = R_;
+        H.noalias() += dHdx * P * dHdx.transpose();
+        K = -H.ldlt().solve(dHdx * P * A_.transpose());
+
+        state_matrix_t P_next = Q_;
+        P_next.noalias() += A_ * P * A_.transpose();
+        P_next.noalias() -= K.transpose() * H * K;
+        P_next = (P_next + P_next.transpose()).eval() / 2.0;
+        if (!P_next.allFinite())
+            return false;
+
+        const SCALAR diff = (P_next - P).cwiseAbs().maxCoeff() / std::max(SCALAR(1.0), P_next.cwiseAbs().maxCoeff());
+        const SCALAR rate = diff / diffPrev;
+        P = P_next;
+        diffPrev = diff;
+
+        if (diff == SCALAR(0.0) ||
+            (i > 0 && rate < SCALAR(1.0) && diff * rate / (SCALAR(1.0) - rate) < dareTolerance_))
+        {
+            // the gain of the converged P, as computed by the doubling algorithm
+            H = R_;
+            H.noalias() += dHdx * P * dHdx.transpose();
+            K_ = -H.ldlt().solve(dHdx * P * A_.transpose());
+            P_ = P;
+            return true;
+        }
+    }
+    return false;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
 void SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setMaxDAREIterations(size_t maxDAREIterations)
 {
     maxDAREIterations_ = maxDAREIterations;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setDARETolerance(SCALAR dareTolerance)
+{
+    dareTolerance_ = dareTolerance;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setMaxWarmStartIterations(
+    size_t maxWarmStartIterations)
+{
+    maxWarmStartIterations_ = maxWarmStartIterations;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setGainCaching(bool cacheGain,
+    SCALAR tolerance)
+{
+    cacheGain_ = cacheGain;
+    gainCacheTolerance_ = tolerance;
+    gainValid_ = false;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+size_t SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::getNumGainUpdates() const
+{
+    return numGainUpdates_;
+}
+
 }  // namespace optcon
 }  // namespace ct
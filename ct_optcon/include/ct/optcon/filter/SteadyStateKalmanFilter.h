@@ -22,6 +22,11 @@ struct SteadyStateKalmanFilterSettings;
  *        standard Kalman Filter, but instead of propagating the covariance and estimate through time, it assumes
  *        convergence reducing the problem to solving an Algebraic Ricatti Equation.
  *
+ *        The Riccati equation is solved with the structured doubling algorithm. Once a solution exists, the
+ *        fixed-point iteration warm-started from the previous solution is tried first, it converges within a few
+ *        iterations if the linearization changed only little. If gain caching is enabled, the steady-state gain is
+ *        only recomputed once the linearization deviates by more than a given tolerance from the one the gain was
+ *        computed for.
  */
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR = double>
 class SteadyStateKalmanFilter final : public EstimatorBase<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>
@@ -42,11 +47,14 @@ public:
         const state_matrix_t& Q,
         const output_matrix_t& R,
         const state_vector_t& x0 = state_vector_t::Zero(),
-        size_t maxDAREIterations = 1000);
+        size_t maxDAREIterations = 1000,
+        SCALAR dareTolerance = SCALAR(1e-6));
 
     //! Constructor from settings.
     SteadyStateKalmanFilter(std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
         std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+        const state_matrix_t& Q,
+        const output_matrix_t& R,
         const SteadyStateKalmanFilterSettings<STATE_DIM, SCALAR>& sskf_settings);
 
     //! Estimator predict method.
@@ -57,15 +65,45 @@ public:
     //! Estimator update method.
     const state_vector_t& update(const output_vector_t& y, const ct::core::Time& dt, const ct::core::Time& t) override;
 
-    //! Limit number of iterations of the DARE solver.
+    //! Limit the number of doubling steps of the DARE solver, step k covers 2^k stages of the Riccati recursion.
     void setMaxDAREIterations(size_t maxDAREIterations);
 
+    //! Relative convergence tolerance of the DARE solution.
+    void setDARETolerance(SCALAR dareTolerance);
+
+    //! Limit the number of warm-started fixed-point iterations before falling back to doubling, 0 disables.
+    void setMaxWarmStartIterations(size_t maxWarmStartIterations);
+
+    /*!
+     * \brief Reuse the steady-state gain as long as the linearization does not change
+     * @param cacheGain enable gain caching
+     * @param tolerance max. absolute change of the entries of A and dh/dx for which the gain is reused
+     */
+    void setGainCaching(bool cacheGain, SCALAR tolerance = SCALAR(0.0));
+
+    //! Number of times the steady-state gain was computed.
+    size_t getNumGainUpdates() const;
+
 private:
+    //! fixed-point iteration of the DARE starting from the last solution, false if it does not converge quickly
+    bool warmStartDARE(const ct::core::OutputStateMatrix<OUTPUT_DIM, STATE_DIM, SCALAR>& dHdx);
+
     size_t maxDAREIterations_;
+    SCALAR dareTolerance_;
+    size_t maxWarmStartIterations_;
     state_matrix_t P_;  //! Covariance estimate.
     state_matrix_t A_;  //! Computed linearized system matrix
     output_matrix_t R_;
     state_matrix_t Q_;
+
+    DARE<STATE_DIM, OUTPUT_DIM, SCALAR> dare_;
+    Eigen::Matrix<SCALAR, OUTPUT_DIM, STATE_DIM> K_;                        //! Steady-state gain.
+    state_matrix_t A_gain_;                                                 //! A the gain was computed for.
+    ct::core::OutputStateMatrix<OUTPUT_DIM, STATE_DIM, SCALAR> dHdx_gain_;  //! dh/dx the gain was computed for.
+    bool gainValid_;
+    bool cacheGain_;
+    SCALAR gainCacheTolerance_;
+    size_t numGainUpdates_;
 };
 
 }  // namespace optcon
@@ -0,0 +1,112 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \brief Layout of the append-only binary log written by BinaryLogger and read by BinaryLogReader
+ *
+ * A file starts with a BinaryLogFileHeader, followed by any number of records. Every record consists of a
+ * BinaryLogRecordHeader and nFields fields. Every field consists of a BinaryLogFieldHeader followed by
+ * count matrices of size rows x cols, stored column-major and zero-padded to a multiple of 8 bytes.
+ *
+ * All headers have a size which is a multiple of 8 bytes, hence all data is 8-byte aligned relative to the start of
+ * the file and can be accessed in place when the file is memory-mapped. Values are stored in host byte order.
+ */
+namespace binary_log {
+
+static const uint32_t FILE_VERSION = 1;
+static const char FILE_MAGIC[8] = {'C', 'T', 'L', 'O', 'G', '\0', '\0', '\0'};
+static const uint32_t RECORD_MAGIC = 0x43524543;  //!< marks the start of a record
+static const size_t MAX_NAME_LENGTH = 31;
+
+//! the type of a record
+enum RecordType : uint32_t
+{
+    INIT = 0,        //!< initial guess of a solve
+    ITERATION = 1,   //!< trajectories, policy and summary of an iteration
+    LQ_PROBLEM = 2,  //!< the linear-quadratic approximation of an iteration
+    SUMMARY = 3,     //!< summary of all iterations
+    USER = 100       //!< first type available for user records
+};
+
+//! the scalar type of a field
+enum ScalarType : uint32_t
+{
+    DOUBLE = 0,
+    FLOAT = 1,
+    INT64 = 2
+};
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+struct RecordHeader
+{
+    uint32_t magic;
+    uint32_t type;
+    uint64_t sequence;     //!< running number of the record in the file
+    double timestamp;      //!< seconds since the logger was started
+    uint64_t payloadSize;  //!< number of bytes following this header
+    uint32_t nFields;
+    uint32_t reserved;
+};
+
+struct FieldHeader
+{
+    char name[MAX_NAME_LENGTH + 1];  //!< zero-terminated field name
+    uint32_t scalarType;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t reserved;
+    uint64_t count;  //!< number of matrices, e.g. the length of a trajectory
+};
+
+static_assert(sizeof(FileHeader) % 8 == 0, "binary log headers need to preserve 8 byte alignment");
+static_assert(sizeof(RecordHeader) % 8 == 0, "binary log headers need to preserve 8 byte alignment");
+static_assert(sizeof(FieldHeader) % 8 == 0, "binary log headers need to preserve 8 byte alignment");
+
+//! rounds a number of bytes up to the next multiple of 8
+inline size_t padded(size_t bytes)
+{
+    return (bytes + 7) & ~size_t(7);
+}
+
+//! size in bytes of a scalar type
+inline size_t scalarSize(uint32_t scalarType)
+{
+    return scalarType == FLOAT ? 4 : 8;
+}
+
+template <typename SCALAR>
+struct ScalarTypeOf;
+template <>
+struct ScalarTypeOf<double>
+{
+    static const uint32_t value = DOUBLE;
+};
+template <>
+struct ScalarTypeOf<float>
+{
+    static const uint32_t value = FLOAT;
+};
+template <>
+struct ScalarTypeOf<int64_t>
+{
+    static const uint32_t value = INT64;
+};
+
+}  // namespace binary_log
+}  // namespace optcon
+}  // namespace ct
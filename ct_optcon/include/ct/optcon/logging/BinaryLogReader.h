@@ -0,0 +1,194 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "BinaryLogFormat.h"
+
+namespace ct {
+namespace optcon {
+
+//! read-only view of a field of a memory-mapped binary log record
+class BinaryLogField
+{
+public:
+    BinaryLogField(const binary_log::FieldHeader* header) : header_(header) {}
+    std::string name() const { return std::string(header_->name); }
+    uint32_t scalarType() const { return header_->scalarType; }
+    size_t rows() const { return header_->rows; }
+    size_t cols() const { return header_->cols; }
+    //! number of matrices stored in the field, e.g. the length of a trajectory
+    size_t count() const { return header_->count; }
+    //! maps the k-th matrix of the field without copying
+    template <typename SCALAR = double>
+    Eigen::Map<const Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic>> matrix(size_t k = 0) const
+    {
+        if (binary_log::ScalarTypeOf<SCALAR>::value != header_->scalarType)
+            throw std::runtime_error("BinaryLogField: scalar type mismatch for field " + name());
+        if (k >= count())
+            throw std::runtime_error("BinaryLogField: index out of range for field " + name());
+
+        const SCALAR* data = reinterpret_cast<const SCALAR*>(header_ + 1) + k * rows() * cols();
+        return Eigen::Map<const Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic>>(data, rows(), cols());
+    }
+
+    //! the value of a scalar field, converted to double
+    double scalar() const
+    {
+        if (header_->scalarType == binary_log::INT64)
+            return static_cast<double>(*reinterpret_cast<const int64_t*>(header_ + 1));
+        if (header_->scalarType == binary_log::FLOAT)
+            return *reinterpret_cast<const float*>(header_ + 1);
+        return *reinterpret_cast<const double*>(header_ + 1);
+    }
+
+private:
+    const binary_log::FieldHeader* header_;
+};
+
+
+//! read-only view of a record of a memory-mapped binary log
+class BinaryLogRecordView
+{
+public:
+    BinaryLogRecordView(const binary_log::RecordHeader* header) : header_(header)
+    {
+        const char* p = reinterpret_cast<const char*>(header_ + 1);
+        for (size_t i = 0; i < header_->nFields; i++)
+        {
+            const binary_log::FieldHeader* f = reinterpret_cast<const binary_log::FieldHeader*>(p);
+            fields_.push_back(f);
+            p += sizeof(binary_log::FieldHeader) +
+                 binary_log::padded(f->rows * f->cols * f->count * binary_log::scalarSize(f->scalarType));
+        }
+    }
+
+    uint32_t type() const { return header_->type; }
+    uint64_t sequence() const { return header_->sequence; }
+    double timestamp() const { return header_->timestamp; }
+    size_t nFields() const { return fields_.size(); }
+    BinaryLogField field(size_t i) const { return BinaryLogField(fields_[i]); }
+    bool hasField(const std::string& name) const { return find(name) != nullptr; }
+    BinaryLogField field(const std::string& name) const
+    {
+        const binary_log::FieldHeader* f = find(name);
+        if (!f)
+            throw std::runtime_error("BinaryLogRecordView: record has no field " + name);
+        return BinaryLogField(f);
+    }
+
+private:
+    const binary_log::FieldHeader* find(const std::string& name) const
+    {
+        for (auto f : fields_)
+            if (name == f->name)
+                return f;
+        return nullptr;
+    }
+
+    const binary_log::RecordHeader* header_;
+    std::vector<const binary_log::FieldHeader*> fields_;
+};
+
+
+/*!
+ * \brief Reads a log written by BinaryLogger by memory-mapping the file
+ *
+ * The file is indexed once on construction. Field data is accessed in place, no data is copied. A log that is still
+ * being written can be read, a trailing incomplete record is ignored.
+ */
+class BinaryLogReader
+{
+public:
+    /*!
+     * \brief Constructor, maps and indexes the file
+     * @param fileName the log file
+     */
+    BinaryLogReader(const std::string& fileName) : data_(nullptr), size_(0)
+    {
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("BinaryLogReader: cannot open file " + fileName);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(binary_log::FileHeader))
+        {
+            ::close(fd);
+            throw std::runtime_error("BinaryLogReader: " + fileName + " is not a binary log");
+        }
+        size_ = st.st_size;
+
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED)
+            throw std::runtime_error("BinaryLogReader: cannot map file " + fileName);
+        data_ = static_cast<const char*>(p);
+
+        const binary_log::FileHeader* h = reinterpret_cast<const binary_log::FileHeader*>(data_);
+        if (std::memcmp(h->magic, binary_log::FILE_MAGIC, sizeof(h->magic)) != 0 ||
+            h->version != binary_log::FILE_VERSION)
+        {
+            ::munmap(const_cast<char*>(data_), size_);
+            throw std::runtime_error("BinaryLogReader: " + fileName + " is not a binary log of a supported version");
+        }
+
+        buildIndex();
+    }
+
+    BinaryLogReader(const BinaryLogReader&) = delete;
+    BinaryLogReader& operator=(const BinaryLogReader&) = delete;
+
+    ~BinaryLogReader() { ::munmap(const_cast<char*>(data_), size_); }
+    //! number of complete records
+    size_t size() const { return records_.size(); }
+    const BinaryLogRecordView& operator[](size_t i) const { return records_[i]; }
+    //! indices of all records of a given type
+    std::vector<size_t> recordsOfType(uint32_t type) const
+    {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < records_.size(); i++)
+            if (records_[i].type() == type)
+                indices.push_back(i);
+        return indices;
+    }
+
+private:
+    void buildIndex()
+    {
+        size_t offset = sizeof(binary_log::FileHeader);
+        while (offset + sizeof(binary_log::RecordHeader) <= size_)
+        {
+            const binary_log::RecordHeader* r = reinterpret_cast<const binary_log::RecordHeader*>(data_ + offset);
+            if (r->magic != binary_log::RECORD_MAGIC)
+                throw std::runtime_error("BinaryLogReader: corrupt record header");
+
+            const size_t end = offset + sizeof(binary_log::RecordHeader) + r->payloadSize;
+            if (end > size_)
+                break;  // record not completely written yet
+
+            records_.emplace_back(r);
+            offset = end;
+        }
+    }
+
+    const char* data_;
+    size_t size_;
+    std::vector<BinaryLogRecordView> records_;
+};
+
+}  // namespace optcon
+}  // namespace ct
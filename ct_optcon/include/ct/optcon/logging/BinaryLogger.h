@@ -0,0 +1,270 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <ct/core/types/arrays/DiscreteArray.h>
+#include <ct/core/types/arrays/ScalarArray.h>
+
+#include "BinaryLogFormat.h"
+#include "SPSCQueue.h"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \brief A record of the binary log under construction
+ *
+ * Fields are serialized directly into a byte buffer which keeps its capacity between records, such that logging a
+ * record of the same size as a previous one does not allocate.
+ */
+class BinaryLogRecord
+{
+public:
+    //! starts a new record of the given type
+    void clear(uint32_t type, uint64_t sequence, double timestamp)
+    {
+        buffer_.resize(sizeof(binary_log::RecordHeader));
+        binary_log::RecordHeader& h = header();
+        h.magic = binary_log::RECORD_MAGIC;
+        h.type = type;
+        h.sequence = sequence;
+        h.timestamp = timestamp;
+        h.payloadSize = 0;
+        h.nFields = 0;
+        h.reserved = 0;
+    }
+
+    //! adds a matrix or vector
+    template <typename Derived>
+    void add(const std::string& name, const Eigen::MatrixBase<Derived>& m)
+    {
+        typedef typename Derived::Scalar S;
+        char* data = addField(name, binary_log::ScalarTypeOf<S>::value, m.rows(), m.cols(), 1);
+        Eigen::Map<Eigen::Matrix<S, Eigen::Dynamic, Eigen::Dynamic>>(reinterpret_cast<S*>(data), m.rows(), m.cols()) =
+            m;
+    }
+
+    //! adds a trajectory of fixed-size matrices or vectors, e.g. a StateVectorArray or FeedbackArray
+    template <typename MATRIX, typename ALLOC>
+    void add(const std::string& name, const ct::core::DiscreteArray<MATRIX, ALLOC>& array)
+    {
+        typedef typename MATRIX::Scalar S;
+        const size_t rows = MATRIX::RowsAtCompileTime;
+        const size_t cols = MATRIX::ColsAtCompileTime;
+        char* data = addField(name, binary_log::ScalarTypeOf<S>::value, rows, cols, array.size());
+        for (size_t i = 0; i < array.size(); i++)
+            std::memcpy(data + i * rows * cols * sizeof(S), array[i].data(), rows * cols * sizeof(S));
+    }
+
+    //! adds a scalar trajectory, e.g. a TimeArray, as a single column vector
+    template <typename S>
+    void add(const std::string& name, const ct::core::ScalarArray<S>& array)
+    {
+        S* data = reinterpret_cast<S*>(addField(name, binary_log::ScalarTypeOf<S>::value, array.size(), 1, 1));
+        for (size_t i = 0; i < array.size(); i++)
+            data[i] = array[i];
+    }
+
+    //! adds a scalar
+    void add(const std::string& name, double value)
+    {
+        std::memcpy(addField(name, binary_log::DOUBLE, 1, 1, 1), &value, sizeof(double));
+    }
+
+    //! adds an integer
+    void add(const std::string& name, int64_t value)
+    {
+        std::memcpy(addField(name, binary_log::INT64, 1, 1, 1), &value, sizeof(int64_t));
+    }
+
+    //! the serialized record
+    const std::vector<char>& buffer() const { return buffer_; }
+private:
+    binary_log::RecordHeader& header() { return *reinterpret_cast<binary_log::RecordHeader*>(buffer_.data()); }
+    //! appends a field header and returns a pointer to the zero-initialized data section of the field
+    char* addField(const std::string& name, uint32_t scalarType, size_t rows, size_t cols, size_t count)
+    {
+        if (name.size() > binary_log::MAX_NAME_LENGTH)
+            throw std::runtime_error("BinaryLogRecord: field name '" + name + "' is too long.");
+
+        const size_t dataSize = binary_log::padded(rows * cols * count * binary_log::scalarSize(scalarType));
+        const size_t offset = buffer_.size();
+        buffer_.resize(offset + sizeof(binary_log::FieldHeader) + dataSize, 0);
+
+        binary_log::FieldHeader f;
+        std::memset(&f, 0, sizeof(f));
+        std::memcpy(f.name, name.data(), name.size());
+        f.scalarType = scalarType;
+        f.rows = static_cast<uint32_t>(rows);
+        f.cols = static_cast<uint32_t>(cols);
+        f.count = count;
+        std::memcpy(buffer_.data() + offset, &f, sizeof(f));
+
+        header().payloadSize = buffer_.size() - sizeof(binary_log::RecordHeader);
+        header().nFields++;
+
+        return buffer_.data() + offset + sizeof(binary_log::FieldHeader);
+    }
+
+    std::vector<char> buffer_;
+};
+
+
+/*!
+ * \brief Asynchronous logger writing records to an append-only binary file
+ *
+ * Records are built on the calling thread directly into preallocated slots of a lock-free SPSC queue and are written
+ * to disk by a background thread. The calling thread never waits for the disk: if the queue is full, the record is
+ * dropped and counted, see getNumDropped(). The file format is described in BinaryLogFormat.h and can be read with
+ * BinaryLogReader, also while it is still being written.
+ *
+ * Usage from the (single) producer thread:
+ * \code
+ * BinaryLogRecord* r = logger.beginRecord(binary_log::ITERATION);
+ * if (r)
+ * {
+ *     r->add("x", x);
+ *     logger.commitRecord();
+ * }
+ * \endcode
+ */
+class BinaryLogger
+{
+public:
+    /*!
+     * \brief Constructor, opens the file and starts the writer thread
+     * @param fileName the log file, existing files are truncated
+     * @param queueSize maximum number of records waiting to be written
+     */
+    BinaryLogger(const std::string& fileName, size_t queueSize = 64)
+        : queue_(queueSize),
+          sequence_(0),
+          numWritten_(0),
+          numDropped_(0),
+          running_(true),
+          startTime_(std::chrono::steady_clock::now())
+    {
+        file_ = std::fopen(fileName.c_str(), "wb");
+        if (!file_)
+            throw std::runtime_error("BinaryLogger: cannot open file " + fileName);
+
+        binary_log::FileHeader h;
+        std::memcpy(h.magic, binary_log::FILE_MAGIC, sizeof(h.magic));
+        h.version = binary_log::FILE_VERSION;
+        h.reserved = 0;
+        std::fwrite(&h, sizeof(h), 1, file_);
+        std::fflush(file_);
+
+        writerThread_ = std::thread(&BinaryLogger::writerLoop, this);
+    }
+
+    BinaryLogger(const BinaryLogger&) = delete;
+    BinaryLogger& operator=(const BinaryLogger&) = delete;
+
+    //! writes all pending records and closes the file
+    ~BinaryLogger() { close(); }
+    /*!
+     * \brief writes all pending records, stops the writer thread and closes the file
+     *
+     * Records committed before the call are written. No records may be started or flushed afterwards.
+     */
+    void close()
+    {
+        if (!writerThread_.joinable())
+            return;
+        running_ = false;
+        writerThread_.join();
+        std::fclose(file_);
+    }
+
+    /*!
+     * \brief starts a new record
+     * @param type the record type, see binary_log::RecordType
+     * @return the record to be filled, nullptr if the queue is full and the record is dropped
+     */
+    BinaryLogRecord* beginRecord(uint32_t type)
+    {
+        BinaryLogRecord* record = queue_.producerSlot();
+        if (!record)
+        {
+            numDropped_++;
+            return nullptr;
+        }
+        std::chrono::duration<double> t = std::chrono::steady_clock::now() - startTime_;
+        record->clear(type, sequence_++, t.count());
+        return record;
+    }
+
+    //! hands the record obtained from beginRecord() over to the writer thread
+    void commitRecord() { queue_.push(); }
+    //! blocks until all committed records are written to the file. Not meant to be called from a control loop.
+    void flush()
+    {
+        while (!queue_.empty())
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        std::lock_guard<std::mutex> lock(fileMutex_);
+        std::fflush(file_);
+    }
+
+    //! number of records written to the file
+    size_t getNumWritten() const { return numWritten_; }
+    //! number of records dropped because the queue was full
+    size_t getNumDropped() const { return numDropped_; }
+private:
+    void writerLoop()
+    {
+        while (true)
+        {
+            // read the flag before the queue: a record committed before shutdown is then still seen below
+            const bool running = running_;
+            BinaryLogRecord* record = queue_.consumerSlot();
+            if (record)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(fileMutex_);
+                    std::fwrite(record->buffer().data(), 1, record->buffer().size(), file_);
+                }
+                queue_.pop();
+                numWritten_++;
+            }
+            else if (!running)
+            {
+                break;
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+        std::fflush(file_);
+    }
+
+    SPSCQueue<BinaryLogRecord> queue_;
+    uint64_t sequence_;
+    std::atomic<size_t> numWritten_;
+    std::atomic<size_t> numDropped_;
+    std::atomic<bool> running_;
+    std::chrono::steady_clock::time_point startTime_;
+
+    std::FILE* file_;
+    std::mutex fileMutex_;  //!< only protects flushing from the producer side, never taken on the hot path
+    std::thread writerThread_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,76 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \brief A bounded, lock-free single-producer single-consumer ring buffer
+ *
+ * The slots are allocated once and are reused. Instead of copying elements in and out, the producer fills the slot
+ * returned by producerSlot() in place and publishes it with push(), the consumer processes the slot returned by
+ * consumerSlot() in place and releases it with pop(). Slot contents (e.g. the capacity of a std::vector) therefore
+ * survive a round trip, such that steady-state operation does not allocate.
+ *
+ * Exactly one thread may call the producer methods and exactly one thread may call the consumer methods.
+ *
+ * \tparam T the slot type
+ */
+template <typename T>
+class SPSCQueue
+{
+public:
+    /*!
+     * \brief Constructor
+     * @param capacity maximum number of elements in the queue
+     */
+    explicit SPSCQueue(size_t capacity) : slots_(capacity + 1), head_(0), tail_(0) {}
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    //! free slot to be filled by the producer, nullptr if the queue is full
+    T* producerSlot()
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (increment(tail) == head_.load(std::memory_order_acquire))
+            return nullptr;
+        return &slots_[tail];
+    }
+
+    //! publishes the slot returned by the last call to producerSlot()
+    void push() { tail_.store(increment(tail_.load(std::memory_order_relaxed)), std::memory_order_release); }
+    //! oldest published slot, nullptr if the queue is empty
+    T* consumerSlot()
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return nullptr;
+        return &slots_[head];
+    }
+
+    //! releases the slot returned by the last call to consumerSlot()
+    void pop() { head_.store(increment(head_.load(std::memory_order_relaxed)), std::memory_order_release); }
+    bool empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+    size_t capacity() const { return slots_.size() - 1; }
+private:
+    size_t increment(size_t i) const { return (i + 1 == slots_.size()) ? 0 : i + 1; }
+    std::vector<T> slots_;
+
+    // producer and consumer index on separate cache lines to avoid false sharing. Padding is used instead of
+    // alignas(64), over-aligned types cannot safely be allocated with new in C++14.
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    std::atomic<size_t> head_;
+    char headPadding_[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> tail_;
+    char tailPadding_[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+}  // namespace optcon
+}  // namespace ct
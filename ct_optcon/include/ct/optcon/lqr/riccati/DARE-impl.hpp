@@ -67,5 +67,70 @@ DARE<STATE_DIM, CONTROL_DIM, SCALAR>::computeSteadyStateRiccatiMatrix(const stat
     return P;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+typename DARE<STATE_DIM, CONTROL_DIM, SCALAR>::state_matrix_t
+DARE<STATE_DIM, CONTROL_DIM, SCALAR>::solveStructuredDoubling(const state_matrix_t& Q,
+    const control_matrix_t& R,
+    const state_matrix_t& A,
+    const control_gain_matrix_t& B,
+    control_feedback_t& K,
+    bool verbose,
+    const SCALAR eps,
+    size_t maxIter)
+{
+    // The DARE is written as P = Q + A^T P (I + G P)^-1 A with G = B R^-1 B^T. Every doubling step k yields the
+    // solution of the Riccati recursion over 2^k stages (Chu, Fan, Lin 2005):
+    //     A_k+1 = A_k (I + G_k H_k)^-1 A_k
+    //     G_k+1 = G_k + A_k (I + G_k H_k)^-1 G_k A_k^T
+    //     H_k+1 = H_k + A_k^T H_k (I + G_k H_k)^-1 A_k
+    // with H_k converging to P.
+    state_matrix_t Ak = A;
+    state_matrix_t Gk = B * R.ldlt().solve(B.transpose());
+    state_matrix_t Hk = Q;
+
+    Eigen::PartialPivLU<state_matrix_t> lu;
+    state_matrix_t WinvA, WinvG, H_next;
+
+    size_t numIter = 0;
+    SCALAR diff = 1;
+
+    while (diff > eps && numIter < maxIter)
+    {
+        lu.compute(state_matrix_t::Identity() + Gk * Hk);
+        WinvA = lu.solve(Ak);
+        WinvG = lu.solve(Gk);
+
+        H_next = Hk + Ak.transpose() * Hk * WinvA;
+        Gk = Gk + Ak * WinvG * Ak.transpose();
+        Ak = Ak * WinvA;
+
+        H_next = (H_next + H_next.transpose()).eval() / 2.0;
+        Gk = (Gk + Gk.transpose()).eval() / 2.0;
+
+        diff = (H_next - Hk).cwiseAbs().maxCoeff() / std::max(SCALAR(1.0), H_next.cwiseAbs().maxCoeff());
+        Hk = H_next;
+        numIter++;
+
+        if (!Hk.allFinite())
+            throw std::runtime_error("DARE : Failed to converge - doubling algorithm diverged.");
+    }
+
+    if (diff > eps)
+        throw std::runtime_error("DARE : Failed to converge - maximum number of doubling steps reached.");
+
+    control_matrix_t H = R;
+    H.noalias() += B.transpose() * Hk * B;
+    K = -H.ldlt().solve(B.transpose() * Hk * A);
+
+    if (verbose)
+    {
+        std::cout << "DARE : doubling algorithm converged after " << numIter << " iterations out of a maximum of "
+                  << maxIter << std::endl;
+        std::cout << "Resulting K: " << K << std::endl;
+    }
+
+    return Hk;
+}
+
 }  // namespace optcon
 }  // namespace ct
@@ -74,6 +74,28 @@ public:
         const SCALAR eps = 1e-6,
         size_t maxIter = 1000);
 
+    /*! compute the discrete-time steady state Riccati-Matrix using the structured doubling algorithm (SDA)
+     * In contrast to the fixed-point iteration above, the doubling algorithm converges quadratically, typically
+     * within less than 20 iterations. It requires R to be positive definite.
+     * @param Q state weight
+     * @param R control weight
+     * @param A discrete-time linear system matrix A
+     * @param B discrete-time linear system matrix B
+     * @param K resulting feedback matrix
+     * @param verbose print additional information
+     * @param eps relative treshold to stop iterating
+     * @param maxIter maximum number of doubling steps
+     * @return steady state riccati matrix P
+     */
+    state_matrix_t solveStructuredDoubling(const state_matrix_t& Q,
+        const control_matrix_t& R,
+        const state_matrix_t& A,
+        const control_gain_matrix_t& B,
+        control_feedback_t& K,
+        bool verbose = false,
+        const SCALAR eps = 1e-12,
+        size_t maxIter = 100);
+
 
 private:
     DynamicRiccatiEquation<STATE_DIM, CONTROL_DIM> dynamicRDE_;
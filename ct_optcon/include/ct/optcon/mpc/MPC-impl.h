@@ -22,7 +22,8 @@ MPC<OPTCON_SOLVER>::MPC(const OptConProblem_t& problem,
       forwardIntegrator_(dynamics_, mpcsettings.stateForwardIntegratorType_),
       firstRun_(true),
       runCallCounter_(0),
-      policyHandler_(new PolicyHandler<Policy_t, STATE_DIM, CONTROL_DIM, Scalar_t>())
+      policyHandler_(new PolicyHandler<Policy_t, STATE_DIM, CONTROL_DIM, Scalar_t>()),
+      policyShift_(0)
 {
     checkSettings(mpcsettings);
 
@@ -158,6 +159,7 @@ void MPC<OPTCON_SOLVER>::prepareIteration(const Scalar_t& extTime)
 
     // Calculate new initial guess / warm-starting policy
     policyHandler_->designWarmStartingPolicy(t_forward_stop_, newTimeHorizon, currentPolicy_);
+    policyShift_ += policyHandler_->getWarmStartShift();
 
     // todo: remove this after through testing
     if (t_forward_stop_ < t_forward_start_)
@@ -169,6 +171,9 @@ void MPC<OPTCON_SOLVER>::prepareIteration(const Scalar_t& extTime)
 	 */
     solver_.setInitialGuess(currentPolicy_);
 
+    // allows the solver to reuse the shifted LQ approximation of the previous iteration
+    solver_.setMPCShift(policyShift_);
+
     solver_.prepareMPCIteration();
 }
 
@@ -199,6 +204,9 @@ bool MPC<OPTCON_SOLVER>::finishIteration(const core::StateVector<STATE_DIM, Scal
 
     bool solveSuccessful = solver_.finishMPCIteration();
 
+    // the solver iterated on the current policy, also if the solve failed
+    policyShift_ = 0;
+
     if (solveSuccessful)
     {
         newPolicy_ts = newPolicy_ts + (t_forward_stop_ - t_forward_start_);
@@ -229,6 +237,7 @@ bool MPC<OPTCON_SOLVER>::finishIteration(const core::StateVector<STATE_DIM, Scal
 
                 // update policy timestamp with the truncated time
                 newPolicy_ts += dt_truncated_eff;
+                policyShift_ = dt_truncated_eff;
             }
             else if (t_forward_stop_ >= dtp && !firstRun_)
             {
@@ -273,6 +282,8 @@ void MPC<OPTCON_SOLVER>::resetMpc(const Scalar_t& newTimeHorizon)
 
     runCallCounter_ = 0;
 
+    policyShift_ = 0;
+
     // reset the time horizon of the strategy
     timeHorizonStrategy_->updateInitialTimeHorizon(newTimeHorizon);
 
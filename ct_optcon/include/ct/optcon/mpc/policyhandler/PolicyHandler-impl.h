@@ -9,7 +9,7 @@ namespace ct {
 namespace optcon {
 
 template <typename POLICY, size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
-PolicyHandler<POLICY, STATE_DIM, CONTROL_DIM, SCALAR>::PolicyHandler()
+PolicyHandler<POLICY, STATE_DIM, CONTROL_DIM, SCALAR>::PolicyHandler() : warmStartShift_(0)
 {
 }
 
@@ -24,6 +24,7 @@ void PolicyHandler<POLICY, STATE_DIM, CONTROL_DIM, SCALAR>::designWarmStartingPo
     POLICY& policy)
 {
     policy = initialPolicy_;
+    warmStartShift_ = 0;
 }
 
 template <typename POLICY, size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -39,5 +40,11 @@ void PolicyHandler<POLICY, STATE_DIM, CONTROL_DIM, SCALAR>::setPolicy(const POLI
     initialPolicy_ = newPolicy;
 }
 
+template <typename POLICY, size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+const SCALAR& PolicyHandler<POLICY, STATE_DIM, CONTROL_DIM, SCALAR>::getWarmStartShift() const
+{
+    return warmStartShift_;
+}
+
 }  // namespace optcon
 }  // namespace ct
@@ -51,9 +51,13 @@ public:
     //! set new policy to policy handler
     void setPolicy(const POLICY& newPolicy);
 
+    //! the time the last warm-starting policy was effectively shifted about, zero if not shifted
+    const SCALAR& getWarmStartShift() const;
+
 
 protected:
     POLICY initialPolicy_;  //! the initial policy
+    SCALAR warmStartShift_;  //! the time the last warm-starting policy was effectively shifted about
 };
 
 }  // namespace optcon
@@ -37,6 +37,7 @@ void StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, SCALAR>::designWarmStart
     // compute number indices to be shifted. Note: it does not make sense to shift more entries than are available
     int num_di = FeedForwardTraj.getIndexFromTime(delay);
     num_di = std::min(num_di, currentSize - 1);
+    this->warmStartShift_ = std::max(num_di, 0) * dt_;
 
 
 #ifdef DEBUG_POLICYHANDLER
@@ -48,12 +49,13 @@ void StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, SCALAR>::designWarmStart
 #endif
 
 
-    // Step 1 - Truncate Front: remove first 'num_di' elements from controller and shift time accordingly
+    // Step 1 - Truncate Front: remove first 'num_di' elements from controller and shift time accordingly,
+    // on the equally spaced grid this keeps the time stamps and only drops the last ones
     if (num_di > 0)
     {
-        FeedForwardTraj.eraseFront(num_di, num_di * dt_);
-        FeedbackTraj.eraseFront(num_di, num_di * dt_);
-        StateRefTraj.eraseFront(num_di, num_di * dt_);
+        FeedForwardTraj.dropFront(num_di);
+        FeedbackTraj.dropFront(num_di);
+        StateRefTraj.dropFront(num_di);
         currentSize -= num_di;
     }
 
@@ -62,23 +64,18 @@ void StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, SCALAR>::designWarmStart
     if (Kn_new > currentSize)
     {
         //extend at back with constant value taken from last element
-        bool timeIsRelative = true;
-        for (int i = 0; i < Kn_new - currentSize; i++)
-        {
-            FeedbackTraj.push_back(FeedbackTraj.back(), dt_, timeIsRelative);
-            FeedForwardTraj.push_back(FeedForwardTraj.back(), dt_, timeIsRelative);
-            StateRefTraj.push_back(StateRefTraj.back(), dt_, timeIsRelative);
-        }
+        const size_t nExtend = Kn_new - currentSize;
+        FeedbackTraj.extend(nExtend, dt_);
+        FeedForwardTraj.extend(nExtend, dt_);
+        StateRefTraj.extend(nExtend, dt_);
     }
     else if (Kn_new < currentSize)
     {
         // remove elements from back
-        for (int i = 0; i < currentSize - Kn_new; i++)
-        {
-            FeedbackTraj.pop_back();
-            FeedForwardTraj.pop_back();
-            StateRefTraj.pop_back();
-        }
+        const size_t nRemove = currentSize - Kn_new;
+        FeedbackTraj.pop_back(nRemove);
+        FeedForwardTraj.pop_back(nRemove);
+        StateRefTraj.pop_back(nRemove);
     }
 
     // safety check, which should never be entered
@@ -110,9 +107,9 @@ void StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, SCALAR>::truncateSolutio
     // remove first num_di elements from controller
     if (num_di > 0 && num_di < currentSize)
     {
-        policy.getFeedbackTrajectory().eraseFront(num_di, effectivelyTruncated);
-        policy.getFeedforwardTrajectory().eraseFront(num_di, effectivelyTruncated);
-        policy.getReferenceStateTrajectory().eraseFront(num_di, effectivelyTruncated);
+        policy.getFeedbackTrajectory().dropFront(num_di);
+        policy.getFeedforwardTrajectory().dropFront(num_di);
+        policy.getReferenceStateTrajectory().dropFront(num_di);
     }
 }
 
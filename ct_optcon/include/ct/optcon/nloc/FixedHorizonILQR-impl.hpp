@@ -0,0 +1,251 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t N,
+    typename SYSTEM,
+    typename LINEAR_SYSTEM,
+    typename COST,
+    typename SCALAR>
+FixedHorizonILQR<STATE_DIM, CONTROL_DIM, N, SYSTEM, LINEAR_SYSTEM, COST, SCALAR>::FixedHorizonILQR(const SYSTEM& system,
+    const LINEAR_SYSTEM& linearSystem,
+    const COST& costFunction,
+    const NLOptConSettings& settings)
+    : system_(system),
+      linearSystem_(linearSystem),
+      costFunction_(costFunction),
+      cost_(std::numeric_limits<SCALAR>::infinity()),
+      iteration_(0)
+{
+    x_.fill(StateVector::Zero());
+    u_.fill(ControlVector::Zero());
+    L_.fill(FeedbackMatrix::Zero());
+    configure(settings);
+}
+
+
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t N,
+    typename SYSTEM,
+    typename LINEAR_SYSTEM,
+    typename COST,
+    typename SCALAR>
+void FixedHorizonILQR<STATE_DIM, CONTROL_DIM, N, SYSTEM, LINEAR_SYSTEM, COST, SCALAR>::configure(
+    const NLOptConSettings& settings)
+{
+    if (!settings.parametersOk())
+        throw std::runtime_error("Settings are incorrect. Aborting.");
+
+    settings_ = settings;
+    lqocSolver_.configure(settings);
+}
+
+
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t N,
+    typename SYSTEM,
+    typename LINEAR_SYSTEM,
+    typename COST,
+    typename SCALAR>
+void FixedHorizonILQR<STATE_DIM, CONTROL_DIM, N, SYSTEM, LINEAR_SYSTEM, COST, SCALAR>::setInitialGuess(
+    const StateVectorArray& x,
+    const ControlVectorArray& u,
+    const FeedbackArray& L)
+{
+    x_ = x;
+    u_ = u;
+    L_ = L;
+    iteration_ = 0;
+}
+
+
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t N,
+    typename SYSTEM,
+    typename LINEAR_SYSTEM,
+    typename COST,
+    typename SCALAR>
+void FixedHorizonILQR<STATE_DIM, CONTROL_DIM, N, SYSTEM, LINEAR_SYSTEM, COST, SCALAR>::changeInitialState(
+    const StateVector& x0)
+{
+    x_[0] = x0;
+    iteration_ = 0;
+}
+
+
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t N,
+    typename SYSTEM,
+    typename LINEAR_SYSTEM,
+    typename COST,
+    typename SCALAR>
+bool FixedHorizonILQR<STATE_DIM, CONTROL_DIM, N, SYSTEM, LINEAR_SYSTEM, COST, SCALAR>::runIteration()
+{
+    if (iteration_ == 0)
+    {
+        // nominal rollout of the initial guess around itself
+        x_ref_alpha_ = x_;
+        u_ref_alpha_ = u_;
+        cost_ = rollout(x_ref_alpha_, u_ref_alpha_, x_, u_);
+        if (!std::isfinite(cost_))
+            throw std::runtime_error("Rollout failed. System became unstable");
+    }
+
+    computeLQApproximation();
+    lqocSolver_.solve(lqocProblem_);
+
+    const SCALAR costPrevious = cost_;
+    const SCALAR alpha = lineSearch();
+
+    iteration_++;
+
+    if (alpha == 0.0)
+        return false;
+
+    return std::abs((costPrevious - cost_) / costPrevious) > settings_.min_cost_improvement;
+}
+
+
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t N,
+    typename SYSTEM,
+    typename LINEAR_SYSTEM,
+    typename COST,
+    typename SCALAR>
+bool FixedHorizonILQR<STATE_DIM, CONTROL_DIM, N, SYSTEM, LINEAR_SYSTEM, COST, SCALAR>::solve()
+{
+    while (iteration_ < static_cast<size_t>(settings_.max_iterations))
+    {
+        if (!runIteration())
+            return true;
+    }
+    return false;
+}
+
+
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t N,
+    typename SYSTEM,
+    typename LINEAR_SYSTEM,
+    typename COST,
+    typename SCALAR>
+inline SCALAR FixedHorizonILQR<STATE_DIM, CONTROL_DIM, N, SYSTEM, LINEAR_SYSTEM, COST, SCALAR>::rollout(
+    const StateVectorArray& x_ref,
+    const ControlVectorArray& u_ref,
+    StateVectorArray& x,
+    ControlVectorArray& u)
+{
+    const SCALAR dt = settings_.dt;
+    SCALAR intermediateCost = 0.0;
+
+    x[0] = x_ref[0];
+    for (size_t k = 0; k < N; k++)
+    {
+        u[k] = u_ref[k] + L_[k] * (x[k] - x_ref[k]);
+        system_.propagateControlledDynamics(x[k], k, u[k], x[k + 1]);
+
+        costFunction_.setCurrentStateAndControl(x[k], u[k], dt * k);
+        intermediateCost += costFunction_.evaluateIntermediate();
+    }
+
+    costFunction_.setCurrentStateAndControl(x[N], ControlVector::Zero(), dt * N);
+    const SCALAR cost = intermediateCost * dt + costFunction_.evaluateTerminal();
+
+    return std::isnan(cost) ? std::numeric_limits<SCALAR>::infinity() : cost;
+}
+
+
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t N,
+    typename SYSTEM,
+    typename LINEAR_SYSTEM,
+    typename COST,
+    typename SCALAR>
+inline void FixedHorizonILQR<STATE_DIM, CONTROL_DIM, N, SYSTEM, LINEAR_SYSTEM, COST, SCALAR>::computeLQApproximation()
+{
+    LQOCProblem_t& p = lqocProblem_;
+    const SCALAR dt = settings_.dt;
+
+    for (size_t k = 0; k < N; k++)
+    {
+        linearSystem_.getAandB(x_[k], u_[k], x_[k + 1], static_cast<int>(k), 1, p.A_[k], p.B_[k]);
+        p.b_[k] = x_[k + 1] - p.A_[k] * x_[k] - p.B_[k] * u_[k];
+
+        costFunction_.setCurrentStateAndControl(x_[k], u_[k], dt * k);
+        p.Q_[k] = costFunction_.stateSecondDerivativeIntermediate() * dt;
+        p.R_[k] = costFunction_.controlSecondDerivativeIntermediate() * dt;
+        p.P_[k] = costFunction_.stateControlDerivativeIntermediate() * dt;
+        p.qv_[k] = costFunction_.stateDerivativeIntermediate() * dt - p.Q_[k] * x_[k] - p.P_[k].transpose() * u_[k];
+        p.rv_[k] = costFunction_.controlDerivativeIntermediate() * dt - p.R_[k] * u_[k] - p.P_[k] * x_[k];
+
+        p.x_[k] = x_[k];
+        p.u_[k] = u_[k];
+    }
+
+    costFunction_.setCurrentStateAndControl(x_[N], ControlVector::Zero(), dt * N);
+    p.Q_[N] = costFunction_.stateSecondDerivativeTerminal();
+    p.qv_[N] = costFunction_.stateDerivativeTerminal() - p.Q_[N] * x_[N];
+    p.x_[N] = x_[N];
+}
+
+
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t N,
+    typename SYSTEM,
+    typename LINEAR_SYSTEM,
+    typename COST,
+    typename SCALAR>
+inline SCALAR FixedHorizonILQR<STATE_DIM, CONTROL_DIM, N, SYSTEM, LINEAR_SYSTEM, COST, SCALAR>::lineSearch()
+{
+    const StateVectorArray& x_sol = lqocSolver_.getSolutionState();
+    const ControlVectorArray& u_sol = lqocSolver_.getSolutionControl();
+    L_ = lqocSolver_.getSolutionFeedback();
+
+    const LineSearchSettings& ls = settings_.lineSearchSettings;
+    SCALAR alpha = ls.active ? ls.alpha_0 : 1.0;
+    const size_t maxIterations = ls.active ? ls.maxIterations : 1;
+
+    for (size_t i = 0; i < maxIterations; i++)
+    {
+        for (size_t k = 0; k < N; k++)
+        {
+            x_ref_alpha_[k] = alpha * x_sol[k] + (1 - alpha) * x_[k];
+            u_ref_alpha_[k] = alpha * u_sol[k] + (1 - alpha) * u_[k];
+        }
+        x_ref_alpha_[N] = alpha * x_sol[N] + (1 - alpha) * x_[N];
+
+        const SCALAR cost = rollout(x_ref_alpha_, u_ref_alpha_, x_alpha_, u_alpha_);
+
+        // without line search, the full step is always taken
+        if (!ls.active || cost < cost_)
+        {
+            x_ = x_alpha_;
+            u_ = u_alpha_;
+            cost_ = cost;
+            return alpha;
+        }
+
+        alpha *= ls.n_alpha;
+    }
+
+    return 0.0;
+}
+
+}  // namespace optcon
+}  // namespace ct
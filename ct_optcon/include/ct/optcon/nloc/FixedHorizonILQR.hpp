@@ -0,0 +1,130 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <array>
+
+#include <ct/optcon/problem/FixedHorizonLQOCProblem.hpp>
+#include <ct/optcon/solver/NLOptConSettings.hpp>
+#include <ct/optcon/solver/lqp/FixedHorizonRiccatiSolver.hpp>
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \ingroup NLOC
+ *
+ * \brief iLQR for discrete-time systems with a compile-time horizon
+ *
+ * A specialization of the NLOC iLQR path (closed-loop single shooting, GNRiccati solver, line search on the cost) for
+ * small embedded MPC problems. The horizon N is a template parameter and all stage data live in std::array. The
+ * system, its linearization and the cost function are held by value with their concrete types, such that calls are
+ * resolved at compile time and the rollout, LQ approximation, Riccati sweep and line search can be fully inlined.
+ * No memory is allocated after construction.
+ *
+ * Given the same settings, the iterates are identical to the ones of NLOptConSolver with iLQR, closed-loop
+ * shooting, a single thread and the GNRiccati solver on the corresponding DiscreteOptConProblem.
+ * Of the settings, dt, epsilon, fixedHessianCorrection, max_iterations, min_cost_improvement and the line search
+ * settings alpha_0, n_alpha, maxIterations and active are used.
+ *
+ * \tparam N the number of stages
+ * \tparam SYSTEM a core::DiscreteControlledSystem
+ * \tparam LINEAR_SYSTEM a core::DiscreteLinearSystem, the linearization of SYSTEM
+ * \tparam COST a CostFunctionQuadratic
+ */
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t N,
+    typename SYSTEM,
+    typename LINEAR_SYSTEM,
+    typename COST,
+    typename SCALAR = double>
+class FixedHorizonILQR
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef FixedHorizonLQOCProblem<STATE_DIM, CONTROL_DIM, N, SCALAR> LQOCProblem_t;
+    typedef FixedHorizonRiccatiSolver<STATE_DIM, CONTROL_DIM, N, SCALAR> LQOCSolver_t;
+
+    typedef ct::core::StateVector<STATE_DIM, SCALAR> StateVector;
+    typedef ct::core::ControlVector<CONTROL_DIM, SCALAR> ControlVector;
+    typedef ct::core::FeedbackMatrix<STATE_DIM, CONTROL_DIM, SCALAR> FeedbackMatrix;
+
+    typedef std::array<StateVector, N + 1> StateVectorArray;
+    typedef std::array<ControlVector, N> ControlVectorArray;
+    typedef std::array<FeedbackMatrix, N> FeedbackArray;
+
+    /*!
+     * \brief Constructor, copies system, linear system and cost function
+     * @param system the nonlinear system
+     * @param linearSystem the linearization of the system
+     * @param costFunction the cost function
+     * @param settings the settings
+     */
+    FixedHorizonILQR(const SYSTEM& system,
+        const LINEAR_SYSTEM& linearSystem,
+        const COST& costFunction,
+        const NLOptConSettings& settings);
+
+    void configure(const NLOptConSettings& settings);
+
+    //! set the initial guess, x[0] is the initial state
+    void setInitialGuess(const StateVectorArray& x, const ControlVectorArray& u, const FeedbackArray& L);
+
+    //! change the initial state for the next solve, e.g. in MPC
+    void changeInitialState(const StateVector& x0);
+
+    //! runs one iteration, returns false if converged
+    bool runIteration();
+
+    //! iterates until convergence or the maximum number of iterations, returns true if converged
+    bool solve();
+
+    const StateVectorArray& getStateTrajectory() const { return x_; }
+    const ControlVectorArray& getControlTrajectory() const { return u_; }
+    const FeedbackArray& getFeedbackTrajectory() const { return L_; }
+    SCALAR getCost() const { return cost_; }
+    size_t iteration() const { return iteration_; }
+    SYSTEM& getSystem() { return system_; }
+    COST& getCostFunction() { return costFunction_; }
+private:
+    //! closed-loop rollout around the reference x_ref, u_ref, returns the cost (infinity if the rollout diverges)
+    SCALAR rollout(const StateVectorArray& x_ref,
+        const ControlVectorArray& u_ref,
+        StateVectorArray& x,
+        ControlVectorArray& u);
+
+    void computeLQApproximation();
+
+    //! returns the step size, 0 if no lower cost was found
+    SCALAR lineSearch();
+
+    NLOptConSettings settings_;
+
+    SYSTEM system_;
+    LINEAR_SYSTEM linearSystem_;
+    COST costFunction_;
+
+    LQOCProblem_t lqocProblem_;
+    LQOCSolver_t lqocSolver_;
+
+    StateVectorArray x_;
+    ControlVectorArray u_;
+    FeedbackArray L_;
+    SCALAR cost_;
+
+    //! line search candidates
+    StateVectorArray x_ref_alpha_;
+    ControlVectorArray u_ref_alpha_;
+    StateVectorArray x_alpha_;
+    ControlVectorArray u_alpha_;
+
+    size_t iteration_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -51,13 +51,22 @@ NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCB
       intermediateCostBest_(std::numeric_limits<SCALAR>::infinity()),
       finalCostBest_(std::numeric_limits<SCALAR>::infinity()),
       lowestCost_(std::numeric_limits<SCALAR>::infinity()),
+      lineSearchMeritReference_(std::numeric_limits<SCALAR>::infinity()),
+      lineSearchCostReference_(std::numeric_limits<SCALAR>::infinity()),
+      lineSearchViolationReference_(std::numeric_limits<SCALAR>::infinity()),
       intermediateCostPrevious_(std::numeric_limits<SCALAR>::infinity()),
       finalCostPrevious_(std::numeric_limits<SCALAR>::infinity()),
       boxConstraints_(settings.nThreads + 1, nullptr),      // initialize constraints with null
       generalConstraints_(settings.nThreads + 1, nullptr),  // initialize constraints with null
       firstRollout_(true),
       alphaBest_(-1),
-      lqpCounter_(0)
+      alphaExpPrevious_(0),
+      alPenalty_(settings.augmentedLagrangianSettings.penalty_0),
+      alViolation_(std::numeric_limits<SCALAR>::infinity()),
+      lqpCounter_(0),
+      lqApproximationShiftable_(false),
+      numShiftedStages_(0),
+      numReusedStages_(0)
 {
     Eigen::initParallel();
 
@@ -188,6 +197,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         throw std::runtime_error("negative or zero time steps specified");
 
     K_ = numStages;
+    lqApproximationShiftable_ = false;
 
     t_ = TimeArray(settings_.dt, K_ + 1, 0.0);
 
@@ -204,6 +214,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     substepsU_->resize(K_ + 1);
 
     resetDefects();
+    resetAugmentedLagrangian();
 
     systemInterface_->changeNumStages(K_);
 
@@ -241,12 +252,12 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         throw std::runtime_error("cost function is nullptr");
 
     costFunctions_.resize(settings_.nThreads + 1);
+    lqApproximationShiftable_ = false;
 
-    for (int i = 0; i < settings_.nThreads + 1; i++)
-    {
-        // make a deep copy
-        costFunctions_[i] = typename OptConProblem_t::CostFunctionPtr_t(cf->clone());
-    }
+    // make one deep copy, the per-thread instances share its immutable data and only carry evaluation buffers
+    costFunctions_[0] = typename OptConProblem_t::CostFunctionPtr_t(cf->clone());
+    for (int i = 1; i < settings_.nThreads + 1; i++)
+        costFunctions_[i] = typename OptConProblem_t::CostFunctionPtr_t(costFunctions_[0]->cloneShared());
 
     // recompute cost if line search is active
     // TODO: this should be multi-threaded to save time
@@ -259,6 +270,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     const typename OptConProblem_t::DynamicsPtr_t& dyn)
 {
     systemInterface_->changeNonlinearSystem(dyn);
+    lqApproximationShiftable_ = false;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -300,18 +312,24 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         generalConstraints_[i] = typename OptConProblem_t::ConstraintPtr_t(con->clone());
     }
 
-    // we need to allocate memory in HPIPM for the new constraints
-    for (int i = 0; i < K_; i++)
+    resetAugmentedLagrangian();
+
+    // with an augmented Lagrangian, the constraints enter the cost and the LQ problem remains unconstrained
+    if (!useAugmentedLagrangian())
     {
-        generalConstraints_[settings_.nThreads]->setCurrentStateAndControl(
-            lqocProblem_->x_[i], lqocProblem_->u_[i], i * settings_.dt);
-        lqocProblem_->ng_[i] = generalConstraints_[settings_.nThreads]->getIntermediateConstraintsCount();
-    }
+        // we need to allocate memory in HPIPM for the new constraints
+        for (int i = 0; i < K_; i++)
+        {
+            generalConstraints_[settings_.nThreads]->setCurrentStateAndControl(
+                lqocProblem_->x_[i], lqocProblem_->u_[i], i * settings_.dt);
+            lqocProblem_->ng_[i] = generalConstraints_[settings_.nThreads]->getIntermediateConstraintsCount();
+        }
 
-    lqocProblem_->ng_[K_] = generalConstraints_[settings_.nThreads]->getTerminalConstraintsCount();
-    lqocSolver_->setProblem(lqocProblem_);
-    lqocSolver_->configureGeneralConstraints(lqocProblem_);
-    lqocSolver_->initializeAndAllocate();
+        lqocProblem_->ng_[K_] = generalConstraints_[settings_.nThreads]->getTerminalConstraintsCount();
+        lqocSolver_->setProblem(lqocProblem_);
+        lqocSolver_->configureGeneralConstraints(lqocProblem_);
+        lqocSolver_->initializeAndAllocate();
+    }
 
     // TODO can we do this multi-threaded?
     if (iteration_ > 0 && settings_.lineSearchSettings.active)
@@ -323,6 +341,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     const typename OptConProblem_t::LinearPtr_t& lin)
 {
     systemInterface_->changeLinearSystem(lin);
+    lqApproximationShiftable_ = false;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -369,6 +388,16 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         throw std::runtime_error("HPIPM selected but not built.");
 #endif
     }
+    else if (settings.lqocp_solver == NLOptConSettings::LQOCP_SOLVER::CONDENSING_SOLVER)
+    {
+        lqocSolver_ = std::shared_ptr<CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>>(
+            new CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>());
+    }
+    else if (settings.lqocp_solver == NLOptConSettings::LQOCP_SOLVER::BOX_RICCATI_SOLVER)
+    {
+        lqocSolver_ = std::shared_ptr<BoxConstrainedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>>(
+            new BoxConstrainedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>());
+    }
     else
         throw std::runtime_error("Solver for Linear Quadratic Optimal Control Problem wrongly specified.");
 
@@ -383,7 +412,13 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 
     lqocSolver_->configure(settings);
 
+    if (!settings.logToBinary)
+        binaryLogger_.reset();
+    else if (!binaryLogger_ || !settings_.logToBinary || settings.loggingPrefix != settings_.loggingPrefix)
+        binaryLogger_ = std::shared_ptr<BinaryLogger>(new BinaryLogger(settings.loggingPrefix + "Log.ctlog"));
+
     settings_ = settings;
+    lqApproximationShiftable_ = false;
 
     reset();
 
@@ -535,20 +570,16 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     scalar_t& intermediateCost,
     scalar_t& finalCost) const
 {
-    intermediateCost = 0;
-
-    for (size_t k = 0; k < (size_t)K_; k++)
-    {
-        // feed current state and control to cost function
-        costFunctions_[threadId]->setCurrentStateAndControl(x_local[k], u_local[k], settings_.dt * k);
+    assert(u_local.size() == (size_t)K_);
 
-        // derivative of cost with respect to state
-        intermediateCost += costFunctions_[threadId]->evaluateIntermediate();
-    }
+    intermediateCost = costFunctions_[threadId]->evaluateIntermediateHorizon(x_local, u_local, settings_.dt);
     intermediateCost *= settings_.dt;
 
     costFunctions_[threadId]->setCurrentStateAndControl(x_local[K_], control_vector_t::Zero(), settings_.dt * K_);
     finalCost = costFunctions_[threadId]->evaluateTerminal();
+
+    if (useAugmentedLagrangian())
+        intermediateCost += computeAugmentedLagrangianOfTrajectory(threadId, x_local, u_local);
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -632,9 +663,17 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::executeLQApproximation(size_t threadId,
     size_t k)
+{
+    executeDynamicsApproximation(threadId, k);
+    executeCostApproximation(threadId, k, k);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::executeDynamicsApproximation(
+    size_t threadId,
+    size_t k)
 {
     LQOCProblem_t& p = *lqocProblem_;
-    const scalar_t& dt = settings_.dt;
 
     assert(lqocProblem_ != nullptr);
 
@@ -655,28 +694,41 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     // compute dynamics offset term b_n
     p.b_[k] = d_[k] + x_[k + 1] - p.A_[k] * x_[k] - p.B_[k] * u_ff_[k];
 
-    // feed current state and control to cost function
-    costFunctions_[threadId]->setCurrentStateAndControl(x_[k], u_ff_[k], dt * k);
+    // set current reference trajectories x_n and u_n
+    p.x_[k] = x_[k];
+    p.u_[k] = u_ff_[k];
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::executeCostApproximation(
+    size_t threadId,
+    size_t firstIndex,
+    size_t lastIndex)
+{
+    LQOCProblem_t& p = *lqocProblem_;
+    const scalar_t& dt = settings_.dt;
+
+    assert(lqocProblem_ != nullptr);
+    assert(lqocProblem_->Q_.size() > lastIndex);
 
-    // By using the following order of evaluations, we avoid caching matrices
-    // second derivative w.r.t state
-    p.Q_[k] = costFunctions_[threadId]->stateSecondDerivativeIntermediate() * dt;
-    // second derivative w.r.t control
-    p.R_[k] = costFunctions_[threadId]->controlSecondDerivativeIntermediate() * dt;
-    // cross terms
-    p.P_[k] = costFunctions_[threadId]->stateControlDerivativeIntermediate() * dt;
+    // the first derivatives are computed into qv and rv and mapped into LQ problem coordinates below
+    costFunctions_[threadId]->intermediateDerivativesHorizon(
+        x_, u_ff_, dt, firstIndex, lastIndex, p.qv_, p.Q_, p.rv_, p.R_, p.P_);
 
-    // derivative of cost with respect to state
-    p.qv_[k] =
-        costFunctions_[threadId]->stateDerivativeIntermediate() * dt - p.Q_[k] * x_[k] - p.P_[k].transpose() * u_ff_[k];
-    // derivative of cost with respect to control
-    p.rv_[k] = costFunctions_[threadId]->controlDerivativeIntermediate() * dt - p.R_[k] * u_ff_[k] - p.P_[k] * x_[k];
+    for (size_t k = firstIndex; k <= lastIndex; k++)
+    {
+        p.Q_[k] *= dt;
+        p.R_[k] *= dt;
+        p.P_[k] *= dt;
 
-    // p.q_[k] = ... // not evaluated since we don't need it in GNMS/iLQR -- WARNING, potentially implement when using a different QP solver
+        p.qv_[k] = p.qv_[k] * dt - p.Q_[k] * x_[k] - p.P_[k].transpose() * u_ff_[k];
+        p.rv_[k] = p.rv_[k] * dt - p.R_[k] * u_ff_[k] - p.P_[k] * x_[k];
 
-    // set current reference trajectories x_n and u_n
-    p.x_[k] = x_[k];
-    p.u_[k] = u_ff_[k];
+        // p.q_[k] = ... // not evaluated since we don't need it in GNMS/iLQR -- WARNING, potentially implement when using a different QP solver
+
+        if (useAugmentedLagrangian())
+            addAugmentedLagrangianApproximation(threadId, k);
+    }
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -740,8 +792,8 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     size_t threadId,
     size_t k)
 {
-    // set general if there are any
-    if (generalConstraints_[threadId] != nullptr)
+    // set general if there are any, unless they are part of the augmented Lagrangian
+    if (generalConstraints_[threadId] != nullptr && !useAugmentedLagrangian())
     {
         LQOCProblem_t& p = *lqocProblem_;
         const scalar_t& dt = settings_.dt;
@@ -784,7 +836,11 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     p.x_[K_] = x_[K_];
 
     // init terminal general constraints, if any
-    if (generalConstraints_[settings_.nThreads] != nullptr)
+    if (useAugmentedLagrangian())
+    {
+        addAugmentedLagrangianApproximation(settings_.nThreads, K_);
+    }
+    else if (generalConstraints_[settings_.nThreads] != nullptr)
     {
         p.ng_[K_] = generalConstraints_[settings_.nThreads]->getTerminalConstraintsCount();
         if (p.ng_[K_] > 0)
@@ -804,6 +860,206 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     }
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::useAugmentedLagrangian() const
+{
+    return settings_.augmentedLagrangianSettings.active && generalConstraints_[settings_.nThreads] != nullptr;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::evaluateGeneralConstraints(
+    size_t threadId,
+    size_t k,
+    const state_vector_t& x,
+    const control_vector_t& u,
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& g,
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& lb,
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& ub) const
+{
+    const typename OptConProblem_t::ConstraintPtr_t& con = generalConstraints_[threadId];
+    con->setCurrentStateAndControl(x, u, settings_.dt * k);
+
+    if (k < (size_t)K_)
+    {
+        g = con->evaluateIntermediate();
+        lb = con->getLowerBoundsIntermediate();
+        ub = con->getUpperBoundsIntermediate();
+    }
+    else
+    {
+        g = con->evaluateTerminal();
+        lb = con->getLowerBoundsTerminal();
+        ub = con->getUpperBoundsTerminal();
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+SCALAR NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::evaluateAugmentedLagrangian(
+    size_t k,
+    const Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& g,
+    const Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& lb,
+    const Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& ub,
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>* gradient,
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>* weight) const
+{
+    const scalar_t mu = alPenalty_;
+    const Eigen::Index n = g.size();
+
+    // multipliers which have not been updated yet are zero
+    const bool hasMultipliers = k < alMultipliersLower_.size() && alMultipliersLower_[k].size() == n;
+
+    if (gradient)
+        gradient->setZero(n);
+    if (weight)
+        weight->setZero(n);
+
+    scalar_t value = 0.0;
+    for (Eigen::Index i = 0; i < n; i++)
+    {
+        const scalar_t lambdaLower = hasMultipliers ? alMultipliersLower_[k](i) : 0.0;
+        const scalar_t lambdaUpper = hasMultipliers ? alMultipliersUpper_[k](i) : 0.0;
+
+        const scalar_t nuLower = std::max(scalar_t(0.0), lambdaLower + mu * (lb(i) - g(i)));
+        const scalar_t nuUpper = std::max(scalar_t(0.0), lambdaUpper + mu * (g(i) - ub(i)));
+
+        value += (nuLower * nuLower - lambdaLower * lambdaLower + nuUpper * nuUpper - lambdaUpper * lambdaUpper) /
+                 (2.0 * mu);
+
+        if (gradient)
+            (*gradient)(i) = nuUpper - nuLower;
+        if (weight)
+            (*weight)(i) = mu * ((nuLower > 0.0) + (nuUpper > 0.0));
+    }
+
+    return value;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+SCALAR NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::computeAugmentedLagrangianOfTrajectory(
+    size_t threadId,
+    const ct::core::StateVectorArray<STATE_DIM, SCALAR>& x_local,
+    const ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>& u_local) const
+{
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> g, lb, ub;
+    scalar_t value = 0.0;
+
+    for (size_t k = 0; k <= (size_t)K_; k++)
+    {
+        const control_vector_t& u = (k < (size_t)K_) ? u_local[k] : control_vector_t::Zero();
+        evaluateGeneralConstraints(threadId, k, x_local[k], u, g, lb, ub);
+        value += evaluateAugmentedLagrangian(k, g, lb, ub);
+    }
+
+    return value;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::addAugmentedLagrangianApproximation(
+    size_t threadId,
+    size_t k)
+{
+    LQOCProblem_t& p = *lqocProblem_;
+    const typename OptConProblem_t::ConstraintPtr_t& con = generalConstraints_[threadId];
+    const bool terminal = (k == (size_t)K_);
+
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> g, lb, ub, gradient, weight;
+    const control_vector_t u = terminal ? control_vector_t::Zero() : u_ff_[k];
+    evaluateGeneralConstraints(threadId, k, x_[k], u, g, lb, ub);
+
+    if (g.size() == 0)
+        return;
+
+    evaluateAugmentedLagrangian(k, g, lb, ub, &gradient, &weight);
+
+    const Eigen::Matrix<SCALAR, Eigen::Dynamic, STATE_DIM> C =
+        terminal ? con->jacobianStateTerminal() : con->jacobianStateIntermediate();
+
+    // Gauss-Newton approximation, only the currently active bounds contribute
+    const state_matrix_t Q_al = C.transpose() * weight.asDiagonal() * C;
+    p.Q_[k] += Q_al;
+    p.qv_[k] += C.transpose() * gradient - Q_al * x_[k];
+
+    if (terminal)
+        return;
+
+    const Eigen::Matrix<SCALAR, Eigen::Dynamic, CONTROL_DIM> D = con->jacobianInputIntermediate();
+    const control_matrix_t R_al = D.transpose() * weight.asDiagonal() * D;
+    const control_state_matrix_t P_al = D.transpose() * weight.asDiagonal() * C;
+
+    p.R_[k] += R_al;
+    p.P_[k] += P_al;
+    p.qv_[k] -= P_al.transpose() * u_ff_[k];
+    p.rv_[k] += D.transpose() * gradient - R_al * u_ff_[k] - P_al * x_[k];
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::updateAugmentedLagrangian()
+{
+    if (!useAugmentedLagrangian())
+        return false;
+
+    const AugmentedLagrangianSettings& al = settings_.augmentedLagrangianSettings;
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> g, lb, ub;
+
+    // largest violation of the current trajectory
+    scalar_t violation = 0.0;
+    for (size_t k = 0; k <= (size_t)K_; k++)
+    {
+        const control_vector_t u = (k < (size_t)K_) ? u_ff_[k] : control_vector_t::Zero();
+        evaluateGeneralConstraints(settings_.nThreads, k, x_[k], u, g, lb, ub);
+        if (g.size() > 0)
+            violation = std::max(violation, std::max((lb - g).maxCoeff(), (g - ub).maxCoeff()));
+    }
+
+    if (violation <= al.tolerance)
+    {
+        if (settings_.debugPrint || settings_.printSummary)
+            std::cout << "Augmented Lagrangian: general constraints satisfied, max violation " << violation
+                      << std::endl;
+        return false;
+    }
+
+    // first order multiplier update
+    for (size_t k = 0; k <= (size_t)K_; k++)
+    {
+        const control_vector_t u = (k < (size_t)K_) ? u_ff_[k] : control_vector_t::Zero();
+        evaluateGeneralConstraints(settings_.nThreads, k, x_[k], u, g, lb, ub);
+
+        if (alMultipliersLower_[k].size() != g.size())
+        {
+            alMultipliersLower_[k].setZero(g.size());
+            alMultipliersUpper_[k].setZero(g.size());
+        }
+
+        alMultipliersLower_[k] = (alMultipliersLower_[k] + alPenalty_ * (lb - g)).cwiseMax(0.0);
+        alMultipliersUpper_[k] = (alMultipliersUpper_[k] + alPenalty_ * (g - ub)).cwiseMax(0.0);
+    }
+
+    if (violation > al.violationDecrease * alViolation_)
+        alPenalty_ = std::min(al.penaltyFactor * alPenalty_, al.penaltyMax);
+    alViolation_ = violation;
+
+    if (settings_.debugPrint || settings_.printSummary)
+        std::cout << "Augmented Lagrangian: max violation " << violation << ", updated multipliers, penalty "
+                  << alPenalty_ << std::endl;
+
+    // the cost of the current trajectory changes with the multipliers, previous filter entries are meaningless
+    filter_.clear();
+    updateCosts();
+    lowestCost_ = intermediateCostBest_ + finalCostBest_;
+
+    return true;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::resetAugmentedLagrangian()
+{
+    alMultipliersLower_.assign(K_ + 1, Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>());
+    alMultipliersUpper_.assign(K_ + 1, Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>());
+    alPenalty_ = settings_.augmentedLagrangianSettings.penalty_0;
+    alViolation_ = std::numeric_limits<scalar_t>::infinity();
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::printSummary()
 {
@@ -818,7 +1074,9 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
                         settings_.meritFunctionRhoConstraints * (e_box_norm_ + e_gen_norm_);
 
     SCALAR smallestEigenvalue = 0.0;
-    if (settings_.recordSmallestEigenvalue && settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER)
+    if (settings_.recordSmallestEigenvalue &&
+        (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER ||
+            settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::BOX_RICCATI_SOLVER))
     {
         smallestEigenvalue = lqocSolver_->getSmallestEigenvalue();
     }
@@ -843,7 +1101,8 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 
     //! @todo the printing of the smallest eigenvalue is hacky
     if (settings_.printSummary && settings_.recordSmallestEigenvalue &&
-        settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER)
+        (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER ||
+            settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::BOX_RICCATI_SOLVER))
     {
         std::cout << std::setprecision(15) << "smallest eigenvalue this iteration: " << smallestEigenvalue << std::endl;
     }
@@ -933,6 +1192,95 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::logIterationToBinary(const size_t& iteration)
+{
+    if (!binaryLogger_)
+        return;
+
+    BinaryLogRecord* r = binaryLogger_->beginRecord(binary_log::ITERATION);
+    if (r)
+    {
+        r->add("iteration", static_cast<int64_t>(iteration));
+        r->add("K", static_cast<int64_t>(K_));
+        r->add("dt", settings_.dt);
+        r->add("t", t_);
+        r->add("x", x_);
+        r->add("u_ff", u_ff_);
+        r->add("L", L_);
+        r->add("d", d_);
+        r->add("xShot", xShot_);
+
+        // summary of this iteration, as recorded by printSummary()
+        if (!summaryAllIterations_.iterations.empty())
+        {
+            r->add("cost", static_cast<double>(summaryAllIterations_.totalCosts.back()));
+            r->add("merit", static_cast<double>(summaryAllIterations_.merits.back()));
+            r->add("d_norm", static_cast<double>(summaryAllIterations_.defect_l1_norms.back()));
+            r->add("e_box_norm", static_cast<double>(summaryAllIterations_.e_box_norms.back()));
+            r->add("e_gen_norm", static_cast<double>(summaryAllIterations_.e_gen_norms.back()));
+        }
+        r->add("lx_norm", static_cast<double>(lx_norm_));
+        r->add("lu_norm", static_cast<double>(lu_norm_));
+        r->add("alphaStep", static_cast<double>(alphaBest_));
+        binaryLogger_->commitRecord();
+    }
+
+    const LQOCProblem_t& p = *lqocProblem_;
+    r = binaryLogger_->beginRecord(binary_log::LQ_PROBLEM);
+    if (r)
+    {
+        r->add("iteration", static_cast<int64_t>(iteration));
+        r->add("A", p.A_);
+        r->add("B", p.B_);
+        r->add("b", p.b_);
+        r->add("Q", p.Q_);
+        r->add("P", p.P_);
+        r->add("R", p.R_);
+        r->add("qv", p.qv_);
+        r->add("rv", p.rv_);
+        r->add("q", p.q_);
+        binaryLogger_->commitRecord();
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::logInitToBinary()
+{
+    if (!binaryLogger_)
+        return;
+
+    BinaryLogRecord* r = binaryLogger_->beginRecord(binary_log::INIT);
+    if (r)
+    {
+        r->add("K", static_cast<int64_t>(K_));
+        r->add("dt", settings_.dt);
+        r->add("x", x_);
+        r->add("u_ff", u_ff_);
+        r->add("d", d_);
+        r->add("cost", static_cast<double>(getCost()));
+        binaryLogger_->commitRecord();
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::setBinaryLogger(
+    const std::shared_ptr<BinaryLogger>& logger)
+{
+    binaryLogger_ = logger;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const std::shared_ptr<BinaryLogger>&
+NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getBinaryLogger() const
+{
+    return binaryLogger_;
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 const core::ControlTrajectory<CONTROL_DIM, SCALAR>
 NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getControlTrajectory() const
@@ -1005,10 +1353,14 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     {
         // merit of previous trajectory
         d_norm_ = computeDefectsNorm<1>(d_);
-        lowestCost_ = intermediateCostBest_ + finalCostBest_ + d_norm_ * settings_.meritFunctionRho +
-                      (e_box_norm_ + e_gen_norm_) * settings_.meritFunctionRhoConstraints;
+        lowestCost_ = computeMerit(intermediateCostBest_, finalCostBest_, d_norm_, e_box_norm_, e_gen_norm_);
         lowestCostPrevious = lowestCost_;
 
+        // reference for accepting a step
+        lineSearchMeritReference_ = lowestCost_;
+        lineSearchCostReference_ = intermediateCostBest_ + finalCostBest_;
+        lineSearchViolationReference_ = d_norm_ + e_box_norm_ + e_gen_norm_;
+
         resetDefects();
 
 
@@ -1039,8 +1391,18 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
             {
                 std::cout << "WARNING: No better control found during line search. Converged." << std::endl;
             }
-            return false;
+            return updateAugmentedLagrangian();
         }
+
+        alphaExpPrevious_ = static_cast<int>(std::lround(std::log(alphaBest_ / settings_.lineSearchSettings.alpha_0) /
+                                                         std::log(settings_.lineSearchSettings.n_alpha)));
+
+        // a step which did not sufficiently decrease the cost was accepted for reducing the constraint violation,
+        // from now on the cost-violation pair of the previous iterate is forbidden
+        const LineSearchSettings& ls = settings_.lineSearchSettings;
+        const scalar_t costMargin = lineSearchCostReference_ - ls.filterGammaCost * lineSearchViolationReference_;
+        if (ls.type == LineSearchSettings::FILTER && !(intermediateCostBest_ + finalCostBest_ < costMargin))
+            filter_.emplace_back(costMargin, (1.0 - ls.filterGammaViolation) * lineSearchViolationReference_);
     }
 
     if ((fabs((lowestCostPrevious - lowestCost_) / lowestCostPrevious)) > settings_.min_cost_improvement)
@@ -1059,7 +1421,88 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
                   << fabs(lowestCostPrevious - lowestCost_) / lowestCostPrevious
                   << "x, which is lower than convergence criteria: " << settings_.min_cost_improvement << std::endl;
     }
-    return false;
+    return updateAugmentedLagrangian();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+SCALAR NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::computeMerit(
+    const scalar_t intermediateCost,
+    const scalar_t finalCost,
+    const scalar_t defectNorm,
+    const scalar_t e_box_norm,
+    const scalar_t e_gen_norm) const
+{
+    return intermediateCost + finalCost + settings_.meritFunctionRho * defectNorm +
+           settings_.meritFunctionRhoConstraints * (e_box_norm + e_gen_norm);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::acceptLineSearchStep(
+    const scalar_t intermediateCost,
+    const scalar_t finalCost,
+    const scalar_t defectNorm,
+    const scalar_t e_box_norm,
+    const scalar_t e_gen_norm) const
+{
+    const LineSearchSettings& ls = settings_.lineSearchSettings;
+
+    if (ls.type == LineSearchSettings::MERIT)
+    {
+        const scalar_t merit = computeMerit(intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm);
+        return !std::isnan(merit) && merit < lineSearchMeritReference_;
+    }
+
+    const scalar_t cost = intermediateCost + finalCost;
+    const scalar_t violation = defectNorm + e_box_norm + e_gen_norm;
+    if (!std::isfinite(cost) || !std::isfinite(violation))
+        return false;
+
+    // sufficient decrease of either constraint violation or cost compared to the current iterate
+    if (!(violation < (1.0 - ls.filterGammaViolation) * lineSearchViolationReference_ ||
+            cost < lineSearchCostReference_ - ls.filterGammaCost * lineSearchViolationReference_))
+        return false;
+
+    // not dominated by any previous iterate in the filter
+    for (const auto& entry : filter_)
+    {
+        if (cost >= entry.first && violation >= entry.second)
+            return false;
+    }
+    return true;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+SCALAR NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getLineSearchAlpha(
+    const int exponent) const
+{
+    return settings_.lineSearchSettings.alpha_0 * std::pow(settings_.lineSearchSettings.n_alpha, exponent);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+int NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getLineSearchMinExponent() const
+{
+    const LineSearchSettings& ls = settings_.lineSearchSettings;
+    if (!ls.adaptive)
+        return 0;
+
+    // largest step size alpha_0 * n_alpha^exponent not exceeding alpha_max
+    return std::min(0, static_cast<int>(std::ceil(std::log(ls.alpha_max / ls.alpha_0) / std::log(ls.n_alpha) - 1e-9)));
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+int NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getLineSearchStartExponent() const
+{
+    if (!settings_.lineSearchSettings.adaptive)
+        return 0;
+
+    // try one step size larger than the one accepted last, up to alpha_max
+    const int maxExponent = static_cast<int>(settings_.lineSearchSettings.maxIterations) - 1;
+    return std::max(getLineSearchMinExponent(), std::min(alphaExpPrevious_ - 1, maxExponent));
 }
 
 
@@ -1148,12 +1591,14 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 {
     lqpCounter_++;
 
-    // if solver is HPIPM, there's nothing to prepare
-    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER)
+    // if solver is HPIPM or condensing, there's nothing to prepare
+    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER ||
+        settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::CONDENSING_SOLVER)
     {
     }
-    // if solver is GNRiccati - we iterate backward up to the first stage
-    else if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER)
+    // if solver is a Riccati solver - we iterate backward up to the first stage
+    else if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER ||
+             settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::BOX_RICCATI_SOLVER)
     {
         lqocSolver_->setProblem(lqocProblem_);
 
@@ -1171,12 +1616,14 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 {
     lqpCounter_++;
 
-    // if solver is HPIPM, solve the full problem
-    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER)
+    // if solver is HPIPM or condensing, solve the full problem
+    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER ||
+        settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::CONDENSING_SOLVER)
     {
         solveFullLQProblem();
     }
-    else if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER)
+    else if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER ||
+             settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::BOX_RICCATI_SOLVER)
     {
         lqocSolver_->setProblem(lqocProblem_);
 
@@ -1254,7 +1701,10 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     finalCostBest_ = std::numeric_limits<scalar_t>::infinity();
     intermediateCostPrevious_ = std::numeric_limits<scalar_t>::infinity();
     finalCostPrevious_ = std::numeric_limits<scalar_t>::infinity();
+    filter_.clear();
+    alphaExpPrevious_ = 0;
     resetDefects();
+    resetAugmentedLagrangian();
 }
 
 
@@ -1267,6 +1717,124 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     alphaBest_ = 1.0;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+size_t NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::shiftLQApproximation(
+    size_t firstIndex,
+    size_t lastIndex)
+{
+    numReusedStages_ = 0;
+
+    const size_t K_shot = getNumStepsPerShot();
+    const size_t shift = numShiftedStages_;
+    LQOCProblem_t& p = *lqocProblem_;
+
+    // only shifts about multiples of the shot length preserve the shots
+    if (!lqApproximationShiftable_ || settings_.closedLoopShooting ||
+        generalConstraints_[settings_.nThreads] != nullptr || shift % K_shot != 0)
+    {
+        rolloutShots(firstIndex, lastIndex);
+        computeLQApproximation(firstIndex, lastIndex);
+        return numReusedStages_;
+    }
+
+    auto deviation = [&](size_t k, size_t kPrev) {
+        return std::max((x_[k] - p.x_[kPrev]).template lpNorm<Eigen::Infinity>(),
+            (u_ff_[k] - p.u_[kPrev]).template lpNorm<Eigen::Infinity>());
+    };
+    const SCALAR tol = settings_.mpcShiftWarmStartTolerance;
+
+    // move reusable shots to their new position. Sources are located behind their destination, hence shifting in
+    // increasing order does not overwrite data which is still needed
+    std::vector<bool> reuseShot;
+    for (size_t k = firstIndex; k <= lastIndex; k += K_shot)
+    {
+        const size_t kEnd = std::min(k + K_shot, (size_t)K_);
+
+        bool reuse = (kEnd - 1 + shift < (size_t)K_);
+        for (size_t i = k; reuse && i < kEnd; i++)
+            reuse = deviation(i, i + shift) <= tol;
+
+        reuseShot.push_back(reuse);
+        if (!reuse)
+            continue;
+
+        for (size_t i = k; i < kEnd && shift > 0; i++)
+        {
+            const size_t iPrev = i + shift;
+            p.A_[i] = p.A_[iPrev];
+            p.B_[i] = p.B_[iPrev];
+            p.b_[i] = p.b_[iPrev];
+            p.Q_[i] = p.Q_[iPrev];
+            p.R_[i] = p.R_[iPrev];
+            p.P_[i] = p.P_[iPrev];
+            p.q_[i] = p.q_[iPrev];
+            p.qv_[i] = p.qv_[iPrev];
+            p.rv_[i] = p.rv_[iPrev];
+            p.x_[i] = p.x_[iPrev];
+            p.u_[i] = p.u_[iPrev];
+            xShot_[i] = xShot_[iPrev];
+            std::swap((*substepsX_)[i], (*substepsX_)[iPrev]);
+            std::swap((*substepsU_)[i], (*substepsU_)[iPrev]);
+        }
+
+        // restore the states inside the shot as obtained from the rollout
+        for (size_t i = k + 1; i < kEnd; i++)
+            x_[i] = xShot_[i - 1];
+        if (kEnd == (size_t)K_)
+            x_[K_] = xShot_[K_ - 1];
+
+        computeSingleDefect(k, x_, xShot_, d_);
+        numReusedStages_ += kEnd - k;
+    }
+
+    // roll out and linearize the remaining shots, in blocks of consecutive shots
+    bool costToGoInitialized = false;
+    size_t shotIdx = 0;
+    for (size_t k = firstIndex; k <= lastIndex; k += K_shot, shotIdx++)
+    {
+        if (reuseShot[shotIdx])
+            continue;
+
+        size_t kLast = k;
+        while (kLast + K_shot <= lastIndex && !reuseShot[shotIdx + 1])
+        {
+            kLast += K_shot;
+            shotIdx++;
+        }
+        const size_t kEnd = std::min(std::min(kLast + K_shot, (size_t)K_), lastIndex + 1);
+
+        rolloutShots(k, kLast);
+        computeLQApproximation(k, kEnd - 1);
+
+        costToGoInitialized = costToGoInitialized || (kEnd == (size_t)K_);
+        k = kLast;
+    }
+
+    if (!costToGoInitialized)
+        initializeCostToGo();
+
+    return numReusedStages_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::setMPCShift(const SCALAR& shift)
+{
+    numShiftedStages_ = std::max(0l, std::lround(shift / settings_.dt));
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::setLQApproximationShiftable(
+    bool shiftable)
+{
+    lqApproximationShiftable_ = shiftable;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+size_t NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getNumReusedStages() const
+{
+    return numReusedStages_;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::logSummaryToMatlab(
     const std::string& fileName)
@@ -1274,6 +1842,13 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     summaryAllIterations_.logToMatlab(fileName);
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::logSummaryToBinary()
+{
+    if (binaryLogger_)
+        summaryAllIterations_.logToBinary(*binaryLogger_);
+}
+
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 const SummaryAllIterations<SCALAR>&
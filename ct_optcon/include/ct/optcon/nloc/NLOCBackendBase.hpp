@@ -17,6 +17,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <ct/optcon/solver/NLOptConSettings.hpp>
 
+#include <ct/optcon/logging/BinaryLogger.h>
+
 #include "NLOCResults.hpp"
 
 #ifdef MATLAB
@@ -268,6 +270,26 @@ public:
     //! log the initial guess to Matlab
     void logInitToMatlab();
 
+    //! log trajectories, policy and LQ problem of an iteration to the binary logger, if there is one
+    /*!
+      In contrast to logToMatlab(), this function only copies the data into the queue of the logger, the file is
+      written by a background thread. Call after printSummary(), the summary of the iteration is included.
+    */
+    void logIterationToBinary(const size_t& iteration);
+
+    //! log the initial guess to the binary logger, if there is one
+    void logInitToBinary();
+
+    //! set the binary logger, e.g. to write several solvers into one file. nullptr disables binary logging.
+    /*!
+     * configure() replaces the logger according to NLOptConSettings::logToBinary, call this function afterwards.
+     * \warning BinaryLogger supports a single producer, only one solver at a time may log into a logger instance.
+     */
+    void setBinaryLogger(const std::shared_ptr<BinaryLogger>& logger);
+
+    //! the binary logger, nullptr if binary logging is disabled
+    const std::shared_ptr<BinaryLogger>& getBinaryLogger() const;
+
     //! return the cost of the solution of the current iteration
     SCALAR getCost() const;
 
@@ -365,11 +387,71 @@ public:
     //! performLineSearch: execute the line search, possibly with different threading schemes
     virtual SCALAR performLineSearch() = 0;
 
+    //! merit of a trajectory, trades off cost and constraint violations with the penalties from the settings
+    scalar_t computeMerit(const scalar_t intermediateCost,
+        const scalar_t finalCost,
+        const scalar_t defectNorm,
+        const scalar_t e_box_norm,
+        const scalar_t e_gen_norm) const;
+
+    /*!
+     * \brief check if a line search trial is acceptable
+     *
+     * Compares the trial to the trajectory at the start of the line search, either by merit or, for
+     * LineSearchSettings::FILTER, by cost and constraint violation against the current iterate and the filter.
+     */
+    bool acceptLineSearchStep(const scalar_t intermediateCost,
+        const scalar_t finalCost,
+        const scalar_t defectNorm,
+        const scalar_t e_box_norm,
+        const scalar_t e_gen_norm) const;
+
+    //! step size for an exponent, alpha_0 * n_alpha^exponent
+    scalar_t getLineSearchAlpha(const int exponent) const;
+
+    //! smallest step size exponent, negative if adaptive and alpha_max exceeds alpha_0
+    int getLineSearchMinExponent() const;
+
+    //! step size exponent the line search starts with, adapted to the previous iteration if adaptive
+    int getLineSearchStartExponent() const;
+
     //! simple full-step update for state and feedforward control (used for MPC-mode!)
     void doFullStepUpdate();
 
+    /*!
+     * \brief build the LQ approximation by shifting the one of the previous MPC cycle (MPC warm start)
+     *
+     * The current initial guess is assumed to be the previous one shifted about the time set with setMPCShift().
+     * Every shot whose states and controls deviate by less than mpcShiftWarmStartTolerance from the shifted
+     * linearization points is reused, including its end state and substeps. All other shots, typically the new tail
+     * of the horizon, are rolled out and linearized.
+     *
+     * \warning the reused stages keep the time of their original linearization, hence this is only valid for
+     * time-invariant dynamics and cost.
+     *
+     * Falls back to rolloutShots() and computeLQApproximation() if no consistent approximation is stored, if the
+     * shift is not a multiple of the shot length, for closed-loop shooting and in presence of general constraints.
+     *
+     * @param firstIndex first stage to approximate, needs to be the start of a shot
+     * @param lastIndex last stage to approximate
+     * @return number of reused stages
+     */
+    size_t shiftLQApproximation(size_t firstIndex, size_t lastIndex);
+
+    //! set the time the initial guess was shifted about since the stored LQ approximation was computed, set by MPC
+    void setMPCShift(const SCALAR& shift);
+
+    //! mark whether the LQ approximation of all stages is consistent and may be shifted in the next MPC cycle
+    void setLQApproximationShiftable(bool shiftable);
+
+    //! number of stages reused by the last call to shiftLQApproximation()
+    size_t getNumReusedStages() const;
+
     void logSummaryToMatlab(const std::string& fileName);
 
+    //! log the summary of all iterations to the binary logger, if there is one
+    void logSummaryToBinary();
+
     const SummaryAllIterations<SCALAR>& getSummary() const;
 
 protected:
@@ -409,6 +491,25 @@ protected:
     */
     void executeLQApproximation(size_t threadId, size_t k);
 
+    //! Computes the affine dynamics approximation A, B and b at a specific point of the trajectory
+    /*!
+      \param threadId the id of the worker thread
+      \param k step k
+    */
+    void executeDynamicsApproximation(size_t threadId, size_t k);
+
+    //! Computes the quadratic cost approximation for the steps firstIndex ... lastIndex
+    /*!
+      The cost function evaluates all steps in one call, such that cost functions made of analytical terms
+      go through every term only once, see CostFunctionQuadratic::intermediateDerivativesHorizon().
+      The result is mapped into the coordinates of the LQ problem.
+
+      \param threadId the id of the worker thread
+      \param firstIndex first step
+      \param lastIndex last step
+    */
+    void executeCostApproximation(size_t threadId, size_t firstIndex, size_t lastIndex);
+
 
     //! Computes the linearized general constraints at a specific point of the trajectory
     /*!
@@ -422,6 +523,65 @@ protected:
     */
     void computeLinearizedConstraints(size_t threadId, size_t k);
 
+    //! True if the general constraints are handled by an augmented Lagrangian instead of the LQ solver
+    bool useAugmentedLagrangian() const;
+
+    //! Adds the augmented Lagrangian of the general constraints to the LQ approximation at step k
+    /*!
+      The gradient of the augmented Lagrangian is added to qv and rv, the Gauss-Newton approximation of its Hessian
+      to Q, R and P. The LQ problem stays unconstrained and can be solved by the Riccati solver.
+
+      \param threadId the id of the worker thread
+      \param k step k, the terminal constraints are treated for k = K
+    */
+    void addAugmentedLagrangianApproximation(size_t threadId, size_t k);
+
+    //! Evaluates the general constraints and their bounds at step k, the terminal constraints for k = K
+    void evaluateGeneralConstraints(size_t threadId,
+        size_t k,
+        const state_vector_t& x,
+        const control_vector_t& u,
+        Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& g,
+        Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& lb,
+        Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& ub) const;
+
+    //! Evaluates the augmented Lagrangian of the general constraints at step k
+    /*!
+      Uses the Powell-Hestenes-Rockafellar form for the lower and upper bounds of every constraint,
+      \f$ \frac{1}{2 \mu} (\max(0, \lambda + \mu c)^2 - \lambda^2) \f$ with \f$ c = g - ub \f$ or \f$ c = lb - g \f$.
+
+      \param k step k
+      \param g constraint values
+      \param lb lower bounds
+      \param ub upper bounds
+      \param gradient if not nullptr, the derivative with respect to g
+      \param weight if not nullptr, the diagonal Gauss-Newton Hessian with respect to g
+      \return the augmented Lagrangian
+    */
+    scalar_t evaluateAugmentedLagrangian(size_t k,
+        const Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& g,
+        const Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& lb,
+        const Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& ub,
+        Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>* gradient = nullptr,
+        Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>* weight = nullptr) const;
+
+    //! Augmented Lagrangian of the general constraints summed over a trajectory
+    scalar_t computeAugmentedLagrangianOfTrajectory(size_t threadId,
+        const core::StateVectorArray<STATE_DIM, SCALAR>& x_local,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u_local) const;
+
+    //! Outer augmented Lagrangian iteration, called once the current subproblem has converged
+    /*!
+      Updates the multipliers with the constraint values of the current trajectory and increases the penalty if the
+      constraint violation did not decrease sufficiently since the last update.
+
+      \return true if the general constraints are not yet satisfied and the iterations have to continue
+    */
+    bool updateAugmentedLagrangian();
+
+    //! Sets all multipliers to zero and the penalty to its initial value
+    void resetAugmentedLagrangian();
+
     //! Initializes cost to go
     /*!
      * This function initializes the cost-to-go function at time K.
@@ -577,6 +737,14 @@ protected:
     scalar_t finalCostBest_;
     scalar_t lowestCost_;
 
+    //! merit, cost and constraint violation at the start of the line search, see acceptLineSearchStep()
+    scalar_t lineSearchMeritReference_;
+    scalar_t lineSearchCostReference_;
+    scalar_t lineSearchViolationReference_;
+
+    //! filter of (cost, constraint violation) pairs which new iterates have to improve upon in one of the two
+    std::vector<std::pair<scalar_t, scalar_t>> filter_;
+
     //! costs of the previous iteration, required to determine convergence
     scalar_t intermediateCostPrevious_;
     scalar_t finalCostPrevious_;
@@ -599,11 +767,24 @@ protected:
 
     bool firstRollout_;
     scalar_t alphaBest_;
+    int alphaExpPrevious_;  //! step size exponent accepted in the previous line search
+
+    //! augmented Lagrangian multipliers of the lower and upper bounds of the general constraints, one entry per step
+    std::vector<Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>> alMultipliersLower_;
+    std::vector<Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>> alMultipliersUpper_;
+    scalar_t alPenalty_;    //! augmented Lagrangian penalty
+    scalar_t alViolation_;  //! largest general constraint violation at the last multiplier update
 
     //! a counter used to identify lqp problems in derived classes, i.e. for thread management in MP
     size_t lqpCounter_;
 
     SummaryAllIterations<SCALAR> summaryAllIterations_;
+
+    std::shared_ptr<BinaryLogger> binaryLogger_;  //! asynchronous logger, nullptr if binary logging is disabled
+
+    bool lqApproximationShiftable_;  //! true if the stored LQ approximation may be shifted, see shiftLQApproximation()
+    size_t numShiftedStages_;        //! shift of the initial guess w.r.t. the stored LQ approximation
+    size_t numReusedStages_;         //! number of stages reused by the last MPC warm start
 };
 
 
@@ -410,13 +410,35 @@ SCALAR NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 {
     Eigen::setNbThreads(1);  // disable Eigen multi-threading
 
-    alphaProcessed_.clear();
+    const LineSearchSettings& ls = this->settings_.lineSearchSettings;
+    alphaExpMax_ = static_cast<int>(ls.maxIterations);
+    alphaExpCandidates_.clear();
+    if (ls.speculative)
+    {
+        // most likely the previous step size fits again, evaluate it and its neighbours first
+        alphaExpMin_ = std::min(this->getLineSearchMinExponent(), alphaExpMax_);
+        const int predicted = std::max(alphaExpMin_, std::min(this->alphaExpPrevious_, alphaExpMax_ - 1));
+        if (alphaExpMin_ < alphaExpMax_)
+            alphaExpCandidates_.push_back(predicted);
+        for (int d = 1; predicted - d >= alphaExpMin_ || predicted + d < alphaExpMax_; d++)
+        {
+            if (predicted - d >= alphaExpMin_)
+                alphaExpCandidates_.push_back(predicted - d);
+            if (predicted + d < alphaExpMax_)
+                alphaExpCandidates_.push_back(predicted + d);
+        }
+    }
+    else
+    {
+        alphaExpMin_ = this->getLineSearchStartExponent();
+        for (int alphaExp = alphaExpMin_; alphaExp < alphaExpMax_; alphaExp++)
+            alphaExpCandidates_.push_back(alphaExp);
+    }
+
+    alphaProcessed_.assign(std::max(0, alphaExpMax_ - alphaExpMin_), 0);
     alphaTaken_ = 0;
-    alphaBestFound_ = false;
-    alphaExpBest_ = this->settings_.lineSearchSettings.maxIterations;
-    alphaExpMax_ = this->settings_.lineSearchSettings.maxIterations;
-    alphaProcessed_.resize(this->settings_.lineSearchSettings.maxIterations, 0);
-    lowestCostPrevious_ = this->lowestCost_;
+    alphaBestFound_ = alphaExpCandidates_.empty();
+    alphaExpBest_ = alphaExpMax_;
 
 #ifdef DEBUG_PRINT_MP
     std::cout << "[MP]: Waking up workers." << std::endl;
@@ -438,8 +460,7 @@ SCALAR NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     double alphaBest = 0.0;
     if (alphaExpBest_ != alphaExpMax_)
     {
-        alphaBest = this->settings_.lineSearchSettings.alpha_0 *
-                    std::pow(this->settings_.lineSearchSettings.n_alpha, alphaExpBest_);
+        alphaBest = this->getLineSearchAlpha(alphaExpBest_);
     }
 
     Eigen::setNbThreads(this->settings_.nThreadsEigen);  // restore Eigen multi-threading
@@ -466,20 +487,25 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::li
 {
     while (true)
     {
-        size_t alphaExp = alphaTaken_++;
+        const size_t candidate = alphaTaken_++;
+
+        if (candidate >= alphaExpCandidates_.size() || alphaBestFound_)
+        {
+            return;
+        }
+
+        const int alphaExp = alphaExpCandidates_[candidate];
 
 #ifdef DEBUG_PRINT_MP
         printString("[Thread " + std::to_string(threadId) + "]: Taking alpha index " + std::to_string(alphaExp));
 #endif
 
-        if (alphaExp >= alphaExpMax_ || alphaBestFound_)
-        {
-            return;
-        }
+        // a larger step size has already been accepted
+        if (alphaExp > alphaExpBest_)
+            continue;
 
         //! convert to real alpha
-        double alpha =
-            this->settings_.lineSearchSettings.alpha_0 * std::pow(this->settings_.lineSearchSettings.n_alpha, alphaExp);
+        double alpha = this->getLineSearchAlpha(alphaExp);
 
         //! local variables
         SCALAR cost = std::numeric_limits<SCALAR>::max();
@@ -503,11 +529,12 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::li
             intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm, *substepsX, *substepsU, &alphaBestFound_);
 
         // compute merit
-        cost = intermediateCost + finalCost + this->settings_.meritFunctionRho * defectNorm +
-               this->settings_.meritFunctionRhoConstraints * (e_box_norm + e_gen_norm);
+        cost = this->computeMerit(intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm);
+        const bool accepted =
+            this->acceptLineSearchStep(intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm);
 
         lineSearchResultMutex_.lock();
-        if (cost < lowestCostPrevious_ && !std::isnan(cost))
+        if (accepted && alphaExp < alphaExpBest_)
         {
             // make sure we do not alter an existing result
             if (alphaBestFound_)
@@ -561,14 +588,19 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::li
             }
         }
 
-        alphaProcessed_[alphaExp] = 1;
+        alphaProcessed_[alphaExp - alphaExpMin_] = 1;
 
         // we now check if all alphas prior to the best have been processed
         // this also covers the case that there is no better alpha
+        // in speculative mode, it suffices that the next larger alpha has been processed and rejected
+        int firstRequired = alphaExpMin_;
+        if (this->settings_.lineSearchSettings.speculative && alphaExpBest_ < alphaExpMax_)
+            firstRequired = std::max(alphaExpMin_, alphaExpBest_ - 1);
+
         bool allPreviousAlphasProcessed = true;
-        for (size_t i = 0; i < alphaExpBest_; i++)
+        for (int i = firstRequired; i < alphaExpBest_; i++)
         {
-            if (alphaProcessed_[i] != 1)
+            if (alphaProcessed_[i - alphaExpMin_] != 1)
             {
                 allPreviousAlphasProcessed = false;
                 break;
@@ -124,19 +124,18 @@ private:
     std::condition_variable alphaBestFoundCondition_;
 
     std::atomic_size_t alphaTaken_;
-    size_t alphaMax_;
-    size_t alphaExpBest_;
-    size_t alphaExpMax_;
+    std::vector<int> alphaExpCandidates_;  //! step size exponents in the order the workers evaluate them
+    int alphaExpMin_;                      //! smallest candidate exponent, i.e. largest step size
+    int alphaExpMax_;                      //! one past the largest candidate exponent
+    std::atomic_int alphaExpBest_;         //! smallest accepted exponent so far, alphaExpMax_ if none
     std::atomic_bool alphaBestFound_;
-    std::vector<size_t> alphaProcessed_;
+    std::vector<size_t> alphaProcessed_;  //! indexed by exponent - alphaExpMin_
 
     std::atomic_size_t kTaken_;
     std::atomic_size_t kCompleted_;
 
     size_t KMax_;
     size_t KMin_;
-
-    SCALAR lowestCostPrevious_;
 };
 
 
@@ -44,11 +44,13 @@ void NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::co
 
     for (size_t k = firstIndex; k <= lastIndex; k++)
     {
-        this->executeLQApproximation(this->settings_.nThreads, k);
+        this->executeDynamicsApproximation(this->settings_.nThreads, k);
 
         if (this->generalConstraints_[this->settings_.nThreads] != nullptr)
             this->computeLinearizedConstraints(this->settings_.nThreads, k);
     }
+
+    this->executeCostApproximation(this->settings_.nThreads, firstIndex, lastIndex);
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -70,21 +72,25 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, type
 SCALAR NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::performLineSearch()
 {
     // we start with extrapolation
-    double alpha = this->settings_.lineSearchSettings.alpha_0;
+    int alphaExp = this->getLineSearchStartExponent();
+    const int maxTrials = static_cast<int>(this->settings_.lineSearchSettings.maxIterations) - alphaExp;
+    int trials = 0;
     double alphaBest = 0.0;
-    size_t iterations = 0;
 
     this->lx_norm_ = 0.0;
     this->lu_norm_ = 0.0;
 
 
-    while (iterations < this->settings_.lineSearchSettings.maxIterations)
+    while (alphaExp < static_cast<int>(this->settings_.lineSearchSettings.maxIterations))
     {
+        const double alpha = this->getLineSearchAlpha(alphaExp);
+
         if (this->settings_.lineSearchSettings.debugPrint)
-            std::cout << "[LineSearch]: Iteration: " << iterations << ", try alpha: " << alpha << " out of maximum "
-                      << this->settings_.lineSearchSettings.maxIterations << " iterations. " << std::endl;
+            std::cout << "[LineSearch]: Trial: " << trials << ", try alpha: " << alpha << " out of maximum "
+                      << maxTrials << " trials. " << std::endl;
 
-        iterations++;
+        alphaExp++;
+        trials++;
 
         SCALAR cost = std::numeric_limits<SCALAR>::max();
         SCALAR intermediateCost = std::numeric_limits<SCALAR>::max();
@@ -111,12 +117,10 @@ SCALAR NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 
 
         // compute merit
-        cost = intermediateCost + finalCost + this->settings_.meritFunctionRho * defectNorm +
-               this->settings_.meritFunctionRhoConstraints * (e_box_norm + e_gen_norm);
+        cost = this->computeMerit(intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm);
 
         // catch the case that a rollout might be unstable
-        if (std::isnan(cost) ||
-            cost >= this->lowestCost_)  // TODO: alternatively cost >= (this->lowestCost_*(1 - 1e-3*alpha)), study this
+        if (!this->acceptLineSearchStep(intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm))
         {
             if (this->settings_.lineSearchSettings.debugPrint)
             {
@@ -127,9 +131,6 @@ SCALAR NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
                 std::cout << "[LineSearch]: err gen constr:\t" + std::to_string(e_gen_norm) << std::endl;
                 std::cout << "[LineSearch]: Merit:\t" << cost << std::endl;
             }
-
-            // compute new alpha
-            alpha = alpha * this->settings_.lineSearchSettings.n_alpha;
         }
         else
         {
@@ -5,6 +5,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
+#include <ct/optcon/logging/BinaryLogger.h>
+
 #ifdef MATLAB
 #include <ct/optcon/matlab.hpp>
 #endif
@@ -88,6 +90,35 @@ struct SummaryAllIterations
 #endif
     }
 
+    //! write the summary of all iterations as a single record to a binary log
+    void logToBinary(ct::optcon::BinaryLogger& logger) const
+    {
+        typedef Eigen::Map<const Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>> Map_t;
+
+        ct::optcon::BinaryLogRecord* r = logger.beginRecord(ct::optcon::binary_log::SUMMARY);
+        if (!r)
+            return;
+
+        Eigen::Matrix<int64_t, Eigen::Dynamic, 1> iter(iterations.size());
+        for (size_t i = 0; i < iterations.size(); i++)
+            iter(i) = iterations[i];
+
+        r->add("iterations", iter);
+        r->add("defect_l1_norms", Map_t(defect_l1_norms.data(), defect_l1_norms.size()));
+        r->add("defect_l2_norms", Map_t(defect_l2_norms.data(), defect_l2_norms.size()));
+        r->add("box_constr_norms", Map_t(e_box_norms.data(), e_box_norms.size()));
+        r->add("gen_constr_norms", Map_t(e_gen_norms.data(), e_gen_norms.size()));
+        r->add("lx_norms", Map_t(lx_norms.data(), lx_norms.size()));
+        r->add("lu_norms", Map_t(lu_norms.data(), lu_norms.size()));
+        r->add("intermediateCosts", Map_t(intermediateCosts.data(), intermediateCosts.size()));
+        r->add("finalCosts", Map_t(finalCosts.data(), finalCosts.size()));
+        r->add("totalCosts", Map_t(totalCosts.data(), totalCosts.size()));
+        r->add("merits", Map_t(merits.data(), merits.size()));
+        r->add("stepSizes", Map_t(stepSizes.data(), stepSizes.size()));
+        r->add("smallestEigenvalues", Map_t(smallestEigenvalues.data(), smallestEigenvalues.size()));
+        logger.commitRecord();
+    }
+
 //! if building with MATLAB support, include matfile
 #ifdef MATLAB
     matlab::MatFile matFile_;
@@ -113,6 +113,8 @@ bool GNMS<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::finishItera
     if (this->backend_->iteration() == 0)
         this->backend_->logInitToMatlab();
 #endif
+    if (this->backend_->iteration() == 0)
+        this->backend_->logInitToBinary();
 
     auto start = std::chrono::steady_clock::now();
     this->backend_->computeLQApproximation(0, K_shot - 1);
@@ -155,6 +157,7 @@ bool GNMS<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::finishItera
 #ifdef MATLAB_FULL_LOG
     this->backend_->logToMatlab(this->backend_->iteration());
 #endif  //MATLAB_FULL_LOG
+    this->backend_->logIterationToBinary(this->backend_->iteration());
 
     this->backend_->iteration()++;
 
@@ -183,11 +186,20 @@ void GNMS<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::prepareMPCI
 
     this->backend_->resetDefects();
 
-    this->backend_->rolloutShots(K_shot, K - 1);
-
     auto start = std::chrono::steady_clock::now();
-    this->backend_->setBoxConstraintsForLQOCProblem();
-    this->backend_->computeLQApproximation(K_shot, K - 1);
+    if (this->backend_->getSettings().mpcShiftWarmStart)
+    {
+        this->backend_->setBoxConstraintsForLQOCProblem();
+        size_t nReused = this->backend_->shiftLQApproximation(K_shot, K - 1);
+        if (debugPrint)
+            std::cout << "[GNMS-MPC]: reused " << nReused << " of " << K - K_shot << " stages" << std::endl;
+    }
+    else
+    {
+        this->backend_->rolloutShots(K_shot, K - 1);
+        this->backend_->setBoxConstraintsForLQOCProblem();
+        this->backend_->computeLQApproximation(K_shot, K - 1);
+    }
     auto end = std::chrono::steady_clock::now();
     auto diff = end - start;
     if (debugPrint)
@@ -234,9 +246,12 @@ bool GNMS<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::finishMPCIt
     if (this->backend_->iteration() == 0)
         this->backend_->logInitToMatlab();
 #endif
+    if (this->backend_->iteration() == 0)
+        this->backend_->logInitToBinary();
 
     auto start = std::chrono::steady_clock::now();
     this->backend_->computeLQApproximation(0, K_shot - 1);
+    this->backend_->setLQApproximationShiftable(true);
     auto end = std::chrono::steady_clock::now();
     auto diff = end - start;
     if (debugPrint)
@@ -278,6 +293,7 @@ bool GNMS<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::finishMPCIt
 #ifdef MATLAB_FULL_LOG
     this->backend_->logToMatlab(this->backend_->iteration());
 #endif  //MATLAB_FULL_LOG
+    this->backend_->logIterationToBinary(this->backend_->iteration());
 
     this->backend_->iteration()++;
 
@@ -75,6 +75,8 @@ bool iLQR<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::finishItera
     if (this->backend_->iteration() == 0)
         this->backend_->logInitToMatlab();
 #endif
+    if (this->backend_->iteration() == 0)
+        this->backend_->logInitToBinary();
 
     auto start = std::chrono::steady_clock::now();
     auto startEntire = start;
@@ -127,6 +129,7 @@ bool iLQR<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::finishItera
 #ifdef MATLAB_FULL_LOG
     this->backend_->logToMatlab(this->backend_->iteration());
 #endif
+    this->backend_->logIterationToBinary(this->backend_->iteration());
 
     this->backend_->iteration()++;
 
@@ -115,6 +115,12 @@ public:
         xInit_ = xinit;
     }
 
+    /**
+     * @brief      Uses the current optimization variables as initial guess,
+     *             e.g. to warm start the next solve from the previous solution
+     */
+    void setSolutionAsInitialGuess() { xInit_ = x_; }
+
     /**
      * @brief      Checks if the optimization variables have to correct size
      *
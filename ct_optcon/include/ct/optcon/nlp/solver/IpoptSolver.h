@@ -81,6 +81,17 @@ public:
 
     bool solve() override;
 
+    /**
+	 * @brief      Solves the nlp warm started from the previous solution,
+	 *             including the bound and constraint multipliers. With the
+	 *             persistent solver setting, the IPOPT instance, the
+	 *             sparsity patterns and the scaling of the previous solve are
+	 *             reused.
+	 *
+	 * @return     Returns true of solve succeeded
+	 */
+    bool resolve() override;
+
     void prepareWarmStart(size_t maxIterations) override;
 
     void configureDerived(const NlpSolverSettings& settings) override;
@@ -108,6 +119,15 @@ public:
         bool init_lambda,
         SCALAR* lambda) override;
 
+    /** Method to return the scaling of the problem, used by the persistent solver */
+    bool get_scaling_parameters(SCALAR& obj_scaling,
+        bool& use_x_scaling,
+        Ipopt::Index n,
+        SCALAR* x_scaling,
+        bool& use_g_scaling,
+        Ipopt::Index m,
+        SCALAR* g_scaling) override;
+
     /** Method to return the objective value */
     bool eval_f(Ipopt::Index n, const SCALAR* x, bool new_x, SCALAR& obj_value) override;
 
@@ -169,9 +189,47 @@ private:
 	 * @brief      Sets the IPOPT solver options.
 	 */
     void setSolverOptions();
+
+    /**
+	 * @brief      Sets the IPOPT options for starting from the previous solution
+	 */
+    void setWarmStartOptions();
+
+    /**
+	 * @brief      Runs IPOPT, reoptimizing the previous problem in persistent mode
+	 *
+	 * @return     Returns true of solve succeeded
+	 */
+    bool optimize();
+
+    /**
+	 * @brief      Queries the sparsity pattern of the constraint jacobian from
+	 *             the nlp, unless it is cached by the persistent solver
+	 *
+	 * @param[in]  nele_jac  The number of non zeros in the constraint jacobian
+	 */
+    void updateSparsityPatternJacobian(Ipopt::Index nele_jac);
+
+    /**
+	 * @brief      Computes the gradient-based scaling of IPOPT at the initial
+	 *             guess, such that it can be kept across solves
+	 */
+    void computeScaling();
+
     std::shared_ptr<Ipopt::IpoptApplication> ipoptApp_; /*!< A pointer to ipopt*/
     Ipopt::ApplicationReturnStatus status_;             /*!< The return status of IPOPT*/
     IpoptSettings settings_;                            /*!< Contains the IPOPT settings*/
+
+    bool warmStart_;         /*!< solve() starts from the previous solution, see prepareWarmStart()*/
+    bool appInitialized_;    /*!< The IPOPT application has been initialized*/
+    bool hasOptimized_;      /*!< IPOPT has solved this nlp successfully, which can hence be reoptimized*/
+    Ipopt::Index nnzJac_;    /*!< Cached number of non zeros in the constraint jacobian, -1 if unknown*/
+    Ipopt::Index nnzHess_;   /*!< Cached number of non zeros in the hessian, -1 if unknown*/
+    Eigen::VectorXi jacRow_; /*!< Cached row indices of the constraint jacobian*/
+    Eigen::VectorXi jacCol_; /*!< Cached column indices of the constraint jacobian*/
+    bool hasScaling_;        /*!< The scaling has been computed*/
+    SCALAR objScaling_;      /*!< Cached scaling of the objective*/
+    VectorXs gScaling_;      /*!< Cached scaling of the constraints*/
 };
 
 #include "implementation/IpoptSolver-impl.h"
@@ -189,6 +247,7 @@ public:
     }
 
     bool solve() override { return false; }
+    bool resolve() override { return false; }
     void prepareWarmStart(size_t maxIterations) override {}
     void configureDerived(const NlpSolverSettings& settings) override {}
 };
@@ -73,6 +73,16 @@ public:
 	 */
     virtual bool solve() = 0;
 
+    /**
+	 * @brief      Solves the nlp again after the problem data changed but
+	 *             its structure did not, e.g. in MPC-like repeated solves.
+	 *             Solvers may reuse their internal data and warm start from
+	 *             the previous solution. Defaults to a regular solve.
+	 *
+	 * @return     Returns true of solve succeeded
+	 */
+    virtual bool resolve() { return solve(); }
+
     /**
 	 * @brief      Prepares the solver for a warmstarting scenario with
 	 *             available (good) initial guess
@@ -147,7 +147,8 @@ public:
           derivativeTestPrintAll_("no"),
           linearSystemScaling_("ma27"),
           linear_solver_("mumps"),
-          jacobianApproximation_("finite-difference-values")
+          jacobianApproximation_("finite-difference-values"),
+          persistentSolver_(false)
     {
     }
 
@@ -173,6 +174,7 @@ public:
     std::string linearSystemScaling_;
     std::string linear_solver_;
     std::string jacobianApproximation_;
+    bool persistentSolver_; /*!< keep the IPOPT instance, sparsity patterns and scaling across solves */
 
     /**
 	 * @brief      Prints out information about the settings
@@ -236,6 +238,7 @@ public:
         setParameterIfExists(pt, linear_solver_, "linear_solver", ns);
         setParameterIfExists(pt, linearSystemScaling_, "linearSystemScaling", ns);
         setParameterIfExists(pt, jacobianApproximation_, "jacobianApproximation", ns);
+        setParameterIfExists(pt, persistentSolver_, "persistentSolver", ns);
     }
 
     template <typename TYPE>
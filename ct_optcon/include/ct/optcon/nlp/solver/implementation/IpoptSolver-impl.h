@@ -10,7 +10,15 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 template <typename SCALAR>
 IpoptSolver<SCALAR>::IpoptSolver(std::shared_ptr<tpl::Nlp<SCALAR>> nlp, const NlpSolverSettings& settings)
-    : BASE(nlp, settings), settings_(BASE::settings_.ipoptSettings_)
+    : BASE(nlp, settings),
+      settings_(BASE::settings_.ipoptSettings_),
+      warmStart_(false),
+      appInitialized_(false),
+      hasOptimized_(false),
+      nnzJac_(-1),
+      nnzHess_(-1),
+      hasScaling_(false),
+      objScaling_(1.0)
 {
     //Constructor arguments
     //Argument 1: create console output
@@ -34,6 +42,14 @@ void IpoptSolver<SCALAR>::configureDerived(const NlpSolverSettings& settings)
     std::cout << "calling Ipopt configure derived" << std::endl;
     settings_ = settings.ipoptSettings_;
     setSolverOptions();
+
+    // the problem structure and scaling may have changed, start over with the next solve
+    appInitialized_ = false;
+    hasOptimized_ = false;
+    nnzJac_ = -1;
+    nnzHess_ = -1;
+    hasScaling_ = false;
+
     this->isInitialized_ = true;
 }
 
@@ -59,19 +75,71 @@ void IpoptSolver<SCALAR>::setSolverOptions()
     ipoptApp_->Options()->SetNumericValue("point_perturbation_radius", settings_.point_perturbation_radius_);
     ipoptApp_->Options()->SetStringValueIfUnset("linear_system_scaling", settings_.linearSystemScaling_);
     ipoptApp_->Options()->SetStringValueIfUnset("linear_solver", settings_.linear_solver_);
+
+    // IPOPT recomputes its scaling on every solve, the persistent solver provides the scaling of the first solve
+    if (settings_.persistentSolver_ && settings_.nlp_scaling_method_ == "gradient-based")
+        ipoptApp_->Options()->SetStringValue("nlp_scaling_method", "user-scaling");
+}
+
+template <typename SCALAR>
+void IpoptSolver<SCALAR>::setWarmStartOptions()
+{
+    ipoptApp_->Options()->SetStringValue("warm_start_init_point", "yes");
+    ipoptApp_->Options()->SetNumericValue("warm_start_bound_push", 1e-9);
+    ipoptApp_->Options()->SetNumericValue("warm_start_bound_frac", 1e-9);
+    ipoptApp_->Options()->SetNumericValue("warm_start_slack_bound_frac", 1e-9);
+    ipoptApp_->Options()->SetNumericValue("warm_start_slack_bound_push", 1e-9);
+    ipoptApp_->Options()->SetNumericValue("warm_start_mult_bound_push", 1e-9);
 }
 
 template <typename SCALAR>
 bool IpoptSolver<SCALAR>::solve()
 {
-    status_ = ipoptApp_->Initialize();
-    if (!(status_ == Ipopt::Solve_Succeeded) && !this->isInitialized_)
-        throw(std::runtime_error("NLP initialization failed"));
+    return optimize();
+}
+
+template <typename SCALAR>
+bool IpoptSolver<SCALAR>::resolve()
+{
+    if (!hasOptimized_)
+        return solve();
+
+    // the previous solution and multipliers are provided by the nlp in get_starting_point()
+    setWarmStartOptions();
+    bool success = optimize();
+
+    if (!warmStart_)
+        ipoptApp_->Options()->SetStringValue("warm_start_init_point", "no");
 
-    // Ask Ipopt to solve the problem
-    status_ = ipoptApp_->OptimizeTNLP(this);
+    return success;
+}
 
-    if (status_ == Ipopt::Solve_Succeeded || status_ == Ipopt::Solved_To_Acceptable_Level)
+template <typename SCALAR>
+bool IpoptSolver<SCALAR>::optimize()
+{
+    if (settings_.persistentSolver_ && hasOptimized_)
+    {
+        // keeps the IPOPT data structures of the previous solve, the problem structure must not have changed
+        status_ = ipoptApp_->ReOptimizeTNLP(this);
+    }
+    else
+    {
+        if (!settings_.persistentSolver_ || !appInitialized_)
+        {
+            status_ = ipoptApp_->Initialize();
+            if (!(status_ == Ipopt::Solve_Succeeded) && !this->isInitialized_)
+                throw(std::runtime_error("NLP initialization failed"));
+            appInitialized_ = true;
+        }
+
+        // Ask Ipopt to solve the problem
+        status_ = ipoptApp_->OptimizeTNLP(this);
+    }
+
+    // ReOptimizeTNLP() and warm starts require a previous successful solve
+    hasOptimized_ = (status_ == Ipopt::Solve_Succeeded || status_ == Ipopt::Solved_To_Acceptable_Level);
+
+    if (hasOptimized_)
     {
         // Retrieve some statistics about the solve
         if (settings_.printLevel_ > 1)
@@ -99,12 +167,8 @@ bool IpoptSolver<SCALAR>::solve()
 template <typename SCALAR>
 void IpoptSolver<SCALAR>::prepareWarmStart(size_t maxIterations)
 {
-    ipoptApp_->Options()->SetStringValue("warm_start_init_point", "yes");
-    ipoptApp_->Options()->SetNumericValue("warm_start_bound_push", 1e-9);
-    ipoptApp_->Options()->SetNumericValue("warm_start_bound_frac", 1e-9);
-    ipoptApp_->Options()->SetNumericValue("warm_start_slack_bound_frac", 1e-9);
-    ipoptApp_->Options()->SetNumericValue("warm_start_slack_bound_push", 1e-9);
-    ipoptApp_->Options()->SetNumericValue("warm_start_mult_bound_push", 1e-9);
+    warmStart_ = true;
+    setWarmStartOptions();
     ipoptApp_->Options()->SetIntegerValue("max_iter", (int)maxIterations);
     ipoptApp_->Options()->SetStringValue("derivative_test", "none");
 }
@@ -125,11 +189,17 @@ bool IpoptSolver<SCALAR>::get_nlp_info(Ipopt::Index& n,
     m = this->nlp_->getConstraintsCount();
     assert(m == m);
 
-    nnz_jac_g = static_cast<Ipopt::Index>(this->nlp_->getNonZeroJacobianCount());
+    if (!settings_.persistentSolver_ || nnzJac_ < 0)
+        nnzJac_ = static_cast<Ipopt::Index>(this->nlp_->getNonZeroJacobianCount());
+    nnz_jac_g = nnzJac_;
     assert(nnz_jac_g == nnz_jac_g);
 
     if (settings_.hessian_approximation_ == "exact")
-        nnz_h_lag = static_cast<Ipopt::Index>(this->nlp_->getNonZeroHessianCount());
+    {
+        if (!settings_.persistentSolver_ || nnzHess_ < 0)
+            nnzHess_ = static_cast<Ipopt::Index>(this->nlp_->getNonZeroHessianCount());
+        nnz_h_lag = nnzHess_;
+    }
 
     index_style = Ipopt::TNLP::C_STYLE;
 
@@ -218,6 +288,84 @@ bool IpoptSolver<SCALAR>::get_starting_point(Ipopt::Index n,
     return true;
 }
 
+template <typename SCALAR>
+bool IpoptSolver<SCALAR>::get_scaling_parameters(SCALAR& obj_scaling,
+    bool& use_x_scaling,
+    Ipopt::Index n,
+    SCALAR* x_scaling,
+    bool& use_g_scaling,
+    Ipopt::Index m,
+    SCALAR* g_scaling)
+{
+#ifdef DEBUG_PRINT
+    std::cout << "... entering get_scaling_parameters()" << std::endl;
+#endif  //DEBUG_PRINT
+    if (!hasScaling_)
+        computeScaling();
+
+    assert(gScaling_.size() == m);
+    obj_scaling = objScaling_;
+    use_x_scaling = false;
+    use_g_scaling = true;
+    MapVecXs g_scalingVec(g_scaling, m);
+    g_scalingVec = gScaling_;
+
+    return true;
+}
+
+template <typename SCALAR>
+void IpoptSolver<SCALAR>::computeScaling()
+{
+    // the rule of IPOPT's gradient-based scaling: functions whose gradient exceeds maxGradient in the maximum norm
+    // at the initial guess are scaled down to maxGradient
+    const SCALAR maxGradient = 100.0;
+    const SCALAR minScaling = 1e-8;
+    auto scaling = [&](SCALAR gradientNorm) {
+        return std::max(minScaling, std::min(SCALAR(1.0), maxGradient / gradientNorm));
+    };
+
+    const size_t n = this->nlp_->getVarCount();
+    const size_t m = this->nlp_->getConstraintsCount();
+    if (nnzJac_ < 0)
+        nnzJac_ = static_cast<Ipopt::Index>(this->nlp_->getNonZeroJacobianCount());
+
+    VectorXs x(n);
+    MapVecXs xVec(x.data(), n);
+    this->nlp_->getInitialGuess(n, xVec);
+    MapConstVecXs xConstVec(x.data(), n);
+    this->nlp_->extractOptimizationVars(xConstVec, true);
+
+    VectorXs grad(n);
+    MapVecXs gradVec(grad.data(), n);
+    this->nlp_->evaluateCostGradient(n, gradVec);
+    objScaling_ = scaling(grad.template lpNorm<Eigen::Infinity>());
+
+    updateSparsityPatternJacobian(nnzJac_);
+    VectorXs jac(nnzJac_);
+    MapVecXs jacVec(jac.data(), nnzJac_);
+    this->nlp_->evaluateConstraintJacobian(nnzJac_, jacVec);
+
+    VectorXs rowNorm = VectorXs::Zero(m);
+    for (Ipopt::Index k = 0; k < nnzJac_; k++)
+        rowNorm(jacRow_(k)) = std::max(rowNorm(jacRow_(k)), std::abs(jac(k)));
+
+    gScaling_ = rowNorm.unaryExpr(scaling);
+    hasScaling_ = true;
+}
+
+template <typename SCALAR>
+void IpoptSolver<SCALAR>::updateSparsityPatternJacobian(Ipopt::Index nele_jac)
+{
+    if (settings_.persistentSolver_ && jacRow_.size() == nele_jac)
+        return;
+
+    jacRow_.resize(nele_jac);
+    jacCol_.resize(nele_jac);
+    Eigen::Map<Eigen::VectorXi> iRowVec(jacRow_.data(), nele_jac);
+    Eigen::Map<Eigen::VectorXi> jColVec(jacCol_.data(), nele_jac);
+    this->nlp_->getSparsityPatternJacobian(nele_jac, iRowVec, jColVec);
+}
+
 template <typename SCALAR>
 bool IpoptSolver<SCALAR>::eval_f(Ipopt::Index n, const SCALAR* x, bool new_x, SCALAR& obj_value)
 {
@@ -289,9 +437,9 @@ bool IpoptSolver<SCALAR>::eval_jac_g(Ipopt::Index n,
         std::cout << "... entering eval_jac_g, values == NULL" << std::endl;
 #endif  //DEBUG_PRINT
         // set indices of nonzero elements of the jacobian
-        Eigen::Map<Eigen::VectorXi> iRowVec(iRow, nele_jac);
-        Eigen::Map<Eigen::VectorXi> jColVec(jCol, nele_jac);
-        this->nlp_->getSparsityPatternJacobian(nele_jac, iRowVec, jColVec);
+        updateSparsityPatternJacobian(nele_jac);
+        Eigen::Map<Eigen::VectorXi>(iRow, nele_jac) = jacRow_;
+        Eigen::Map<Eigen::VectorXi>(jCol, nele_jac) = jacCol_;
 
 
 #ifdef DEBUG_PRINT
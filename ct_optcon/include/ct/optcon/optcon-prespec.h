@@ -20,22 +20,34 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "problem/ContinuousOptConProblem.h"
 #include "problem/DiscreteOptConProblem.h"
 #include "problem/LQOCProblem.hpp"
+#include "problem/FixedHorizonLQOCProblem.hpp"
 
 #include "system_interface/OptconSystemInterface.h"
 #include "system_interface/OptconContinuousSystemInterface.h"
 #include "system_interface/OptconDiscreteSystemInterface.h"
 
+#include "logging/BinaryLogger.h"
+#include "logging/BinaryLogReader.h"
+
 #include "nloc/NLOCBackendBase.hpp"
 #include "nloc/NLOCBackendST.hpp"
 #include "nloc/NLOCBackendMP.hpp"
 #include "nloc/algorithms/gnms/GNMS.hpp"
 #include "nloc/algorithms/ilqr/iLQR.hpp"
+#include "nloc/FixedHorizonILQR.hpp"
+#include "nloc/FixedHorizonILQR-impl.hpp"  // not prespecified, the horizon is user-defined
 
 #include "solver/OptConSolver.h"
 #include "solver/lqp/HPIPMInterface.hpp"
 #include "solver/lqp/GNRiccatiSolver.hpp"
+#include "solver/lqp/BoxConstrainedRiccatiSolver.hpp"
+#include "solver/lqp/FixedHorizonRiccatiSolver.hpp"
+#include "solver/lqp/CondensingSolver.hpp"
+#include "solver/lqp/FixedHorizonRiccatiSolver-impl.hpp"  // not prespecified, the horizon is user-defined
 #include "solver/NLOptConSolver.hpp"
 #include "solver/NLOptConSettings.hpp"
+#include "solver/MultiStartNLOptConSolver.hpp"
+#include "solver/MultiStartNLOptConSolver-impl.hpp"  // not prespecified, drives prespecified NLOptConSolvers
 
 #include "lqr/riccati/CARE.hpp"
 #include "lqr/riccati/DARE.hpp"
@@ -16,22 +16,31 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "problem/ContinuousOptConProblem.h"
 #include "problem/DiscreteOptConProblem.h"
 #include "problem/LQOCProblem.hpp"
+#include "problem/FixedHorizonLQOCProblem.hpp"
 #include "solver/NLOptConSettings.hpp"
 
 #include "system_interface/OptconSystemInterface.h"
 #include "system_interface/OptconContinuousSystemInterface.h"
 #include "system_interface/OptconDiscreteSystemInterface.h"
 
+#include "logging/BinaryLogger.h"
+#include "logging/BinaryLogReader.h"
+
 #include "nloc/NLOCBackendBase.hpp"
 #include "nloc/NLOCBackendST.hpp"
 #include "nloc/NLOCBackendMP.hpp"
 #include "nloc/algorithms/gnms/GNMS.hpp"
 #include "nloc/algorithms/ilqr/iLQR.hpp"
+#include "nloc/FixedHorizonILQR.hpp"
 
 #include "solver/OptConSolver.h"
 #include "solver/lqp/HPIPMInterface.hpp"
 #include "solver/lqp/GNRiccatiSolver.hpp"
+#include "solver/lqp/BoxConstrainedRiccatiSolver.hpp"
+#include "solver/lqp/FixedHorizonRiccatiSolver.hpp"
+#include "solver/lqp/CondensingSolver.hpp"
 #include "solver/NLOptConSolver.hpp"
+#include "solver/MultiStartNLOptConSolver.hpp"
 
 #include "lqr/riccati/CARE.hpp"
 #include "lqr/riccati/DARE.hpp"
@@ -60,8 +69,12 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "problem/LQOCProblem-impl.hpp"
 
 #include "solver/lqp/GNRiccatiSolver-impl.hpp"
+#include "solver/lqp/BoxConstrainedRiccatiSolver-impl.hpp"
+#include "solver/lqp/FixedHorizonRiccatiSolver-impl.hpp"
 #include "solver/lqp/HPIPMInterface-impl.hpp"
+#include "solver/lqp/CondensingSolver-impl.hpp"
 #include "solver/NLOptConSolver-impl.hpp"
+#include "solver/MultiStartNLOptConSolver-impl.hpp"
 
 #include "lqr/riccati/CARE-impl.hpp"
 #include "lqr/riccati/DARE-impl.hpp"
@@ -73,6 +86,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "nloc/NLOCBackendMP-impl.hpp"
 #include "nloc/algorithms/gnms/GNMS-impl.hpp"
 #include "nloc/algorithms/ilqr/iLQR-impl.hpp"
+#include "nloc/FixedHorizonILQR-impl.hpp"
 
 #include "mpc/MPC-impl.h"
 #include "mpc/timehorizon/MpcTimeHorizon-impl.h"
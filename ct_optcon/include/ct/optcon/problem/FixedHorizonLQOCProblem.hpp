@@ -0,0 +1,78 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <array>
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \brief An unconstrained LQ optimal control problem with a compile-time number of stages
+ *
+ * Holds the same data as the unconstrained part of LQOCProblem, in absolute coordinates, but stores all stages in
+ * std::array such that the problem lives in a single contiguous, statically sized block of memory.
+ * Meant for small, embedded problems, see FixedHorizonRiccatiSolver and FixedHorizonILQR.
+ *
+ * \tparam N the number of stages
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t N, typename SCALAR = double>
+class FixedHorizonLQOCProblem
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef ct::core::StateVector<STATE_DIM, SCALAR> StateVector;
+    typedef ct::core::ControlVector<CONTROL_DIM, SCALAR> ControlVector;
+    typedef ct::core::StateMatrix<STATE_DIM, SCALAR> StateMatrix;
+    typedef ct::core::ControlMatrix<CONTROL_DIM, SCALAR> ControlMatrix;
+    typedef ct::core::StateControlMatrix<STATE_DIM, CONTROL_DIM, SCALAR> StateControlMatrix;
+    typedef ct::core::FeedbackMatrix<STATE_DIM, CONTROL_DIM, SCALAR> FeedbackMatrix;
+
+    static constexpr size_t getNumberOfStages() { return N; }
+    //! copies the unconstrained part of a dynamic-horizon LQ problem with N stages
+    void fromLQOCProblem(const LQOCProblem<STATE_DIM, CONTROL_DIM, SCALAR>& p)
+    {
+        if (p.A_.size() != N)
+            throw std::runtime_error("FixedHorizonLQOCProblem: number of stages does not match.");
+
+        for (size_t k = 0; k < N; k++)
+        {
+            A_[k] = p.A_[k];
+            B_[k] = p.B_[k];
+            b_[k] = p.b_[k];
+            x_[k] = p.x_[k];
+            u_[k] = p.u_[k];
+            Q_[k] = p.Q_[k];
+            P_[k] = p.P_[k];
+            qv_[k] = p.qv_[k];
+            R_[k] = p.R_[k];
+            rv_[k] = p.rv_[k];
+        }
+        x_[N] = p.x_[N];
+        Q_[N] = p.Q_[N];
+        qv_[N] = p.qv_[N];
+    }
+
+    //! affine system dynamics
+    std::array<StateMatrix, N> A_;
+    std::array<StateControlMatrix, N> B_;
+    std::array<StateVector, N> b_;
+
+    //! reference trajectories
+    std::array<StateVector, N + 1> x_;
+    std::array<ControlVector, N> u_;
+
+    //! LQ approximation of the cost function
+    std::array<StateMatrix, N + 1> Q_;
+    std::array<FeedbackMatrix, N> P_;
+    std::array<StateVector, N + 1> qv_;
+    std::array<ControlMatrix, N> R_;
+    std::array<ControlVector, N> rv_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,224 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::MultiStartNLOptConSolver(
+    const OptConProblem_t& optConProblem,
+    const Settings_t& settings,
+    size_t nStarts,
+    const MultiStartSettings& multiStartSettings)
+    : multiStartSettings_(multiStartSettings),
+      status_(nStarts, RUNNING),
+      iterations_(nStarts, 0),
+      merits_(nStarts, std::numeric_limits<SCALAR>::infinity()),
+      bestStart_(0),
+      threadPool_(std::min(multiStartSettings.nThreads, std::max<size_t>(nStarts, 1)))
+{
+    if (nStarts == 0)
+        throw std::runtime_error("MultiStartNLOptConSolver: the number of starts needs to be positive.");
+
+    if (!multiStartSettings_.parametersOk())
+        throw std::runtime_error("MultiStartNLOptConSolver: the multi-start settings are not valid.");
+
+    // the instances are created sequentially, they all clone the systems and cost function of the same problem
+    for (size_t i = 0; i < nStarts; i++)
+        solvers_.push_back(std::shared_ptr<NLOptConSolver_t>(new NLOptConSolver_t(optConProblem, settings)));
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::~MultiStartNLOptConSolver()
+{
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::setInitialGuesses(
+    const std::vector<Policy_t>& initialGuesses)
+{
+    if (initialGuesses.size() != solvers_.size())
+        throw std::runtime_error(
+            "MultiStartNLOptConSolver: the number of initial guesses must match the number of starts.");
+
+    threadPool_.parallelFor(solvers_.size(), [&](size_t i) { solvers_[i]->setInitialGuess(initialGuesses[i]); });
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::solve()
+{
+    std::fill(status_.begin(), status_.end(), RUNNING);
+    std::fill(iterations_.begin(), iterations_.end(), 0);
+    std::fill(merits_.begin(), merits_.end(), std::numeric_limits<SCALAR>::infinity());
+    bestStart_ = 0;
+
+    while (true)
+    {
+        runningStarts_.clear();
+        for (size_t i = 0; i < solvers_.size(); i++)
+            if (status_[i] == RUNNING)
+                runningStarts_.push_back(i);
+
+        if (runningStarts_.empty())
+            break;
+
+        threadPool_.parallelFor(runningStarts_.size(), [this](size_t j) { iterateStart(runningStarts_[j]); });
+
+        compareStarts();
+
+        if (multiStartSettings_.printSummary)
+            printSummary();
+    }
+
+    return status_[bestStart_] != CANCELLED;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::iterateStart(size_t start)
+{
+    NLOptConSolver_t& solver = *solvers_[start];
+
+    bool foundBetter = solver.runIteration();
+    iterations_[start]++;
+
+    // every iteration appends the merit of its solution to the summary
+    merits_[start] = solver.getBackend()->getSummary().merits.back();
+
+    if (!foundBetter || iterations_[start] >= solver.getSettings().max_iterations)
+        status_[start] = FINISHED;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::compareStarts()
+{
+    // a diverged start has a NaN merit and never becomes the best start
+    for (size_t i = 0; i < solvers_.size(); i++)
+    {
+        if (std::isnan(merits_[i]))
+            continue;
+        if (std::isnan(merits_[bestStart_]) || merits_[i] < merits_[bestStart_])
+            bestStart_ = i;
+    }
+
+    if (!multiStartSettings_.earlyTermination)
+        return;
+
+    const SCALAR bestMerit = merits_[bestStart_];
+    const SCALAR threshold = bestMerit + multiStartSettings_.relativeMargin * std::abs(bestMerit) +
+                             multiStartSettings_.absoluteMargin;
+
+    for (size_t i = 0; i < solvers_.size(); i++)
+    {
+        if (status_[i] != RUNNING || iterations_[i] < multiStartSettings_.minIterations)
+            continue;
+
+        if (std::isnan(merits_[i]) || merits_[i] > threshold)
+            status_[i] = CANCELLED;
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::printSummary() const
+{
+    std::cout << "[MultiStart]: best start " << bestStart_ << std::endl;
+    for (size_t i = 0; i < solvers_.size(); i++)
+    {
+        std::cout << "  start " << i << ": iterations " << iterations_[i] << ", merit " << merits_[i];
+        if (status_[i] == FINISHED)
+            std::cout << ", finished";
+        else if (status_[i] == CANCELLED)
+            std::cout << ", cancelled";
+        std::cout << std::endl;
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const typename MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::Policy_t&
+MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getSolution()
+{
+    return solvers_[bestStart_]->getSolution();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const core::StateTrajectory<STATE_DIM, SCALAR>
+MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getStateTrajectory() const
+{
+    return solvers_[bestStart_]->getStateTrajectory();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const core::ControlTrajectory<CONTROL_DIM, SCALAR>
+MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getControlTrajectory() const
+{
+    return solvers_[bestStart_]->getControlTrajectory();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+size_t MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getBestStart() const
+{
+    return bestStart_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+SCALAR MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getBestMerit() const
+{
+    return merits_[bestStart_];
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const std::vector<SCALAR>&
+MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getMerits() const
+{
+    return merits_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const std::vector<
+    typename MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::START_STATUS>&
+MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getStatus() const
+{
+    return status_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const std::vector<int>&
+MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getIterations() const
+{
+    return iterations_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+size_t MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getNumberOfStarts() const
+{
+    return solvers_.size();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+typename MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOptConSolver_t&
+MultiStartNLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getSolver(size_t start)
+{
+    return *solvers_[start];
+}
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,130 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "NLOptConSolver.hpp"
+#include "MultiStartSettings.hpp"
+
+namespace ct {
+namespace optcon {
+
+/** \ingroup OptConSolver
+ *
+ * \brief Solves an optimal control problem from several initial guesses concurrently and keeps the best solution
+ *
+ * Every start is an NLOptConSolver instance constructed from the same OptConProblem. The instances clone the systems
+ * and cost functions of the problem, hence models which have been JIT compiled before are compiled only once and
+ * loaded by every instance.
+ *
+ * The iterations of all starts run on one shared pool of threads. After every iteration the merits of the starts
+ * are compared and, if MultiStartSettings::earlyTermination is set, dominated starts are cancelled. A start finishes
+ * under the same conditions as NLOptConSolver::solve().
+ */
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t P_DIM = STATE_DIM / 2,
+    size_t V_DIM = STATE_DIM / 2,
+    typename SCALAR = double,
+    bool CONTINUOUS = true>
+class MultiStartNLOptConSolver
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS> NLOptConSolver_t;
+    typedef typename NLOptConSolver_t::Settings_t Settings_t;
+    typedef typename NLOptConSolver_t::OptConProblem_t OptConProblem_t;
+    typedef typename NLOptConSolver_t::Policy_t Policy_t;
+
+    //! status of a start
+    enum START_STATUS
+    {
+        RUNNING = 0,  //!< the start iterates
+        FINISHED,     //!< the start converged or reached the maximum number of iterations
+        CANCELLED     //!< the start was dominated by another start
+    };
+
+    //! constructor
+    /*!
+     * @param optConProblem the problem solved by all starts
+     * @param settings the settings of every start
+     * @param nStarts the number of starts
+     * @param multiStartSettings the settings of the multi-start driver
+     */
+    MultiStartNLOptConSolver(const OptConProblem_t& optConProblem,
+        const Settings_t& settings,
+        size_t nStarts,
+        const MultiStartSettings& multiStartSettings = MultiStartSettings());
+
+    //! destructor
+    virtual ~MultiStartNLOptConSolver();
+
+    //! set one initial guess per start
+    void setInitialGuesses(const std::vector<Policy_t>& initialGuesses);
+
+    /**
+	 * solve the optimal control problem from all initial guesses
+	 * @return true if at least one start was not cancelled
+	 */
+    bool solve();
+
+    //! the policy of the best start
+    const Policy_t& getSolution();
+
+    //! the state trajectory of the best start
+    const core::StateTrajectory<STATE_DIM, SCALAR> getStateTrajectory() const;
+
+    //! the control trajectory of the best start
+    const core::ControlTrajectory<CONTROL_DIM, SCALAR> getControlTrajectory() const;
+
+    //! the index of the start with the lowest merit
+    size_t getBestStart() const;
+
+    //! the merit of the best start
+    SCALAR getBestMerit() const;
+
+    //! the merits of all starts after their last iteration
+    const std::vector<SCALAR>& getMerits() const;
+
+    //! the status of all starts
+    const std::vector<START_STATUS>& getStatus() const;
+
+    //! the number of iterations every start has run
+    const std::vector<int>& getIterations() const;
+
+    //! get the number of starts
+    size_t getNumberOfStarts() const;
+
+    //! access the solver of a start, e.g. to change the problem of a single start
+    NLOptConSolver_t& getSolver(size_t start);
+
+private:
+    //! run one iteration of a start and update its merit and status
+    void iterateStart(size_t start);
+
+    //! find the best start and cancel all starts dominated by it
+    void compareStarts();
+
+    //! print the merits and status of all starts
+    void printSummary() const;
+
+    MultiStartSettings multiStartSettings_;
+
+    std::vector<std::shared_ptr<NLOptConSolver_t>> solvers_;
+
+    std::vector<START_STATUS> status_;
+    std::vector<int> iterations_;
+    std::vector<SCALAR> merits_;
+    size_t bestStart_;
+
+    //! indices of the running starts, processed by the pool
+    std::vector<size_t> runningStarts_;
+
+    core::ThreadPool threadPool_;
+};
+
+}  // namespace optcon
+}  // namespace ct
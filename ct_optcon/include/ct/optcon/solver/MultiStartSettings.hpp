@@ -0,0 +1,63 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <thread>
+
+namespace ct {
+namespace optcon {
+
+//! Settings for the MultiStartNLOptConSolver
+struct MultiStartSettings
+{
+    /*!
+     * Number of threads of the pool which runs the iterations of all starts, including the calling thread.
+     * Every start runs on one thread at a time, hence the starts should use the single-threaded NLOC backend,
+     * i.e. NLOptConSettings::nThreads = 1.
+     */
+    size_t nThreads = std::thread::hardware_concurrency();
+
+    /*!
+     * Cancel dominated starts early. A start is dominated if its merit exceeds the best merit of all starts by more
+     * than relativeMargin * |best merit| + absoluteMargin.
+     */
+    bool earlyTermination = true;
+
+    //! number of iterations every start runs before it can be cancelled
+    int minIterations = 2;
+
+    //! relative margin of the dominance test
+    double relativeMargin = 0.1;
+
+    //! absolute margin of the dominance test
+    double absoluteMargin = 0.0;
+
+    //! print the merits of all starts after every iteration
+    bool printSummary = false;
+
+    //! check if the settings are valid
+    bool parametersOk() const
+    {
+        return (nThreads > 0) && (minIterations >= 0) && (relativeMargin >= 0.0) && (absoluteMargin >= 0.0);
+    }
+
+    //! print the settings to the console
+    void print() const
+    {
+        std::cout << "======================= MultiStartSettings =====================" << std::endl;
+        std::cout << "nThreads:         " << nThreads << std::endl;
+        std::cout << "earlyTermination: " << earlyTermination << std::endl;
+        std::cout << "minIterations:    " << minIterations << std::endl;
+        std::cout << "relativeMargin:   " << relativeMargin << std::endl;
+        std::cout << "absoluteMargin:   " << absoluteMargin << std::endl;
+        std::cout << "printSummary:     " << printSummary << std::endl;
+        std::cout << "================================================================" << std::endl;
+    }
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -21,28 +21,47 @@ namespace optcon {
  */
 struct LineSearchSettings
 {
+    //! acceptance criterion for a step size
+    enum TYPE
+    {
+        MERIT = 0,  //! accept if the merit function, see NLOptConSettings::meritFunctionRho, decreases
+        FILTER      //! accept if the step is not dominated in cost and constraint violation by the filter
+    };
+
     //! default constructor for the NLOptCon line-search settings
     LineSearchSettings()
         : active(true),
+          type(MERIT),
           adaptive(false),
+          speculative(false),
           maxIterations(10),
           alpha_0(1.0),
           alpha_max(1.0),
           n_alpha(0.5),
+          filterGammaCost(1e-5),
+          filterGammaViolation(1e-5),
           debugPrint(false)
     {
     }
 
     //! check if the currently set line-search parameters are meaningful
-    bool parametersOk() const { return (alpha_0 > 0.0) && (n_alpha > 0.0) && (n_alpha < 1.0) && (alpha_max > 0.0); }
+    bool parametersOk() const
+    {
+        return (alpha_0 > 0.0) && (n_alpha > 0.0) && (n_alpha < 1.0) && (alpha_max > 0.0) &&
+               (filterGammaCost >= 0.0) && (filterGammaViolation >= 0.0) && (filterGammaViolation < 1.0);
+    }
     bool active;          /*!< Flag whether or not to perform line search */
+    TYPE type;            /*!< Acceptance criterion, merit function or filter */
     bool adaptive;        /*!< Flag whether alpha_0 gets updated based on previous iteration */
+    bool speculative;     /*!< Multi-threaded only: evaluate the step sizes around the previously accepted one first */
     size_t maxIterations; /*!< Maximum number of iterations during line search */
     double alpha_0;       /*!< Initial step size for line search. Use 1 for step size as suggested by NLOptCon */
     double alpha_max;     /*!< Maximum step size for line search. This is the limit when adapting alpha_0. */
     double
         n_alpha;     /*!< Factor by which the line search step size alpha gets multiplied with after each iteration. Usually 0.5 is a good value. */
-    bool debugPrint; /*!< Print out debug information during line-search*/
+    double filterGammaCost;      /*!< Filter: required cost decrease relative to the constraint violation */
+    double filterGammaViolation; /*!< Filter: required relative decrease of the constraint violation */
+    bool debugPrint;             /*!< Print out debug information during line-search*/
 
 
     //! print the current line search settings to console
@@ -51,11 +70,15 @@ struct LineSearchSettings
         std::cout << "Line Search Settings: " << std::endl;
         std::cout << "=====================" << std::endl;
         std::cout << "active:\t" << active << std::endl;
+        std::cout << "type:\t" << (type == FILTER ? "FILTER" : "MERIT") << std::endl;
         std::cout << "adaptive:\t" << adaptive << std::endl;
+        std::cout << "speculative:\t" << speculative << std::endl;
         std::cout << "maxIter:\t" << maxIterations << std::endl;
         std::cout << "alpha_0:\t" << alpha_0 << std::endl;
         std::cout << "alpha_max:\t" << alpha_max << std::endl;
         std::cout << "n_alpha:\t" << n_alpha << std::endl;
+        std::cout << "filterGammaCost:\t" << filterGammaCost << std::endl;
+        std::cout << "filterGammaViolation:\t" << filterGammaViolation << std::endl;
         std::cout << "debugPrint:\t" << debugPrint << std::endl;
         std::cout << "              =======" << std::endl;
         std::cout << std::endl;
@@ -86,6 +109,17 @@ struct LineSearchSettings
         {
         }
 
+        const std::string typeStr = pt.get<std::string>(ns + ".type", "MERIT");
+        if (typeStr == "FILTER")
+            type = FILTER;
+        else if (typeStr == "MERIT")
+            type = MERIT;
+        else
+            throw std::runtime_error("Invalid line search type " + typeStr + ", should be MERIT or FILTER.");
+        speculative = pt.get<bool>(ns + ".speculative", false);
+        filterGammaCost = pt.get<double>(ns + ".filterGammaCost", filterGammaCost);
+        filterGammaViolation = pt.get<double>(ns + ".filterGammaViolation", filterGammaViolation);
+
         if (verbose)
         {
             std::cout << "Loaded line search settings from " << filename << ": " << std::endl;
@@ -95,6 +129,70 @@ struct LineSearchSettings
 };
 
 
+//! Augmented Lagrangian settings
+/*!
+ * \ingroup GNMS
+ *
+ * If active, the general constraints are not passed to the linear-quadratic solver but folded into the stage costs
+ * as augmented Lagrangian terms. Constrained problems can then be solved with the unconstrained Riccati solver.
+ * Whenever the NLOptCon iterations converge for the current multipliers, the multipliers are updated and, if the
+ * constraint violation did not decrease sufficiently, the penalty is increased.
+ */
+struct AugmentedLagrangianSettings
+{
+    AugmentedLagrangianSettings()
+        : active(false),
+          penalty_0(10.0),
+          penaltyFactor(10.0),
+          penaltyMax(1e8),
+          violationDecrease(0.25),
+          tolerance(1e-4)
+    {
+    }
+
+    bool active;               /*!< Fold general constraints into the cost instead of passing them to the LQ solver */
+    double penalty_0;          /*!< Initial penalty */
+    double penaltyFactor;      /*!< Factor by which the penalty increases if the violation did not decrease enough */
+    double penaltyMax;         /*!< Upper limit of the penalty */
+    double violationDecrease;  /*!< Required decrease factor of the max. violation between multiplier updates */
+    double tolerance;          /*!< Max. constraint violation at which the constraints are considered satisfied */
+
+    //! check if the currently set parameters are meaningful
+    bool parametersOk() const
+    {
+        return (penalty_0 > 0.0) && (penaltyFactor >= 1.0) && (penaltyMax >= penalty_0) && (violationDecrease > 0.0) &&
+               (violationDecrease < 1.0) && (tolerance > 0.0);
+    }
+
+    void print() const
+    {
+        std::cout << "======================= AugmentedLagrangianSettings =====================" << std::endl;
+        std::cout << "active: \t" << active << std::endl;
+        std::cout << "penalty_0: \t" << penalty_0 << std::endl;
+        std::cout << "penaltyFactor: \t" << penaltyFactor << std::endl;
+        std::cout << "penaltyMax: \t" << penaltyMax << std::endl;
+        std::cout << "violationDecrease: \t" << violationDecrease << std::endl;
+        std::cout << "tolerance: \t" << tolerance << std::endl;
+    }
+
+    void load(const std::string& filename, bool verbose = true, const std::string& ns = "augmented_lagrangian")
+    {
+        if (verbose)
+            std::cout << "Trying to load AugmentedLagrangianSettings config from " << filename << ": " << std::endl;
+
+        boost::property_tree::ptree pt;
+        boost::property_tree::read_info(filename, pt);
+
+        active = pt.get<bool>(ns + ".active", active);
+        penalty_0 = pt.get<double>(ns + ".penalty_0", penalty_0);
+        penaltyFactor = pt.get<double>(ns + ".penaltyFactor", penaltyFactor);
+        penaltyMax = pt.get<double>(ns + ".penaltyMax", penaltyMax);
+        violationDecrease = pt.get<double>(ns + ".violationDecrease", violationDecrease);
+        tolerance = pt.get<double>(ns + ".tolerance", tolerance);
+    }
+};
+
+
 //! LQOC Solver settings
 /*!
  * Settings for solving each linear-quadratic (constrained) sub-problem
@@ -102,14 +200,20 @@ struct LineSearchSettings
 struct LQOCSolverSettings
 {
 public:
-    LQOCSolverSettings() : num_lqoc_iterations(5), lqoc_debug_print(false) {}
+    LQOCSolverSettings() : num_lqoc_iterations(5), num_ipm_iterations(50), ipm_tolerance(1e-10), lqoc_debug_print(false)
+    {
+    }
     int num_lqoc_iterations;  //! number of allowed sub-iterations of LQOC solver per NLOC main iteration
+    int num_ipm_iterations;   //! max. number of interior point iterations of the CondensingSolver
+    double ipm_tolerance;     //! CondensingSolver tolerance on residuals and complementarity
     bool lqoc_debug_print;
 
     void print() const
     {
         std::cout << "======================= LQOCSolverSettings =====================" << std::endl;
         std::cout << "num_lqoc_iterations: \t" << num_lqoc_iterations << std::endl;
+        std::cout << "num_ipm_iterations: \t" << num_ipm_iterations << std::endl;
+        std::cout << "ipm_tolerance: \t" << ipm_tolerance << std::endl;
         std::cout << "lqoc_debug_print: \t" << lqoc_debug_print << std::endl;
     }
 
@@ -128,6 +232,18 @@ public:
         {
         }
         try
+        {
+            num_ipm_iterations = pt.get<int>(ns + ".num_ipm_iterations");
+        } catch (...)
+        {
+        }
+        try
+        {
+            ipm_tolerance = pt.get<double>(ns + ".ipm_tolerance");
+        } catch (...)
+        {
+        }
+        try
         {
             lqoc_debug_print = pt.get<bool>(ns + ".lqoc_debug_print");
         } catch (...)
@@ -159,7 +275,9 @@ public:
     enum LQOCP_SOLVER
     {
         GNRICCATI_SOLVER = 0,
-        HPIPM_SOLVER = 1
+        HPIPM_SOLVER = 1,
+        CONDENSING_SOLVER = 2,
+        BOX_RICCATI_SOLVER = 3
     };
 
 
@@ -189,10 +307,14 @@ public:
           nThreads(4),
           nThreadsEigen(4),
           lineSearchSettings(),
+          augmentedLagrangianSettings(),
           debugPrint(false),
           printSummary(true),
           useSensitivityIntegrator(false),
-          logToMatlab(false)
+          logToMatlab(false),
+          logToBinary(false),
+          mpcShiftWarmStart(false),
+          mpcShiftWarmStartTolerance(1e-6)
     {
     }
 
@@ -219,10 +341,14 @@ public:
         nThreadsEigen;                      //! number of threads for eigen parallelization (applies both to MP and ST) Note. in order to activate Eigen parallelization, compile with '-fopenmp'
     LineSearchSettings lineSearchSettings;  //! the line search settings
     LQOCSolverSettings lqoc_solver_settings;
+    AugmentedLagrangianSettings augmentedLagrangianSettings;  //! general constraint handling with the Riccati solver
     bool debugPrint;
     bool printSummary;
     bool useSensitivityIntegrator;
     bool logToMatlab;  //! log to matlab (true/false)
+    bool logToBinary;  //! log every iteration to <loggingPrefix>Log.ctlog in a background thread, see BinaryLogger
+    bool mpcShiftWarmStart;  //! in MPC, reuse the shifted LQ approximation of the previous cycle (GNMS only) \warning only valid for time-invariant cost and dynamics
+    double mpcShiftWarmStartTolerance;  //! max. deviation of state and control for which a stage is reused
 
 
     //! compute the number of discrete time steps for an arbitrary input time interval
@@ -271,12 +397,17 @@ public:
         std::cout << "printSummary:\t" << printSummary << std::endl;
         std::cout << "useSensitivityIntegrator:\t" << useSensitivityIntegrator << std::endl;
         std::cout << "logToMatlab:\t" << logToMatlab << std::endl;
+        std::cout << "logToBinary:\t" << logToBinary << std::endl;
+        std::cout << "mpcShiftWarmStart:\t" << mpcShiftWarmStart << std::endl;
+        std::cout << "mpcShiftWarmStartTolerance:\t" << mpcShiftWarmStartTolerance << std::endl;
         std::cout << std::endl;
 
         lineSearchSettings.print();
 
         lqoc_solver_settings.print();
 
+        augmentedLagrangianSettings.print();
+
         std::cout << "===============================================================" << std::endl;
     }
 
@@ -320,7 +451,7 @@ public:
             std::cout << "Number of threads should not exceed 100." << std::endl;
             return false;
         }
-        return (lineSearchSettings.parametersOk());
+        return (lineSearchSettings.parametersOk() && augmentedLagrangianSettings.parametersOk());
     }
 
 
@@ -424,6 +555,24 @@ public:
         {
         }
         try
+        {
+            logToBinary = pt.get<bool>(ns + ".logToBinary");
+        } catch (...)
+        {
+        }
+        try
+        {
+            mpcShiftWarmStart = pt.get<bool>(ns + ".mpcShiftWarmStart");
+        } catch (...)
+        {
+        }
+        try
+        {
+            mpcShiftWarmStartTolerance = pt.get<double>(ns + ".mpcShiftWarmStartTolerance");
+        } catch (...)
+        {
+        }
+        try
         {
             dt = pt.get<double>(ns + ".dt");
         } catch (...)
@@ -472,6 +621,12 @@ public:
         } catch (...)
         {
         }
+        try
+        {
+            augmentedLagrangianSettings.load(filename, verbose, ns + ".augmented_lagrangian");
+        } catch (...)
+        {
+        }
 
 
         try
@@ -612,10 +767,12 @@ private:
 
     //! mappings for linear-quadratic solver types
     std::map<LQOCP_SOLVER, std::string> locp_solverToString = {
-        {GNRICCATI_SOLVER, "GNRICCATI_SOLVER"}, {HPIPM_SOLVER, "HPIPM_SOLVER"}};
+        {GNRICCATI_SOLVER, "GNRICCATI_SOLVER"}, {HPIPM_SOLVER, "HPIPM_SOLVER"},
+        {CONDENSING_SOLVER, "CONDENSING_SOLVER"}, {BOX_RICCATI_SOLVER, "BOX_RICCATI_SOLVER"}};
 
     std::map<std::string, LQOCP_SOLVER> stringTolocp_solver = {
-        {"GNRICCATI_SOLVER", GNRICCATI_SOLVER}, {"HPIPM_SOLVER", HPIPM_SOLVER}};
+        {"GNRICCATI_SOLVER", GNRICCATI_SOLVER}, {"HPIPM_SOLVER", HPIPM_SOLVER},
+        {"CONDENSING_SOLVER", CONDENSING_SOLVER}, {"BOX_RICCATI_SOLVER", BOX_RICCATI_SOLVER}};
 };
 }  // namespace optcon
 }  // namespace ct
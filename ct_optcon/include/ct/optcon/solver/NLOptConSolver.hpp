@@ -102,6 +102,12 @@ public:
 	 */
     virtual void prepareMPCIteration();
 
+    /*!
+	 * set the time the initial guess was shifted about since the previous MPC iteration, used to reuse the shifted
+	 * LQ approximation if NLOptConSettings::mpcShiftWarmStart is set
+	 */
+    void setMPCShift(const SCALAR& shift);
+
     /*!
 	 * execute finishing step for an iteration, e.g. solving Riccati backward pass.
 	 * @return
@@ -235,6 +241,9 @@ public:
     //! logging a short summary to matlab
     void logSummaryToMatlab(const std::string& fileName);
 
+    //! logging a short summary to the binary log, see NLOptConSettings::logToBinary
+    void logSummaryToBinary();
+
 protected:
     //! the backend holding all the math operations
     std::shared_ptr<Backend_t> nlocBackend_;
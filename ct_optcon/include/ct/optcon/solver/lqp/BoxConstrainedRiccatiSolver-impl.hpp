@@ -0,0 +1,227 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+ **********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+BoxConstrainedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::BoxConstrainedRiccatiSolver(
+    const std::shared_ptr<LQOCProblem_t>& lqocProblem)
+    : Base(lqocProblem)
+{
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+BoxConstrainedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::BoxConstrainedRiccatiSolver(int N) : Base(N)
+{
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void BoxConstrainedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::setProblemImpl(
+    std::shared_ptr<LQOCProblem_t> lqocProblem)
+{
+    if (lqocProblem->isGeneralConstrained())
+        throw std::runtime_error("BoxConstrainedRiccatiSolver cannot handle general constraints.");
+
+    if (lqocProblem->isBoxConstrained())
+    {
+        const int N = lqocProblem->getNumberOfStages();
+        for (int k = 0; k < N; k++)
+        {
+            for (int i = 0; i < lqocProblem->nb_[k]; i++)
+            {
+                // the indices are ordered [u x]
+                if (lqocProblem->ux_I_[k](i) >= static_cast<int>(CONTROL_DIM))
+                    throw std::runtime_error("BoxConstrainedRiccatiSolver cannot handle state box constraints.");
+            }
+        }
+        if (lqocProblem->nb_[N] > 0)
+            throw std::runtime_error("BoxConstrainedRiccatiSolver cannot handle terminal box constraints.");
+    }
+
+    this->changeNumberOfStages(lqocProblem->getNumberOfStages());
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void BoxConstrainedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::extractLQSolution()
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+    ControlVector lb, ub;
+
+    this->x_sol_[0] = p.x_[0];
+
+    for (int k = 0; k < p.getNumberOfStages(); k++)
+    {
+        //! control update rule
+        this->u_sol_[k] = this->lv_[k] + this->L_[k] * this->x_sol_[k];
+        if (getControlBounds(k, lb, ub))
+            this->u_sol_[k] = this->u_sol_[k].cwiseMax(lb).cwiseMin(ub);
+
+        //! state update rule
+        this->x_sol_[k + 1] = p.A_[k] * this->x_sol_[k] + p.B_[k] * this->u_sol_[k] + p.b_[k];
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+bool BoxConstrainedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::getControlBounds(size_t k,
+    ControlVector& lb,
+    ControlVector& ub) const
+{
+    const LQOCProblem_t& p = *this->lqocProblem_;
+
+    if (!p.isBoxConstrained() || p.nb_[k] == 0)
+        return false;
+
+    lb.setConstant(-std::numeric_limits<SCALAR>::infinity());
+    ub.setConstant(std::numeric_limits<SCALAR>::infinity());
+
+    for (int i = 0; i < p.nb_[k]; i++)
+    {
+        const int idx = p.ux_I_[k](i);
+        lb(idx) = p.ux_lb_[k](i);
+        ub(idx) = p.ux_ub_[k](i);
+    }
+
+    return true;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void BoxConstrainedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
+{
+    // unconstrained controller and regularized Hessian Hi_
+    Base::designController(k);
+
+    ControlVector lb, ub;
+    if (!getControlBounds(k, lb, ub))
+        return;
+
+    const LQOCProblem_t& p = *this->lqocProblem_;
+
+    // the control the unconstrained controller applies at the reference state
+    ControlVector u = this->lv_[k] + this->L_[k] * p.x_[k];
+    if ((u.array() >= lb.array()).all() && (u.array() <= ub.array()).all())
+        return;
+
+    // minimize the cost-to-go at the reference state within the bounds, warm started with the clamped control
+    const ControlVector g = this->gv_[k] + this->G_[k] * p.x_[k];
+    u = u.cwiseMax(lb).cwiseMin(ub);
+    FreeMask free;
+    solveBoxQP(this->Hi_[k], g, lb, ub, u, free);
+
+    // feedback only acts on the free controls
+    const int nFree = free.count();
+    this->L_[k].setZero();
+    if (nFree > 0)
+    {
+        SubMatrix H_ff(nFree, nFree);
+        SubFeedback G_f(nFree, STATE_DIM);
+        for (int i = 0, fi = 0; i < static_cast<int>(CONTROL_DIM); i++)
+        {
+            if (!free(i))
+                continue;
+            for (int j = 0, fj = 0; j < static_cast<int>(CONTROL_DIM); j++)
+            {
+                if (free(j))
+                    H_ff(fi, fj++) = this->Hi_[k](i, j);
+            }
+            G_f.row(fi++) = this->G_[k].row(i);
+        }
+
+        const SubFeedback L_f = -H_ff.llt().solve(G_f);
+        for (int i = 0, fi = 0; i < static_cast<int>(CONTROL_DIM); i++)
+        {
+            if (free(i))
+                this->L_[k].row(i) = L_f.row(fi++);
+        }
+    }
+
+    // affine control law in absolute coordinates, u = lv + L x
+    this->lv_[k] = u - this->L_[k] * p.x_[k];
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+int BoxConstrainedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::solveBoxQP(const ControlMatrix& H,
+    const ControlVector& g,
+    const ControlVector& lb,
+    const ControlVector& ub,
+    ControlVector& u,
+    FreeMask& free)
+{
+    u = u.cwiseMax(lb).cwiseMin(ub);
+    SCALAR value = 0.5 * u.dot(H * u) + g.dot(u);
+
+    int iter = 0;
+    for (; iter < maxIterations_; iter++)
+    {
+        const ControlVector grad = g + H * u;
+
+        // a control is clamped if it is at a bound and the gradient points outwards
+        for (int i = 0; i < static_cast<int>(CONTROL_DIM); i++)
+            free(i) = !((u(i) <= lb(i) && grad(i) > 0.0) || (u(i) >= ub(i) && grad(i) < 0.0));
+
+        const int nFree = free.count();
+        if (nFree == 0)
+            break;
+
+        SubMatrix H_ff(nFree, nFree);
+        SubVector grad_f(nFree);
+        for (int i = 0, fi = 0; i < static_cast<int>(CONTROL_DIM); i++)
+        {
+            if (!free(i))
+                continue;
+            for (int j = 0, fj = 0; j < static_cast<int>(CONTROL_DIM); j++)
+            {
+                if (free(j))
+                    H_ff(fi, fj++) = H(i, j);
+            }
+            grad_f(fi++) = grad(i);
+        }
+
+        if (grad_f.norm() < gradientTolerance_)
+            break;
+
+        // Newton step in the free subspace
+        const SubVector step_f = -H_ff.llt().solve(grad_f);
+        ControlVector step = ControlVector::Zero();
+        for (int i = 0, fi = 0; i < static_cast<int>(CONTROL_DIM); i++)
+        {
+            if (free(i))
+                step(i) = step_f(fi++);
+        }
+
+        // Armijo line search along the projection arc
+        SCALAR alpha = 1.0;
+        ControlVector uNew;
+        SCALAR valueNew = value;
+        for (; alpha >= minStepSize_; alpha *= 0.5)
+        {
+            uNew = (u + alpha * step).cwiseMax(lb).cwiseMin(ub);
+            valueNew = 0.5 * uNew.dot(H * uNew) + g.dot(uNew);
+            if (valueNew - value <= armijo_ * grad.dot(uNew - u))
+                break;
+        }
+
+        if (alpha < minStepSize_)
+            break;
+
+        u = uNew;
+        value = valueNew;
+    }
+
+    return iter;
+}
+
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,107 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "GNRiccatiSolver.hpp"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \brief Riccati backward pass for linear-quadratic problems with box constraints on the controls (box-DDP)
+ *
+ * At every stage, the control minimizing the quadratic cost-to-go at the reference state of the LQ problem is found
+ * with a projected Newton method which respects the control bounds. The feedback gains only act on the controls which
+ * are not clamped to a bound, see Tassa et al., "Control-Limited Differential Dynamic Programming", ICRA 2014.
+ *
+ * The per-stage problems are solved at the reference state only, hence the solution of a single backward pass is not
+ * the optimum of the constrained LQ problem. Away from the reference state, the feedback may drive free controls
+ * beyond their bounds, they are clamped in the forward pass. Iterated within GNMS or iLQR, the reference converges to the constrained
+ * optimum. Stages with inactive bounds are treated exactly like in GNRiccatiSolver.
+ *
+ * \note box constraints on the states and general constraints are not supported, use HPIPMInterface or
+ * CondensingSolver for those.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class BoxConstrainedRiccatiSolver : public GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR> Base;
+    typedef typename Base::LQOCProblem_t LQOCProblem_t;
+    typedef typename Base::ControlVector ControlVector;
+    typedef typename Base::ControlMatrix ControlMatrix;
+
+    //! mask of the controls which are not clamped to a bound
+    typedef Eigen::Matrix<bool, CONTROL_DIM, 1> FreeMask;
+
+    BoxConstrainedRiccatiSolver(const std::shared_ptr<LQOCProblem_t>& lqocProblem = nullptr);
+
+    BoxConstrainedRiccatiSolver(int N);
+
+    ~BoxConstrainedRiccatiSolver() override = default;
+
+    //! the box constraints are read from the problem in every backward pass, nothing to configure
+    void configureBoxConstraints(std::shared_ptr<LQOCProblem<STATE_DIM, CONTROL_DIM>> lqocProblem) override {}
+
+    //! forward pass of the affine control law, the controls are clamped to their bounds
+    void extractLQSolution() override;
+
+    /*!
+     * \brief minimizes \f$ \frac{1}{2} u^T H u + g^T u \f$ subject to \f$ lb \leq u \leq ub \f$
+     *
+     * Projected Newton method with an Armijo line search along the projection arc. In every iteration, the Newton
+     * step is taken in the subspace of the controls which are not clamped to a bound.
+     *
+     * @param H positive definite Hessian
+     * @param g gradient
+     * @param lb lower bound
+     * @param ub upper bound
+     * @param u initial guess, the solution on return
+     * @param free the controls which are not clamped at the solution
+     * @return the number of iterations
+     */
+    static int solveBoxQP(const ControlMatrix& H,
+        const ControlVector& g,
+        const ControlVector& lb,
+        const ControlVector& ub,
+        ControlVector& u,
+        FreeMask& free);
+
+protected:
+    void setProblemImpl(std::shared_ptr<LQOCProblem_t> lqocProblem) override;
+
+    //! computes the unconstrained controller and replaces it by the box-constrained one if a bound is active
+    void designController(size_t k) override;
+
+    //! extracts the control bounds of stage k from the LQ problem, returns false if there are none
+    bool getControlBounds(size_t k, ControlVector& lb, ControlVector& ub) const;
+
+    //! dynamic size with fixed maximum size, avoids heap allocations
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic, 0, CONTROL_DIM, CONTROL_DIM> SubMatrix;
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, 1, 0, CONTROL_DIM, 1> SubVector;
+    typedef Eigen::Matrix<SCALAR,
+        Eigen::Dynamic,
+        STATE_DIM,
+        (CONTROL_DIM == 1 && STATE_DIM != 1) ? Eigen::RowMajor : Eigen::ColMajor,
+        CONTROL_DIM,
+        STATE_DIM>
+        SubFeedback;
+
+    //! maximum number of projected Newton iterations
+    static constexpr int maxIterations_ = 100;
+    //! tolerance on the gradient norm in the free subspace
+    static constexpr double gradientTolerance_ = 1e-10;
+    //! sufficient decrease parameter of the Armijo line search
+    static constexpr double armijo_ = 0.1;
+    //! smallest step size of the line search
+    static constexpr double minStepSize_ = 1e-12;
+};
+
+
+}  // namespace optcon
+}  // namespace ct
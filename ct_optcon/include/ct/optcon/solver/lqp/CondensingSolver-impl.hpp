@@ -0,0 +1,401 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+ **********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::CondensingSolver(const std::shared_ptr<LQOCProblem_t>& lqocProblem)
+    : LQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>(lqocProblem), N_(-1), nIterations_(0), converged_(true)
+{
+    if (lqocProblem)
+        changeNumberOfStages(lqocProblem->getNumberOfStages());
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::CondensingSolver(int N) : N_(-1), nIterations_(0), converged_(true)
+{
+    changeNumberOfStages(N);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::configure(const NLOptConSettings& settings)
+{
+    settings_ = settings;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::initializeAndAllocate()
+{
+    // memory is allocated when the number of stages changes
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::setProblemImpl(std::shared_ptr<LQOCProblem_t> lqocProblem)
+{
+    changeNumberOfStages(lqocProblem->getNumberOfStages());
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::changeNumberOfStages(int N)
+{
+    if (N <= 0)
+        return;
+
+    if (N_ == N)
+        return;
+
+    Gamma_.setZero((N + 1) * STATE_DIM, N * CONTROL_DIM);
+    c_.resize(N + 1);
+    AiB_.resize(N);
+
+    H_.resize(N * CONTROL_DIM, N * CONTROL_DIM);
+    g_.resize(N * CONTROL_DIM);
+    M_.resize(STATE_DIM, N * CONTROL_DIM);
+    U_.resize(N * CONTROL_DIM);
+
+    this->x_sol_.resize(N + 1);
+    this->u_sol_.resize(N);
+    this->L_.resize(N);
+
+    N_ = N;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::solve()
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+    changeNumberOfStages(p.getNumberOfStages());
+
+    computeStateSensitivities();
+    condenseCost();
+    factorizeHessian();
+
+    nIterations_ = 0;
+    converged_ = true;
+    if (p.isConstrained())
+    {
+        condenseConstraints();
+        solveConstrainedQP();
+    }
+    else
+    {
+        U_ = -llt_.solve(g_);
+    }
+
+    expandSolution();
+
+    if (settings_.closedLoopShooting)
+        designFeedback();
+    else
+        this->L_.setConstant(core::FeedbackMatrix<STATE_DIM, CONTROL_DIM, SCALAR>::Zero());
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeStateSensitivities()
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+    const int n = STATE_DIM;
+    const int m = CONTROL_DIM;
+
+    c_[0] = p.x_[0];
+    for (int k = 0; k < N_; k++)
+        c_[k + 1] = p.A_[k] * c_[k] + p.b_[k];
+
+    bool timeInvariant = true;
+    for (int k = 1; k < N_ && timeInvariant; k++)
+        timeInvariant = (p.A_[k] == p.A_[0]) && (p.B_[k] == p.B_[0]);
+
+    if (timeInvariant)
+    {
+        // block Toeplitz: dx_k / du_j = A^(k-1-j) B
+        AiB_[0] = p.B_[0];
+        for (int i = 1; i < N_; i++)
+            AiB_[i].noalias() = p.A_[0] * AiB_[i - 1];
+
+        for (int k = 1; k <= N_; k++)
+            for (int j = 0; j < k; j++)
+                Gamma_.block(k * n, j * m, n, m) = AiB_[k - 1 - j];
+    }
+    else
+    {
+        for (int k = 1; k <= N_; k++)
+        {
+            Gamma_.block(k * n, 0, n, (k - 1) * m).noalias() =
+                p.A_[k - 1] * Gamma_.block((k - 1) * n, 0, n, (k - 1) * m);
+            Gamma_.block(k * n, (k - 1) * m, n, m) = p.B_[k - 1];
+        }
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::condenseCost()
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+    const int n = STATE_DIM;
+    const int m = CONTROL_DIM;
+
+    // M_k = sum_{l >= k} (A_{l-1} ... A_k)^T Q_l Gamma_l, only the columns of the controls before stage k are needed
+    M_.leftCols(N_ * m).noalias() = p.Q_[N_] * Gamma_.block(N_ * n, 0, n, N_ * m);
+    m_ = p.qv_[N_] + p.Q_[N_] * c_[N_];
+
+    for (int i = N_ - 1; i >= 0; i--)
+    {
+        // lower triangle of block row i
+        H_.block(i * m, 0, m, (i + 1) * m).noalias() = p.B_[i].transpose() * M_.leftCols((i + 1) * m);
+        if (i > 0)
+            H_.block(i * m, 0, m, i * m).noalias() += p.P_[i] * Gamma_.block(i * n, 0, n, i * m);
+        H_.block(i * m, i * m, m, m) += p.R_[i];
+
+        g_.segment(i * m, m) = p.rv_[i] + p.P_[i] * c_[i] + p.B_[i].transpose() * m_;
+
+        if (i > 0)
+        {
+            M_.leftCols(i * m) = (p.Q_[i] * Gamma_.block(i * n, 0, n, i * m) +
+                                  p.A_[i].transpose() * M_.leftCols(i * m))
+                                     .eval();
+            m_ = (p.qv_[i] + p.Q_[i] * c_[i] + p.A_[i].transpose() * m_).eval();
+        }
+    }
+
+    H_.template triangularView<Eigen::StrictlyUpper>() = H_.transpose();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::factorizeHessian()
+{
+    if (settings_.fixedHessianCorrection && settings_.epsilon > 1e-10)
+        H_.diagonal().array() += SCALAR(settings_.epsilon);
+
+    llt_.compute(H_);
+
+    if (llt_.info() != Eigen::Success)
+    {
+        // make the Hessian positive definite by lifting its eigenvalues, as in GNRiccatiSolver
+        Eigen::SelfAdjointEigenSolver<MatrixX> eigenvalueSolver(H_);
+        const VectorX lambda = eigenvalueSolver.eigenvalues().cwiseMax(SCALAR(settings_.epsilon));
+        H_ = eigenvalueSolver.eigenvectors() * lambda.asDiagonal() * eigenvalueSolver.eigenvectors().transpose();
+        llt_.compute(H_);
+
+        if (llt_.info() != Eigen::Success)
+            throw std::runtime_error("CondensingSolver: condensed Hessian is not positive definite");
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::condenseConstraints()
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+    const int n = STATE_DIM;
+    const int m = CONTROL_DIM;
+    const int nU = N_ * m;
+
+    int nConstraints = 0;
+    for (int k = 0; k <= N_; k++)
+    {
+        if (p.isBoxConstrained())
+            nConstraints += p.nb_[k];
+        if (p.isGeneralConstrained())
+            nConstraints += p.ng_[k];
+    }
+
+    G_.setZero(nConstraints, nU);
+    lb_.resize(nConstraints);
+    ub_.resize(nConstraints);
+
+    int row = 0;
+    for (int k = 0; k <= N_; k++)
+    {
+        if (p.isBoxConstrained())
+        {
+            for (int i = 0; i < p.nb_[k]; i++)
+            {
+                // intermediate stages are ordered [u x], the terminal stage only contains the state
+                const int idx = (k < N_) ? p.ux_I_[k](i) : p.ux_I_[k](i) + m;
+
+                if (idx < m)
+                {
+                    G_(row, k * m + idx) = SCALAR(1.0);
+                    lb_(row) = p.ux_lb_[k](i);
+                    ub_(row) = p.ux_ub_[k](i);
+                }
+                else
+                {
+                    // the initial state is fixed
+                    if (k == 0)
+                        continue;
+
+                    G_.row(row).head(k * m) = Gamma_.block(k * n + idx - m, 0, 1, k * m);
+                    lb_(row) = p.ux_lb_[k](i) - c_[k](idx - m);
+                    ub_(row) = p.ux_ub_[k](i) - c_[k](idx - m);
+                }
+                row++;
+            }
+        }
+
+        if (p.isGeneralConstrained() && p.ng_[k] > 0)
+        {
+            const int ng = p.ng_[k];
+            G_.block(row, 0, ng, k * m).noalias() = p.C_[k] * Gamma_.block(k * n, 0, n, k * m);
+            if (k < N_)
+                G_.block(row, k * m, ng, m) = p.D_[k];
+            lb_.segment(row, ng) = p.d_lb_[k] - p.C_[k] * c_[k];
+            ub_.segment(row, ng) = p.d_ub_[k] - p.C_[k] * c_[k];
+            row += ng;
+        }
+    }
+
+    G_.conservativeResize(row, nU);
+    lb_.conservativeResize(row);
+    ub_.conservativeResize(row);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::solveConstrainedQP()
+{
+    const int nU = N_ * CONTROL_DIM;
+    const int nC = G_.rows();
+
+    // constraints on the fixed initial state only, nothing left to enforce
+    if (nC == 0)
+    {
+        U_ = -llt_.solve(g_);
+        return;
+    }
+
+    // one-sided form C U <= d with C = [G; -G], d = [ub; -lb]
+    MatrixX C(2 * nC, nU);
+    C << G_, -G_;
+    VectorX d(2 * nC);
+    d << ub_, -lb_;
+
+    // start from the unconstrained solution
+    U_ = -llt_.solve(g_);
+    VectorX s = (d - C * U_).cwiseMax(SCALAR(1.0));
+    VectorX lambda = VectorX::Ones(2 * nC);
+
+    const SCALAR tol = SCALAR(settings_.lqoc_solver_settings.ipm_tolerance);
+    MatrixX K(nU, nU);
+    Eigen::LLT<MatrixX> lltK;
+    VectorX rd, rp, rc, dU, ds, dLambda;
+
+    converged_ = false;
+    for (nIterations_ = 0;; nIterations_++)
+    {
+        rd = H_ * U_ + g_ + C.transpose() * lambda;
+        rp = C * U_ + s - d;
+        const SCALAR mu = s.dot(lambda) / SCALAR(2 * nC);
+
+        converged_ =
+            rd.template lpNorm<Eigen::Infinity>() < tol && rp.template lpNorm<Eigen::Infinity>() < tol && mu < tol;
+        if (converged_ || nIterations_ == settings_.lqoc_solver_settings.num_ipm_iterations)
+            break;
+
+        // reduced system (H + C^T W C) dU = -rd + C^T ((rc - lambda .* rp) ./ s), W = lambda ./ s
+        const VectorX w = lambda.cwiseQuotient(s);
+        K = H_;
+        K.noalias() += C.transpose() * w.asDiagonal() * C;
+        lltK.compute(K);
+
+        auto computeStep = [&]() {
+            dU = lltK.solve(-rd + C.transpose() * (rc - lambda.cwiseProduct(rp)).cwiseQuotient(s));
+            ds = -rp - C * dU;
+            dLambda = -(rc + lambda.cwiseProduct(ds)).cwiseQuotient(s);
+        };
+
+        // affine predictor
+        rc = s.cwiseProduct(lambda);
+        computeStep();
+        SCALAR alphaAffine = std::min(maxStepLength(s, ds), maxStepLength(lambda, dLambda));
+        const SCALAR muAffine = (s + alphaAffine * ds).dot(lambda + alphaAffine * dLambda) / SCALAR(2 * nC);
+        const SCALAR sigma = std::pow(muAffine / mu, SCALAR(3.0));
+
+        // centering corrector
+        rc = s.cwiseProduct(lambda) + ds.cwiseProduct(dLambda) - VectorX::Constant(2 * nC, sigma * mu);
+        computeStep();
+
+        const SCALAR alpha = std::min(SCALAR(1.0),
+            SCALAR(ipmStepFraction_) * std::min(maxStepLength(s, ds), maxStepLength(lambda, dLambda)));
+        U_ += alpha * dU;
+        s += alpha * ds;
+        lambda += alpha * dLambda;
+    }
+
+    if (!converged_)
+        std::cerr << "WARNING: CondensingSolver: interior point method did not converge in " << nIterations_
+                  << " iterations, the solution may violate the constraints." << std::endl;
+
+    if (settings_.lqoc_solver_settings.lqoc_debug_print)
+        std::cout << "CondensingSolver: " << nIterations_ << " interior point iterations" << std::endl;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+SCALAR CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::maxStepLength(const VectorX& v, const VectorX& dv)
+{
+    SCALAR alpha = SCALAR(1.0);
+    for (int i = 0; i < v.size(); i++)
+        if (dv(i) < SCALAR(0.0))
+            alpha = std::min(alpha, -v(i) / dv(i));
+    return alpha;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::expandSolution()
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+
+    this->x_sol_[0] = p.x_[0];
+    for (int k = 0; k < N_; k++)
+    {
+        this->u_sol_[k] = U_.segment(k * CONTROL_DIM, CONTROL_DIM);
+        this->x_sol_[k + 1] = p.A_[k] * this->x_sol_[k] + p.B_[k] * this->u_sol_[k] + p.b_[k];
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designFeedback()
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+
+    StateMatrix S = p.Q_[N_];
+    for (int k = N_ - 1; k >= 0; k--)
+    {
+        ControlMatrix Hk = p.R_[k];
+        Hk.noalias() += p.B_[k].transpose() * S * p.B_[k];
+        if (settings_.fixedHessianCorrection && settings_.epsilon > 1e-10)
+            Hk += SCALAR(settings_.epsilon) * ControlMatrix::Identity();
+
+        core::FeedbackMatrix<STATE_DIM, CONTROL_DIM, SCALAR> Gk = p.P_[k];
+        Gk.noalias() += p.B_[k].transpose() * S * p.A_[k];
+
+        this->L_[k] = -Hk.ldlt().solve(Gk);
+
+        StateMatrix Sk = p.Q_[k];
+        Sk.noalias() += p.A_[k].transpose() * S * p.A_[k];
+        Sk.noalias() += Gk.transpose() * this->L_[k];
+        S = 0.5 * (Sk + Sk.transpose());
+    }
+}
+
+
+}  // namespace optcon
+}  // namespace ct
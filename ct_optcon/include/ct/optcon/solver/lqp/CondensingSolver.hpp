@@ -0,0 +1,136 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "LQOCSolver.hpp"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \brief Solves an LQOCProblem by condensing it into a dense QP in the controls
+ *
+ * The states are eliminated using the dynamics, \f$ \mathbf x = \mathbf \Gamma \mathbf U + \mathbf c \f$, where
+ * \f$ \mathbf U \f$ stacks all controls and \f$ \mathbf \Gamma \f$ is block lower triangular. For time-invariant
+ * dynamics \f$ \mathbf \Gamma \f$ is block Toeplitz and built from the N products \f$ \mathbf A^i \mathbf B \f$ only.
+ * The dense Hessian and gradient are accumulated with a backward recursion in \f$ O(N^2) \f$ block operations.
+ *
+ * The unconstrained QP is solved with a Cholesky factorization. Box and general constraints are condensed into
+ * dense inequalities in \f$ \mathbf U \f$ and the QP is solved with a Mehrotra predictor-corrector interior point
+ * method, using at most LQOCSolverSettings::num_ipm_iterations iterations. If the tolerance
+ * LQOCSolverSettings::ipm_tolerance is not reached, a warning is printed and converged() returns false.
+ *
+ * Condensing pays off for short horizons with many states and few controls. As the effort grows with \f$ N^2 \f$
+ * (Hessian) and \f$ (N m)^3 \f$ (factorization), GNRiccatiSolver or HPIPMInterface are preferable for long horizons.
+ *
+ * The feedback gains are only computed if closed-loop shooting is selected in the settings. They are the gains of the
+ * unconstrained problem.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class CondensingSolver : public LQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static const int state_dim = STATE_DIM;
+    static const int control_dim = CONTROL_DIM;
+
+    typedef LQOCProblem<STATE_DIM, CONTROL_DIM, SCALAR> LQOCProblem_t;
+
+    typedef ct::core::StateMatrix<STATE_DIM, SCALAR> StateMatrix;
+    typedef ct::core::ControlMatrix<CONTROL_DIM, SCALAR> ControlMatrix;
+    typedef ct::core::StateVectorArray<STATE_DIM, SCALAR> StateVectorArray;
+    typedef ct::core::StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR> StateControlMatrixArray;
+
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic> MatrixX;
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> VectorX;
+
+    CondensingSolver(const std::shared_ptr<LQOCProblem_t>& lqocProblem = nullptr);
+
+    CondensingSolver(int N);
+
+    ~CondensingSolver() override = default;
+
+    void configure(const NLOptConSettings& settings) override;
+
+    //! the box constraints are read from the problem in every solve, nothing to configure
+    void configureBoxConstraints(std::shared_ptr<LQOCProblem<STATE_DIM, CONTROL_DIM>> lqocProblem) override {}
+    //! the general constraints are read from the problem in every solve, nothing to configure
+    void configureGeneralConstraints(std::shared_ptr<LQOCProblem<STATE_DIM, CONTROL_DIM>> lqocProblem) override {}
+    void initializeAndAllocate() override;
+
+    void solve() override;
+
+    //! the number of interior point iterations of the last solve, zero for unconstrained problems
+    int getNumIterations() const { return nIterations_; }
+    //! false if the interior point method of the last solve stopped at the iteration limit
+    bool converged() const { return converged_; }
+
+protected:
+    void setProblemImpl(std::shared_ptr<LQOCProblem_t> lqocProblem) override;
+
+    void changeNumberOfStages(int N);
+
+    //! compute Gamma_ and the free state response c_
+    void computeStateSensitivities();
+
+    //! compute the dense Hessian H_ and gradient g_ in the controls
+    void condenseCost();
+
+    //! collect all constraints as lb <= G U <= ub
+    void condenseConstraints();
+
+    //! factorize H_, regularize it if necessary
+    void factorizeHessian();
+
+    //! solve the condensed QP with box and general constraints
+    void solveConstrainedQP();
+
+    //! compute the state trajectory for the optimal controls
+    void expandSolution();
+
+    //! Riccati recursion for the feedback gains of the unconstrained problem
+    void designFeedback();
+
+    //! largest step in (0, 1] which keeps v + alpha * dv >= 0
+    static SCALAR maxStepLength(const VectorX& v, const VectorX& dv);
+
+    NLOptConSettings settings_;
+
+    int N_;
+
+    //! sensitivity of all states w.r.t. all controls, block (k, j) is dx_k / du_j
+    MatrixX Gamma_;
+    //! state trajectory for zero controls
+    StateVectorArray c_;
+    //! A^i * B, used for time invariant dynamics
+    StateControlMatrixArray AiB_;
+
+    MatrixX H_;
+    VectorX g_;
+    //! backward recursion of the state cost, Hessian and gradient part
+    Eigen::Matrix<SCALAR, STATE_DIM, Eigen::Dynamic> M_;
+    Eigen::Matrix<SCALAR, STATE_DIM, 1> m_;
+
+    Eigen::LLT<MatrixX> llt_;
+
+    //! condensed constraints lb_ <= G_ U <= ub_
+    MatrixX G_;
+    VectorX lb_;
+    VectorX ub_;
+
+    VectorX U_;
+
+    int nIterations_;
+    bool converged_;
+
+    //! fraction of the step to the boundary
+    static constexpr double ipmStepFraction_ = 0.995;
+};
+
+
+}  // namespace optcon
+}  // namespace ct
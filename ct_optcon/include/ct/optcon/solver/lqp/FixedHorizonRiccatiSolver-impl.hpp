@@ -0,0 +1,117 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t N, typename SCALAR>
+FixedHorizonRiccatiSolver<STATE_DIM, CONTROL_DIM, N, SCALAR>::FixedHorizonRiccatiSolver()
+{
+    configure(NLOptConSettings());
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t N, typename SCALAR>
+void FixedHorizonRiccatiSolver<STATE_DIM, CONTROL_DIM, N, SCALAR>::configure(const NLOptConSettings& settings)
+{
+    epsilon_ = settings.epsilon;
+    fixedHessianCorrection_ = settings.fixedHessianCorrection;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t N, typename SCALAR>
+inline void FixedHorizonRiccatiSolver<STATE_DIM, CONTROL_DIM, N, SCALAR>::solve(const Problem_t& p)
+{
+    S_[N] = p.Q_[N];
+    sv_[N] = p.qv_[N];
+
+    for (int k = N - 1; k >= 0; k--)
+    {
+        designController(p, k);
+
+        if (k > 0)
+            computeCostToGo(p, k);
+    }
+
+    extractLQSolution(p);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t N, typename SCALAR>
+inline void FixedHorizonRiccatiSolver<STATE_DIM, CONTROL_DIM, N, SCALAR>::designController(const Problem_t& p,
+    size_t k)
+{
+    const Eigen::Matrix<SCALAR, CONTROL_DIM, STATE_DIM> BtS =
+        p.B_[k].transpose() * S_[k + 1].template selfadjointView<Eigen::Lower>();
+
+    gv_[k] = p.rv_[k];
+    gv_[k].noalias() += p.B_[k].transpose() * sv_[k + 1];
+    gv_[k].noalias() += BtS * p.b_[k];
+
+    G_[k] = p.P_[k];
+    G_[k].noalias() += BtS * p.A_[k];
+
+    ControlMatrix H = p.R_[k];
+    H.noalias() += BtS * p.B_[k];
+
+    if (fixedHessianCorrection_)
+    {
+        if (epsilon_ > 1e-10)
+            Hi_[k] = H + epsilon_ * ControlMatrix::Identity();
+        else
+            Hi_[k] = H;
+
+        Hi_inverse_[k] = -Hi_[k].template selfadjointView<Eigen::Lower>().llt().solve(ControlMatrix::Identity());
+    }
+    else
+    {
+        // make H positive definite by clamping its eigenvalues, see GNRiccatiSolver
+        eigenvalueSolver_.compute(H, Eigen::ComputeEigenvectors);
+        const ControlMatrix& V = eigenvalueSolver_.eigenvectors();
+        const ControlVector D = eigenvalueSolver_.eigenvalues().cwiseMax(epsilon_);
+
+        Hi_[k].noalias() = V * D.asDiagonal() * V.transpose();
+        Hi_inverse_[k].noalias() = V * (-1.0 * D.cwiseInverse()).asDiagonal() * V.transpose();
+    }
+
+    L_[k].noalias() = Hi_inverse_[k] * G_[k];
+    lv_[k].noalias() = Hi_inverse_[k] * gv_[k];
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t N, typename SCALAR>
+inline void FixedHorizonRiccatiSolver<STATE_DIM, CONTROL_DIM, N, SCALAR>::computeCostToGo(const Problem_t& p, size_t k)
+{
+    const Eigen::Matrix<SCALAR, CONTROL_DIM, STATE_DIM> HiL = Hi_[k] * L_[k];
+
+    S_[k] = p.Q_[k];
+    S_[k].noalias() += p.A_[k].transpose() * S_[k + 1] * p.A_[k];
+    S_[k].noalias() -= L_[k].transpose() * HiL;
+    S_[k] = 0.5 * (S_[k] + S_[k].transpose()).eval();
+
+    sv_[k] = p.qv_[k];
+    sv_[k].noalias() += p.A_[k].transpose() * (sv_[k + 1] + S_[k + 1] * p.b_[k]);
+    sv_[k].noalias() += HiL.transpose() * lv_[k];
+    sv_[k].noalias() += L_[k].transpose() * gv_[k];
+    sv_[k].noalias() += G_[k].transpose() * lv_[k];
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t N, typename SCALAR>
+inline void FixedHorizonRiccatiSolver<STATE_DIM, CONTROL_DIM, N, SCALAR>::extractLQSolution(const Problem_t& p)
+{
+    x_sol_[0] = p.x_[0];
+
+    for (size_t k = 0; k < N; k++)
+    {
+        u_sol_[k] = lv_[k] + L_[k] * x_sol_[k];
+        x_sol_[k + 1] = p.A_[k] * x_sol_[k] + p.B_[k] * u_sol_[k] + p.b_[k];
+    }
+}
+
+}  // namespace optcon
+}  // namespace ct
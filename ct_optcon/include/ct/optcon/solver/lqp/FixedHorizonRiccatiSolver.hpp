@@ -0,0 +1,81 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <array>
+
+#include <ct/optcon/problem/FixedHorizonLQOCProblem.hpp>
+#include <ct/optcon/solver/NLOptConSettings.hpp>
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \brief Riccati backward pass for an unconstrained LQ problem with a compile-time number of stages
+ *
+ * Implements the same recursion and Hessian regularization as GNRiccatiSolver, but without virtual dispatch,
+ * shared pointers or heap allocated stage data. All loops run over the compile-time horizon N, such that the compiler
+ * can fully inline the sweep for small problems.
+ *
+ * \tparam N the number of stages
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t N, typename SCALAR = double>
+class FixedHorizonRiccatiSolver
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef FixedHorizonLQOCProblem<STATE_DIM, CONTROL_DIM, N, SCALAR> Problem_t;
+
+    typedef ct::core::StateVector<STATE_DIM, SCALAR> StateVector;
+    typedef ct::core::ControlVector<CONTROL_DIM, SCALAR> ControlVector;
+    typedef ct::core::StateMatrix<STATE_DIM, SCALAR> StateMatrix;
+    typedef ct::core::ControlMatrix<CONTROL_DIM, SCALAR> ControlMatrix;
+    typedef ct::core::FeedbackMatrix<STATE_DIM, CONTROL_DIM, SCALAR> FeedbackMatrix;
+
+    typedef std::array<StateVector, N + 1> StateVectorArray;
+    typedef std::array<ControlVector, N> ControlVectorArray;
+    typedef std::array<FeedbackMatrix, N> FeedbackArray;
+
+    FixedHorizonRiccatiSolver();
+
+    //! uses epsilon and fixedHessianCorrection of the settings
+    void configure(const NLOptConSettings& settings);
+
+    //! Riccati backward pass followed by the forward computation of the state and control solution
+    void solve(const Problem_t& p);
+
+    const StateVectorArray& getSolutionState() const { return x_sol_; }
+    const ControlVectorArray& getSolutionControl() const { return u_sol_; }
+    const FeedbackArray& getSolutionFeedback() const { return L_; }
+private:
+    void designController(const Problem_t& p, size_t k);
+
+    void computeCostToGo(const Problem_t& p, size_t k);
+
+    void extractLQSolution(const Problem_t& p);
+
+    SCALAR epsilon_;
+    bool fixedHessianCorrection_;
+
+    std::array<ControlVector, N> gv_;
+    std::array<FeedbackMatrix, N> G_;
+    std::array<ControlMatrix, N> Hi_;
+    std::array<ControlMatrix, N> Hi_inverse_;
+    std::array<ControlVector, N> lv_;
+    FeedbackArray L_;
+
+    std::array<StateVector, N + 1> sv_;
+    std::array<StateMatrix, N + 1> S_;
+
+    StateVectorArray x_sol_;
+    ControlVectorArray u_sol_;
+
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM>> eigenvalueSolver_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -77,7 +77,7 @@ protected:
 
     void computeCostToGo(size_t k);
 
-    void designController(size_t k);
+    virtual void designController(size_t k);
 
     void logToMatlab();
 
@@ -8,6 +8,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include "ADTest_timeDependent.h"
 #include "CostFunctionTest.h"
+#include "SharedCostFunctionTest.h"
+#include "HorizonCostFunctionTest.h"
 
 
 int main(int argc, char** argv)
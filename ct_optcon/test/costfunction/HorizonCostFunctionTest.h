@@ -0,0 +1,250 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+/*!
+ * Builds an analytical cost function from all terms with a vectorized horizon evaluation, plus a term which uses the
+ * default per-stage horizon evaluation. Some terms are time activated.
+ */
+std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> createHorizonCostFunction(const size_t N,
+    const double dt)
+{
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction(
+        new CostFunctionAnalytical<state_dim, control_dim>());
+
+    Eigen::Matrix<double, state_dim, state_dim> Q = Eigen::Matrix<double, state_dim, state_dim>::Random();
+    Eigen::Matrix<double, control_dim, control_dim> R = Eigen::Matrix<double, control_dim, control_dim>::Random();
+
+    std::shared_ptr<TermQuadratic<state_dim, control_dim>> termQuadratic(new TermQuadratic<state_dim, control_dim>(
+        Q, R, core::StateVector<state_dim>::Random(), core::ControlVector<control_dim>::Random()));
+    costFunction->addIntermediateTerm(termQuadratic);
+
+    core::StateVectorArray<state_dim> xRef(N + 1);
+    core::ControlVectorArray<control_dim> uRef(N + 1);
+    for (size_t k = 0; k < N + 1; k++)
+    {
+        xRef[k].setRandom();
+        uRef[k].setRandom();
+    }
+    std::shared_ptr<TermQuadTracking<state_dim, control_dim>> termTracking(
+        new TermQuadTracking<state_dim, control_dim>(Q, R, core::LIN, core::ZOH, true));
+    termTracking->setStateAndControlReference(
+        core::StateTrajectory<state_dim>(xRef, dt, 0.0, core::LIN), core::ControlTrajectory<control_dim>(uRef, dt, 0.0));
+    termTracking->setTimeActivation(std::shared_ptr<core::tpl::ActivationBase<double>>(
+        new core::tpl::LinearActivation<double>(0.25 * N * dt, 0.75 * N * dt, 2.0, 0.5)));
+    costFunction->addIntermediateTerm(termTracking);
+
+    std::shared_ptr<TermLinear<state_dim, control_dim>> termLinear(new TermLinear<state_dim, control_dim>(
+        core::StateVector<state_dim>::Random(), core::ControlVector<control_dim>::Random(), 0.3));
+    termLinear->setTimeActivation(std::shared_ptr<core::tpl::ActivationBase<double>>(
+        new core::tpl::SingleActivation<double>(0.0, 0.5 * N * dt)));
+    costFunction->addIntermediateTerm(termLinear);
+
+    std::shared_ptr<TermSmoothAbs<state_dim, control_dim>> termSmoothAbs(
+        new TermSmoothAbs<state_dim, control_dim>(core::StateVector<state_dim>::Random().cwiseAbs(),
+            core::StateVector<state_dim>::Random(), core::ControlVector<control_dim>::Random().cwiseAbs(),
+            core::ControlVector<control_dim>::Random(), 0.1));
+    costFunction->addIntermediateTerm(termSmoothAbs);
+
+    core::ControlVector<control_dim> uRefQuadMult = core::ControlVector<control_dim>::Random();
+    std::shared_ptr<TermQuadMult<state_dim, control_dim>> termQuadMult(
+        new TermQuadMult<state_dim, control_dim>(Q, R, core::StateVector<state_dim>::Random(), uRefQuadMult));
+    costFunction->addIntermediateTerm(termQuadMult);
+
+    return costFunction;
+}
+
+/*!
+ * Compares the horizon evaluation of an analytical cost function to the stage-wise evaluation and prints the
+ * evaluation times of both.
+ */
+TEST(CostFunctionTest, HorizonEvaluationTest)
+{
+    const size_t N = 100;
+    const double dt = 0.01;
+    const size_t nRuns = 100;
+
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction = createHorizonCostFunction(N, dt);
+
+    core::StateVectorArray<state_dim> x(N + 1);
+    core::ControlVectorArray<control_dim> u(N);
+    for (size_t k = 0; k < N; k++)
+    {
+        x[k].setRandom();
+        u[k].setRandom();
+    }
+    x[N].setRandom();
+
+    // stage-wise reference
+    double costReference = 0.0;
+    core::StateVectorArray<state_dim> dxReference(N);
+    core::StateMatrixArray<state_dim> dxxReference(N);
+    core::ControlVectorArray<control_dim> duReference(N);
+    core::ControlMatrixArray<control_dim> duuReference(N);
+    core::FeedbackArray<state_dim, control_dim> duxReference(N);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nRuns; i++)
+    {
+        costReference = 0.0;
+        for (size_t k = 0; k < N; k++)
+        {
+            costFunction->setCurrentStateAndControl(x[k], u[k], dt * k);
+            costReference += costFunction->evaluateIntermediate();
+            dxReference[k] = costFunction->stateDerivativeIntermediate();
+            dxxReference[k] = costFunction->stateSecondDerivativeIntermediate();
+            duReference[k] = costFunction->controlDerivativeIntermediate();
+            duuReference[k] = costFunction->controlSecondDerivativeIntermediate();
+            duxReference[k] = costFunction->stateControlDerivativeIntermediate();
+        }
+    }
+    std::chrono::duration<double, std::micro> stageTime = std::chrono::steady_clock::now() - start;
+
+    // horizon evaluation
+    double cost = 0.0;
+    core::StateVectorArray<state_dim> dx(N);
+    core::StateMatrixArray<state_dim> dxx(N);
+    core::ControlVectorArray<control_dim> du(N);
+    core::ControlMatrixArray<control_dim> duu(N);
+    core::FeedbackArray<state_dim, control_dim> dux(N);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nRuns; i++)
+    {
+        cost = costFunction->evaluateIntermediateHorizon(x, u, dt);
+        costFunction->intermediateDerivativesHorizon(x, u, dt, 0, N - 1, dx, dxx, du, duu, dux);
+    }
+    std::chrono::duration<double, std::micro> horizonTime = std::chrono::steady_clock::now() - start;
+
+    std::cout << "average evaluation time of cost and derivatives for " << N << " stages: stage-wise "
+              << stageTime.count() / nRuns << " us, horizon " << horizonTime.count() / nRuns << " us" << std::endl;
+
+    const double tol = 1e-10;
+    EXPECT_NEAR(cost, costReference, tol * std::abs(costReference));
+    for (size_t k = 0; k < N; k++)
+    {
+        EXPECT_TRUE(dx[k].isApprox(dxReference[k], tol));
+        EXPECT_TRUE(dxx[k].isApprox(dxxReference[k], tol));
+        EXPECT_TRUE(du[k].isApprox(duReference[k], tol));
+        EXPECT_TRUE(duu[k].isApprox(duuReference[k], tol));
+        EXPECT_TRUE(dux[k].isApprox(duxReference[k], tol));
+    }
+
+    // a sub-range only writes the requested stages
+    core::StateVectorArray<state_dim> dxRange(N, core::StateVector<state_dim>::Zero());
+    costFunction->intermediateDerivativesHorizon(x, u, dt, 30, 60, dxRange, dxx, du, duu, dux);
+    for (size_t k = 0; k < N; k++)
+    {
+        if (k < 30 || k > 60)
+            EXPECT_TRUE(dxRange[k].isZero());
+        else
+            EXPECT_TRUE(dxRange[k].isApprox(dxReference[k], tol));
+    }
+
+    // the default implementation of the base class gives the same result
+    CostFunctionQuadraticSimple<state_dim, control_dim> costFunctionSimple(
+        Eigen::Matrix<double, state_dim, state_dim>::Identity(),
+        Eigen::Matrix<double, control_dim, control_dim>::Identity(), core::StateVector<state_dim>::Random(),
+        core::ControlVector<control_dim>::Random(), core::StateVector<state_dim>::Zero(),
+        Eigen::Matrix<double, state_dim, state_dim>::Identity());
+    costReference = 0.0;
+    for (size_t k = 0; k < N; k++)
+    {
+        costFunctionSimple.setCurrentStateAndControl(x[k], u[k], dt * k);
+        costReference += costFunctionSimple.evaluateIntermediate();
+    }
+    EXPECT_NEAR(costFunctionSimple.evaluateIntermediateHorizon(x, u, dt), costReference, tol * costReference);
+}
+
+/*!
+ * Compares the horizon derivatives of an auto-diff cost function, which evaluates the generated derivatives in
+ * batches, to the stage-wise evaluation and prints the evaluation times of both.
+ */
+TEST(CostFunctionTest, HorizonEvaluationADTest)
+{
+    const size_t N = 101;
+    const double dt = 0.01;
+    const size_t nRuns = 100;
+
+    typedef TermQuadratic<state_dim, control_dim, double, ct::core::ADCGScalar> ADQuadratic;
+    typedef TermQuadMult<state_dim, control_dim, double, ct::core::ADCGScalar> ADQuadMult;
+
+    Eigen::Matrix<double, state_dim, state_dim> Q = Eigen::Matrix<double, state_dim, state_dim>::Random();
+    Eigen::Matrix<double, control_dim, control_dim> R = Eigen::Matrix<double, control_dim, control_dim>::Random();
+
+    CostFunctionAD<state_dim, control_dim> costFunction;
+    costFunction.addIntermediateADTerm(std::shared_ptr<ADQuadratic>(
+        new ADQuadratic(Q, R, core::StateVector<state_dim>::Random(), core::ControlVector<control_dim>::Random())));
+    core::StateVector<state_dim> xRefQuadMult = core::StateVector<state_dim>::Random();
+    core::ControlVector<control_dim> uRefQuadMult = core::ControlVector<control_dim>::Random();
+    costFunction.addIntermediateADTerm(
+        std::shared_ptr<ADQuadMult>(new ADQuadMult(Q, R, xRefQuadMult, uRefQuadMult)));
+    costFunction.addIntermediateTerm(std::shared_ptr<TermLinear<state_dim, control_dim>>(
+        new TermLinear<state_dim, control_dim>(
+            core::StateVector<state_dim>::Random(), core::ControlVector<control_dim>::Random(), 0.3)));
+    core::DerivativesCppadSettings batchSettings;
+    batchSettings.createBatch_ = true;
+    costFunction.setBatchSettings(batchSettings);
+    costFunction.initialize();
+
+    core::StateVectorArray<state_dim> x(N + 1);
+    core::ControlVectorArray<control_dim> u(N);
+    for (size_t k = 0; k < N; k++)
+    {
+        x[k].setRandom();
+        u[k].setRandom();
+    }
+    x[N].setRandom();
+
+    core::StateVectorArray<state_dim> dxReference(N), dx(N);
+    core::StateMatrixArray<state_dim> dxxReference(N), dxx(N);
+    core::ControlVectorArray<control_dim> duReference(N), du(N);
+    core::ControlMatrixArray<control_dim> duuReference(N), duu(N);
+    core::FeedbackArray<state_dim, control_dim> duxReference(N), dux(N);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nRuns; i++)
+    {
+        for (size_t k = 0; k < N; k++)
+        {
+            costFunction.setCurrentStateAndControl(x[k], u[k], dt * k);
+            dxReference[k] = costFunction.stateDerivativeIntermediate();
+            dxxReference[k] = costFunction.stateSecondDerivativeIntermediate();
+            duReference[k] = costFunction.controlDerivativeIntermediate();
+            duuReference[k] = costFunction.controlSecondDerivativeIntermediate();
+            duxReference[k] = costFunction.stateControlDerivativeIntermediate();
+        }
+    }
+    std::chrono::duration<double, std::micro> stageTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nRuns; i++)
+        costFunction.intermediateDerivativesHorizon(x, u, dt, 0, N - 1, dx, dxx, du, duu, dux);
+    std::chrono::duration<double, std::micro> horizonTime = std::chrono::steady_clock::now() - start;
+
+    std::cout << "average evaluation time of auto-diff derivatives per stage: stage-wise "
+              << stageTime.count() / nRuns / N << " us, batched horizon " << horizonTime.count() / nRuns / N << " us" << std::endl;
+
+    const double tol = 1e-10;
+    for (size_t k = 0; k < N; k++)
+    {
+        EXPECT_TRUE(dx[k].isApprox(dxReference[k], tol));
+        EXPECT_TRUE(dxx[k].isApprox(dxxReference[k], tol));
+        EXPECT_TRUE(du[k].isApprox(duReference[k], tol));
+        EXPECT_TRUE(duu[k].isApprox(duuReference[k], tol));
+        EXPECT_TRUE(dux[k].isApprox(duxReference[k], tol));
+    }
+}
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
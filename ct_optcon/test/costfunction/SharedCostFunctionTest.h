@@ -0,0 +1,229 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <thread>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "compareCostFunctions.h"
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+//! heap memory currently allocated by this process in kB, 0 if it cannot be queried
+inline size_t allocatedMemoryKb()
+{
+#ifdef __GLIBC__
+#if __GLIBC_PREREQ(2, 33)
+    return mallinfo2().uordblks / 1024;
+#else
+    // mallinfo() counts in int, the heap of this test stays far below its range
+    return static_cast<unsigned int>(mallinfo().uordblks) / 1024;
+#endif
+#else
+    return 0;
+#endif
+}
+
+/*!
+ * Creates per-thread instances of a large AD cost function by deep cloning and by shared cloning, compares the memory
+ * footprint and checks that the shared instances can be evaluated concurrently.
+ */
+TEST(CostFunctionTest, SharedCloneTest)
+{
+    const size_t nThreads = 16;
+    const size_t nTerms = 20;
+    const size_t nTests = 10;
+
+    typedef CostFunctionAD<state_dim, control_dim> CostFunctionAD_t;
+    typedef TermQuadratic<state_dim, control_dim, double, ct::core::ADCGScalar> TermAD_t;
+
+    CostFunctionAD_t costFunctionAD;
+
+    for (size_t i = 0; i < nTerms; i++)
+    {
+        Eigen::Matrix<double, state_dim, state_dim> Q;
+        Eigen::Matrix<double, control_dim, control_dim> R;
+        Q.setRandom();
+        R.setRandom();
+        Q += Q.transpose().eval();
+        R += R.transpose().eval();
+
+        std::shared_ptr<TermAD_t> term(new TermAD_t(Q, R));
+        term->setStateAndControlReference(
+            core::StateVector<state_dim>::Random(), core::ControlVector<control_dim>::Random());
+        costFunctionAD.addIntermediateADTerm(term);
+    }
+    Eigen::Matrix<double, state_dim, state_dim> Q_final = Eigen::Matrix<double, state_dim, state_dim>::Identity();
+    Eigen::Matrix<double, control_dim, control_dim> R_final = Eigen::Matrix<double, control_dim, control_dim>::Zero();
+    costFunctionAD.addFinalADTerm(std::shared_ptr<TermAD_t>(new TermAD_t(Q_final, R_final)));
+
+    costFunctionAD.initialize();
+
+    size_t memoryStart = allocatedMemoryKb();
+    std::vector<std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>>> sharedInstances;
+    for (size_t i = 0; i < nThreads; i++)
+        sharedInstances.emplace_back(costFunctionAD.cloneShared());
+    size_t memoryShared = allocatedMemoryKb() - memoryStart;
+
+    memoryStart = allocatedMemoryKb();
+    std::vector<std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>>> deepInstances;
+    for (size_t i = 0; i < nThreads; i++)
+        deepInstances.emplace_back(costFunctionAD.clone());
+    size_t memoryDeep = allocatedMemoryKb() - memoryStart;
+
+    std::cout << "memory for " << nThreads << " instances with " << nTerms << " terms: deep clones " << memoryDeep
+              << " kB, shared clones " << memoryShared << " kB" << std::endl;
+
+    EXPECT_LE(memoryShared, memoryDeep);
+
+    // shared instances are equivalent to deep instances
+    for (size_t j = 0; j < nTests; j++)
+    {
+        core::StateVector<state_dim> x = core::StateVector<state_dim>::Random();
+        core::ControlVector<control_dim> u = core::ControlVector<control_dim>::Random();
+
+        deepInstances[0]->setCurrentStateAndControl(x, u, 0.0);
+        sharedInstances[0]->setCurrentStateAndControl(x, u, 0.0);
+        compareCostFunctionOutput(*deepInstances[0], *sharedInstances[0]);
+    }
+
+    // shared instances can be evaluated concurrently
+    std::vector<core::StateVector<state_dim>, Eigen::aligned_allocator<core::StateVector<state_dim>>> xs(nTests);
+    std::vector<core::ControlVector<control_dim>, Eigen::aligned_allocator<core::ControlVector<control_dim>>> us(
+        nTests);
+    std::vector<double> costs(nTests);
+    for (size_t j = 0; j < nTests; j++)
+    {
+        xs[j].setRandom();
+        us[j].setRandom();
+        costFunctionAD.setCurrentStateAndControl(xs[j], us[j], 0.0);
+        costs[j] = costFunctionAD.evaluateIntermediate();
+    }
+
+    std::vector<int> success(nThreads, 1);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nThreads; i++)
+    {
+        threads.emplace_back([&, i]() {
+            for (size_t rep = 0; rep < 100; rep++)
+                for (size_t j = 0; j < nTests; j++)
+                {
+                    sharedInstances[i]->setCurrentStateAndControl(xs[j], us[j], 0.0);
+                    sharedInstances[i]->stateSecondDerivativeIntermediate();
+                    if (std::abs(sharedInstances[i]->evaluateIntermediate() - costs[j]) > 1e-9)
+                        success[i] = 0;
+                }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    for (size_t i = 0; i < nThreads; i++)
+        ASSERT_TRUE(success[i]);
+}
+
+/*!
+ * Creates per-thread instances of an analytical cost function with a long tracking reference by deep cloning and by
+ * shared cloning, compares the memory footprint and checks that the shared instances can be evaluated concurrently.
+ */
+TEST(CostFunctionTest, SharedCloneAnalyticalTest)
+{
+    const size_t nThreads = 16;
+    const size_t nSamples = 10000;
+    const double dt = 0.001;
+
+    typedef CostFunctionAnalytical<state_dim, control_dim> CostFunctionAnalytical_t;
+    typedef TermQuadTracking<state_dim, control_dim> TermTracking_t;
+
+    core::StateVectorArray<state_dim> xRef(nSamples);
+    core::ControlVectorArray<control_dim> uRef(nSamples);
+    for (size_t k = 0; k < nSamples; k++)
+    {
+        xRef[k].setConstant(std::sin(k * dt));
+        uRef[k].setConstant(std::cos(k * dt));
+    }
+    core::StateTrajectory<state_dim> xTraj(xRef, dt, 0.0, core::LIN);
+    core::ControlTrajectory<control_dim> uTraj(uRef, dt, 0.0, core::ZOH);
+
+    Eigen::Matrix<double, state_dim, state_dim> Q = Eigen::Matrix<double, state_dim, state_dim>::Identity();
+    Eigen::Matrix<double, control_dim, control_dim> R = Eigen::Matrix<double, control_dim, control_dim>::Identity();
+    std::shared_ptr<TermTracking_t> term(new TermTracking_t(Q, R, core::LIN, core::ZOH, true));
+    term->setStateAndControlReference(xTraj, uTraj);
+
+    CostFunctionAnalytical_t costFunction;
+    costFunction.addIntermediateTerm(term);
+
+    size_t memoryStart = allocatedMemoryKb();
+    std::vector<std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>>> sharedInstances;
+    for (size_t i = 0; i < nThreads; i++)
+        sharedInstances.emplace_back(costFunction.cloneShared());
+    size_t memoryShared = allocatedMemoryKb() - memoryStart;
+
+    memoryStart = allocatedMemoryKb();
+    std::vector<std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>>> deepInstances;
+    for (size_t i = 0; i < nThreads; i++)
+        deepInstances.emplace_back(costFunction.clone());
+    size_t memoryDeep = allocatedMemoryKb() - memoryStart;
+
+    std::cout << "memory for " << nThreads << " analytical instances with " << nSamples
+              << " reference samples: deep clones " << memoryDeep << " kB, shared clones " << memoryShared << " kB"
+              << std::endl;
+
+    EXPECT_LE(memoryShared, memoryDeep);
+
+    // shared instances are equivalent to deep instances
+    const size_t nTests = 100;
+    std::vector<core::StateVector<state_dim>, Eigen::aligned_allocator<core::StateVector<state_dim>>> xs(nTests);
+    std::vector<core::ControlVector<control_dim>, Eigen::aligned_allocator<core::ControlVector<control_dim>>> us(
+        nTests);
+    std::vector<double> ts(nTests), costs(nTests);
+    for (size_t j = 0; j < nTests; j++)
+    {
+        xs[j].setRandom();
+        us[j].setRandom();
+        ts[j] = (nTests - j) * (nSamples - 1) * dt / nTests;  // backwards, such that the interpolation has to search
+        costFunction.setCurrentStateAndControl(xs[j], us[j], ts[j]);
+        costs[j] = costFunction.evaluateIntermediate();
+
+        deepInstances[0]->setCurrentStateAndControl(xs[j], us[j], ts[j]);
+        sharedInstances[0]->setCurrentStateAndControl(xs[j], us[j], ts[j]);
+        compareCostFunctionOutput(*deepInstances[0], *sharedInstances[0]);
+    }
+
+    // changing the reference of the original does not affect existing shared instances
+    term->setStateAndControlReference(core::StateTrajectory<state_dim>(xRef, dt, 1.0, core::LIN), uTraj);
+    sharedInstances[0]->setCurrentStateAndControl(xs[0], us[0], ts[0]);
+    ASSERT_NEAR(sharedInstances[0]->evaluateIntermediate(), costs[0], 1e-12);
+
+    // shared instances can be evaluated concurrently
+    std::vector<int> success(nThreads, 1);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nThreads; i++)
+    {
+        threads.emplace_back([&, i]() {
+            for (size_t rep = 0; rep < 10; rep++)
+                for (size_t j = 0; j < nTests; j++)
+                {
+                    sharedInstances[i]->setCurrentStateAndControl(xs[j], us[j], ts[j]);
+                    if (std::abs(sharedInstances[i]->evaluateIntermediate() - costs[j]) > 1e-9)
+                        success[i] = 0;
+                }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    for (size_t i = 0; i < nThreads; i++)
+        ASSERT_TRUE(success[i]);
+}
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
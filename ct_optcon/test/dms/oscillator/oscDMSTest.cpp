@@ -96,26 +96,7 @@ public:
 
     void getIpoptSolution()
     {
-        settings_.solverSettings_.solverType_ = NlpSolverType::IPOPT;
-
-        generalConstraints_ = std::shared_ptr<ct::optcon::ConstraintContainerAnalytical<2, 1>>(
-            new ct::optcon::ConstraintContainerAnalytical<2, 1>());
-
-        std::shared_ptr<TerminalConstraint<2, 1>> termConstraint(new TerminalConstraint<2, 1>(x_final_));
-
-        termConstraint->setName("TerminalConstraint");
-        generalConstraints_->addTerminalConstraint(termConstraint, true);
-        generalConstraints_->initialize();
-
-        ContinuousOptConProblem<2, 1> optProblem(oscillator_, costFunction_);
-        optProblem.setInitialState(x_0_);
-
-        optProblem.setTimeHorizon(settings_.T_);
-        optProblem.setGeneralConstraints(generalConstraints_);
-        dmsPlanner_ = std::shared_ptr<DmsSolver<2, 1>>(new DmsSolver<2, 1>(optProblem, settings_));
-
-        calcInitGuess();
-        dmsPlanner_->setInitialGuess(initialPolicy_);
+        createIpoptPlanner();
         dmsPlanner_->solve();
         solutionPolicy_ = dmsPlanner_->getSolution();
 
@@ -125,6 +106,54 @@ public:
         timeSolutionIpopt_ = solutionPolicy_.tSolution_;
     }
 
+    /*!
+     * Solves a sequence of problems as in MPC, the initial state advances by one shot along the previous solution.
+     * The first problem is solved from the initial guess, the following ones either from the initial guess again or
+     * warm started from the shifted previous solution.
+     *
+     * @return the time spent in the solves after the first one
+     */
+    double solveIpoptSequence(bool warmStart, bool persistent, size_t nSolves, DmsPolicy<2, 1>& solution)
+    {
+        settings_.solverSettings_.ipoptSettings_.persistentSolver_ = persistent;
+        settings_.solverSettings_.ipoptSettings_.printLevel_ = 0;
+        createIpoptPlanner();
+        EXPECT_TRUE(dmsPlanner_->solve());
+
+        double time = 0.0;
+        for (size_t i = 0; i < nSolves; i++)
+        {
+            OscDimensions::state_vector_t x0 = dmsPlanner_->getSolution().xSolution_[1];
+            dmsPlanner_->changeInitialState(x0);
+
+            auto start = std::chrono::steady_clock::now();
+            bool success;
+            if (warmStart)
+                success = dmsPlanner_->resolve(1);
+            else
+            {
+                dmsPlanner_->setInitialGuess(initialPolicy_);
+                success = dmsPlanner_->solve();
+            }
+            time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            EXPECT_TRUE(success);
+        }
+
+        solution = dmsPlanner_->getSolution();
+        return time;
+    }
+
+    //! solves the problem with IPOPT and the given shot integration
+    DmsPolicy<2, 1> solveIpopt(DmsSettings::IntegrationType integrationType, bool skipUnchangedShots)
+    {
+        settings_.integrationType_ = integrationType;
+        settings_.skipUnchangedShots_ = skipUnchangedShots;
+        settings_.solverSettings_.ipoptSettings_.printLevel_ = 0;
+        createIpoptPlanner();
+        EXPECT_TRUE(dmsPlanner_->solve());
+        return dmsPlanner_->getSolution();
+    }
+
     void getSnoptSolution()
     {
         settings_.solverSettings_.solverType_ = NlpSolverType::SNOPT;
@@ -183,6 +212,30 @@ public:
 
 
 private:
+    void createIpoptPlanner()
+    {
+        settings_.solverSettings_.solverType_ = NlpSolverType::IPOPT;
+
+        generalConstraints_ = std::shared_ptr<ct::optcon::ConstraintContainerAnalytical<2, 1>>(
+            new ct::optcon::ConstraintContainerAnalytical<2, 1>());
+
+        std::shared_ptr<TerminalConstraint<2, 1>> termConstraint(new TerminalConstraint<2, 1>(x_final_));
+
+        termConstraint->setName("TerminalConstraint");
+        generalConstraints_->addTerminalConstraint(termConstraint, true);
+        generalConstraints_->initialize();
+
+        ContinuousOptConProblem<2, 1> optProblem(oscillator_, costFunction_);
+        optProblem.setInitialState(x_0_);
+
+        optProblem.setTimeHorizon(settings_.T_);
+        optProblem.setGeneralConstraints(generalConstraints_);
+        dmsPlanner_ = std::shared_ptr<DmsSolver<2, 1>>(new DmsSolver<2, 1>(optProblem, settings_));
+
+        calcInitGuess();
+        dmsPlanner_->setInitialGuess(initialPolicy_);
+    }
+
     void calcInitGuess()
     {
         x_initguess_.resize(settings_.N_ + 1, OscDimensions::state_vector_t::Zero());
@@ -260,6 +313,117 @@ TEST(DmsTest, OscDmsTest)
 }
 
 
+/*!
+ * Shifting the previous solution moves states, controls, bound multipliers and the multipliers of the initial state
+ * and continuity constraints by the given number of shots, repeats the last pair and keeps the initial state
+ */
+TEST(DmsTest, ShiftSolutionTest)
+{
+    typedef OptVectorDms<2, 1> OptVector_t;
+    typedef Eigen::Map<const Eigen::VectorXd> MapConstVecXd;
+
+    DmsSettings settings;
+    settings.N_ = 6;
+    const size_t nPairs = settings.N_ + 1;
+    const size_t pairSize = 3;
+    const size_t n = nPairs * pairSize;
+    const size_t nShots = 2;
+
+    // the state constraints come first, followed by e.g. a terminal constraint
+    const size_t nStateConstraints = nPairs * 2;
+    const size_t m = nStateConstraints + 2;
+
+    OptVector_t w(n, settings);
+    const Eigen::VectorXd x = Eigen::VectorXd::Random(n);
+    const Eigen::VectorXd zL = Eigen::VectorXd::Random(n);
+    const Eigen::VectorXd zU = Eigen::VectorXd::Random(n);
+    const Eigen::VectorXd lambda = Eigen::VectorXd::Random(m);
+    w.setNewIpoptSolution(MapConstVecXd(x.data(), n), MapConstVecXd(zL.data(), n), MapConstVecXd(zU.data(), n),
+        MapConstVecXd(lambda.data(), m));
+
+    const Eigen::Vector2d x0(0.3, -0.7);
+    w.changeInitialState(x0);
+    w.shiftSolution(nShots);
+
+    Eigen::VectorXd xInit(n), zLShifted(n), zUShifted(n), lambdaShifted(m);
+    Eigen::Map<Eigen::VectorXd> xInitMap(xInit.data(), n), zLMap(zLShifted.data(), n), zUMap(zUShifted.data(), n),
+        lambdaMap(lambdaShifted.data(), m);
+    w.getInitialGuess(n, xInitMap);
+    w.getBoundMultipliers(n, zLMap, zUMap);
+    w.getLambdaVars(m, lambdaMap);
+
+    for (size_t i = 0; i < nPairs; i++)
+    {
+        const size_t from = std::min(i + nShots, nPairs - 1);
+        if (i > 0)
+            ASSERT_EQ(xInit.segment(i * pairSize, 2), x.segment(from * pairSize, 2));
+        ASSERT_EQ(xInit.segment(i * pairSize + 2, 1), x.segment(from * pairSize + 2, 1));
+        ASSERT_EQ(zLShifted.segment(i * pairSize, pairSize), zL.segment(from * pairSize, pairSize));
+        ASSERT_EQ(zUShifted.segment(i * pairSize, pairSize), zU.segment(from * pairSize, pairSize));
+        ASSERT_EQ(lambdaShifted.segment(i * 2, 2), lambda.segment(from * 2, 2));
+    }
+    ASSERT_EQ(xInit.head(2), x0);
+    ASSERT_EQ(lambdaShifted.tail(m - nStateConstraints), lambda.tail(m - nStateConstraints));
+}
+
+
+#ifdef BUILD_WITH_IPOPT_SUPPORT
+/*!
+ * Repeated solves warm started from the shifted previous solution, with and without the persistent IPOPT instance,
+ * find the same solutions as solves from the initial guess
+ */
+TEST(DmsTest, OscDmsResolveTest)
+{
+    const size_t nSolves = 10;
+    DmsPolicy<2, 1> cold, warm, persistent;
+
+    OscDms oscDms;
+    oscDms.initialize();
+    double coldTime = oscDms.solveIpoptSequence(false, false, nSolves, cold);
+    double warmTime = oscDms.solveIpoptSequence(true, false, nSolves, warm);
+    double persistentTime = oscDms.solveIpoptSequence(true, true, nSolves, persistent);
+
+    std::cout << "time per solve, cold: " << 1e3 * coldTime / nSolves
+              << " ms, warm started: " << 1e3 * warmTime / nSolves
+              << " ms, warm started and persistent: " << 1e3 * persistentTime / nSolves << " ms" << std::endl;
+    std::cout << "speedup over cold solves, warm started: " << coldTime / warmTime
+              << ", warm started and persistent: " << coldTime / persistentTime << std::endl;
+
+    ASSERT_EQ(cold.xSolution_.size(), warm.xSolution_.size());
+    for (size_t i = 0; i < cold.xSolution_.size(); i++)
+    {
+        ASSERT_LT((cold.xSolution_[i] - warm.xSolution_[i]).norm(), 1e-3);
+        ASSERT_LT((cold.xSolution_[i] - persistent.xSolution_[i]).norm(), 1e-3);
+        ASSERT_LT((cold.uSolution_[i] - warm.uSolution_[i]).norm(), 1e-3);
+        ASSERT_LT((cold.uSolution_[i] - persistent.uSolution_[i]).norm(), 1e-3);
+    }
+}
+
+
+/*!
+ * Full solves with the adaptive RK5 shot integration, with and without skipping unchanged shots, find the solution
+ * of the fixed step RK4 integration
+ */
+TEST(DmsTest, OscDmsRK5Test)
+{
+    OscDms oscDms;
+    oscDms.initialize();
+    DmsPolicy<2, 1> rk4 = oscDms.solveIpopt(DmsSettings::RK4, false);
+    DmsPolicy<2, 1> rk5 = oscDms.solveIpopt(DmsSettings::RK5, false);
+    DmsPolicy<2, 1> rk5Skipping = oscDms.solveIpopt(DmsSettings::RK5, true);
+
+    ASSERT_EQ(rk4.xSolution_.size(), rk5.xSolution_.size());
+    ASSERT_EQ(rk5.xSolution_.size(), rk5Skipping.xSolution_.size());
+    for (size_t i = 0; i < rk4.xSolution_.size(); i++)
+    {
+        ASSERT_LT((rk4.xSolution_[i] - rk5.xSolution_[i]).norm(), 1e-3);
+        ASSERT_LT((rk4.uSolution_[i] - rk5.uSolution_[i]).norm(), 1e-3);
+        ASSERT_LT((rk5.xSolution_[i] - rk5Skipping.xSolution_[i]).norm(), 1e-6);
+        ASSERT_LT((rk5.uSolution_[i] - rk5Skipping.uSolution_[i]).norm(), 1e-6);
+    }
+}
+#endif  // BUILD_WITH_IPOPT_SUPPORT
+
 }  // namespace example
 }  // namespace optcon
 }  // namespace ct
@@ -0,0 +1,311 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * This unit test compares the adaptive shot integration of DMS against a fine fixed step integration and checks
+ * the step size memory and the skipping of unchanged shots.
+ */
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+const size_t state_dim = 2;
+const size_t control_dim = 1;
+
+//! oscillator which counts the evaluations of its dynamics
+class CountingOscillator : public ct::core::SecondOrderSystem
+{
+public:
+    CountingOscillator(double w_n, double zeta) : ct::core::SecondOrderSystem(w_n, zeta), nEvaluations_(0) {}
+    CountingOscillator(const CountingOscillator& other)
+        : ct::core::SecondOrderSystem(other), nEvaluations_(other.nEvaluations_)
+    {
+    }
+
+    CountingOscillator* clone() const override { return new CountingOscillator(*this); }
+    void computeControlledDynamics(const ct::core::StateVector<state_dim>& state,
+        const double& t,
+        const ct::core::ControlVector<control_dim>& control,
+        ct::core::StateVector<state_dim>& derivative) override
+    {
+        nEvaluations_++;
+        ct::core::SecondOrderSystem::computeControlledDynamics(state, t, control, derivative);
+    }
+
+    size_t nEvaluations_;
+};
+
+class ShotFixture
+{
+public:
+    typedef ShotContainer<state_dim, control_dim> Shot_t;
+
+    ShotFixture(const DmsSettings& settings) : settings_(settings)
+    {
+        timeGrid_ = std::shared_ptr<tpl::TimeGrid<double>>(new tpl::TimeGrid<double>(settings_.N_, settings_.T_));
+        if (settings_.splineType_ == DmsSettings::PIECEWISE_LINEAR)
+            spliner_ = std::shared_ptr<SplinerBase<ct::core::ControlVector<control_dim>>>(
+                new LinearSpliner<ct::core::ControlVector<control_dim>>(timeGrid_));
+        else
+            spliner_ = std::shared_ptr<SplinerBase<ct::core::ControlVector<control_dim>>>(
+                new ZeroOrderHoldSpliner<ct::core::ControlVector<control_dim>>(timeGrid_));
+
+        w_ = std::shared_ptr<OptVectorDms<state_dim, control_dim>>(
+            new OptVectorDms<state_dim, control_dim>((settings_.N_ + 1) * (state_dim + control_dim), settings_));
+
+        Eigen::Matrix2d Q;
+        Q << 1.0, 0.2, 0.2, 2.0;
+        Eigen::Matrix<double, 1, 1> R;
+        R << 0.5;
+        ct::core::StateVector<state_dim> xRef;
+        xRef << 1.0, -0.5;
+        ct::core::ControlVector<control_dim> uRef;
+        uRef << 0.3;
+        costFunction_ = std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>>(
+            new CostFunctionQuadraticSimple<state_dim, control_dim>(Q, R, xRef, uRef, xRef, Q));
+
+        for (size_t i = 0; i < settings_.N_; i++)
+        {
+            std::shared_ptr<ControllerDms<state_dim, control_dim>> controller(
+                new ControllerDms<state_dim, control_dim>(spliner_, i));
+            systems_.push_back(std::shared_ptr<CountingOscillator>(new CountingOscillator(2.0, 0.1)));
+            systems_.back()->setController(controller);
+            linearSystems_.push_back(std::shared_ptr<ct::core::LinearSystem<state_dim, control_dim>>(
+                new ct::core::SystemLinearizer<state_dim, control_dim>(systems_.back())));
+            linearSystems_.back()->setController(controller);
+
+            size_t nSteps = (timeGrid_->getShotEndTime(i) - timeGrid_->getShotStartTime(i)) / settings_.dt_sim_ + 0.5;
+            shots_.push_back(std::shared_ptr<Shot_t>(new Shot_t(systems_.back(), linearSystems_.back(),
+                costFunction_, w_, spliner_, timeGrid_, i, settings_, nSteps)));
+        }
+    }
+
+    //! sets the optimization vector and updates the control spline like DmsProblem
+    void update(const Eigen::VectorXd& x)
+    {
+        w_->setOptimizationVars(x);
+        spliner_->computeSpline(w_->getOptimizedInputs().toImplementation());
+        for (auto shot : shots_)
+            shot->reset();
+    }
+
+    DmsSettings settings_;
+    std::shared_ptr<tpl::TimeGrid<double>> timeGrid_;
+    std::shared_ptr<SplinerBase<ct::core::ControlVector<control_dim>>> spliner_;
+    std::shared_ptr<OptVectorDms<state_dim, control_dim>> w_;
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction_;
+    std::vector<std::shared_ptr<CountingOscillator>> systems_;
+    std::vector<std::shared_ptr<ct::core::LinearSystem<state_dim, control_dim>>> linearSystems_;
+    std::vector<std::shared_ptr<Shot_t>> shots_;
+};
+
+DmsSettings shotSettings(DmsSettings::IntegrationType integrationType, double dt)
+{
+    DmsSettings settings;
+    settings.N_ = 4;
+    settings.T_ = 2.0;
+    settings.splineType_ = DmsSettings::PIECEWISE_LINEAR;
+    settings.costEvaluationType_ = DmsSettings::FULL;
+    settings.integrationType_ = integrationType;
+    settings.dt_sim_ = dt;
+    settings.absErrTol_ = 1e-10;
+    settings.relErrTol_ = 1e-10;
+    return settings;
+}
+
+Eigen::VectorXd randomOptVector(const DmsSettings& settings)
+{
+    return Eigen::VectorXd::Random((settings.N_ + 1) * (state_dim + control_dim));
+}
+
+TEST(AdaptiveShotTest, CompareToFixedStep)
+{
+    ShotFixture adaptive(shotSettings(DmsSettings::RK5, 0.01));
+    ShotFixture fixed(shotSettings(DmsSettings::RK4, 0.0005));
+
+    Eigen::VectorXd x = randomOptVector(adaptive.settings_);
+    adaptive.update(x);
+    fixed.update(x);
+
+    for (size_t i = 0; i < adaptive.settings_.N_; i++)
+    {
+        auto& a = adaptive.shots_[i];
+        auto& f = fixed.shots_[i];
+
+        a->integrateCost();
+        f->integrateCost();
+        a->integrateCostSensitivities();
+        f->integrateCostSensitivities();
+
+        ASSERT_TRUE(a->getStateIntegrated().isApprox(f->getStateIntegrated(), 1e-8));
+        ASSERT_NEAR(a->getIntegrationTimeFinal(), f->getIntegrationTimeFinal(), 1e-12);
+        ASSERT_TRUE(a->getdXdSiIntegrated().isApprox(f->getdXdSiIntegrated(), 1e-8));
+        ASSERT_TRUE(a->getdXdQiIntegrated().isApprox(f->getdXdQiIntegrated(), 1e-8));
+        ASSERT_TRUE(a->getdXdQip1Integrated().isApprox(f->getdXdQip1Integrated(), 1e-8));
+
+        ASSERT_NEAR(a->getCostIntegrated(), f->getCostIntegrated(), 1e-6);
+        ASSERT_TRUE(a->getdLdSiIntegrated().isApprox(f->getdLdSiIntegrated(), 1e-5));
+        ASSERT_TRUE(a->getdLdQiIntegrated().isApprox(f->getdLdQiIntegrated(), 1e-5));
+        ASSERT_TRUE(a->getdLdQip1Integrated().isApprox(f->getdLdQip1Integrated(), 1e-5));
+
+        // the continuous extension is sampled on the dt_sim grid
+        const auto& xAdaptive = a->getXHistory();
+        const auto& tAdaptive = a->getTHistory();
+        const auto& xFixed = f->getXHistory();
+        ASSERT_EQ(xAdaptive.size(), size_t(51));
+        for (size_t k = 0; k < xAdaptive.size(); k++)
+        {
+            ASSERT_NEAR(tAdaptive[k], f->getTHistory()[20 * k], 1e-12);
+            ASSERT_TRUE(xAdaptive[k].isApprox(xFixed[20 * k], 1e-6));
+        }
+
+        // the adaptive integrator takes far less steps than the fixed step integrator
+        ASSERT_LT(a->getAdaptiveIntegrator()->getNumAcceptedSteps(), size_t(200));
+    }
+}
+
+TEST(AdaptiveShotTest, StepSizeMemory)
+{
+    DmsSettings settings = shotSettings(DmsSettings::RK5, 1e-4);
+    settings.dt_sim_ = 1e-4;
+    ShotFixture adaptive(settings);
+
+    Eigen::VectorXd x = randomOptVector(settings);
+    adaptive.update(x);
+    adaptive.shots_[0]->integrateSensitivities();
+    const auto& integrator = adaptive.shots_[0]->getAdaptiveIntegrator();
+    const size_t stepsFirst = integrator->getNumAcceptedSteps() + integrator->getNumRejectedSteps();
+    const double firstStep = integrator->getFirstStepSize();
+
+    // the next iterate starts with the first step size of the previous one
+    x += 1e-3 * Eigen::VectorXd::Random(x.size());
+    adaptive.update(x);
+    adaptive.shots_[0]->integrateSensitivities();
+    const size_t stepsSecond = integrator->getNumAcceptedSteps() + integrator->getNumRejectedSteps();
+
+    ASSERT_GT(firstStep, settings.dt_sim_);
+    ASSERT_LT(stepsSecond, stepsFirst);
+}
+
+TEST(AdaptiveShotTest, SkipUnchangedShots)
+{
+    for (int integrationType : {DmsSettings::RK4, DmsSettings::RK5})
+    {
+        DmsSettings settings = shotSettings(static_cast<DmsSettings::IntegrationType>(integrationType), 0.01);
+        ShotFixture reference(settings);
+        settings.skipUnchangedShots_ = true;
+        ShotFixture skipping(settings);
+
+        Eigen::VectorXd x = randomOptVector(settings);
+        for (size_t iteration = 0; iteration < 3; iteration++)
+        {
+            // only change the last node, which only affects the last shot
+            x.tail(state_dim + control_dim).setRandom();
+            reference.update(x);
+            skipping.update(x);
+
+            // with RK5 the reference starts from a different step size, hence the tolerance
+
+            for (size_t i = 0; i < settings.N_; i++)
+            {
+                const size_t nEvaluations = skipping.systems_[i]->nEvaluations_;
+
+                reference.shots_[i]->integrateCost();
+                skipping.shots_[i]->integrateCost();
+                reference.shots_[i]->integrateCostSensitivities();
+                skipping.shots_[i]->integrateCostSensitivities();
+
+                auto& r = reference.shots_[i];
+                auto& s = skipping.shots_[i];
+                ASSERT_TRUE(s->getStateIntegrated().isApprox(r->getStateIntegrated(), 1e-8));
+                ASSERT_TRUE(s->getdXdSiIntegrated().isApprox(r->getdXdSiIntegrated(), 1e-8));
+                ASSERT_TRUE(s->getdXdQiIntegrated().isApprox(r->getdXdQiIntegrated(), 1e-8));
+                ASSERT_TRUE(s->getdXdQip1Integrated().isApprox(r->getdXdQip1Integrated(), 1e-8));
+                ASSERT_NEAR(s->getCostIntegrated(), r->getCostIntegrated(), 1e-8);
+                ASSERT_TRUE(s->getdLdSiIntegrated().isApprox(r->getdLdSiIntegrated(), 1e-8));
+                ASSERT_TRUE(s->getdLdQiIntegrated().isApprox(r->getdLdQiIntegrated(), 1e-8));
+
+                const bool changed = (iteration == 0) || (i == settings.N_ - 1);
+                if (changed)
+                    ASSERT_GT(skipping.systems_[i]->nEvaluations_, nEvaluations);
+                else
+                    ASSERT_EQ(skipping.systems_[i]->nEvaluations_, nEvaluations);
+            }
+        }
+    }
+}
+
+TEST(AdaptiveShotTest, SkipCacheInvalidation)
+{
+    for (int integrationType : {DmsSettings::RK4, DmsSettings::RK5})
+    {
+        DmsSettings settings = shotSettings(static_cast<DmsSettings::IntegrationType>(integrationType), 0.01);
+        settings.skipUnchangedShots_ = true;
+        ShotFixture skipping(settings);
+
+        Eigen::VectorXd x = randomOptVector(settings);
+        skipping.update(x);
+        for (auto shot : skipping.shots_)
+            shot->integrateCostSensitivities();
+
+        // an invalidated shot is integrated again although its inputs did not change
+        std::vector<size_t> nEvaluations;
+        for (auto system : skipping.systems_)
+            nEvaluations.push_back(system->nEvaluations_);
+
+        skipping.shots_[1]->invalidate();
+        skipping.update(x);
+        for (size_t i = 0; i < settings.N_; i++)
+        {
+            skipping.shots_[i]->integrateCostSensitivities();
+            if (i == 1)
+                ASSERT_GT(skipping.systems_[i]->nEvaluations_, nEvaluations[i]);
+            else
+                ASSERT_EQ(skipping.systems_[i]->nEvaluations_, nEvaluations[i]);
+        }
+
+        // a change of the time grid invalidates all shots, they are integrated over the new intervals
+        nEvaluations.clear();
+        for (auto system : skipping.systems_)
+            nEvaluations.push_back(system->nEvaluations_);
+
+        settings.T_ *= 1.5;
+        ShotFixture fresh(settings);
+        fresh.update(x);
+
+        skipping.timeGrid_->changeTimeHorizon(settings.T_);
+        skipping.update(x);
+        for (size_t i = 0; i < settings.N_; i++)
+        {
+            auto& s = skipping.shots_[i];
+            auto& f = fresh.shots_[i];
+            s->integrateCostSensitivities();
+            f->integrateCostSensitivities();
+            ASSERT_GT(skipping.systems_[i]->nEvaluations_, nEvaluations[i]);
+
+            ASSERT_NEAR(s->getIntegrationTimeFinal(), fresh.timeGrid_->getShotEndTime(i), 1e-12);
+            ASSERT_EQ(s->getXHistory().size(), f->getXHistory().size());
+            ASSERT_TRUE(s->getStateIntegrated().isApprox(f->getStateIntegrated(), 1e-8));
+            ASSERT_TRUE(s->getdXdSiIntegrated().isApprox(f->getdXdSiIntegrated(), 1e-8));
+            ASSERT_TRUE(s->getdXdQiIntegrated().isApprox(f->getdXdQiIntegrated(), 1e-8));
+            ASSERT_NEAR(s->getCostIntegrated(), f->getCostIntegrated(), 1e-8);
+        }
+    }
+}
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,159 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * This unit test checks the shot scheduler of DMS and compares its timing to OpenMP loops for shots of very different
+ * integration effort.
+ */
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+//! busy work which mimics the integration of a shot with the given number of steps
+double integrateDummyShot(size_t nSteps)
+{
+    double x = 1.0;
+    for (size_t i = 0; i < nSteps; i++)
+        x = x + 1e-3 * std::sin(x);
+    return x;
+}
+
+//! every 10th shot is 20 times more expensive, e.g. due to a stiff phase with an adaptive integrator
+size_t dummyShotSteps(size_t shotNr) { return (shotNr % 10 == 3) ? 100000 : 5000; }
+
+TEST(ShotSchedulerTest, AllShotsProcessed)
+{
+    DmsSettings settings;
+    settings.nThreads_ = 4;
+    ShotScheduler scheduler(settings);
+    ShotScheduler::Workload workload;
+
+    const size_t nShots = 50;
+    for (size_t iteration = 0; iteration < 3; iteration++)
+    {
+        std::vector<int> counts(nShots, 0);
+        std::vector<double> results(nShots, 0.0);
+        const std::vector<double> previousDurations = workload.durations;
+        scheduler.run(nShots, workload, [&](size_t shotNr) {
+            counts[shotNr]++;
+            results[shotNr] = integrateDummyShot(dummyShotSteps(shotNr));
+            return true;
+        });
+
+        for (size_t i = 0; i < nShots; i++)
+        {
+            ASSERT_EQ(counts[i], 1);
+            ASSERT_EQ(results[i], integrateDummyShot(dummyShotSteps(i)));
+            ASSERT_GT(workload.durations[i], 0.0);
+        }
+
+        // after the first call, the shots are handed out longest first
+        if (iteration > 0)
+        {
+            for (size_t i = 1; i < nShots; i++)
+                ASSERT_GE(previousDurations[workload.order[i - 1]], previousDurations[workload.order[i]]);
+        }
+    }
+}
+
+TEST(ShotSchedulerTest, CachedShotsKeepDuration)
+{
+    DmsSettings settings;
+    settings.nThreads_ = 2;
+    ShotScheduler scheduler(settings);
+    ShotScheduler::Workload workload;
+
+    const size_t nShots = 20;
+    scheduler.run(nShots, workload, [](size_t shotNr) {
+        integrateDummyShot(dummyShotSteps(shotNr));
+        return true;
+    });
+    const std::vector<double> durations = workload.durations;
+
+    // the odd shots are cached, their durations of the computing call are kept
+    scheduler.run(nShots, workload, [](size_t shotNr) {
+        if (shotNr % 2)
+            return false;
+        integrateDummyShot(dummyShotSteps(shotNr));
+        return true;
+    });
+    for (size_t i = 1; i < nShots; i += 2)
+        ASSERT_EQ(workload.durations[i], durations[i]);
+}
+
+TEST(ShotSchedulerTest, ExceptionIsForwarded)
+{
+    DmsSettings settings;
+    settings.nThreads_ = 2;
+    ShotScheduler scheduler(settings);
+    ShotScheduler::Workload workload;
+
+    ASSERT_THROW(scheduler.run(10, workload,
+                     [](size_t shotNr) {
+                         if (shotNr == 7)
+                             throw std::runtime_error("integration failed");
+                         return true;
+                     }),
+        std::runtime_error);
+}
+
+TEST(ShotSchedulerTest, CompareToOpenMP)
+{
+    const size_t nIterations = 3;
+
+    for (size_t nThreads : {2, 4})
+    {
+        DmsSettings settings;
+        settings.nThreads_ = nThreads;
+        ShotScheduler scheduler(settings);
+
+        for (size_t nShots : {20, 50, 100, 200})
+        {
+            std::vector<double> results(nShots, 0.0);
+            ShotScheduler::Workload workload;
+
+            auto start = std::chrono::steady_clock::now();
+            for (size_t iteration = 0; iteration < nIterations; iteration++)
+            {
+#pragma omp parallel for num_threads(settings.nThreads_)
+                for (size_t shotNr = 0; shotNr < nShots; shotNr++)
+                    results[shotNr] = integrateDummyShot(dummyShotSteps(shotNr));
+            }
+            const double durationOmp =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            start = std::chrono::steady_clock::now();
+            for (size_t iteration = 0; iteration < nIterations; iteration++)
+            {
+                scheduler.run(nShots, workload,
+                    [&](size_t shotNr) {
+                        results[shotNr] = integrateDummyShot(dummyShotSteps(shotNr));
+                        return true;
+                    });
+            }
+            const double durationPool =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::cout << "threads: " << nThreads << ", shots: " << nShots
+                      << ", OpenMP: " << 1e3 * durationOmp / nIterations
+                      << " ms, thread pool: " << 1e3 * durationPool / nIterations << " ms" << std::endl;
+        }
+    }
+}
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,156 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+using namespace ct::optcon;
+
+const size_t state_dim = 4;
+const size_t control_dim = 1;
+const size_t output_dim = 2;
+
+//! a discrete-time linear system model with a settable system matrix
+class LinearSystemModel : public SystemModelBase<state_dim, control_dim>
+{
+public:
+    LinearSystemModel(const state_matrix_t& A) : A_(A) {}
+    state_vector_t computeDynamics(const state_vector_t& state,
+        const control_vector_t& control,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return A_ * state + state_vector_t::Ones() * control(0);
+    }
+
+    state_matrix_t computeDerivativeState(const state_vector_t& state,
+        const control_vector_t& control,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return A_;
+    }
+
+    state_matrix_t computeDerivativeNoise(const state_vector_t& state,
+        const control_vector_t& control,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return state_matrix_t::Identity();
+    }
+
+    state_matrix_t A_;
+};
+
+typedef SteadyStateKalmanFilter<state_dim, control_dim, output_dim> Filter;
+
+class SteadyStateKalmanFilterTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        StateMatrix<state_dim> A = StateMatrix<state_dim>::Random();
+        A /= 1.05 * A.eigenvalues().cwiseAbs().maxCoeff();
+        model_ = std::make_shared<LinearSystemModel>(A);
+        measurement_ = std::make_shared<LTIMeasurementModel<output_dim, state_dim>>(
+            OutputStateMatrix<output_dim, state_dim>::Random());
+        Q_.setIdentity();
+        R_.setIdentity();
+    }
+
+    //! runs predict and update for nSteps with random measurements, returns the final estimate
+    StateVector<state_dim> run(Filter& filter, size_t nSteps)
+    {
+        std::srand(0);
+        for (size_t i = 0; i < nSteps; i++)
+        {
+            filter.predict(ControlVector<control_dim>::Random(), 0.01, 0.01 * i);
+            filter.update(OutputVector<output_dim>::Random(), 0.01, 0.01 * i);
+        }
+        return filter.getEstimate();
+    }
+
+    std::shared_ptr<LinearSystemModel> model_;
+    std::shared_ptr<LTIMeasurementModel<output_dim, state_dim>> measurement_;
+    StateMatrix<state_dim> Q_;
+    OutputMatrix<output_dim> R_;
+};
+
+/*!
+ * With gain caching, the gain is reused as long as A and dh/dx stay within the tolerance of the cached
+ * linearization and gives the same estimates as recomputing it in every step
+ */
+TEST_F(SteadyStateKalmanFilterTest, GainCaching)
+{
+    const size_t nSteps = 20;
+    const double cacheTolerance = 1e-3;
+
+    Filter uncached(model_, measurement_, Q_, R_);
+    Filter cached(model_, measurement_, Q_, R_);
+    cached.setGainCaching(true, cacheTolerance);
+
+    const StateVector<state_dim> xUncached = run(uncached, nSteps);
+    const StateVector<state_dim> xCached = run(cached, nSteps);
+    ASSERT_EQ(uncached.getNumGainUpdates(), nSteps);
+    ASSERT_EQ(cached.getNumGainUpdates(), 1u);
+    ASSERT_LT((xCached - xUncached).cwiseAbs().maxCoeff(), 1e-12);
+
+    // a change within the tolerance reuses the gain
+    model_->A_(0, 0) += 0.5 * cacheTolerance;
+    run(cached, nSteps);
+    ASSERT_EQ(cached.getNumGainUpdates(), 1u);
+
+    // a change beyond the tolerance recomputes it once
+    model_->A_(0, 0) += 2.0 * cacheTolerance;
+    run(cached, nSteps);
+    ASSERT_EQ(cached.getNumGainUpdates(), 2u);
+
+    // the same through the settings
+    SteadyStateKalmanFilterSettings<state_dim> settings;
+    settings.x0.setZero();
+    settings.cacheGain = true;
+    settings.gainCacheTolerance = cacheTolerance;
+    Filter fromSettings(model_, measurement_, Q_, R_, settings);
+    run(fromSettings, nSteps);
+    ASSERT_EQ(fromSettings.getNumGainUpdates(), 1u);
+
+    // changing the caching settings invalidates the gain
+    fromSettings.setGainCaching(true, cacheTolerance);
+    run(fromSettings, 1);
+    ASSERT_EQ(fromSettings.getNumGainUpdates(), 2u);
+}
+
+/*!
+ * The warm-started fixed-point iteration gives the same estimates as the doubling algorithm from scratch
+ */
+TEST_F(SteadyStateKalmanFilterTest, WarmStart)
+{
+    const size_t nSteps = 20;
+
+    Filter warmStarted(model_, measurement_, Q_, R_, StateVector<state_dim>::Zero(), 1000, 1e-10);
+    Filter doubling(model_, measurement_, Q_, R_, StateVector<state_dim>::Zero(), 1000, 1e-10);
+    doubling.setMaxWarmStartIterations(0);
+
+    // slowly varying linearization
+    std::srand(0);
+    for (size_t i = 0; i < nSteps; i++)
+    {
+        model_->A_(1, 2) += 1e-4;
+        const ControlVector<control_dim> u = ControlVector<control_dim>::Random();
+        const OutputVector<output_dim> y = OutputVector<output_dim>::Random();
+        warmStarted.predict(u, 0.01, 0.01 * i);
+        doubling.predict(u, 0.01, 0.01 * i);
+        warmStarted.update(y, 0.01, 0.01 * i);
+        doubling.update(y, 0.01, 0.01 * i);
+        ASSERT_LT((warmStarted.getEstimate() - doubling.getEstimate()).cwiseAbs().maxCoeff(), 1e-6);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,231 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <chrono>
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+#include "../testSystems/LinearOscillator.h"
+
+using namespace ct::core;
+using namespace ct::optcon;
+using namespace ct::optcon::example;
+
+
+TEST(BinaryLoggerTest, SPSCQueueTest)
+{
+    SPSCQueue<int> queue(2);
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(queue.consumerSlot(), nullptr);
+
+    for (int i = 0; i < 2; i++)
+    {
+        int* slot = queue.producerSlot();
+        ASSERT_NE(slot, nullptr);
+        *slot = i;
+        queue.push();
+    }
+    ASSERT_EQ(queue.producerSlot(), nullptr);  // full
+
+    for (int i = 0; i < 2; i++)
+    {
+        int* slot = queue.consumerSlot();
+        ASSERT_NE(slot, nullptr);
+        ASSERT_EQ(*slot, i);
+        queue.pop();
+    }
+    ASSERT_TRUE(queue.empty());
+}
+
+
+TEST(BinaryLoggerTest, WriteReadTest)
+{
+    const std::string fileName = "BinaryLoggerTest.ctlog";
+    const size_t nRecords = 50;
+
+    StateVectorArray<2> x(11);
+    FeedbackArray<2, 1> L(10);
+    Eigen::Matrix<float, 3, 4> m = Eigen::Matrix<float, 3, 4>::Random();
+
+    {
+        BinaryLogger logger(fileName, 2 * nRecords);
+        for (size_t i = 0; i < nRecords; i++)
+        {
+            for (size_t k = 0; k < x.size(); k++)
+                x[k] = StateVector<2>::Constant(i + 0.1 * k);
+            for (size_t k = 0; k < L.size(); k++)
+                L[k] = FeedbackMatrix<2, 1>::Constant(-(i + 0.1 * k));
+
+            BinaryLogRecord* r = logger.beginRecord(binary_log::USER + (i % 2));
+            ASSERT_NE(r, nullptr);
+            r->add("i", static_cast<int64_t>(i));
+            r->add("value", 0.5 * i);
+            r->add("x", x);
+            r->add("L", L);
+            r->add("m", m);
+            logger.commitRecord();
+        }
+        logger.flush();
+
+        ASSERT_EQ(logger.getNumWritten(), nRecords);
+        ASSERT_EQ(logger.getNumDropped(), 0u);
+    }
+
+    BinaryLogReader reader(fileName);
+    ASSERT_EQ(reader.size(), nRecords);
+    ASSERT_EQ(reader.recordsOfType(binary_log::USER).size(), nRecords / 2);
+
+    for (size_t i = 0; i < nRecords; i++)
+    {
+        const BinaryLogRecordView& r = reader[i];
+        ASSERT_EQ(r.type(), binary_log::USER + (i % 2));
+        ASSERT_EQ(r.sequence(), i);
+        ASSERT_EQ(r.nFields(), 5u);
+        ASSERT_EQ(r.field("i").scalar(), i);
+        ASSERT_EQ(r.field("value").scalar(), 0.5 * i);
+        ASSERT_FALSE(r.hasField("y"));
+
+        BinaryLogField xField = r.field("x");
+        ASSERT_EQ(xField.count(), x.size());
+        ASSERT_EQ(xField.rows(), 2u);
+        ASSERT_EQ(xField.cols(), 1u);
+        for (size_t k = 0; k < x.size(); k++)
+            ASSERT_TRUE(xField.matrix(k).isApprox(StateVector<2>::Constant(i + 0.1 * k)));
+
+        BinaryLogField LField = r.field("L");
+        ASSERT_EQ(LField.rows(), 1u);
+        ASSERT_EQ(LField.cols(), 2u);
+        ASSERT_TRUE(LField.matrix(L.size() - 1).isApprox(FeedbackMatrix<2, 1>::Constant(-(i + 0.9))));
+
+        ASSERT_TRUE(r.field("m").matrix<float>() == m);
+        ASSERT_ANY_THROW(r.field("m").matrix<double>());
+    }
+}
+
+
+TEST(BinaryLoggerTest, ShutdownTest)
+{
+    const std::string fileName = "BinaryLoggerShutdownTest.ctlog";
+
+    // records committed right before shutdown must still be written
+    for (size_t i = 0; i < 100; i++)
+    {
+        BinaryLogger logger(fileName);
+        BinaryLogRecord* r = logger.beginRecord(binary_log::USER);
+        ASSERT_NE(r, nullptr);
+        r->add("i", static_cast<int64_t>(i));
+        logger.commitRecord();
+        logger.close();
+
+        ASSERT_EQ(logger.getNumWritten(), 1u);
+
+        BinaryLogReader reader(fileName);
+        ASSERT_EQ(reader.size(), 1u);
+        ASSERT_EQ(reader[0].field("i").scalar(), i);
+    }
+
+    // same through the destructor
+    for (size_t i = 0; i < 100; i++)
+    {
+        {
+            BinaryLogger logger(fileName);
+            BinaryLogRecord* r = logger.beginRecord(binary_log::USER);
+            ASSERT_NE(r, nullptr);
+            r->add("i", static_cast<int64_t>(i));
+            logger.commitRecord();
+        }
+
+        BinaryLogReader reader(fileName);
+        ASSERT_EQ(reader.size(), 1u);
+        ASSERT_EQ(reader[0].field("i").scalar(), i);
+    }
+}
+
+
+TEST(BinaryLoggerTest, NLOCLogTest)
+{
+    typedef NLOptConSolver<state_dim, control_dim> NLOptConSolver;
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+    StateVector<state_dim> initState;
+    initState << 0.0, 1.0;
+
+    NLOptConSettings settings;
+    settings.dt = 0.01;
+    settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    settings.printSummary = false;
+    settings.nThreads = 1;
+    settings.loggingPrefix = "BinaryLoggerTestNLOC";
+    settings.logToBinary = true;
+
+    std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new LinearOscillator());
+    std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear());
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+        ct::optcon::example::tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+    ct::core::Time tf = 1.0;
+    size_t nSteps = settings.computeK(tf);
+    StateVectorArray<state_dim> x0(nSteps + 1, initState);
+    ControlVectorArray<control_dim> u0(nSteps, ControlVector<control_dim>::Zero());
+    FeedbackArray<state_dim, control_dim> u0_fb(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero());
+
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+        tf, x0[0], nonlinearSystem, costFunction, analyticLinearSystem);
+
+    const size_t nIterations = 3;
+    std::string logFile;
+    {
+        NLOptConSolver solver(optConProblem, settings);
+        solver.setInitialGuess(NLOptConSolver::Policy_t(x0, u0, u0_fb, settings.dt));
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < nIterations; i++)
+            solver.runIteration();
+        auto end = std::chrono::steady_clock::now();
+        std::cout << nIterations << " iterations with binary logging took "
+                  << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+        solver.logSummaryToBinary();
+        solver.getBackend()->getBinaryLogger()->flush();
+        ASSERT_EQ(solver.getBackend()->getBinaryLogger()->getNumDropped(), 0u);
+
+        BinaryLogReader reader(settings.loggingPrefix + "Log.ctlog");
+        ASSERT_EQ(reader.recordsOfType(binary_log::INIT).size(), 1u);
+        ASSERT_EQ(reader.recordsOfType(binary_log::ITERATION).size(), nIterations);
+        ASSERT_EQ(reader.recordsOfType(binary_log::LQ_PROBLEM).size(), nIterations);
+        ASSERT_EQ(reader.recordsOfType(binary_log::SUMMARY).size(), 1u);
+
+        // the last iteration record holds the solution
+        const BinaryLogRecordView& last = reader[reader.recordsOfType(binary_log::ITERATION).back()];
+        ASSERT_EQ(last.field("iteration").scalar(), nIterations - 1);
+        const StateVectorArray<state_dim>& x = solver.getSolution().x_ref();
+        BinaryLogField xLogged = last.field("x");
+        ASSERT_EQ(xLogged.count(), x.size());
+        for (size_t k = 0; k < x.size(); k++)
+            ASSERT_TRUE(xLogged.matrix(k).isApprox(x[k]));
+        ASSERT_NEAR(last.field("cost").scalar(), solver.getBackend()->getSummary().totalCosts.back(), 1e-12);
+
+        const BinaryLogRecordView& lq = reader[reader.recordsOfType(binary_log::LQ_PROBLEM).back()];
+        ASSERT_EQ(lq.field("A").count(), nSteps);
+        ASSERT_EQ(lq.field("Q").count(), nSteps + 1);
+
+        const BinaryLogRecordView& summary = reader[reader.recordsOfType(binary_log::SUMMARY).back()];
+        ASSERT_EQ(summary.field("totalCosts").rows(), nIterations);
+
+        // disabling binary logging in the settings releases the logger
+        settings.logToBinary = false;
+        solver.configure(settings);
+        ASSERT_FALSE(solver.getBackend()->getBinaryLogger());
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
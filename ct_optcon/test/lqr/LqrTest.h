@@ -25,6 +25,19 @@ namespace ct {
 namespace optcon {
 namespace example {
 
+//! max. absolute residual of the discrete-time algebraic Riccati equation
+template <typename STATE_MATRIX, typename CONTROL_MATRIX, typename GAIN_MATRIX>
+double dareResidual(const STATE_MATRIX& Q,
+    const CONTROL_MATRIX& R,
+    const STATE_MATRIX& A,
+    const GAIN_MATRIX& B,
+    const STATE_MATRIX& P)
+{
+    STATE_MATRIX res = Q + A.transpose() * P * A -
+                       A.transpose() * P * B * (R + B.transpose() * P * B).inverse() * B.transpose() * P * A - P;
+    return res.array().abs().maxCoeff();
+}
+
 TEST(LQRTest, DARETest)
 {
     const size_t stateDim = 2;
@@ -46,6 +59,56 @@ TEST(LQRTest, DARETest)
     Eigen::Matrix<double, stateDim, stateDim> P_test;
     P_test << 6.932484752255643, 4.332273119899151, 4.332273119899151, 4.55195134961773;
     ASSERT_LT((P - P_test).array().abs().maxCoeff(), 1e-12);
+
+    // the fixed-point iteration regularizes the control Hessian, hence the solutions differ slightly
+    Eigen::Matrix<double, controlDim, stateDim> K_sda;
+    Eigen::Matrix<double, stateDim, stateDim> P_sda = dare.solveStructuredDoubling(Q, R, A, B, K_sda, true);
+    ASSERT_LT((P_sda - P_test).array().abs().maxCoeff(), 1e-4);
+    ASSERT_LT((K_sda - K).array().abs().maxCoeff(), 1e-4);
+    ASSERT_LT(dareResidual(Q, R, A, B, P_sda), 1e-10);
+}
+
+
+template <size_t STATE_DIM, size_t OUTPUT_DIM>
+void timeSteadyStateKalmanDARE(size_t nTests)
+{
+    typedef Eigen::Matrix<double, STATE_DIM, STATE_DIM> state_matrix_t;
+
+    // random, marginally stable estimator problem: A^T and C^T in place of A and B
+    state_matrix_t A = state_matrix_t::Random();
+    A /= 1.05 * A.eigenvalues().cwiseAbs().maxCoeff();
+    Eigen::Matrix<double, OUTPUT_DIM, STATE_DIM> C = Eigen::Matrix<double, OUTPUT_DIM, STATE_DIM>::Random();
+    state_matrix_t Q = state_matrix_t::Identity();
+    Eigen::Matrix<double, OUTPUT_DIM, OUTPUT_DIM> R = Eigen::Matrix<double, OUTPUT_DIM, OUTPUT_DIM>::Identity();
+
+    ct::optcon::DARE<STATE_DIM, OUTPUT_DIM> dare;
+    Eigen::Matrix<double, OUTPUT_DIM, STATE_DIM> K_iter, K_sda;
+    state_matrix_t P_iter, P_sda;
+
+    auto start1 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nTests; i++)
+        P_iter = dare.computeSteadyStateRiccatiMatrix(Q, R, A.transpose(), C.transpose(), K_iter, false, 1e-9, 10000);
+    auto end1 = std::chrono::steady_clock::now();
+
+    auto start2 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nTests; i++)
+        P_sda = dare.solveStructuredDoubling(Q, R, A.transpose(), C.transpose(), K_sda);
+    auto end2 = std::chrono::steady_clock::now();
+
+    std::cout << "DARE with state dimension " << STATE_DIM << ": fixed-point iteration "
+              << std::chrono::duration<double, std::micro>(end1 - start1).count() / nTests << " us, doubling "
+              << std::chrono::duration<double, std::micro>(end2 - start2).count() / nTests << " us" << std::endl;
+
+    ASSERT_LT((P_iter - P_sda).array().abs().maxCoeff() / P_sda.array().abs().maxCoeff(), 1e-4);
+    ASSERT_LT((K_iter - K_sda).array().abs().maxCoeff(), 1e-4);
+    Eigen::Matrix<double, STATE_DIM, OUTPUT_DIM> Ct = C.transpose();
+    ASSERT_LT(dareResidual(Q, R, state_matrix_t(A.transpose()), Ct, P_sda) / P_sda.array().abs().maxCoeff(), 1e-9);
+}
+
+TEST(LQRTest, DAREDoublingTest)
+{
+    timeSteadyStateKalmanDARE<12, 6>(100);
+    timeSteadyStateKalmanDARE<36, 12>(10);
 }
 
 
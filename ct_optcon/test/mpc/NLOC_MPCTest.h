@@ -24,6 +24,63 @@ using namespace ct::optcon;
 using std::shared_ptr;
 
 
+/**
+ * Shift a policy repeatedly with the default policy handler. The remaining data moves to the front, the time grid stays
+ * anchored at zero and the policy is extended at the back with its last element.
+ */
+TEST(MPCTestA, PolicyHandlerShiftTest)
+{
+    const size_t state_dim = 2;
+    const size_t control_dim = 1;
+    const double dt = 0.1;
+    const int K = 20;
+
+    StateVectorArray<state_dim> x_ref(K + 1);
+    ControlVectorArray<control_dim> uff(K);
+    FeedbackArray<state_dim, control_dim> fb(K);
+    for (int i = 0; i <= K; i++)
+    {
+        x_ref[i].setConstant(i);
+        if (i < K)
+        {
+            uff[i].setConstant(i);
+            fb[i].setConstant(i);
+        }
+    }
+
+    StateFeedbackController<state_dim, control_dim> policy(x_ref, uff, fb, dt);
+    StateFeedbackPolicyHandler<state_dim, control_dim, double> policyHandler(dt);
+
+    const int shift = 3;
+    for (int cycle = 1; cycle <= 8; cycle++)
+    {
+        policyHandler.designWarmStartingPolicy((shift + 0.5) * dt, K * dt, policy);
+
+        ASSERT_EQ(policy.getFeedforwardTrajectory().size(), (size_t)K);
+        ASSERT_EQ(policy.getFeedbackTrajectory().size(), (size_t)K);
+        ASSERT_NEAR(policy.getFeedforwardTrajectory().startTime(), 0.0, 1e-12);
+        for (int i = 0; i < K; i++)
+        {
+            const double expected = std::min(i + cycle * shift, K - 1);
+            ASSERT_NEAR(policy.getFeedforwardTrajectory().getTimeFromIndex(i), i * dt, 1e-12);
+            ASSERT_NEAR(policy.getFeedbackTrajectory().getTimeFromIndex(i), i * dt, 1e-12);
+            ASSERT_NEAR(policy.getReferenceStateTrajectory().getTimeFromIndex(i), i * dt, 1e-12);
+            ASSERT_EQ(policy.uff()[i](0), expected);
+            ASSERT_EQ(policy.K()[i](0, 1), expected);
+            ASSERT_EQ(policy.x_ref()[i](1), std::min(i + cycle * shift, K));
+            ASSERT_EQ(policy.getFeedforwardTrajectory().eval(i * dt + 0.5 * dt)(0), expected);
+        }
+    }
+
+    // truncation without extension shortens the policy about the effectively truncated time
+    double truncated = 0.0;
+    policyHandler.truncateSolutionFront((shift + 0.5) * dt, policy, truncated);
+    ASSERT_NEAR(truncated, shift * dt, 1e-12);
+    ASSERT_EQ(policy.uff().size(), (size_t)(K - shift));
+    ASSERT_NEAR(policy.getFeedforwardTrajectory().finalTime(), (K - shift - 1) * dt, 1e-12);
+    ASSERT_EQ(policy.uff().front()(0), K - 1);
+}
+
 /**
  * Test the MPC forward integrator
  */
@@ -352,6 +409,141 @@ TEST(MPCTestB, NLOC_MPC_DoublePrecision)
 }
 
 
+//! a pendulum-like oscillator with nonlinear restoring force
+class NonlinearOscillator : public ControlledSystem<state_dim, control_dim>
+{
+public:
+    NonlinearOscillator() : ControlledSystem<state_dim, control_dim>(SYSTEM_TYPE::SECOND_ORDER) {}
+    void computeControlledDynamics(const StateVector<state_dim>& state,
+        const Time& t,
+        const ControlVector<control_dim>& control,
+        StateVector<state_dim>& derivative) override
+    {
+        derivative(0) = state(1);
+        derivative(1) = -10.0 * std::sin(state(0)) - 0.1 * state(1) + control(0);
+    }
+
+    NonlinearOscillator* clone() const override { return new NonlinearOscillator(); };
+};
+
+/**
+ * Test the shift-and-reuse warm start of GNMS in MPC on a nonlinear system. The MPC starts from a converged solution
+ * and the initial state follows the predicted trajectory, such that the warm start matches the shifted linearization
+ * points of the previous cycle up to the tolerance. Reusing the shifted LQ approximation then changes the MPC solution
+ * at most about the order of the tolerance.
+ */
+TEST(MPCTestC, GNMS_ShiftWarmStart)
+{
+    try
+    {
+        StateVector<state_dim> x0;
+        x0 << 1.0, 0.0;
+
+        ct::core::Time timeHorizon = 3.0;
+
+        // regulate to the origin, such that the tail of the horizon stays at rest when the horizon recedes
+        StateMatrix<state_dim> Q = StateMatrix<state_dim>::Identity();
+        ControlMatrix<control_dim> R = 0.1 * ControlMatrix<control_dim>::Identity();
+        shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction(
+            new CostFunctionAnalytical<state_dim, control_dim>);
+        costFunction->addIntermediateTerm(std::make_shared<TermQuadratic<state_dim, control_dim>>(
+            Q, R, StateVector<state_dim>::Zero(), ControlVector<control_dim>::Zero()));
+        costFunction->addFinalTerm(std::make_shared<TermQuadratic<state_dim, control_dim>>(
+            10.0 * Q, R, StateVector<state_dim>::Zero(), ControlVector<control_dim>::Zero()));
+
+        shared_ptr<ControlledSystem<state_dim, control_dim>> system(new NonlinearOscillator);
+
+        ContinuousOptConProblem<state_dim, control_dim> optConProblem(system, costFunction);
+        optConProblem.setTimeHorizon(timeHorizon);
+        optConProblem.setInitialState(x0);
+
+        NLOptConSettings nloc_settings;
+        nloc_settings.dt = 0.01;
+        nloc_settings.K_sim = 1;
+        nloc_settings.K_shot = 5;
+        nloc_settings.max_iterations = 1;
+        nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+        nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+        nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+        nloc_settings.closedLoopShooting = false;
+        nloc_settings.integrator = ct::core::IntegrationType::EULER;
+        nloc_settings.lineSearchSettings.active = false;
+        nloc_settings.nThreads = 1;
+        nloc_settings.printSummary = false;
+
+        int K = nloc_settings.computeK(timeHorizon);
+
+        FeedbackArray<state_dim, control_dim> u0_fb(K, FeedbackMatrix<state_dim, control_dim>::Zero());
+        ControlVectorArray<control_dim> u0_ff(K, ControlVector<control_dim>::Zero());
+        StateVectorArray<state_dim> x_ref(K + 1, x0);
+        ct::core::StateFeedbackController<state_dim, control_dim> initController(
+            x_ref, u0_ff, u0_fb, nloc_settings.dt);
+
+        // start MPC from a converged solution, such that the linearization points of consecutive cycles match
+        NLOptConSettings nloc_settings_init = nloc_settings;
+        nloc_settings_init.max_iterations = 50;
+        NLOptConSolver<state_dim, control_dim> initSolver(optConProblem, nloc_settings_init);
+        initSolver.setInitialGuess(initController);
+        initSolver.solve();
+        ct::core::StateFeedbackController<state_dim, control_dim> perfectInitController = initSolver.getSolution();
+
+        ct::optcon::mpc_settings settings;
+        settings.stateForwardIntegration_ = true;
+        settings.stateForwardIntegratorType_ = nloc_settings.integrator;
+        settings.stateForwardIntegration_dt_ = nloc_settings.dt;
+        settings.postTruncation_ = false;
+        settings.measureDelay_ = false;
+        settings.fixedDelayUs_ = 100000;  // corresponds to two shots
+        settings.delayMeasurementMultiplier_ = 1.0;
+        settings.mpc_mode = ct::optcon::MPC_MODE::CONSTANT_RECEDING_HORIZON;
+        settings.coldStart_ = false;
+        settings.additionalDelayUs_ = 0;
+        settings.useExternalTiming_ = true;
+
+        // stages are only reused if the warm start deviates less than the tolerance from the linearization points
+        const double tolerance = 1e-2;
+        NLOptConSettings nloc_settings_shift = nloc_settings;
+        nloc_settings_shift.mpcShiftWarmStart = true;
+        nloc_settings_shift.mpcShiftWarmStartTolerance = tolerance;
+
+        MPC<NLOptConSolver<state_dim, control_dim>> mpcCold(optConProblem, nloc_settings, settings);
+        MPC<NLOptConSolver<state_dim, control_dim>> mpcShift(optConProblem, nloc_settings_shift, settings);
+        mpcCold.setInitialGuess(perfectInitController);
+        mpcShift.setInitialGuess(perfectInitController);
+
+        size_t nReused = 0;
+        for (int i = 0; i < 20; i++)
+        {
+            double t = i * 1e-6 * settings.fixedDelayUs_;
+
+            mpcCold.prepareIteration(t);
+            mpcShift.prepareIteration(t);
+            nReused += mpcShift.getSolver().getBackend()->getNumReusedStages();
+
+            ct::core::StateFeedbackController<state_dim, control_dim> policyCold, policyShift;
+            ct::core::Time ts;
+            mpcCold.finishIteration(x0, t, policyCold, ts);
+            mpcShift.finishIteration(x0, t, policyShift, ts);
+
+            ASSERT_EQ(policyCold.uff().size(), policyShift.uff().size());
+            for (size_t k = 0; k < policyCold.uff().size(); k++)
+                ASSERT_NEAR(policyCold.uff()[k](0), policyShift.uff()[k](0), 0.1 * tolerance);
+
+            x0 = policyCold.getReferenceStateTrajectory().eval(1e-6 * settings.fixedDelayUs_);
+        }
+
+        // after the first cycle, shifted stages are reused
+        ASSERT_GT(nReused, 0u);
+        std::cout << "reused " << nReused << " stages in total" << std::endl;
+
+    } catch (std::exception& e)
+    {
+        std::cout << "caught exception: " << e.what() << std::endl;
+        FAIL();
+    }
+}
+
+
 }  // namespace example
 }  // namespace optcon
 }  // namespace ct
@@ -0,0 +1,236 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Compares the compile-time horizon solvers FixedHorizonRiccatiSolver and FixedHorizonILQR against their dynamic
+ * counterparts GNRiccatiSolver and NLOptConSolver, and prints the solve times of both paths.
+ */
+
+#include <chrono>
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+using namespace ct::optcon;
+
+const size_t state_dim = 4;
+const size_t control_dim = 1;
+const size_t N = 50;
+const double dt = 0.02;
+
+
+/*!
+ * A cart-pole discretized with forward Euler, the control is the cart acceleration.
+ * x = [cart position, pole angle, cart velocity, pole angular velocity]
+ */
+class DiscreteCartPole final : public DiscreteControlledSystem<state_dim, control_dim>
+{
+public:
+    static constexpr double g = 9.81;
+    static constexpr double l = 0.5;
+
+    DiscreteCartPole* clone() const override { return new DiscreteCartPole(*this); }
+    void propagateControlledDynamics(const StateVector<state_dim>& x,
+        const int n,
+        const ControlVector<control_dim>& u,
+        StateVector<state_dim>& x_next) override
+    {
+        x_next(0) = x(0) + dt * x(2);
+        x_next(1) = x(1) + dt * x(3);
+        x_next(2) = x(2) + dt * u(0);
+        x_next(3) = x(3) + dt * (g * std::sin(x(1)) - u(0) * std::cos(x(1))) / l;
+    }
+};
+
+//! the analytic linearization of DiscreteCartPole
+class DiscreteCartPoleLinear final : public DiscreteLinearSystem<state_dim, control_dim>
+{
+public:
+    DiscreteCartPoleLinear* clone() const override { return new DiscreteCartPoleLinear(*this); }
+    void getAandB(const StateVector<state_dim>& x,
+        const ControlVector<control_dim>& u,
+        const StateVector<state_dim>& x_next,
+        const int n,
+        size_t subSteps,
+        StateMatrix<state_dim>& A,
+        StateControlMatrix<state_dim, control_dim>& B) override
+    {
+        const double g = DiscreteCartPole::g;
+        const double l = DiscreteCartPole::l;
+
+        A.setIdentity();
+        A(0, 2) = dt;
+        A(1, 3) = dt;
+        A(3, 1) = dt * (g * std::cos(x(1)) + u(0) * std::sin(x(1))) / l;
+
+        B.setZero();
+        B(2, 0) = dt;
+        B(3, 0) = -dt * std::cos(x(1)) / l;
+    }
+};
+
+
+NLOptConSettings createSettings()
+{
+    NLOptConSettings settings;
+    settings.dt = dt;
+    settings.epsilon = 0.0;
+    settings.nThreads = 1;
+    settings.max_iterations = 20;
+    settings.min_cost_improvement = 1e-9;
+    settings.fixedHessianCorrection = false;
+    settings.recordSmallestEigenvalue = false;
+    settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::ILQR;
+    settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    settings.closedLoopShooting = true;
+    settings.printSummary = false;
+    settings.lineSearchSettings.active = true;
+    settings.lineSearchSettings.debugPrint = false;
+    return settings;
+}
+
+CostFunctionQuadraticSimple<state_dim, control_dim> createCostFunction()
+{
+    StateMatrix<state_dim> Q = StateMatrix<state_dim>::Identity();
+    ControlMatrix<control_dim> R = 0.1 * ControlMatrix<control_dim>::Identity();
+    StateMatrix<state_dim> Q_final = 100.0 * StateMatrix<state_dim>::Identity();
+
+    return CostFunctionQuadraticSimple<state_dim, control_dim>(Q, R, StateVector<state_dim>::Zero(),
+        ControlVector<control_dim>::Zero(), StateVector<state_dim>::Zero(), Q_final);
+}
+
+
+TEST(FixedHorizonILQRTest, RiccatiSolverComparison)
+{
+    typedef FixedHorizonRiccatiSolver<state_dim, control_dim, N> FixedSolver;
+
+    DiscreteCartPoleLinear linearSystem;
+    CostFunctionQuadraticSimple<state_dim, control_dim> costFunction = createCostFunction();
+
+    StateVector<state_dim> x0;
+    x0.setRandom();
+    ControlVector<control_dim> u0;
+    u0.setRandom();
+    StateVector<state_dim> b;
+    b.setRandom();
+
+    NLOptConSettings settings = createSettings();
+
+    LQOCProblem<state_dim, control_dim> lqocProblem(N);
+    lqocProblem.setFromTimeInvariantLinearQuadraticProblem(x0, u0, linearSystem, costFunction, b, dt);
+
+    GNRiccatiSolver<state_dim, control_dim> gnRiccati(N);
+    gnRiccati.configure(settings);
+    gnRiccati.setProblem(std::make_shared<LQOCProblem<state_dim, control_dim>>(lqocProblem));
+    gnRiccati.solve();
+
+    std::unique_ptr<FixedHorizonLQOCProblem<state_dim, control_dim, N>> fixedProblem(
+        new FixedHorizonLQOCProblem<state_dim, control_dim, N>);
+    fixedProblem->fromLQOCProblem(lqocProblem);
+
+    std::unique_ptr<FixedSolver> fixedRiccati(new FixedSolver);
+    fixedRiccati->configure(settings);
+    fixedRiccati->solve(*fixedProblem);
+
+    for (size_t k = 0; k < N; k++)
+    {
+        ASSERT_LT((fixedRiccati->getSolutionState()[k] - gnRiccati.getSolutionState()[k]).norm(), 1e-8);
+        ASSERT_LT((fixedRiccati->getSolutionControl()[k] - gnRiccati.getSolutionControl()[k]).norm(), 1e-8);
+        ASSERT_LT((fixedRiccati->getSolutionFeedback()[k] - gnRiccati.getSolutionFeedback()[k]).norm(), 1e-8);
+    }
+    ASSERT_LT((fixedRiccati->getSolutionState()[N] - gnRiccati.getSolutionState()[N]).norm(), 1e-8);
+}
+
+
+TEST(FixedHorizonILQRTest, ILQRComparison)
+{
+    typedef FixedHorizonILQR<state_dim, control_dim, N, DiscreteCartPole, DiscreteCartPoleLinear,
+        CostFunctionQuadraticSimple<state_dim, control_dim>>
+        FixedILQR;
+    typedef NLOptConSolver<state_dim, control_dim, state_dim / 2, state_dim / 2, double, false> DynamicILQR;
+
+    NLOptConSettings settings = createSettings();
+
+    StateVector<state_dim> x0;
+    x0 << 0.0, 0.1, 0.0, 0.0;
+
+    // dynamic horizon path
+    std::shared_ptr<DiscreteControlledSystem<state_dim, control_dim>> system(new DiscreteCartPole);
+    std::shared_ptr<DiscreteLinearSystem<state_dim, control_dim>> linearSystem(new DiscreteCartPoleLinear);
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction(
+        new CostFunctionQuadraticSimple<state_dim, control_dim>(createCostFunction()));
+
+    DiscreteOptConProblem<state_dim, control_dim> optConProblem(N, x0, system, costFunction, linearSystem);
+    DynamicILQR dynamicSolver(optConProblem, settings);
+
+    StateVectorArray<state_dim> x_init(N + 1, x0);
+    ControlVectorArray<control_dim> u_init(N, ControlVector<control_dim>::Zero());
+    FeedbackArray<state_dim, control_dim> L_init(N, FeedbackMatrix<state_dim, control_dim>::Zero());
+    StateFeedbackController<state_dim, control_dim> initialGuess(x_init, u_init, L_init, dt);
+
+    // fixed horizon path
+    std::unique_ptr<FixedILQR> fixedSolver(
+        new FixedILQR(DiscreteCartPole(), DiscreteCartPoleLinear(), createCostFunction(), settings));
+
+    typename FixedILQR::StateVectorArray x_init_fixed;
+    typename FixedILQR::ControlVectorArray u_init_fixed;
+    typename FixedILQR::FeedbackArray L_init_fixed;
+    x_init_fixed.fill(x0);
+    u_init_fixed.fill(ControlVector<control_dim>::Zero());
+    L_init_fixed.fill(FeedbackMatrix<state_dim, control_dim>::Zero());
+
+    // the iterates are identical, compare them after every iteration
+    dynamicSolver.setInitialGuess(initialGuess);
+    fixedSolver->setInitialGuess(x_init_fixed, u_init_fixed, L_init_fixed);
+    for (int i = 0; i < settings.max_iterations; i++)
+    {
+        bool dynamicContinues = dynamicSolver.runIteration();
+        bool fixedContinues = fixedSolver->runIteration();
+
+        ASSERT_NEAR(dynamicSolver.getCost(), fixedSolver->getCost(), 1e-8 * dynamicSolver.getCost());
+
+        const StateFeedbackController<state_dim, control_dim>& policy = dynamicSolver.getSolution();
+        for (size_t k = 0; k < N; k++)
+        {
+            ASSERT_LT((policy.x_ref()[k] - fixedSolver->getStateTrajectory()[k]).norm(), 1e-6);
+            ASSERT_LT((policy.uff()[k] - fixedSolver->getControlTrajectory()[k]).norm(), 1e-6);
+            ASSERT_LT((policy.K()[k] - fixedSolver->getFeedbackTrajectory()[k]).norm(), 1e-6);
+        }
+
+        ASSERT_EQ(dynamicContinues, fixedContinues);
+        if (!fixedContinues)
+            break;
+    }
+    ASSERT_LT(std::abs(fixedSolver->getStateTrajectory()[N](1)), 0.05);
+
+    // timing of full solves from the same initial guess
+    const size_t nRuns = 50;
+    std::chrono::duration<double, std::micro> dynamicTime(0);
+    std::chrono::duration<double, std::micro> fixedTime(0);
+    for (size_t i = 0; i < nRuns; i++)
+    {
+        dynamicSolver.setInitialGuess(initialGuess);
+        auto start = std::chrono::steady_clock::now();
+        dynamicSolver.solve();
+        dynamicTime += std::chrono::steady_clock::now() - start;
+
+        fixedSolver->setInitialGuess(x_init_fixed, u_init_fixed, L_init_fixed);
+        start = std::chrono::steady_clock::now();
+        fixedSolver->solve();
+        fixedTime += std::chrono::steady_clock::now() - start;
+    }
+
+    std::cout << "average solve time (" << fixedSolver->iteration() << " iterations): NLOptConSolver "
+              << dynamicTime.count() / nRuns << " us, FixedHorizonILQR " << fixedTime.count() / nRuns << " us"
+              << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
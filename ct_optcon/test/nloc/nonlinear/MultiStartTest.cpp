@@ -0,0 +1,249 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+ **********************************************************************************************************************/
+
+#include <chrono>
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+using namespace ct::core;
+
+const size_t state_dim = 1;
+const size_t control_dim = 1;
+
+typedef NLOptConSolver<state_dim, control_dim, 1, 0> NLOptConSolver_t;
+typedef MultiStartNLOptConSolver<state_dim, control_dim, 1, 0> MultiStartSolver_t;
+
+//! integrator dynamics x' = u
+class Integrator : public ControlledSystem<state_dim, control_dim>
+{
+public:
+    Integrator() : ControlledSystem<state_dim, control_dim>(SYSTEM_TYPE::GENERAL) {}
+    void computeControlledDynamics(const StateVector<state_dim>& state,
+        const Time& t,
+        const ControlVector<control_dim>& control,
+        StateVector<state_dim>& derivative) override
+    {
+        derivative = control;
+    }
+
+    Integrator* clone() const override { return new Integrator(); };
+};
+
+//! linearization of the integrator dynamics
+class IntegratorLinearized : public LinearSystem<state_dim, control_dim>
+{
+public:
+    const state_matrix_t& getDerivativeState(const StateVector<state_dim>& x,
+        const ControlVector<control_dim>& u,
+        const double t = 0.0) override
+    {
+        A_.setZero();
+        return A_;
+    }
+
+    const state_control_matrix_t& getDerivativeControl(const StateVector<state_dim>& x,
+        const ControlVector<control_dim>& u,
+        const double t = 0.0) override
+    {
+        B_.setOnes();
+        return B_;
+    }
+
+    IntegratorLinearized* clone() const override { return new IntegratorLinearized(); }
+
+private:
+    state_matrix_t A_;
+    state_control_matrix_t B_;
+};
+
+/*!
+ * Quadratic control cost and an asymmetric double-well terminal cost w * ((x^2 - 1)^2 + a * x), which has a local
+ * minimum close to x = 1 and the global minimum close to x = -1.
+ */
+class DoubleWellCost : public CostFunctionQuadratic<state_dim, control_dim>
+{
+public:
+    DoubleWellCost(double r = 0.1, double w = 10.0, double a = 0.3) : r_(r), w_(w), a_(a) {}
+    DoubleWellCost* clone() const override { return new DoubleWellCost(r_, w_, a_); }
+
+    double evaluateIntermediate() override { return 0.5 * r_ * this->u_(0) * this->u_(0); }
+    double evaluateTerminal() override
+    {
+        const double x = this->x_(0);
+        return w_ * ((x * x - 1.0) * (x * x - 1.0) + a_ * x);
+    }
+
+    state_vector_t stateDerivativeIntermediate() override { return state_vector_t::Zero(); }
+    state_vector_t stateDerivativeTerminal() override
+    {
+        const double x = this->x_(0);
+        return state_vector_t::Constant(w_ * (4.0 * x * (x * x - 1.0) + a_));
+    }
+    state_matrix_t stateSecondDerivativeIntermediate() override { return state_matrix_t::Zero(); }
+    state_matrix_t stateSecondDerivativeTerminal() override
+    {
+        const double x = this->x_(0);
+        return state_matrix_t::Constant(w_ * (12.0 * x * x - 4.0));
+    }
+    control_vector_t controlDerivativeIntermediate() override { return r_ * this->u_; }
+    control_matrix_t controlSecondDerivativeIntermediate() override { return control_matrix_t::Constant(r_); }
+    control_state_matrix_t stateControlDerivativeIntermediate() override { return control_state_matrix_t::Zero(); }
+
+private:
+    double r_;
+    double w_;
+    double a_;
+};
+
+/*!
+ * Solves the double-well problem from several constant initial controls, both with independent solvers and with the
+ * multi-start solver, and checks that the multi-start solver returns the best of the independent solutions. The
+ * starts which end up in the local minimum are dominated and get cancelled.
+ */
+class MultiStartTest : public ::testing::TestWithParam<NLOptConSettings::NLOCP_ALGORITHM>
+{
+public:
+    void SetUp() override
+    {
+        x0_.setZero();
+        tf_ = 1.0;
+
+        settings_.nlocp_algorithm = GetParam();
+        settings_.integrator = ct::core::IntegrationType::EULERCT;
+        settings_.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+        settings_.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+        settings_.closedLoopShooting = true;
+        settings_.dt = 0.01;
+        settings_.K_shot = 1;
+        settings_.nThreads = 1;
+        settings_.max_iterations = 20;
+        settings_.min_cost_improvement = 1e-12;
+        settings_.lineSearchSettings.active = true;
+        settings_.printSummary = false;
+
+        problem_ = std::shared_ptr<ContinuousOptConProblem<state_dim, control_dim>>(
+            new ContinuousOptConProblem<state_dim, control_dim>(tf_, x0_,
+                std::shared_ptr<ControlledSystem<state_dim, control_dim>>(new Integrator),
+                std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>>(new DoubleWellCost),
+                std::shared_ptr<LinearSystem<state_dim, control_dim>>(new IntegratorLinearized)));
+
+        // constant controls which end close to either well
+        const size_t K = settings_.computeK(tf_);
+        for (double u : {0.8, -1.2, 1.0, 1.3, -0.9, 1.1})
+        {
+            StateVectorArray<state_dim> x(K + 1);
+            for (size_t k = 0; k < K + 1; k++)
+                x[k] = x0_ + StateVector<state_dim>::Constant(u * settings_.dt * k);
+
+            initialGuesses_.push_back(NLOptConSolver_t::Policy_t(x,
+                ControlVectorArray<control_dim>(K, ControlVector<control_dim>::Constant(u)),
+                FeedbackArray<state_dim, control_dim>(K, FeedbackMatrix<state_dim, control_dim>::Zero()),
+                settings_.dt));
+        }
+    }
+
+protected:
+    StateVector<state_dim> x0_;
+    double tf_;
+    NLOptConSettings settings_;
+    std::shared_ptr<ContinuousOptConProblem<state_dim, control_dim>> problem_;
+    std::vector<NLOptConSolver_t::Policy_t> initialGuesses_;
+};
+
+TEST_P(MultiStartTest, BestOfIndependentSolves)
+{
+    const size_t nStarts = initialGuesses_.size();
+
+    // independent solves
+    std::vector<double> merits(nStarts);
+    std::vector<StateTrajectory<state_dim>> xSolutions(nStarts);
+    int iterationsIndependent = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nStarts; i++)
+    {
+        NLOptConSolver_t solver(*problem_, settings_);
+        solver.setInitialGuess(initialGuesses_[i]);
+        solver.solve();
+        merits[i] = solver.getBackend()->getSummary().merits.back();
+        xSolutions[i] = solver.getStateTrajectory();
+        iterationsIndependent += solver.getBackend()->getSummary().iterations.size();
+    }
+    std::chrono::duration<double, std::milli> independentTime = std::chrono::steady_clock::now() - start;
+
+    size_t best = std::min_element(merits.begin(), merits.end()) - merits.begin();
+
+    // without early termination, every start reproduces its independent solve
+    MultiStartSettings multiStartSettings;
+    multiStartSettings.nThreads = 3;
+    multiStartSettings.earlyTermination = false;
+
+    MultiStartSolver_t multiStartAll(*problem_, settings_, nStarts, multiStartSettings);
+    multiStartAll.setInitialGuesses(initialGuesses_);
+    ASSERT_TRUE(multiStartAll.solve());
+
+    EXPECT_EQ(multiStartAll.getBestStart(), best);
+    for (size_t i = 0; i < nStarts; i++)
+    {
+        EXPECT_EQ(multiStartAll.getStatus()[i], MultiStartSolver_t::FINISHED);
+        EXPECT_NEAR(multiStartAll.getMerits()[i], merits[i], 1e-10 * std::abs(merits[i]));
+    }
+
+    // with early termination, dominated starts are cancelled and the best start is unchanged
+    multiStartSettings.earlyTermination = true;
+    multiStartSettings.minIterations = 1;
+    multiStartSettings.relativeMargin = 0.01;
+
+    MultiStartSolver_t multiStart(*problem_, settings_, nStarts, multiStartSettings);
+    multiStart.setInitialGuesses(initialGuesses_);
+
+    start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(multiStart.solve());
+    std::chrono::duration<double, std::milli> multiStartTime = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(multiStart.getBestStart(), best);
+    EXPECT_NEAR(multiStart.getBestMerit(), merits[best], 1e-10 * std::abs(merits[best]));
+
+    StateTrajectory<state_dim> xSolution = multiStart.getStateTrajectory();
+    ASSERT_EQ(xSolution.size(), xSolutions[best].size());
+    for (size_t k = 0; k < xSolution.size(); k++)
+        EXPECT_NEAR(xSolution[k](0), xSolutions[best][k](0), 1e-10);
+
+    int iterationsMultiStart = 0;
+    size_t nCancelled = 0;
+    for (size_t i = 0; i < nStarts; i++)
+    {
+        iterationsMultiStart += multiStart.getIterations()[i];
+        if (multiStart.getStatus()[i] == MultiStartSolver_t::CANCELLED)
+            nCancelled++;
+    }
+    EXPECT_GT(nCancelled, 0u);
+    EXPECT_LT(iterationsMultiStart, iterationsIndependent);
+
+    std::cout << nStarts << " starts: independent solves " << iterationsIndependent << " iterations in "
+              << independentTime.count() << " ms, multi-start " << iterationsMultiStart << " iterations in "
+              << multiStartTime.count() << " ms, " << nCancelled << " starts cancelled" << std::endl;
+}
+
+INSTANTIATE_TEST_CASE_P(MultiStartTestAlgorithms,
+    MultiStartTest,
+    ::testing::Values(NLOptConSettings::NLOCP_ALGORITHM::ILQR, NLOptConSettings::NLOCP_ALGORITHM::GNMS));
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -116,6 +116,296 @@ TEST(NLOCTest, NonlinearSystemAlgorithmComparison)
         ASSERT_NEAR(uRollout_gnms[i](0), uRollout_ilqr[i](0), 1e-4);
     }
 }
+
+/*!
+ * Solves the multiple-shooting problem with line search, the filter line search and the speculative multi-threaded
+ * line search have to converge to the same solution as the merit function line search.
+ */
+TEST(NLOCTest, NonlinearSystemLineSearchComparison)
+{
+    typedef NLOptConSolver<state_dim, control_dim, 1, 0> NLOptConSolver;
+
+    std::string configFile = std::string(NLOC_TEST_DIR) + "/nonlinear/solver.info";
+    std::string costFunctionFile = std::string(NLOC_TEST_DIR) + "/nonlinear/cost.info";
+
+    Eigen::Matrix<double, 1, 1> x_0;
+    ct::core::loadMatrix(costFunctionFile, "x_0", x_0);
+
+    NLOptConSettings settings;
+    settings.load(configFile, false, "ilqr");
+    settings.K_shot = 10;
+    settings.max_iterations = 50;
+    settings.lineSearchSettings.active = true;
+
+    std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new Dynamics);
+    std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearizedSystem);
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction(
+        new CostFunctionAnalytical<state_dim, control_dim>(costFunctionFile));
+
+    ct::core::Time tf = 3.0;
+    ct::core::loadScalar(configFile, "timeHorizon", tf);
+    size_t nSteps = settings.computeK(tf);
+
+    ControlVector<control_dim> uff_init_guess;
+    uff_init_guess << -(x_0(0) + 1) * x_0(0);
+    NLOptConSolver::Policy_t initController(StateVectorArray<state_dim>(nSteps + 1, x_0),
+        ControlVectorArray<control_dim>(nSteps, uff_init_guess),
+        FeedbackArray<state_dim, control_dim>(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero()), settings.dt);
+
+    double defect = 0.0;  // total defect of the last solution
+    auto solve = [&](const NLOptConSettings& s) {
+        ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+            tf, x_0, nonlinearSystem, costFunction, analyticLinearSystem);
+        NLOptConSolver solver(optConProblem, s);
+        solver.setInitialGuess(initController);
+
+        auto start = std::chrono::steady_clock::now();
+        solver.solve();
+        std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+        defect = solver.getBackend()->getTotalDefect();
+        std::cout << "line search " << (s.lineSearchSettings.type == LineSearchSettings::FILTER ? "filter" : "merit")
+                  << ", threads " << s.nThreads << ", speculative " << s.lineSearchSettings.speculative << ": "
+                  << solver.getBackend()->iteration() << " iterations, " << time.count() << " ms, cost "
+                  << solver.getBackend()->getCost() << ", defect " << defect << std::endl;
+        return solver.getControlTrajectory();
+    };
+
+    // without penalty on the defects, the merit function line search gets stuck at an infeasible point
+    settings.meritFunctionRho = 0.0;
+    solve(settings);
+    ASSERT_GT(defect, settings.maxDefectSum);
+
+    // the filter line search does not need a penalty
+    NLOptConSettings filter = settings;
+    filter.lineSearchSettings.type = LineSearchSettings::FILTER;
+    ControlTrajectory<control_dim> uReference = solve(filter);
+    ASSERT_LT(defect, settings.maxDefectSum);
+
+    std::vector<NLOptConSettings> variants;
+    NLOptConSettings merit = settings;
+    merit.meritFunctionRho = 10.0;
+    variants.push_back(merit);
+
+    NLOptConSettings filterMP = filter;
+    filterMP.nThreads = 4;
+    variants.push_back(filterMP);
+
+    NLOptConSettings speculativeMP = merit;
+    speculativeMP.nThreads = 4;
+    speculativeMP.lineSearchSettings.speculative = true;
+    speculativeMP.lineSearchSettings.adaptive = true;
+    variants.push_back(speculativeMP);
+
+    NLOptConSettings adaptiveST = speculativeMP;
+    adaptiveST.nThreads = 1;
+    adaptiveST.lineSearchSettings.speculative = false;
+    variants.push_back(adaptiveST);
+
+    for (const NLOptConSettings& s : variants)
+    {
+        ControlTrajectory<control_dim> u = solve(s);
+        ASSERT_LT(defect, settings.maxDefectSum);
+        ASSERT_EQ(u.size(), uReference.size());
+        for (size_t i = 0; i < u.size(); i++)
+            ASSERT_NEAR(u[i](0), uReference[i](0), 1e-4);
+    }
+}
+
+/*!
+ * Solves the multiple-shooting problem with a too small initial step size alpha_0. With the adaptive line search, the
+ * step size grows beyond alpha_0 up to alpha_max, which needs fewer iterations than the fixed initial step size.
+ */
+TEST(NLOCTest, NonlinearSystemAdaptiveLineSearchExtrapolation)
+{
+    typedef NLOptConSolver<state_dim, control_dim, 1, 0> NLOptConSolver;
+
+    std::string configFile = std::string(NLOC_TEST_DIR) + "/nonlinear/solver.info";
+    std::string costFunctionFile = std::string(NLOC_TEST_DIR) + "/nonlinear/cost.info";
+
+    Eigen::Matrix<double, 1, 1> x_0;
+    ct::core::loadMatrix(costFunctionFile, "x_0", x_0);
+
+    NLOptConSettings settings;
+    settings.load(configFile, false, "ilqr");
+    settings.K_shot = 10;
+    settings.max_iterations = 100;
+    settings.meritFunctionRho = 10.0;
+    settings.lineSearchSettings.active = true;
+    settings.lineSearchSettings.alpha_0 = 0.125;
+    settings.lineSearchSettings.alpha_max = 1.0;
+
+    std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new Dynamics);
+    std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearizedSystem);
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction(
+        new CostFunctionAnalytical<state_dim, control_dim>(costFunctionFile));
+
+    ct::core::Time tf = 3.0;
+    ct::core::loadScalar(configFile, "timeHorizon", tf);
+    size_t nSteps = settings.computeK(tf);
+
+    ControlVector<control_dim> uff_init_guess;
+    uff_init_guess << -(x_0(0) + 1) * x_0(0);
+    NLOptConSolver::Policy_t initController(StateVectorArray<state_dim>(nSteps + 1, x_0),
+        ControlVectorArray<control_dim>(nSteps, uff_init_guess),
+        FeedbackArray<state_dim, control_dim>(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero()), settings.dt);
+
+    size_t iterations = 0;
+    double maxStepSize = 0.0;
+    auto solve = [&](const NLOptConSettings& s) {
+        ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+            tf, x_0, nonlinearSystem, costFunction, analyticLinearSystem);
+        NLOptConSolver solver(optConProblem, s);
+        solver.setInitialGuess(initController);
+        solver.solve();
+        iterations = solver.getBackend()->iteration();
+        const std::vector<double>& stepSizes = solver.getBackend()->getSummary().stepSizes;
+        maxStepSize = *std::max_element(stepSizes.begin(), stepSizes.end());
+        std::cout << "line search adaptive " << s.lineSearchSettings.adaptive << ", threads " << s.nThreads << ": "
+                  << iterations << " iterations, largest step size " << maxStepSize << std::endl;
+        return solver.getControlTrajectory();
+    };
+
+    // reference solution with full steps
+    NLOptConSettings fullStep = settings;
+    fullStep.lineSearchSettings.alpha_0 = 1.0;
+    ControlTrajectory<control_dim> uReference = solve(fullStep);
+
+    // without adaptation, alpha_0 is the largest step size
+    solve(settings);
+    const size_t iterationsFixed = iterations;
+    ASSERT_LE(maxStepSize, settings.lineSearchSettings.alpha_0);
+
+    NLOptConSettings adaptiveST = settings;
+    adaptiveST.lineSearchSettings.adaptive = true;
+
+    NLOptConSettings speculativeMP = adaptiveST;
+    speculativeMP.nThreads = 4;
+    speculativeMP.lineSearchSettings.speculative = true;
+
+    for (const NLOptConSettings& s : {adaptiveST, speculativeMP})
+    {
+        ControlTrajectory<control_dim> u = solve(s);
+        ASSERT_GT(maxStepSize, s.lineSearchSettings.alpha_0);
+        ASSERT_LE(maxStepSize, s.lineSearchSettings.alpha_max);
+        ASSERT_LT(iterations, iterationsFixed);
+        ASSERT_EQ(u.size(), uReference.size());
+        for (size_t i = 0; i < u.size(); i++)
+            ASSERT_NEAR(u[i](0), uReference[i](0), 1e-4);
+    }
+}
+
+/*!
+ * Solves the problem with a general control input constraint as augmented Lagrangian with the Riccati solver, GNMS
+ * and iLQR as well as the single- and multi-threaded backends have to satisfy the constraint
+ */
+TEST(NLOCTest, NonlinearSystemAugmentedLagrangian)
+{
+    typedef NLOptConSolver<state_dim, control_dim, 1, 0> NLOptConSolver;
+
+    std::string configFile = std::string(NLOC_TEST_DIR) + "/nonlinear/solver.info";
+    std::string costFunctionFile = std::string(NLOC_TEST_DIR) + "/nonlinear/cost.info";
+
+    Eigen::Matrix<double, 1, 1> x_0;
+    ct::core::loadMatrix(costFunctionFile, "x_0", x_0);
+
+    NLOptConSettings settings;
+    settings.load(configFile, false, "gnms");
+    settings.nlocp_algorithm = NLOptConSettings::ILQR;
+    settings.K_shot = 1;
+    settings.max_iterations = 100;
+    settings.printSummary = false;
+    settings.augmentedLagrangianSettings.active = true;
+
+    std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new Dynamics);
+    std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearizedSystem);
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction(
+        new CostFunctionAnalytical<state_dim, control_dim>(costFunctionFile));
+
+    ct::core::Time tf = 3.0;
+    ct::core::loadScalar(configFile, "timeHorizon", tf);
+    size_t nSteps = settings.computeK(tf);
+
+    ControlVector<control_dim> uff_init_guess;
+    uff_init_guess << -(x_0(0) + 1) * x_0(0);
+    NLOptConSolver::Policy_t initController(StateVectorArray<state_dim>(nSteps + 1, x_0),
+        ControlVectorArray<control_dim>(nSteps, uff_init_guess),
+        FeedbackArray<state_dim, control_dim>(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero()), settings.dt);
+
+    // unconstrained reference solution
+    ContinuousOptConProblem<state_dim, control_dim> unconstrainedProblem(
+        tf, x_0, nonlinearSystem, costFunction, analyticLinearSystem);
+    NLOptConSolver unconstrained(unconstrainedProblem, settings);
+    unconstrained.setInitialGuess(initController);
+    unconstrained.solve();
+
+    // the constraint cuts off the most negative controls of the unconstrained solution
+    const ControlTrajectory<control_dim> uUnconstrained = unconstrained.getControlTrajectory();
+    double uMin = uUnconstrained.front()(0);
+    double uMax = uUnconstrained.front()(0);
+    for (size_t i = 0; i < uUnconstrained.size(); i++)
+    {
+        uMin = std::min(uMin, uUnconstrained[i](0));
+        uMax = std::max(uMax, uUnconstrained[i](0));
+    }
+    ControlVector<control_dim> u_lb, u_ub;
+    u_lb(0) = uMin + 0.3 * (uMax - uMin);
+    u_ub(0) = uMax + 1.0;
+
+    std::shared_ptr<ConstraintContainerAnalytical<state_dim, control_dim>> generalConstraints(
+        new ConstraintContainerAnalytical<state_dim, control_dim>());
+    generalConstraints->addIntermediateConstraint(
+        std::shared_ptr<ControlInputConstraint<state_dim, control_dim>>(
+            new ControlInputConstraint<state_dim, control_dim>(u_lb, u_ub)),
+        false);
+    generalConstraints->initialize();
+
+    auto solve = [&](const NLOptConSettings& s) {
+        ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+            tf, x_0, nonlinearSystem, costFunction, analyticLinearSystem);
+        optConProblem.setGeneralConstraints(generalConstraints);
+        NLOptConSolver solver(optConProblem, s);
+        solver.setInitialGuess(initController);
+
+        auto start = std::chrono::steady_clock::now();
+        solver.solve();
+        std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+        std::cout << "augmented Lagrangian, " << (s.nlocp_algorithm == NLOptConSettings::GNMS ? "GNMS" : "iLQR")
+                  << ", threads " << s.nThreads << ": " << solver.getBackend()->iteration() << " iterations, "
+                  << time.count() << " ms, cost " << solver.getBackend()->getCost() << std::endl;
+        return solver.getControlTrajectory();
+    };
+
+    std::vector<NLOptConSettings> variants;
+    variants.push_back(settings);
+
+    NLOptConSettings gnms = settings;
+    gnms.nlocp_algorithm = NLOptConSettings::GNMS;
+    gnms.K_shot = 10;
+    variants.push_back(gnms);
+
+    NLOptConSettings ilqrMP = settings;
+    ilqrMP.nThreads = 4;
+    variants.push_back(ilqrMP);
+
+    ControlTrajectory<control_dim> uReference;
+    for (const NLOptConSettings& s : variants)
+    {
+        ControlTrajectory<control_dim> u = solve(s);
+        double uMinConstrained = u.front()(0);
+        for (size_t i = 0; i < u.size(); i++)
+            uMinConstrained = std::min(uMinConstrained, u[i](0));
+
+        // the constraint is satisfied and active
+        ASSERT_GT(uMinConstrained, u_lb(0) - settings.augmentedLagrangianSettings.tolerance);
+        ASSERT_LT(uMinConstrained, u_lb(0) + 1e-2);
+
+        if (uReference.size() == 0)
+            uReference = u;
+        ASSERT_EQ(u.size(), uReference.size());
+        for (size_t i = 0; i < u.size(); i++)
+            ASSERT_NEAR(u[i](0), uReference[i](0), 1e-3);
+    }
+}
 }
 }
 }
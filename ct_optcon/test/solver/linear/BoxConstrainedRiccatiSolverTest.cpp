@@ -0,0 +1,232 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * This unit test checks the box-constrained Riccati solver against the unconstrained Riccati solver for inactive
+ * bounds and against the condensing solver, which solves the box-constrained LQ problem exactly.
+ */
+
+#include <gtest/gtest.h>
+#include <ct/optcon/optcon.h>
+
+#include "../../testSystems/LinearOscillator.h"
+#include "RandomLQOCProblem.h"
+
+using namespace ct;
+using namespace ct::core;
+using namespace ct::optcon;
+
+TEST(BoxConstrainedRiccatiSolverTest, boxQP)
+{
+    const size_t control_dim = 4;
+    typedef BoxConstrainedRiccatiSolver<2, control_dim> Solver;
+
+    std::srand(0);
+    for (int i = 0; i < 100; i++)
+    {
+        const ControlMatrix<control_dim> M = ControlMatrix<control_dim>::Random();
+        const ControlMatrix<control_dim> H = M * M.transpose() + 0.1 * ControlMatrix<control_dim>::Identity();
+        const ControlVector<control_dim> g = 2.0 * ControlVector<control_dim>::Random();
+        const ControlVector<control_dim> lb = -ControlVector<control_dim>::Random().cwiseAbs();
+        const ControlVector<control_dim> ub = ControlVector<control_dim>::Random().cwiseAbs();
+
+        ControlVector<control_dim> u = ControlVector<control_dim>::Zero();
+        Solver::FreeMask free;
+        const int iterations = Solver::solveBoxQP(H, g, lb, ub, u, free);
+        ASSERT_LT(iterations, 20);
+
+        // first order optimality conditions
+        const ControlVector<control_dim> grad = g + H * u;
+        for (size_t j = 0; j < control_dim; j++)
+        {
+            ASSERT_GE(u(j), lb(j));
+            ASSERT_LE(u(j), ub(j));
+            if (free(j))
+                ASSERT_NEAR(grad(j), 0.0, 1e-8);
+            else if (u(j) == lb(j))
+                ASSERT_GT(grad(j), 0.0);
+            else
+                ASSERT_LT(grad(j), 0.0);
+        }
+    }
+}
+
+TEST(BoxConstrainedRiccatiSolverTest, inactiveBoundsMatchRiccati)
+{
+    const size_t state_dim = 8;
+    const size_t control_dim = 2;
+    const int N = 20;
+
+    std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem(new LQOCProblem<state_dim, control_dim>(N));
+    setRandomTimeVaryingProblem<state_dim, control_dim>(*problem);
+
+    NLOptConSettings settings;
+    GNRiccatiSolver<state_dim, control_dim> riccatiSolver;
+    riccatiSolver.configure(settings);
+    riccatiSolver.setProblem(problem);
+    riccatiSolver.solve();
+
+    const int nb = 2;
+    Eigen::VectorXi sparsity(nb);
+    sparsity << 0, 1;
+    Eigen::VectorXd lb(nb), ub(nb);
+    lb.setConstant(-1e3);
+    ub.setConstant(1e3);
+    problem->setIntermediateBoxConstraints(nb, lb, ub, sparsity);
+
+    BoxConstrainedRiccatiSolver<state_dim, control_dim> boxSolver;
+    boxSolver.configure(settings);
+    boxSolver.setProblem(problem);
+    boxSolver.solve();
+
+    for (int k = 0; k < N; k++)
+    {
+        ASSERT_LT((riccatiSolver.getSolutionControl()[k] - boxSolver.getSolutionControl()[k]).norm(), 1e-12);
+        ASSERT_LT((riccatiSolver.getSolutionFeedback()[k] - boxSolver.getSolutionFeedback()[k]).norm(), 1e-12);
+    }
+}
+
+/*!
+ * Every backward pass solves the stage problems at the reference state. Moving the reference to the last solution,
+ * as GNMS and iLQR do, converges to the optimum of the box-constrained problem.
+ */
+TEST(BoxConstrainedRiccatiSolverTest, iteratedSolutionMatchesCondensing)
+{
+    const size_t state_dim = 8;
+    const size_t control_dim = 2;
+    const int N = 10;
+
+    std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem(new LQOCProblem<state_dim, control_dim>(N));
+    setRandomTimeVaryingProblem<state_dim, control_dim>(*problem);
+
+    const int nb = 2;
+    Eigen::VectorXi sparsity(nb);
+    sparsity << 0, 1;
+    Eigen::VectorXd lb(nb), ub(nb);
+    lb << -0.3, -0.1;
+    ub << 0.3, 0.2;
+    problem->setIntermediateBoxConstraints(nb, lb, ub, sparsity);
+
+    NLOptConSettings settings;
+    settings.lqoc_solver_settings.num_lqoc_iterations = 50;
+    CondensingSolver<state_dim, control_dim> condensingSolver;
+    condensingSolver.configure(settings);
+    condensingSolver.setProblem(problem);
+    condensingSolver.solve();
+    const ControlVectorArray<control_dim> uReference = condensingSolver.getSolutionControl();
+
+    BoxConstrainedRiccatiSolver<state_dim, control_dim> boxSolver;
+    boxSolver.configure(settings);
+
+    double difference = std::numeric_limits<double>::infinity();
+    bool active = false;
+    for (int iter = 0; iter < 20 && difference > 1e-8; iter++)
+    {
+        boxSolver.setProblem(problem);
+        boxSolver.solve();
+
+        difference = 0.0;
+        for (int k = 0; k < N; k++)
+        {
+            const ControlVector<control_dim>& u = boxSolver.getSolutionControl()[k];
+            difference = std::max(difference, (u - uReference[k]).array().abs().maxCoeff());
+            active = active || (u.array() <= lb.array() + 1e-8).any() || (u.array() >= ub.array() - 1e-8).any();
+        }
+
+        problem->x_ = boxSolver.getSolutionState();
+        problem->u_ = boxSolver.getSolutionControl();
+    }
+
+    ASSERT_TRUE(active);
+    ASSERT_LT(difference, 1e-8);
+}
+
+//! run NLOC on a linear system with control bounds, GNMS and iLQR have to converge to the condensing solution
+TEST(BoxConstrainedRiccatiSolverTest, NLOCSolverTest)
+{
+    using namespace ct::optcon::example;
+    typedef NLOptConSolver<state_dim, control_dim, state_dim / 2, state_dim / 2> NLOptConSolver;
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+    StateVector<state_dim> initState;
+    initState.setZero();
+    initState(1) = 1.0;
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.epsilon = 0.0;
+    nloc_settings.dt = 0.05;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.integrator = ct::core::IntegrationType::EULERCT;
+    nloc_settings.max_iterations = 20;
+    nloc_settings.min_cost_improvement = 1e-12;
+    nloc_settings.lqoc_solver_settings.num_lqoc_iterations = 50;
+    nloc_settings.printSummary = false;
+
+    ct::core::Time tf = 1.0;
+    size_t nSteps = nloc_settings.computeK(tf);
+
+    std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new LinearOscillator());
+    std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear());
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+        example::tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+    ControlVector<control_dim> u_lb, u_ub;
+    u_lb << -10.0;
+    u_ub << 10.0;
+    std::shared_ptr<ConstraintContainerAnalytical<state_dim, control_dim>> boxConstraints(
+        new ConstraintContainerAnalytical<state_dim, control_dim>());
+    boxConstraints->addIntermediateConstraint(
+        std::shared_ptr<ControlInputConstraint<state_dim, control_dim>>(
+            new ControlInputConstraint<state_dim, control_dim>(u_lb, u_ub)),
+        false);
+    boxConstraints->initialize();
+
+    ControlVector<control_dim> uff;
+    uff << kStiffness * initState(0);
+    NLOptConSolver::Policy_t initController(StateVectorArray<state_dim>(nSteps + 1, initState),
+        ControlVectorArray<control_dim>(nSteps, uff),
+        FeedbackArray<state_dim, control_dim>(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero()),
+        nloc_settings.dt);
+
+    auto solve = [&](const NLOptConSettings& settings) {
+        ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+            tf, initState, nonlinearSystem, costFunction, analyticLinearSystem);
+        optConProblem.setBoxConstraints(boxConstraints);
+        NLOptConSolver solver(optConProblem, settings);
+        solver.setInitialGuess(initController);
+        solver.solve();
+        return solver.getSolution().uff();
+    };
+
+    for (int algClass = 0; algClass < NLOptConSettings::NLOCP_ALGORITHM::NUM_TYPES; algClass++)
+    {
+        nloc_settings.nlocp_algorithm = static_cast<NLOptConSettings::NLOCP_ALGORITHM>(algClass);
+
+        NLOptConSettings condensing = nloc_settings;
+        condensing.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::CONDENSING_SOLVER;
+        const ControlVectorArray<control_dim> uReference = solve(condensing);
+
+        NLOptConSettings boxRiccati = nloc_settings;
+        boxRiccati.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::BOX_RICCATI_SOLVER;
+        const ControlVectorArray<control_dim> u = solve(boxRiccati);
+
+        bool active = false;
+        ASSERT_EQ(u.size(), uReference.size());
+        for (size_t k = 0; k < u.size(); k++)
+        {
+            ASSERT_NEAR(u[k](0), uReference[k](0), 1e-6);
+            active = active || std::abs(u[k](0)) > u_ub(0) - 1e-6;
+        }
+        ASSERT_TRUE(active);
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
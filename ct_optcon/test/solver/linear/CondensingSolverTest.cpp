@@ -0,0 +1,351 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * This unit test compares the condensing LQ solver to the Riccati solver for unconstrained problems and checks the
+ * optimality of its solution for box-constrained problems.
+ */
+
+#include <gtest/gtest.h>
+#include <ct/optcon/optcon.h>
+
+#include "../../testSystems/SpringLoadedMass.h"
+#include "../../testSystems/LinearOscillator.h"
+#include "RandomLQOCProblem.h"
+
+using namespace ct;
+using namespace ct::core;
+using namespace ct::optcon;
+
+//! evaluate the cost of the LQ problem for a given control trajectory, the states are obtained by a forward rollout
+template <size_t state_dim, size_t control_dim>
+double computeLQCost(const LQOCProblem<state_dim, control_dim>& p, const ControlVectorArray<control_dim>& u)
+{
+    const int N = p.A_.size();
+    StateVector<state_dim> x = p.x_[0];
+    double cost = 0.0;
+    for (int k = 0; k < N; k++)
+    {
+        cost += p.q_[k] + p.qv_[k].dot(x) + p.rv_[k].dot(u[k]) + 0.5 * x.dot(p.Q_[k] * x) +
+                0.5 * u[k].dot(p.R_[k] * u[k]) + u[k].dot(p.P_[k] * x);
+        x = p.A_[k] * x + p.B_[k] * u[k] + p.b_[k];
+    }
+    return cost + p.q_[N] + p.qv_[N].dot(x) + 0.5 * x.dot(p.Q_[N] * x);
+}
+
+template <size_t state_dim, size_t control_dim>
+void compareToRiccati(std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem, bool closedLoop)
+{
+    NLOptConSettings settings;
+    settings.closedLoopShooting = closedLoop;
+
+    GNRiccatiSolver<state_dim, control_dim> riccatiSolver;
+    CondensingSolver<state_dim, control_dim> condensingSolver;
+    riccatiSolver.configure(settings);
+    condensingSolver.configure(settings);
+
+    riccatiSolver.setProblem(problem);
+    riccatiSolver.initializeAndAllocate();
+    riccatiSolver.solve();
+
+    condensingSolver.setProblem(problem);
+    condensingSolver.initializeAndAllocate();
+    condensingSolver.solve();
+
+    const auto& xRiccati = riccatiSolver.getSolutionState();
+    const auto& uRiccati = riccatiSolver.getSolutionControl();
+    const auto& KRiccati = riccatiSolver.getSolutionFeedback();
+    const auto& xCondensing = condensingSolver.getSolutionState();
+    const auto& uCondensing = condensingSolver.getSolutionControl();
+    const auto& KCondensing = condensingSolver.getSolutionFeedback();
+
+    ASSERT_EQ(condensingSolver.getNumIterations(), 0);
+
+    for (size_t k = 0; k < xRiccati.size(); k++)
+        ASSERT_LT((xRiccati[k] - xCondensing[k]).array().abs().maxCoeff(), 1e-8);
+
+    for (size_t k = 0; k < uRiccati.size(); k++)
+    {
+        ASSERT_LT((uRiccati[k] - uCondensing[k]).array().abs().maxCoeff(), 1e-8);
+
+        if (closedLoop)
+            ASSERT_LT((KRiccati[k] - KCondensing[k]).array().abs().maxCoeff(), 1e-8);
+        else
+            ASSERT_EQ(KCondensing[k].norm(), 0.0);
+    }
+}
+
+TEST(CondensingSolverTest, compareToRiccatiTimeInvariant)
+{
+    const size_t state_dim = 2;
+    const size_t control_dim = 1;
+    const size_t N = 10;
+    const double dt = 0.5;
+
+    std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem(new LQOCProblem<state_dim, control_dim>(N));
+
+    std::shared_ptr<core::LinearSystem<state_dim, control_dim>> exampleSystem(new example::SpringLoadedMassLinear());
+    core::SensitivityApproximation<state_dim, control_dim> discreteExampleSystem(
+        dt, exampleSystem, core::SensitivityApproximationSettings::APPROXIMATION::MATRIX_EXPONENTIAL);
+
+    ControlVector<control_dim> u0;
+    u0 << 0.1;
+    StateVector<state_dim> x0;
+    x0 << 0.2, 0.1;
+    StateVector<state_dim> xf;
+    xf << -1, 0;
+    auto costFunction = example::createSpringLoadedMassCostFunction(xf);
+    StateVector<state_dim> b;
+    b << 0.1, 0.1;
+
+    problem->setFromTimeInvariantLinearQuadraticProblem(x0, u0, discreteExampleSystem, *costFunction, b, dt);
+
+    compareToRiccati<state_dim, control_dim>(problem, false);
+    compareToRiccati<state_dim, control_dim>(problem, true);
+}
+
+TEST(CondensingSolverTest, compareToRiccatiTimeVarying)
+{
+    const size_t state_dim = 8;
+    const size_t control_dim = 2;
+
+    for (int N : {1, 5, 20})
+    {
+        std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem(new LQOCProblem<state_dim, control_dim>(N));
+        setRandomTimeVaryingProblem<state_dim, control_dim>(*problem);
+
+        compareToRiccati<state_dim, control_dim>(problem, false);
+        compareToRiccati<state_dim, control_dim>(problem, true);
+    }
+}
+
+TEST(CondensingSolverTest, controlBoxConstraints)
+{
+    const size_t state_dim = 8;
+    const size_t control_dim = 2;
+    const int N = 10;
+
+    std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem(new LQOCProblem<state_dim, control_dim>(N));
+    setRandomTimeVaryingProblem<state_dim, control_dim>(*problem);
+
+    // bound the second control input only
+    const int nb = 1;
+    Eigen::VectorXi sparsity(nb);
+    sparsity << 1;
+    Eigen::VectorXd lb(nb), ub(nb);
+    lb << -0.1;
+    ub << 0.2;
+    problem->setIntermediateBoxConstraints(nb, lb, ub, sparsity);
+
+    // default settings, the interior point method has to converge within its default iteration limit
+    NLOptConSettings settings;
+    CondensingSolver<state_dim, control_dim> solver;
+    solver.configure(settings);
+    solver.setProblem(problem);
+    solver.initializeAndAllocate();
+    solver.solve();
+
+    ControlVectorArray<control_dim> u = solver.getSolutionControl();
+    ASSERT_TRUE(solver.converged());
+    ASSERT_GT(solver.getNumIterations(), 0);
+    ASSERT_LT(solver.getNumIterations(), settings.lqoc_solver_settings.num_ipm_iterations);
+
+    // the constraints are respected and active, the state trajectory is consistent
+    bool active = false;
+    for (int k = 0; k < N; k++)
+    {
+        ASSERT_GE(u[k](1), lb(0) - 1e-8);
+        ASSERT_LE(u[k](1), ub(0) + 1e-8);
+        active = active || (u[k](1) < lb(0) + 1e-6) || (u[k](1) > ub(0) - 1e-6);
+
+        const StateVector<state_dim> xNext = problem->A_[k] * solver.getSolutionState()[k] +
+                                             problem->B_[k] * u[k] + problem->b_[k];
+        ASSERT_LT((xNext - solver.getSolutionState()[k + 1]).norm(), 1e-10);
+    }
+    ASSERT_TRUE(active);
+
+    // the problem is convex, no feasible control trajectory has lower cost
+    const double optimalCost = computeLQCost<state_dim, control_dim>(*problem, u);
+    for (int i = 0; i < 100; i++)
+    {
+        ControlVectorArray<control_dim> uPerturbed = u;
+        for (int k = 0; k < N; k++)
+        {
+            uPerturbed[k] += 0.01 * ControlVector<control_dim>::Random();
+            uPerturbed[k](1) = std::min(std::max(uPerturbed[k](1), lb(0)), ub(0));
+        }
+        ASSERT_GE((computeLQCost<state_dim, control_dim>(*problem, uPerturbed)), optimalCost - 1e-8);
+    }
+}
+
+TEST(CondensingSolverTest, stateBoxConstraints)
+{
+    const size_t state_dim = 8;
+    const size_t control_dim = 2;
+    const int N = 10;
+
+    std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem(new LQOCProblem<state_dim, control_dim>(N));
+    setRandomTimeVaryingProblem<state_dim, control_dim>(*problem);
+
+    problem->x_[0](0) = 0.0;
+
+    // the unconstrained solution as reference
+    CondensingSolver<state_dim, control_dim> solver;
+    NLOptConSettings settings;
+    solver.configure(settings);
+    solver.setProblem(problem);
+    solver.solve();
+    const double unconstrainedCost = computeLQCost<state_dim, control_dim>(*problem, solver.getSolutionControl());
+    double maxUnconstrained = 0.0;
+    for (int k = 1; k <= N; k++)
+        maxUnconstrained = std::max(maxUnconstrained, std::abs(solver.getSolutionState()[k](0)));
+
+    // bound the first state at all stages such that the bound is active
+    // the indices of intermediate stages are ordered [u x]
+    const int nb = 1;
+    Eigen::VectorXd lb(nb), ub(nb);
+    ub << 0.5 * maxUnconstrained;
+    lb = -ub;
+    Eigen::VectorXi sparsity(nb);
+    sparsity << control_dim;
+    Eigen::VectorXi sparsityTerminal(nb);
+    sparsityTerminal << 0;
+    problem->setIntermediateBoxConstraints(nb, lb, ub, sparsity);
+    problem->setTerminalBoxConstraints(nb, lb, ub, sparsityTerminal);
+
+    solver.configureBoxConstraints(problem);
+    solver.setProblem(problem);
+    solver.solve();
+
+    const StateVectorArray<state_dim>& x = solver.getSolutionState();
+    for (int k = 1; k <= N; k++)
+    {
+        ASSERT_GE(x[k](0), lb(0) - 1e-8);
+        ASSERT_LE(x[k](0), ub(0) + 1e-8);
+    }
+    const double constrainedCost = computeLQCost<state_dim, control_dim>(*problem, solver.getSolutionControl());
+    ASSERT_GT(constrainedCost, unconstrainedCost);
+    ASSERT_TRUE(solver.converged());
+    ASSERT_GT(solver.getNumIterations(), 0);
+
+    // an insufficient iteration limit is reported
+    settings.lqoc_solver_settings.num_ipm_iterations = 1;
+    solver.configure(settings);
+    solver.solve();
+    ASSERT_FALSE(solver.converged());
+    ASSERT_EQ(solver.getNumIterations(), 1);
+}
+
+//! a box on the fixed initial state only leaves no constraint rows, the solver falls back to the unconstrained solution
+TEST(CondensingSolverTest, initialStateBoxConstraintOnly)
+{
+    const size_t state_dim = 8;
+    const size_t control_dim = 2;
+    const int N = 10;
+
+    std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem(new LQOCProblem<state_dim, control_dim>(N));
+    setRandomTimeVaryingProblem<state_dim, control_dim>(*problem);
+
+    NLOptConSettings settings;
+    CondensingSolver<state_dim, control_dim> solver;
+    solver.configure(settings);
+    solver.setProblem(problem);
+    solver.solve();
+    const ControlVectorArray<control_dim> uUnconstrained = solver.getSolutionControl();
+
+    const int nb = 1;
+    Eigen::VectorXd lb(nb), ub(nb);
+    lb << -1.0;
+    ub << 1.0;
+    Eigen::VectorXi sparsity(nb);
+    sparsity << control_dim;
+    problem->setIntermediateBoxConstraint(0, nb, lb, ub, sparsity);
+    ASSERT_TRUE(problem->isConstrained());
+
+    solver.configureBoxConstraints(problem);
+    solver.setProblem(problem);
+    solver.solve();
+
+    ASSERT_TRUE(solver.converged());
+    ASSERT_EQ(solver.getNumIterations(), 0);
+    for (int k = 0; k < N; k++)
+    {
+        ASSERT_TRUE(solver.getSolutionControl()[k].allFinite());
+        ASSERT_LT((solver.getSolutionControl()[k] - uUnconstrained[k]).norm(), 1e-10);
+    }
+}
+
+//! run the full NLOC with the condensing solver on a linear system, it has to converge in one iteration
+TEST(CondensingSolverTest, NLOCSolverTest)
+{
+    using namespace ct::optcon::example;
+    typedef NLOptConSolver<state_dim, control_dim, state_dim / 2, state_dim / 2> NLOptConSolver;
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+    StateVector<state_dim> initState;
+    initState.setZero();
+    initState(1) = 1.0;
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.epsilon = 0.0;
+    nloc_settings.recordSmallestEigenvalue = false;
+    nloc_settings.fixedHessianCorrection = false;
+    nloc_settings.dt = 0.05;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.integrator = ct::core::IntegrationType::EULERCT;
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::CONDENSING_SOLVER;
+    nloc_settings.printSummary = false;
+
+    for (int algClass = 0; algClass < NLOptConSettings::NLOCP_ALGORITHM::NUM_TYPES; algClass++)
+    {
+        nloc_settings.nlocp_algorithm = static_cast<NLOptConSettings::NLOCP_ALGORITHM>(algClass);
+
+        for (int toggleClosedLoop = 0; toggleClosedLoop <= 1; toggleClosedLoop++)
+        {
+            nloc_settings.closedLoopShooting = (bool)toggleClosedLoop;
+
+            std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new LinearOscillator());
+            std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear());
+            std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+                example::tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+            ct::core::Time tf = 1.0;
+            size_t nSteps = nloc_settings.computeK(tf);
+
+            StateVectorArray<state_dim> x0(nSteps + 1, initState);
+            ControlVector<control_dim> uff;
+            uff << kStiffness * initState(0);
+            ControlVectorArray<control_dim> u0(nSteps, uff);
+            FeedbackArray<state_dim, control_dim> u0_fb(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero());
+
+            NLOptConSolver::Policy_t initController(x0, u0, u0_fb, nloc_settings.dt);
+
+            ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+                tf, x0[0], nonlinearSystem, costFunction, analyticLinearSystem);
+
+            NLOptConSolver solver(optConProblem, nloc_settings);
+            solver.configure(nloc_settings);
+            solver.setInitialGuess(initController);
+
+            solver.runIteration();
+            solver.runIteration();
+
+            const SummaryAllIterations<double>& summary = solver.getBackend()->getSummary();
+            ASSERT_GT(summary.lx_norms.front(), 1e-9);
+            ASSERT_GT(summary.lu_norms.front(), 1e-9);
+            ASSERT_LT(summary.lx_norms.back(), 1e-10);
+            ASSERT_LT(summary.lu_norms.back(), 1e-10);
+            ASSERT_LT(summary.defect_l1_norms.back(), 1e-10);
+        }
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,28 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+//! fill an LQ problem with random time-varying dynamics and cost
+template <size_t state_dim, size_t control_dim>
+void setRandomTimeVaryingProblem(ct::optcon::LQOCProblem<state_dim, control_dim>& p)
+{
+    const int N = p.getNumberOfStages();
+    p.setZero();
+    p.x_[0].setRandom();
+    for (int k = 0; k < N; k++)
+    {
+        p.A_[k] = ct::core::StateMatrix<state_dim>::Identity() + 0.1 * ct::core::StateMatrix<state_dim>::Random();
+        p.B_[k].setRandom();
+        p.b_[k] = 0.1 * ct::core::StateVector<state_dim>::Random();
+        p.Q_[k] = ct::core::StateMatrix<state_dim>::Identity();
+        p.R_[k] = ct::core::ControlMatrix<control_dim>::Identity();
+        p.P_[k] = 0.1 * ct::core::FeedbackMatrix<state_dim, control_dim>::Random();
+        p.qv_[k].setRandom();
+        p.rv_[k].setRandom();
+    }
+    p.Q_[N] = 10.0 * ct::core::StateMatrix<state_dim>::Identity();
+    p.qv_[N].setRandom();
+}
@@ -0,0 +1,92 @@
+# CMake helpers for generating robot linearizations at build time.
+#
+# ct_rbd_add_contact_linearization(<name>
+#     ROBOT_HEADER <header>          header defining the robot, e.g. ct/models/HyQ/HyQ.h
+#     DYNAMICS_TPL <type>            scalar-templated dynamics, e.g. ct::rbd::HyQ::tpl::Dynamics
+#     [NS1 <ns>] [NS2 <ns>]          namespaces of the generated class (default: models <name>)
+#     [CONTACT_PARAMS k d alpha alpha_n zOffset smoothing]
+#     [NO_CONTACT] [REVERSE] [QUAT_INTEGRATION]
+#     [LINK_LIBRARIES <libs>])
+#
+# Creates a generator executable which records the forward dynamics of the floating base system
+# with contact model through FloatingBaseContactLinearizerCG, runs it at build time and compiles the
+# resulting sparse A/B code into the library <name>. The generated header <name>.h is exposed through
+# the include directories of the library. The generator is only re-run if its inputs change.
+
+set(CT_RBD_CODEGEN_TEMPLATE "${CMAKE_CURRENT_LIST_DIR}/ContactLinearizationCodegen.cpp.in")
+
+function(ct_rbd_add_contact_linearization NAME)
+    set(options NO_CONTACT REVERSE QUAT_INTEGRATION)
+    set(oneValueArgs ROBOT_HEADER DYNAMICS_TPL NS1 NS2)
+    set(multiValueArgs CONTACT_PARAMS LINK_LIBRARIES)
+    cmake_parse_arguments(CG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+    if(NOT CG_ROBOT_HEADER OR NOT CG_DYNAMICS_TPL)
+        message(FATAL_ERROR "ct_rbd_add_contact_linearization: ROBOT_HEADER and DYNAMICS_TPL are required.")
+    endif()
+
+    if(NOT CG_NS1)
+        set(CG_NS1 "models")
+    endif()
+    if(NOT CG_NS2)
+        set(CG_NS2 "${NAME}")
+    endif()
+
+    # default contact parameters (identical to the HyQ codegen linearization)
+    set(CG_K 5000.0)
+    set(CG_D 1000.0)
+    set(CG_ALPHA 100.0)
+    set(CG_ALPHA_N 100.0)
+    set(CG_Z_OFFSET -0.02)
+    set(CG_SMOOTHING 1)
+    if(CG_CONTACT_PARAMS)
+        list(LENGTH CG_CONTACT_PARAMS nParams)
+        if(NOT nParams EQUAL 6)
+            message(FATAL_ERROR "ct_rbd_add_contact_linearization: CONTACT_PARAMS expects 6 values.")
+        endif()
+        list(GET CG_CONTACT_PARAMS 0 CG_K)
+        list(GET CG_CONTACT_PARAMS 1 CG_D)
+        list(GET CG_CONTACT_PARAMS 2 CG_ALPHA)
+        list(GET CG_CONTACT_PARAMS 3 CG_ALPHA_N)
+        list(GET CG_CONTACT_PARAMS 4 CG_Z_OFFSET)
+        list(GET CG_CONTACT_PARAMS 5 CG_SMOOTHING)
+    endif()
+
+    set(CG_USE_CONTACT "true")
+    if(CG_NO_CONTACT)
+        set(CG_USE_CONTACT "false")
+    endif()
+    set(CG_USE_REVERSE "false")
+    if(CG_REVERSE)
+        set(CG_USE_REVERSE "true")
+    endif()
+    set(CG_QUAT "false")
+    if(CG_QUAT_INTEGRATION)
+        set(CG_QUAT "true")
+    endif()
+
+    # the code templates of ct_core, located through its package config
+    if(NOT ct_core_CODEGEN_TEMPLATE_DIR)
+        message(FATAL_ERROR "ct_rbd_add_contact_linearization: ct_core_CODEGEN_TEMPLATE_DIR is not set.")
+    endif()
+    set(CG_TEMPLATE_DIR "${ct_core_CODEGEN_TEMPLATE_DIR}")
+
+    set(CG_OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/generated/${NAME}")
+    set(CG_GENERATOR_SRC "${CMAKE_CURRENT_BINARY_DIR}/generated/${NAME}Codegen.cpp")
+    file(MAKE_DIRECTORY ${CG_OUTPUT_DIR})
+    configure_file(${CT_RBD_CODEGEN_TEMPLATE} ${CG_GENERATOR_SRC} @ONLY)
+
+    add_executable(${NAME}Codegen ${CG_GENERATOR_SRC})
+    target_link_libraries(${NAME}Codegen ct_rbd ${CG_LINK_LIBRARIES})
+
+    add_custom_command(
+        OUTPUT ${CG_OUTPUT_DIR}/${NAME}.h ${CG_OUTPUT_DIR}/${NAME}.cpp
+        COMMAND ${NAME}Codegen
+        DEPENDS ${NAME}Codegen
+        COMMENT "Generating contact linearization ${NAME}"
+        VERBATIM)
+
+    add_library(${NAME} ${CG_OUTPUT_DIR}/${NAME}.cpp)
+    target_include_directories(${NAME} PUBLIC $<BUILD_INTERFACE:${CG_OUTPUT_DIR}>)
+    target_link_libraries(${NAME} ct_rbd ${CG_LINK_LIBRARIES})
+endfunction()
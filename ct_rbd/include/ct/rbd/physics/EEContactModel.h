@@ -13,6 +13,9 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <iit/rbd/robcogen_commons.h>
 #include <iit/rbd/traits/TraitSelector.h>
 
+#include "terrain/TerrainBase.h"
+#include "terrain/FlatTerrain.h"
+
 namespace ct {
 namespace rbd {
 
@@ -25,7 +28,9 @@ namespace rbd {
  *
  * \f[ {}_W \lambda = f(q, \dot{q}) \f]
  *
- * The contact model assumes a plane with fixed orientation located at the origin (0, 0, 0). The contact dynamics
+ * By default, the contact model assumes a plane with fixed orientation located at the origin (0, 0, 0). Alternatively,
+ * a terrain (e.g. a HeightFieldTerrain) can be set, which is queried for the penetration depth and surface normal of
+ * every end-effector. In that case the normal spring acts along the local surface normal. The contact dynamics
  * are a combination of a spring-damper perpendicular and a damper in parallel to the surface. The force expressed
  * in world coordinates without velocity smoothing or normal force smoothing is defined as
  *
@@ -74,6 +79,9 @@ public:
     typedef kindr::Position<SCALAR, 3> Position3S;
     typedef kindr::Velocity<SCALAR, 3> Velocity3S;
 
+    typedef TerrainBase<SCALAR> Terrain;
+    typedef typename Kinematics::KinematicsCache_t KinematicsCache_t;
+
 
     /*!
 	 * \brief the type of velcity smoothing
@@ -109,7 +117,8 @@ public:
           d_(d),
           alpha_(alpha),
           alpha_n_(alpha_n),
-          zOffset_(zOffset)
+          zOffset_(zOffset),
+          terrain_(nullptr)
     {
         for (size_t i = 0; i < NUM_EE; i++)
             EEactive_[i] = true;
@@ -127,6 +136,7 @@ public:
           alpha_(other.alpha_),
           alpha_n_(other.alpha_n_),
           zOffset_(other.zOffset_),
+          terrain_(other.terrain_ ? other.terrain_->clone() : nullptr),
           EEactive_(other.EEactive_)
     {
     }
@@ -137,12 +147,29 @@ public:
 	 * @param activeMap flags of active end-effectors
 	 */
     void setActiveEE(const ActiveMap& activeMap) { EEactive_ = activeMap; }
+    /**
+	 * \brief Sets the terrain to be used for contact. If no terrain is set, flat ground at z = 0 is assumed.
+	 * @param terrain the terrain
+	 */
+    void setTerrain(const std::shared_ptr<Terrain>& terrain) { terrain_ = terrain; }
     /**
 	 * \brief Computes the contact forces given a state of the robot. Returns forces expressed in the world frame
 	 * @param state The state of the robot
 	 * @return End-effector forces expressed in the world frame
 	 */
     EEForcesLinear computeContactForces(const RBDState<NJOINTS, SCALAR>& state)
+    {
+        return computeContactForces(state, kinematics_->updateCache(state.jointPositions()));
+    }
+
+    /**
+	 * \brief Computes the contact forces given a state of the robot and the kinematics of its joint configuration.
+	 * Returns forces expressed in the world frame
+	 * @param state The state of the robot
+	 * @param cache Kinematics cache, updated for the joint positions of the state
+	 * @return End-effector forces expressed in the world frame
+	 */
+    EEForcesLinear computeContactForces(const RBDState<NJOINTS, SCALAR>& state, const KinematicsCache_t& cache)
     {
         EEForcesLinear eeForces;
 
@@ -150,12 +177,14 @@ public:
         {
             if (EEactive_[i])
             {
-                Vector3s eePenetration = computePenetration(i, state.basePose(), state.jointPositions());
+                Vector3s normal;
+                Vector3s eePenetration =
+                    computePenetration(kinematics_->getEEPositionInWorld(i, state.basePose(), cache), normal);
 
                 if (eeInContact(eePenetration))
                 {
-                    Velocity3S eeVelocity = kinematics_->getEEVelocityInWorld(i, state);
-                    eeForces[i] = computeEEForce(eePenetration, eeVelocity);
+                    Velocity3S eeVelocity = kinematics_->getEEVelocityInWorld(i, state, cache);
+                    eeForces[i] = computeEEForce(eePenetration, normal, eeVelocity);
                 }
                 else
                 {
@@ -172,11 +201,12 @@ public:
     SCALAR& k() { return k_; }
     SCALAR& d() { return d_; }
     SCALAR& zOffset() { return zOffset_; }
+    std::shared_ptr<Terrain>& terrain() { return terrain_; }
     VELOCITY_SMOOTHING& smoothing() { return smoothing_; }
 private:
     /**
 	 * \brief Checks if end-effector is in contact. Currently assumes this is the case for negative z
-	 * @param eePenetration The surface penetration of the end-effector
+	 * @param eePenetration The surface penetration of the end-effector, expressed in the surface frame (z along normal)
 	 * @return flag if the end-effector is in contact
 	 */
     bool eeInContact(const Vector3s& eePenetration)
@@ -189,21 +219,27 @@ private:
 
 
     /**
-	 * \brief Computes the surface penetration. Currently assumes the surface is at height z = 0.
-	 * @param eeId ID of the end-effector
-	 * @param basePose Position of the robot base
-	 * @param jointPosition Joint position of the robot
-	 * @return Penetration in world coordinates
+	 * \brief Computes the surface penetration. Assumes the surface is at height z = 0 if no terrain is set.
+	 * @param pos Position of the end-effector in world coordinates
+	 * @param normal the surface normal in world coordinates
+	 * @return Penetration in the surface frame, i.e. the signed depth along the normal is the z component
 	 */
-    Vector3s computePenetration(const size_t& eeId,
-        const tpl::RigidBodyPose<SCALAR>& basePose,
-        const typename JointState<NJOINTS, SCALAR>::Position& jointPosition)
+    Vector3s computePenetration(const Position3S& pos, Vector3s& normal)
     {
-        Position3S pos = kinematics_->getEEPositionInWorld(eeId, basePose, jointPosition);
-
-        // we currently assume flat ground at height zero penetration is only z height
         Vector3s penetration;
-        penetration << SCALAR(0.0), SCALAR(0.0), pos.z();
+
+        if (terrain_)
+        {
+            SCALAR depth;
+            terrain_->query(pos.toImplementation(), depth, normal);
+            penetration << SCALAR(0.0), SCALAR(0.0), depth;
+        }
+        else
+        {
+            // flat ground at height zero, penetration is only z height
+            normal << SCALAR(0.0), SCALAR(0.0), SCALAR(1.0);
+            penetration << SCALAR(0.0), SCALAR(0.0), pos.z();
+        }
 
         return penetration;
     }
@@ -211,10 +247,11 @@ private:
     /*!
 	 * \brief Compute the endeffector force based on penetration and velocity
 	 * @param eePenetration end-effector penetration
+	 * @param normal surface normal in world coordinates
 	 * @param eeVelocity end-effector velocity
 	 * @return resulting force vecttor
 	 */
-    EEForceLinear computeEEForce(const Vector3s& eePenetration, const Velocity3S& eeVelocity)
+    EEForceLinear computeEEForce(const Vector3s& eePenetration, const Vector3s& normal, const Velocity3S& eeVelocity)
     {
         EEForceLinear eeForce;
 
@@ -222,7 +259,8 @@ private:
 
         smoothEEForce(eeForce, eePenetration);
 
-        computeNormalSpring(eeForce, eePenetration(2) - zOffset_, eeVelocity.toImplementation()(2));
+        computeNormalSpring(
+            eeForce, normal, eePenetration(2) - zOffset_, normal.dot(eeVelocity.toImplementation()));
 
         return eeForce;
     }
@@ -264,15 +302,22 @@ private:
         force = -d_ * eeVelocity.toImplementation();
     }
 
-    void computeNormalSpring(EEForceLinear& force, const SCALAR& p_N, const SCALAR& p_dot_N)
+    /*!
+	 * \brief computes the normal spring force along the surface normal
+	 * @param force force to be computed
+	 * @param normal surface normal in world coordinates
+	 * @param p_N penetration along the normal
+	 * @param p_dot_N velocity along the normal
+	 */
+    void computeNormalSpring(EEForceLinear& force, const Vector3s& normal, const SCALAR& p_N, const SCALAR& p_dot_N)
     {
         if (alpha_n_ > SCALAR(0))
         {
-            force(2) += k_ * TRAIT::exp(-alpha_n_ * p_N);
+            force += k_ * TRAIT::exp(-alpha_n_ * p_N) * normal;
         }
         else if (p_N <= SCALAR(0))
         {
-            force(2) -= k_ * p_N;
+            force -= k_ * p_N * normal;
         }
     }
 
@@ -289,6 +334,8 @@ private:
     SCALAR alpha_n_;  //!< normal force smoothing coefficient
     SCALAR zOffset_;  //!< vertical offset of the contact pane
 
+    std::shared_ptr<Terrain> terrain_;  //!< terrain, flat ground at z = 0 if not set
+
     ActiveMap EEactive_;  //!< stores which endeffectors are active, i.e. can make contact
 };
 }
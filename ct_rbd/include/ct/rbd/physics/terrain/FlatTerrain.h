@@ -0,0 +1,39 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "TerrainBase.h"
+
+namespace ct {
+namespace rbd {
+
+/*!
+ * \brief A horizontal plane at height z, equivalent to the default behaviour of the EEContactModel
+ *
+ * \tparam SCALAR the scalar type
+ */
+template <typename SCALAR>
+class FlatTerrain : public TerrainBase<SCALAR>
+{
+public:
+    typedef typename TerrainBase<SCALAR>::Vector3s Vector3s;
+
+    FlatTerrain(const SCALAR& z = SCALAR(0.0)) : z_(z) {}
+    virtual ~FlatTerrain() {}
+    FlatTerrain<SCALAR>* clone() const override { return new FlatTerrain<SCALAR>(*this); }
+    SCALAR height(const SCALAR& x, const SCALAR& y) const override { return z_; }
+    void query(const Vector3s& position, SCALAR& depth, Vector3s& normal) const override
+    {
+        depth = position(2) - z_;
+        normal << SCALAR(0.0), SCALAR(0.0), SCALAR(1.0);
+    }
+
+private:
+    SCALAR z_;  //!< height of the plane
+};
+
+}  // namespace rbd
+}  // namespace ct
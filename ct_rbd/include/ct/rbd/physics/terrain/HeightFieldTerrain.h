@@ -0,0 +1,420 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <cppad/cppad.hpp>
+
+#include "TerrainBase.h"
+
+namespace ct {
+namespace rbd {
+namespace internal {
+
+/*!
+ * \brief Immutable height-field data shared by all copies of a HeightFieldTerrain
+ *
+ * Vertices are stored in square tiles of TILE x TILE entries with heights and normals interleaved, such that the four
+ * corners of a cell are mostly located in the same, contiguous block of memory.
+ */
+class HeightFieldGrid
+{
+public:
+    static const size_t TILE = 8;  //!< tile edge length in vertices
+
+    //! a grid vertex with interleaved height and normal
+    struct Vertex
+    {
+        double h;
+        double nx;
+        double ny;
+        double nz;
+    };
+
+    HeightFieldGrid(const Eigen::MatrixXd& heights, double x0, double y0, double resolution)
+        : nx_(heights.rows()), ny_(heights.cols()), x0_(x0), y0_(y0), res_(resolution), invRes_(1.0 / resolution)
+    {
+        if (nx_ < 2 || ny_ < 2)
+            throw std::runtime_error("HeightFieldTerrain: grid needs at least 2x2 vertices.");
+        if (res_ <= 0.0)
+            throw std::runtime_error("HeightFieldTerrain: resolution needs to be positive.");
+
+        nTilesX_ = (nx_ + TILE - 1) / TILE;
+        nTilesY_ = (ny_ + TILE - 1) / TILE;
+        buildTiles(heights);
+    }
+
+    /*!
+     * \brief bilinear interpolation of the height and the (unnormalized) normal in a single cell
+     * @param x world x coordinate
+     * @param y world y coordinate
+     * @param value interpolated height, normal x, normal y and normal z
+     * @param dx partial derivatives of value w.r.t. x, not computed if nullptr
+     * @param dy partial derivatives of value w.r.t. y, not computed if nullptr
+     */
+    void lookup(double x, double y, double* value, double* dx = nullptr, double* dy = nullptr) const
+    {
+        // continuous grid coordinates, clamped to the grid
+        const double uRaw = (x - x0_) * invRes_;
+        const double vRaw = (y - y0_) * invRes_;
+        const double u = std::min(std::max(uRaw, 0.0), double(nx_ - 1));
+        const double v = std::min(std::max(vRaw, 0.0), double(ny_ - 1));
+
+        const size_t i = std::min(static_cast<size_t>(u), nx_ - 2);
+        const size_t j = std::min(static_cast<size_t>(v), ny_ - 2);
+        const double fu = u - i;
+        const double fv = v - j;
+
+        const double* v00 = &tiles_[index(i, j)].h;
+        const double* v10 = &tiles_[index(i + 1, j)].h;
+        const double* v01 = &tiles_[index(i, j + 1)].h;
+        const double* v11 = &tiles_[index(i + 1, j + 1)].h;
+
+        for (size_t k = 0; k < 4; k++)
+            value[k] = (1.0 - fu) * (1.0 - fv) * v00[k] + fu * (1.0 - fv) * v10[k] + (1.0 - fu) * fv * v01[k] +
+                       fu * fv * v11[k];
+
+        // the interpolation is constant in directions in which the query is clamped
+        if (dx)
+        {
+            const double scale = (uRaw < 0.0 || uRaw > double(nx_ - 1)) ? 0.0 : invRes_;
+            for (size_t k = 0; k < 4; k++)
+                dx[k] = scale * ((1.0 - fv) * (v10[k] - v00[k]) + fv * (v11[k] - v01[k]));
+        }
+        if (dy)
+        {
+            const double scale = (vRaw < 0.0 || vRaw > double(ny_ - 1)) ? 0.0 : invRes_;
+            for (size_t k = 0; k < 4; k++)
+                dy[k] = scale * ((1.0 - fu) * (v01[k] - v00[k]) + fu * (v11[k] - v10[k]));
+        }
+    }
+
+    //! access a vertex of the grid
+    const Vertex& vertex(size_t i, size_t j) const { return tiles_[index(i, j)]; }
+    size_t sizeX() const { return nx_; }
+    size_t sizeY() const { return ny_; }
+    double x0() const { return x0_; }
+    double y0() const { return y0_; }
+    double resolution() const { return res_; }
+private:
+    //! index of vertex (i, j) in the tiled storage
+    size_t index(size_t i, size_t j) const
+    {
+        return ((i / TILE) * nTilesY_ + (j / TILE)) * TILE * TILE + (i % TILE) * TILE + (j % TILE);
+    }
+
+    //! precomputes normals and fills the tiled storage
+    void buildTiles(const Eigen::MatrixXd& heights)
+    {
+        tiles_.assign(nTilesX_ * nTilesY_ * TILE * TILE, Vertex{0.0, 0.0, 0.0, 1.0});
+
+        for (size_t i = 0; i < nx_; i++)
+        {
+            for (size_t j = 0; j < ny_; j++)
+            {
+                // central differences, one-sided at the border
+                size_t ip = std::min(i + 1, nx_ - 1), im = (i > 0) ? i - 1 : 0;
+                size_t jp = std::min(j + 1, ny_ - 1), jm = (j > 0) ? j - 1 : 0;
+                double dhdx = (heights(ip, j) - heights(im, j)) / (res_ * (ip - im));
+                double dhdy = (heights(i, jp) - heights(i, jm)) / (res_ * (jp - jm));
+                double norm = std::sqrt(dhdx * dhdx + dhdy * dhdy + 1.0);
+
+                tiles_[index(i, j)] = Vertex{heights(i, j), -dhdx / norm, -dhdy / norm, 1.0 / norm};
+            }
+        }
+    }
+
+    size_t nx_;       //!< number of vertices in x
+    size_t ny_;       //!< number of vertices in y
+    double x0_;       //!< world x of the first vertex
+    double y0_;       //!< world y of the first vertex
+    double res_;      //!< grid spacing
+    double invRes_;   //!< inverse grid spacing
+    size_t nTilesX_;  //!< number of tiles in x
+    size_t nTilesY_;  //!< number of tiles in y
+
+    std::vector<Vertex> tiles_;  //!< tiled vertex storage
+};
+
+/*!
+ * \brief CppAD atomic function for the height-field lookup, y = (h, n_x, n_y, n_z) as a function of x = (x, y)
+ *
+ * The lookup is evaluated on the grid whenever the tape is evaluated, such that a tape recorded once is valid
+ * everywhere and a query costs a single cell lookup. Only first order forward and reverse mode are supported.
+ */
+class HeightFieldAtomic : public CppAD::atomic_base<double>
+{
+public:
+    HeightFieldAtomic(const std::shared_ptr<const HeightFieldGrid>& grid)
+        : CppAD::atomic_base<double>("HeightFieldTerrain"), grid_(grid)
+    {
+    }
+
+    bool forward(size_t p,
+        size_t q,
+        const CppAD::vector<bool>& vx,
+        CppAD::vector<bool>& vy,
+        const CppAD::vector<double>& tx,
+        CppAD::vector<double>& ty) override
+    {
+        if (q > 1)
+            return false;
+
+        if (vx.size() > 0)
+            for (size_t k = 0; k < 4; k++)
+                vy[k] = vx[0] || vx[1];
+
+        double value[4], dx[4], dy[4];
+        grid_->lookup(tx[0], tx[q + 1], value, dx, dy);
+
+        for (size_t k = 0; k < 4; k++)
+        {
+            if (p == 0)
+                ty[k * (q + 1)] = value[k];
+            if (q == 1)
+                ty[k * (q + 1) + 1] = dx[k] * tx[1] + dy[k] * tx[q + 2];
+        }
+        return true;
+    }
+
+    bool reverse(size_t q,
+        const CppAD::vector<double>& tx,
+        const CppAD::vector<double>& ty,
+        CppAD::vector<double>& px,
+        const CppAD::vector<double>& py) override
+    {
+        if (q > 0)
+            return false;
+
+        double value[4], dx[4], dy[4];
+        grid_->lookup(tx[0], tx[1], value, dx, dy);
+
+        px[0] = 0.0;
+        px[1] = 0.0;
+        for (size_t k = 0; k < 4; k++)
+        {
+            px[0] += py[k] * dx[k];
+            px[1] += py[k] * dy[k];
+        }
+        return true;
+    }
+
+    //! every output depends on both inputs
+    bool for_sparse_jac(size_t q, const CppAD::vector<bool>& r, CppAD::vector<bool>& s) override
+    {
+        for (size_t l = 0; l < q; l++)
+            for (size_t k = 0; k < 4; k++)
+                s[k * q + l] = r[l] || r[q + l];
+        return true;
+    }
+
+    bool rev_sparse_jac(size_t q, const CppAD::vector<bool>& rt, CppAD::vector<bool>& st) override
+    {
+        for (size_t l = 0; l < q; l++)
+        {
+            bool any = false;
+            for (size_t k = 0; k < 4; k++)
+                any |= rt[k * q + l];
+            st[l] = any;
+            st[q + l] = any;
+        }
+        return true;
+    }
+
+    bool rev_sparse_hes(const CppAD::vector<bool>& vx,
+        const CppAD::vector<bool>& s,
+        CppAD::vector<bool>& t,
+        size_t q,
+        const CppAD::vector<bool>& r,
+        const CppAD::vector<bool>& u,
+        CppAD::vector<bool>& v) override
+    {
+        bool anyS = false;
+        for (size_t k = 0; k < 4; k++)
+            anyS |= s[k];
+        t[0] = anyS;
+        t[1] = anyS;
+
+        for (size_t l = 0; l < q; l++)
+        {
+            bool any = anyS && (r[l] || r[q + l]);
+            for (size_t k = 0; k < 4; k++)
+                any |= u[k * q + l];
+            v[l] = any;
+            v[q + l] = any;
+        }
+        return true;
+    }
+
+private:
+    std::shared_ptr<const HeightFieldGrid> grid_;
+};
+
+}  // namespace internal
+
+/*!
+ * \brief A 2.5D height-field terrain with bilinear interpolation
+ *
+ * The terrain is defined by heights on a regular grid with vertex (i, j) located at
+ * \f$ (x_0 + i \cdot res, y_0 + j \cdot res) \f$. Vertex normals are precomputed by central differences and
+ * interpolated bilinearly, heights are interpolated bilinearly. Queries outside the grid are clamped to the border.
+ * The grid is shared by all copies of a terrain.
+ *
+ * Depending on the scalar type, a query is evaluated as follows
+ * - floating point scalars look up a single cell.
+ * - CppAD::AD<double> records a CppAD atomic function which looks up a single cell whenever the tape is evaluated.
+ *   The tape is valid as long as one copy of the terrain is alive and supports first order derivatives.
+ * - for other Auto-Diff scalars, in particular codegen, the cell cannot be looked up at recording time. The bilinear
+ *   interpolation is expressed as a tensor product of tent functions, \f$ h(x,y) = w_x(x)^T H w_y(y) \f$, which is
+ *   exact and branch-free but scales with the grid size. Keep such height fields restricted to the relevant region.
+ *
+ * \tparam SCALAR the scalar type
+ */
+template <typename SCALAR>
+class HeightFieldTerrain : public TerrainBase<SCALAR>
+{
+public:
+    typedef typename TerrainBase<SCALAR>::Vector3s Vector3s;
+    typedef internal::HeightFieldGrid::Vertex Vertex;
+
+    /*!
+     * \brief Constructor
+     * @param heights grid heights, heights(i, j) is located at (x0 + i * resolution, y0 + j * resolution)
+     * @param x0 world x coordinate of the first vertex
+     * @param y0 world y coordinate of the first vertex
+     * @param resolution grid spacing in x and y
+     */
+    HeightFieldTerrain(const Eigen::MatrixXd& heights, double x0, double y0, double resolution)
+        : grid_(std::make_shared<const internal::HeightFieldGrid>(heights, x0, y0, resolution)),
+          atomic_(std::is_same<SCALAR, CppAD::AD<double>>::value ? std::make_shared<internal::HeightFieldAtomic>(grid_)
+                                                                  : nullptr)
+    {
+    }
+
+    virtual ~HeightFieldTerrain() {}
+    HeightFieldTerrain<SCALAR>* clone() const override { return new HeightFieldTerrain<SCALAR>(*this); }
+    SCALAR height(const SCALAR& x, const SCALAR& y) const override
+    {
+        SCALAR h;
+        Vector3s normal;
+        interpolate(x, y, h, normal);
+        return h;
+    }
+
+    /*!
+     * \brief computes penetration depth and surface normal
+     *
+     * The depth is approximated as the vertical distance to the surface projected onto the local normal.
+     */
+    void query(const Vector3s& position, SCALAR& depth, Vector3s& normal) const override
+    {
+        SCALAR h;
+        interpolate(position(0), position(1), h, normal);
+        depth = (position(2) - h) * normal(2);
+    }
+
+    //! access a vertex of the grid
+    const Vertex& vertex(size_t i, size_t j) const { return grid_->vertex(i, j); }
+    size_t sizeX() const { return grid_->sizeX(); }
+    size_t sizeY() const { return grid_->sizeY(); }
+    double resolution() const { return grid_->resolution(); }
+private:
+    template <typename S = SCALAR>
+    typename std::enable_if<std::is_arithmetic<S>::value, void>::type interpolate(const SCALAR& x,
+        const SCALAR& y,
+        SCALAR& h,
+        Vector3s& normal) const
+    {
+        double value[4];
+        grid_->lookup(double(x), double(y), value);
+
+        h = value[0];
+        normal << value[1], value[2], value[3];
+        normal /= normal.norm();
+    }
+
+    template <typename S = SCALAR>
+    typename std::enable_if<std::is_same<S, CppAD::AD<double>>::value, void>::type interpolate(const SCALAR& x,
+        const SCALAR& y,
+        SCALAR& h,
+        Vector3s& normal) const
+    {
+        CppAD::vector<SCALAR> ax(2), ay(4);
+        ax[0] = x;
+        ax[1] = y;
+        (*atomic_)(ax, ay);
+
+        h = ay[0];
+        normal << ay[1], ay[2], ay[3];
+        normal /= CppAD::sqrt(normal.squaredNorm());
+    }
+
+    template <typename S = SCALAR>
+    typename std::enable_if<!std::is_arithmetic<S>::value && !std::is_same<S, CppAD::AD<double>>::value,
+        void>::type
+    interpolate(const SCALAR& x, const SCALAR& y, SCALAR& h, Vector3s& normal) const
+    {
+        const size_t nx = grid_->sizeX();
+        const size_t ny = grid_->sizeY();
+
+        // continuous grid coordinates, clamped to the grid without branching
+        SCALAR u = clamp((x - SCALAR(grid_->x0())) / SCALAR(grid_->resolution()), SCALAR(double(nx - 1)));
+        SCALAR v = clamp((y - SCALAR(grid_->y0())) / SCALAR(grid_->resolution()), SCALAR(double(ny - 1)));
+
+        std::vector<SCALAR> wx(nx);
+        std::vector<SCALAR> wy(ny);
+        for (size_t i = 0; i < nx; i++)
+            wx[i] = tent(u - SCALAR(double(i)));
+        for (size_t j = 0; j < ny; j++)
+            wy[j] = tent(v - SCALAR(double(j)));
+
+        h = SCALAR(0.0);
+        normal.setZero();
+        for (size_t i = 0; i < nx; i++)
+        {
+            SCALAR hj(0.0);
+            Vector3s nj = Vector3s::Zero();
+            for (size_t j = 0; j < ny; j++)
+            {
+                const Vertex& vij = grid_->vertex(i, j);
+                hj += wy[j] * vij.h;
+                nj(0) += wy[j] * vij.nx;
+                nj(1) += wy[j] * vij.ny;
+                nj(2) += wy[j] * vij.nz;
+            }
+            h += wx[i] * hj;
+            normal += wx[i] * nj;
+        }
+
+        normal /= CppAD::sqrt(normal.squaredNorm());
+    }
+
+    //! hat function \f$ \max(0, 1 - |x|) \f$ for Auto-Diff types
+    static SCALAR tent(const SCALAR& x)
+    {
+        SCALAR w = SCALAR(1.0) - CppAD::abs(x);
+        return CppAD::CondExpGt(w, SCALAR(0.0), w, SCALAR(0.0));
+    }
+
+    //! clamps x to [0, upper] for Auto-Diff types
+    static SCALAR clamp(const SCALAR& x, const SCALAR& upper)
+    {
+        SCALAR lower = CppAD::CondExpLt(x, SCALAR(0.0), SCALAR(0.0), x);
+        return CppAD::CondExpGt(lower, upper, upper, lower);
+    }
+
+    std::shared_ptr<const internal::HeightFieldGrid> grid_;  //!< grid data, shared between copies
+    std::shared_ptr<internal::HeightFieldAtomic> atomic_;    //!< lookup for CppAD::AD<double>, shared between copies
+};
+
+}  // namespace rbd
+}  // namespace ct
@@ -0,0 +1,53 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <Eigen/Core>
+
+namespace ct {
+namespace rbd {
+
+/*!
+ * \brief Interface for terrain representations queried by the EEContactModel
+ *
+ * A terrain answers for a point expressed in world coordinates the signed penetration depth along the
+ * surface normal (negative below the surface) and the surface normal at the projection of the point.
+ * Implementations need to be branch-free in SCALAR if they are to be used with Auto-Diff codegen.
+ *
+ * \tparam SCALAR the scalar type
+ */
+template <typename SCALAR>
+class TerrainBase
+{
+public:
+    typedef std::shared_ptr<TerrainBase<SCALAR>> Ptr;
+    typedef Eigen::Matrix<SCALAR, 3, 1> Vector3s;
+
+    TerrainBase() {}
+    virtual ~TerrainBase() {}
+    virtual TerrainBase<SCALAR>* clone() const = 0;
+
+    /*!
+     * \brief height of the terrain at a given position in the world x-y plane
+     * @param x world x coordinate
+     * @param y world y coordinate
+     * @return terrain height (world z coordinate)
+     */
+    virtual SCALAR height(const SCALAR& x, const SCALAR& y) const = 0;
+
+    /*!
+     * \brief computes penetration depth and surface normal for a point
+     * @param position point expressed in world coordinates
+     * @param depth signed distance along the normal, negative if the point is below the surface
+     * @param normal unit surface normal expressed in world coordinates
+     */
+    virtual void query(const Vector3s& position, SCALAR& depth, Vector3s& normal) const = 0;
+};
+
+}  // namespace rbd
+}  // namespace ct
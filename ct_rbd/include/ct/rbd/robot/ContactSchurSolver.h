@@ -0,0 +1,369 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <Eigen/Core>
+
+namespace ct {
+namespace rbd {
+
+/**
+ * @brief Solves the contact constrained forward dynamics of a floating base robot
+ *
+ * Solves the equations
+ *      M * qdd = tau + Jc^T * lambda
+ *      Jc * qdd = gamma
+ * for the generalized accelerations qdd and the contact forces lambda, where Jc holds the rows of the end-effectors
+ * in contact.
+ *
+ * The joint space inertia matrix M is factorized once per call as M = L^T D L, where L is unit lower triangular.
+ * The factorization exploits the branch induced sparsity of M (Featherstone, RBDA, ch. 6.5): L has the same sparsity
+ * pattern as M and only entries (i, j) with j being an ancestor of i are touched. The contact forces are then obtained
+ * from the contact space Schur complement Jc M^-1 Jc^T, which is of size 3*nContacts only.
+ *
+ * Every contact configuration (mode) is handled by its own kernel, in which all matrices have compile-time sizes.
+ * The kernels are selected via a lookup table. For robots with more than MAX_FIXED_SIZE_EE end-effectors, one kernel
+ * with dynamic sizes is used for all modes to limit the number of instantiations.
+ *
+ * The algorithm is free of branches on the scalar values, hence it can be used with auto-diff and codegen scalars.
+ *
+ * \tparam SCALAR the scalar type
+ * \tparam NDOF number of degrees of freedom, including the 6 base coordinates
+ * \tparam NEE number of end-effectors
+ */
+template <typename SCALAR, size_t NDOF, size_t NEE>
+class ContactSchurSolver
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static const size_t NMODES = size_t(1) << NEE;
+    static const size_t MAX_FIXED_SIZE_EE = 4;
+    static const size_t NFIXED_SIZE_MODES = (NEE <= MAX_FIXED_SIZE_EE) ? NMODES : 0;
+
+    typedef std::array<int, NDOF> parent_array_t;
+    typedef Eigen::Matrix<SCALAR, NDOF, NDOF> inertia_matrix_t;
+    typedef Eigen::Matrix<SCALAR, NDOF, 1> g_coordinate_vector_t;
+    typedef Eigen::Matrix<SCALAR, 3 * NEE, NDOF> jacobian_t;
+    typedef Eigen::Matrix<SCALAR, 3 * NEE, 1> contact_vector_t;
+
+    /**
+     * @brief Constructor
+     * @param parents the parent of every degree of freedom in the kinematic tree, -1 for the root. Each parent index
+     *                has to be smaller than the index of its child.
+     */
+    ContactSchurSolver(const parent_array_t& parents = chainParents())
+        : parents_(parents), kernels_(makeKernelTable(std::make_index_sequence<NFIXED_SIZE_MODES>()))
+    {
+        for (size_t i = 0; i < NDOF; i++)
+            if (parents_[i] >= static_cast<int>(i))
+                throw std::runtime_error("ContactSchurSolver: parents have to be numbered before their children");
+    }
+
+    //! parent array for a chain, i.e. a dense inertia matrix
+    static parent_array_t chainParents()
+    {
+        parent_array_t parents;
+        for (size_t i = 0; i < NDOF; i++)
+            parents[i] = static_cast<int>(i) - 1;
+        return parents;
+    }
+
+    /**
+     * @brief parent array of a floating base robot derived from the end-effector chains
+     *
+     * The 6 base coordinates form a chain. Within the kinematic chain of an end-effector, each joint is the child of
+     * the previous one. A joint starts a new branch at the base only where the chain of one end-effector ends and the
+     * chain of another one begins. Joints which cannot be attributed are conservatively treated as children of their
+     * predecessor, which is always correct but exploits less sparsity.
+     *
+     * \tparam UTILS the robcogen utilities of the robot, providing the first and last joint of every end-effector
+     */
+    template <class UTILS>
+    static parent_array_t floatingBaseParents()
+    {
+        parent_array_t parents = chainParents();
+        for (size_t j = 1; j < NDOF - 6; j++)
+        {
+            bool inside = false, starts = false, ends = false;
+            for (size_t ee = 0; ee < static_cast<size_t>(UTILS::N_EE); ee++)
+            {
+                const size_t first = UTILS::eeIdToFirstJointId(ee);
+                const size_t last = UTILS::eeIdToLastJointId(ee);
+                inside = inside || (first < j && j <= last);
+                starts = starts || (first == j);
+                ends = ends || (last == j - 1);
+            }
+            if (!inside && starts && ends)
+                parents[6 + j] = 5;
+        }
+        return parents;
+    }
+
+    //! the parent array
+    const parent_array_t& parents() const { return parents_; }
+    /**
+     * @brief factorizes the joint space inertia matrix
+     *
+     * Only the lower triangular part of M is read.
+     */
+    void factorize(const inertia_matrix_t& M)
+    {
+        LD_ = M;
+        for (int k = NDOF - 1; k >= 0; k--)
+        {
+            for (int i = parents_[k]; i >= 0; i = parents_[i])
+            {
+                const SCALAR a = LD_(k, i) / LD_(k, k);
+                for (int j = i; j >= 0; j = parents_[j])
+                    LD_(i, j) -= a * LD_(k, j);
+                LD_(k, i) = a;
+            }
+        }
+        for (size_t i = 0; i < NDOF; i++)
+            Dinv_(i) = SCALAR(1.0) / LD_(i, i);
+    }
+
+    //! computes M^-1 * b in place, requires a previous call to factorize()
+    template <typename Derived>
+    void solveInPlace(Eigen::MatrixBase<Derived>& b) const
+    {
+        applyLTinv(b);
+        b = Dinv_.asDiagonal() * b;
+        applyLinv(b);
+    }
+
+    /**
+     * @brief solves for the accelerations and contact forces, requires a previous call to factorize()
+     *
+     * @param mode      the contact configuration, bit i is set if end-effector i is in contact
+     * @param J         the stacked Jacobians of all end-effectors, only the rows in contact are read
+     * @param gamma     the desired accelerations of all end-effectors, only the rows in contact are read
+     * @param tau       the generalized forces
+     * @param qdd       the generalized accelerations
+     * @param lambda    the contact forces of all end-effectors, zero for end-effectors not in contact
+     */
+    void solve(size_t mode,
+        const jacobian_t& J,
+        const contact_vector_t& gamma,
+        const g_coordinate_vector_t& tau,
+        g_coordinate_vector_t& qdd,
+        contact_vector_t& lambda) const
+    {
+        if (mode >= NMODES)
+            throw std::runtime_error("ContactSchurSolver: invalid contact mode");
+
+        if (NFIXED_SIZE_MODES > 0)
+            (this->*kernels_[mode])(J, gamma, tau, qdd, lambda);
+        else
+            solveDynamicSize(mode, J, gamma, tau, qdd, lambda);
+    }
+
+private:
+    typedef void (ContactSchurSolver::*kernel_t)(const jacobian_t&,
+        const contact_vector_t&,
+        const g_coordinate_vector_t&,
+        g_coordinate_vector_t&,
+        contact_vector_t&) const;
+
+    static constexpr size_t nContacts(size_t mode) { return mode == 0 ? 0 : (mode & 1) + nContacts(mode >> 1); }
+    template <size_t... MODES>
+    static std::array<kernel_t, sizeof...(MODES)> makeKernelTable(std::index_sequence<MODES...>)
+    {
+        return {{&ContactSchurSolver::template solveFixedSize<MODES>...}};
+    }
+
+    //! the kernel of a single contact configuration
+    template <size_t MODE>
+    void solveFixedSize(const jacobian_t& J,
+        const contact_vector_t& gamma,
+        const g_coordinate_vector_t& tau,
+        g_coordinate_vector_t& qdd,
+        contact_vector_t& lambda) const
+    {
+        solveMode(std::integral_constant<size_t, MODE>(), J, gamma, tau, qdd, lambda);
+    }
+
+    //! no contacts, unconstrained forward dynamics
+    void solveMode(std::integral_constant<size_t, 0>,
+        const jacobian_t& J,
+        const contact_vector_t& gamma,
+        const g_coordinate_vector_t& tau,
+        g_coordinate_vector_t& qdd,
+        contact_vector_t& lambda) const
+    {
+        qdd = tau;
+        solveInPlace(qdd);
+        lambda.setZero();
+    }
+
+    template <size_t MODE>
+    void solveMode(std::integral_constant<size_t, MODE>,
+        const jacobian_t& J,
+        const contact_vector_t& gamma,
+        const g_coordinate_vector_t& tau,
+        g_coordinate_vector_t& qdd,
+        contact_vector_t& lambda) const
+    {
+        static const int C = 3 * nContacts(MODE);
+
+        Eigen::Matrix<SCALAR, C, NDOF> Jc;
+        Eigen::Matrix<SCALAR, C, 1> gammac, lambdac;
+        int row = 0;
+        for (size_t ee = 0; ee < NEE; ee++)
+        {
+            if (MODE & (size_t(1) << ee))
+            {
+                Jc.template middleRows<3>(row) = J.template block<3, NDOF>(3 * ee, 0);
+                gammac.template segment<3>(row) = gamma.template segment<3>(3 * ee);
+                row += 3;
+            }
+        }
+
+        solveContact(Jc, gammac, tau, qdd, lambdac);
+
+        lambda.setZero();
+        row = 0;
+        for (size_t ee = 0; ee < NEE; ee++)
+        {
+            if (MODE & (size_t(1) << ee))
+            {
+                lambda.template segment<3>(3 * ee) = lambdac.template segment<3>(row);
+                row += 3;
+            }
+        }
+    }
+
+    //! the kernel for all contact configurations if there are too many end-effectors for fixed-size kernels
+    void solveDynamicSize(size_t mode,
+        const jacobian_t& J,
+        const contact_vector_t& gamma,
+        const g_coordinate_vector_t& tau,
+        g_coordinate_vector_t& qdd,
+        contact_vector_t& lambda) const
+    {
+        const int C = 3 * nContacts(mode);
+
+        Eigen::Matrix<SCALAR, Eigen::Dynamic, NDOF> Jc(C, NDOF);
+        Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> gammac(C), lambdac(C);
+        int row = 0;
+        for (size_t ee = 0; ee < NEE; ee++)
+        {
+            if (mode & (size_t(1) << ee))
+            {
+                Jc.template middleRows<3>(row) = J.template block<3, NDOF>(3 * ee, 0);
+                gammac.template segment<3>(row) = gamma.template segment<3>(3 * ee);
+                row += 3;
+            }
+        }
+
+        solveContact(Jc, gammac, tau, qdd, lambdac);
+
+        lambda.setZero();
+        row = 0;
+        for (size_t ee = 0; ee < NEE; ee++)
+        {
+            if (mode & (size_t(1) << ee))
+            {
+                lambda.template segment<3>(3 * ee) = lambdac.template segment<3>(row);
+                row += 3;
+            }
+        }
+    }
+
+    /**
+     * @brief the actual solve for the contacts in Jc
+     *
+     * With W = L^-T Jc^T and z = L^-T tau, the contact space Schur complement is Lambda = W^T D^-1 W and
+     *      lambda = Lambda^-1 (gamma - W^T D^-1 z)
+     *      qdd = L^-1 D^-1 (z + W lambda)
+     */
+    template <int C>
+    void solveContact(const Eigen::Matrix<SCALAR, C, NDOF>& Jc,
+        const Eigen::Matrix<SCALAR, C, 1>& gamma,
+        const g_coordinate_vector_t& tau,
+        g_coordinate_vector_t& qdd,
+        Eigen::Matrix<SCALAR, C, 1>& lambda) const
+    {
+        Eigen::Matrix<SCALAR, NDOF, C> W = Jc.transpose();
+        applyLTinv(W);
+        qdd = tau;
+        applyLTinv(qdd);
+
+        const Eigen::Matrix<SCALAR, NDOF, C> DinvW = Dinv_.asDiagonal() * W;
+        Eigen::Matrix<SCALAR, C, C> schur = W.transpose() * DinvW;
+        lambda = gamma - DinvW.transpose() * qdd;
+        ldltSolveInPlace(schur, lambda);
+
+        qdd += W * lambda;
+        qdd = Dinv_.asDiagonal() * qdd;
+        applyLinv(qdd);
+    }
+
+    //! b = L^-T b
+    template <typename Derived>
+    void applyLTinv(Eigen::MatrixBase<Derived>& b) const
+    {
+        for (int i = NDOF - 1; i >= 0; i--)
+            for (int j = parents_[i]; j >= 0; j = parents_[j])
+                b.row(j) -= LD_(i, j) * b.row(i);
+    }
+
+    //! b = L^-1 b
+    template <typename Derived>
+    void applyLinv(Eigen::MatrixBase<Derived>& b) const
+    {
+        for (int i = 0; i < static_cast<int>(NDOF); i++)
+            for (int j = parents_[i]; j >= 0; j = parents_[j])
+                b.row(i) -= LD_(i, j) * b.row(j);
+    }
+
+    /**
+     * @brief solves A x = b in place for a small symmetric positive definite matrix A
+     *
+     * A is overwritten by its LDLT factorization. Does not pivot, such that the sequence of operations does not
+     * depend on the values (see also core::LDLTsolve).
+     */
+    template <int C>
+    static void ldltSolveInPlace(Eigen::Matrix<SCALAR, C, C>& A, Eigen::Matrix<SCALAR, C, 1>& b)
+    {
+        const int n = A.rows();
+        for (int j = 0; j < n; j++)
+        {
+            for (int k = 0; k < j; k++)
+                A(j, j) -= A(j, k) * A(j, k) * A(k, k);
+            for (int i = j + 1; i < n; i++)
+            {
+                for (int k = 0; k < j; k++)
+                    A(i, j) -= A(i, k) * A(j, k) * A(k, k);
+                A(i, j) /= A(j, j);
+            }
+        }
+        for (int i = 0; i < n; i++)
+            for (int k = 0; k < i; k++)
+                b(i) -= A(i, k) * b(k);
+        for (int i = n - 1; i >= 0; i--)
+        {
+            b(i) /= A(i, i);
+            for (int k = i + 1; k < n; k++)
+                b(i) -= A(k, i) * b(k);
+        }
+    }
+
+    parent_array_t parents_;
+    std::array<kernel_t, NFIXED_SIZE_MODES> kernels_;
+
+    inertia_matrix_t LD_;         /*!< unit lower triangular L below and D on the diagonal */
+    g_coordinate_vector_t Dinv_;  /*!< the inverse of D */
+};
+
+}  // namespace rbd
+}  // namespace ct
@@ -13,6 +13,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "kinematics/EndEffector.h"
 #include "kinematics/FloatingBaseTransforms.h"
 #include "kinematics/InverseKinematicsBase.h"
+#include "kinematics/KinematicsCache.h"
 
 namespace ct {
 namespace rbd {
@@ -66,6 +67,7 @@ public:
     using EEForce = SpatialForceVector<SCALAR>;
     using EEForceLinear = Vector3Tpl;
     using JointState_t = JointState<NJOINTS, SCALAR>;
+    using KinematicsCache_t = KinematicsCache<SCALAR, NJOINTS, N_EE>;
 
     void initEndeffectors(std::array<EndEffector<NJOINTS, SCALAR>, NUM_EE>& endeffectors)
     {
@@ -73,6 +75,7 @@ public:
         {
             endeffectors[i].setLinkId(ROBCOGEN::UTILS::eeIdToLinkId(i));
         }
+        invalidateCache();
     }
 
     /**
@@ -132,6 +135,65 @@ public:
         return rbdState.base().pose().rotateBaseToInertia(eeVelocityBase);
     }
 
+    /*!
+     * \brief Computes all end-effector positions, Jacobians and link force transforms for a joint configuration
+     *
+     * For floating point types, the cache is only recomputed if the joint configuration or the link of an
+     * end-effector changed. Auto-Diff types cannot be compared at recording time, hence the cache is always
+     * recomputed for them.
+     * @param jointPosition current robot joint positions
+     * @return the updated cache
+     */
+    const KinematicsCache_t& updateCache(const typename JointState_t::Position& jointPosition)
+    {
+        if (isCacheUpToDate(jointPosition))
+            return cache_;
+
+        for (size_t i = 0; i < NUM_EE; i++)
+        {
+            cache_.B_x_EE[i] = robcogen().getEEPositionInBase(i, jointPosition).toImplementation();
+            cache_.B_J_EE[i] = robcogen().getJacobianBaseEEbyId(i, jointPosition);
+            cache_.linkId[i] = getEndEffector(i).getLinkId();
+            cache_.L_X_B[i] = robcogen().getForceTransformLinkBaseById(cache_.linkId[i], jointPosition);
+        }
+        cache_.jointPosition = jointPosition;
+        cache_.valid = true;
+
+        return cache_;
+    }
+
+    //! forces recomputation of the cache in the next call to updateCache()
+    void invalidateCache() { cache_.valid = false; }
+    //! the cache of the last call to updateCache()
+    const KinematicsCache_t& cache() const { return cache_; }
+    //! end-effector velocity in base coordinates, using the positions and Jacobians from the cache
+    Velocity3Tpl getEEVelocityInBase(size_t eeId,
+        const RBDState<NJOINTS, SCALAR>& rbdState,
+        const KinematicsCache_t& cache) const
+    {
+        Velocity3Tpl eeVelocityBase;
+        eeVelocityBase.toImplementation() =
+            (cache.B_J_EE[eeId] * rbdState.jointVelocities()).template bottomRows<3>() +
+            rbdState.base().velocities().getTranslationalVelocity().toImplementation() +
+            rbdState.base().velocities().getRotationalVelocity().toImplementation().cross(cache.B_x_EE[eeId]);
+
+        return eeVelocityBase;
+    }
+
+    //! end-effector velocity in world coordinates, using the positions and Jacobians from the cache
+    Velocity3Tpl getEEVelocityInWorld(size_t eeId,
+        const RBDState<NJOINTS, SCALAR>& rbdState,
+        const KinematicsCache_t& cache) const
+    {
+        return rbdState.base().pose().rotateBaseToInertia(getEEVelocityInBase(eeId, rbdState, cache));
+    }
+
+    //! end-effector position in world coordinates, using the positions from the cache
+    Position3Tpl getEEPositionInWorld(size_t eeID, const RigidBodyPoseTpl& basePose, const KinematicsCache_t& cache) const
+    {
+        return basePose.position() + basePose.template rotateBaseToInertia(Position3Tpl(cache.B_x_EE[eeID]));
+    }
+
     /*!
      * Computes the forward kinematics for the end-effector position and expresses the end-effector position in robot
      * base coordinates.
@@ -263,6 +325,27 @@ public:
         return mapForceFromWorldToLink(eeForce, basePose, jointPosition, eeId);
     }
 
+    /**
+     * \brief Transforms a force applied at an end-effector and expressed in the world into the link frame the EE is
+     * rigidly connected to, using the end-effector position and force transform from the cache
+     * @param W_force Force expressed in world coordinates
+     * @param basePose Pose of the base (in the world)
+     * @param eeId ID of the end-effector
+     * @param cache kinematics cache of the current joint configuration
+     * @return
+     */
+    EEForce mapForceFromWorldToLink3d(const Vector3Tpl& W_force,
+        const RigidBodyPoseTpl& basePose,
+        size_t eeId,
+        const KinematicsCache_t& cache) const
+    {
+        EEForce B_force;
+        B_force.force() = basePose.template rotateInertiaToBase<Vector3Tpl>(W_force);
+        B_force.torque() = cache.B_x_EE[eeId].cross(B_force.force());
+
+        return EEForce(cache.L_X_B[eeId] * B_force);
+    }
+
     /**
      * \brief Transforms a force applied at an end-effector and expressed in the world into the link frame the EE is
      * rigidly connected to.
@@ -359,9 +442,32 @@ public:
 
     RBD& robcogen() { return *rbdContainer_; }
 private:
+    template <typename S = SCALAR>
+    typename std::enable_if<std::is_arithmetic<S>::value, bool>::type isCacheUpToDate(
+        const typename JointState_t::Position& jointPosition)
+    {
+        if (!cache_.valid || cache_.jointPosition != jointPosition)
+            return false;
+
+        // end-effectors are mutable through getEndEffector()
+        for (size_t i = 0; i < NUM_EE; i++)
+            if (cache_.linkId[i] != endEffectors_[i].getLinkId())
+                return false;
+
+        return true;
+    }
+
+    template <typename S = SCALAR>
+    typename std::enable_if<!std::is_arithmetic<S>::value, bool>::type isCacheUpToDate(
+        const typename JointState_t::Position& jointPosition)
+    {
+        return false;
+    }
+
     std::shared_ptr<RBD> rbdContainer_;
     std::array<EndEffector<NJOINTS, SCALAR>, N_EE> endEffectors_;
     FloatingBaseTransforms<RBD> floatingBaseTransforms_;
+    KinematicsCache_t cache_;
 
     std::unordered_map<size_t, std::shared_ptr<InverseKinematicsBase<NJOINTS, SCALAR>>> ikSolvers_;
 };
@@ -5,6 +5,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
+#include "ContactSchurSolver.h"
 #include "jacobian/ConstraintJacobian.h"
 #include "kinematics/RBDDataMap.h"
 #include "Kinematics.h"
@@ -39,6 +40,8 @@ public:
     typedef Eigen::Matrix<Scalar, 6, 1> ForceVector_t;
     typedef Eigen::Matrix<Scalar, CONTROL_DIM, NDOF> selection_matrix_t;
 
+    typedef ContactSchurSolver<Scalar, NDOF, NEE> ContactSolver_t;
+
     typedef RBDDataMap<Eigen::Vector3d, NEE> EE_contact_forces_t;
     typedef RBDDataMap<bool, NEE> EE_in_contact_t;
 
@@ -90,6 +93,17 @@ public:
         qdd.joints().setAcceleration(qddlambda_.template segment<NJOINTS>(6));
     }
 
+    /**
+	 * @brief Reference implementation of ProjectedForwardDynamics() which assembles and solves the full KKT system
+	 * of size NDOF + 3 * number of contacts, used for verification
+	 */
+    void ProjectedForwardDynamicsKKT(const RBDState_t& x, const control_vector_t& u, RBDAcceleration_t& qdd)
+    {
+        ProjectedForwardDynamicsKKTCommon(x, u);
+        qdd.base().fromVector6d(qddlambda_.template segment<6>(0));
+        qdd.joints().setAcceleration(qddlambda_.template segment<NJOINTS>(6));
+    }
+
     /// @brief compute contact forces from last dynamics call
     void getContactForcesInBase(EE_contact_forces_t& lambda)
     {
@@ -153,9 +167,14 @@ private:
      * @brief Simultaniously solves the equations
      *      M*qdd + h = St*tau + Jct*lambda
      *      Jc*qdd + dJcdt*qd + omega x v = 0  (No acceleration of the feet)
+     *
+     *      using the contact space Schur complement, see ContactSchurSolver
      */
     void ProjectedForwardDynamicsCommon(const RBDState_t& x, const control_vector_t& u);
 
+    /// @brief solves the same equations as ProjectedForwardDynamicsCommon() as one dense KKT system
+    void ProjectedForwardDynamicsKKTCommon(const RBDState_t& x, const control_vector_t& u);
+
     void ResetJacobianStructure();
 
     void setSizes();
@@ -166,6 +185,8 @@ private:
 
     size_t neec_ = 0; /*!< The number of EE in contact */
 
+    size_t contactMode_ = 0; /*!< The contact configuration as bit mask, bit i is set if EE i is in contact */
+
     inertia_matrix_t M_;      /*!< The inertia matrix */
     selection_matrix_t S_;    /*!< The selection matrix */
     g_coordinate_vector_t f_; /*!< The input force*/
@@ -182,12 +203,19 @@ private:
 
     inertia_matrix_t P_; /*!< The Projector */
     Eigen::JacobiSVD<MatrixXs> svd_;
+
+    ContactSolver_t contactSolver_;                     /*!< Schur complement solver with per-mode kernels */
+    typename ContactSolver_t::contact_vector_t gamma_;  /*!< The desired accelerations of all EE */
+    typename ContactSolver_t::contact_vector_t lambda_; /*!< The contact forces of all EE */
+    g_coordinate_vector_t qdd_;                         /*!< The generalized accelerations */
 };
 
 template <class RBD, size_t NEE>
 ProjectedDynamics<RBD, NEE>::ProjectedDynamics(const std::shared_ptr<Kinematics<RBD, NEE>> kyn,
     const EE_in_contact_t ee_inc /*= EE_in_Contact_t(false)*/)
-    : kinematics_(kyn), ee_in_contact_(ee_inc)
+    : kinematics_(kyn),
+      ee_in_contact_(ee_inc),
+      contactSolver_(ContactSolver_t::template floatingBaseParents<typename RBD::UTILS>())
 {
     setContactConfiguration(ee_inc);
 }
@@ -226,7 +254,7 @@ void ProjectedDynamics<RBD, NEE>::ProjectedInverseDynamicsCommon(const RBDState_
     const RBDAcceleration_t& qdd,
     control_vector_t& u)
 {
-    Jc_.updateState(x);
+    Jc_.updateState(x, kinematics_->updateCache(x.jointPositions()));
     P_ = Jc_.P();
 
     Eigen::Matrix<Scalar, NDOF, CONTROL_DIM> PSt = P_ * S_.transpose();
@@ -248,7 +276,43 @@ template <class RBD, size_t NEE>
 void ProjectedDynamics<RBD, NEE>::ProjectedForwardDynamicsCommon(const RBDState_t& x, const control_vector_t& u)
 {
     // Set Kinematics
-    Jc_.updateState(x);
+    const auto& kinematicsCache = kinematics_->updateCache(x.jointPositions());
+    Jc_.updateState(x, kinematicsCache);
+    const g_coordinate_vector_t qd = x.toCoordinateVelocity();
+    for (size_t eeinc_i = 0; eeinc_i < NEE; eeinc_i++)
+    {
+        if (ee_in_contact_[eeinc_i])
+        {
+            gamma_.template segment<3>(3 * eeinc_i) =
+                -Jc_.dJdt().template block<3, NDOF>(3 * eeinc_i, 0) * qd -
+                x.baseLocalAngularVelocity().toImplementation().template cross(
+                    kinematics_->getEEVelocityInBase(eeinc_i, x, kinematicsCache).toImplementation());
+        }
+    }
+
+    // Set Dynamics
+    updateDynamicsTerms(x, u);
+    contactSolver_.factorize(M_);
+    contactSolver_.solve(contactMode_, Jc_.J(), gamma_, f_ - h_, qdd_, lambda_);
+
+    qddlambda_.template segment<NDOF>(0) = qdd_;
+    int rowCount = 0;
+    for (size_t eeinc_i = 0; eeinc_i < NEE; eeinc_i++)
+    {
+        if (ee_in_contact_[eeinc_i])
+        {
+            qddlambda_.template segment<3>(NDOF + rowCount) = lambda_.template segment<3>(3 * eeinc_i);
+            rowCount += 3;
+        }
+    }
+}
+
+template <class RBD, size_t NEE>
+void ProjectedDynamics<RBD, NEE>::ProjectedForwardDynamicsKKTCommon(const RBDState_t& x, const control_vector_t& u)
+{
+    // Set Kinematics
+    const auto& kinematicsCache = kinematics_->updateCache(x.jointPositions());
+    Jc_.updateState(x, kinematicsCache);
     int rowCount = 0;
     for (size_t eeinc_i = 0; eeinc_i < NEE; eeinc_i++)
     {
@@ -258,7 +322,7 @@ void ProjectedDynamics<RBD, NEE>::ProjectedForwardDynamicsCommon(const RBDState_
             dJcdt_reduced_.template block<3, NDOF>(rowCount, 0) = Jc_.dJdt().template block<3, NDOF>(3 * eeinc_i, 0);
             feet_crossproduct_.template segment<3>(rowCount) =
                 x.baseLocalAngularVelocity().toImplementation().template cross(
-                    kinematics_->getEEVelocityInBase(eeinc_i, x).toImplementation());
+                    kinematics_->getEEVelocityInBase(eeinc_i, x, kinematicsCache).toImplementation());
             rowCount += 3;
         }
     }
@@ -268,6 +332,7 @@ void ProjectedDynamics<RBD, NEE>::ProjectedForwardDynamicsCommon(const RBDState_
     MJTJ0_.template block<NDOF, NDOF>(0, 0) = M_;
     MJTJ0_.template block(NDOF, 0, 3 * neec_, NDOF) = -Jc_reduced_;
     MJTJ0_.template block(0, NDOF, NDOF, 3 * neec_) = -Jc_reduced_.transpose();
+    MJTJ0_.bottomRightCorner(3 * neec_, 3 * neec_).setZero();
 
     b_.template segment<NDOF>(0) = f_ - h_;
     b_.template segment(NDOF, 3 * neec_) = dJcdt_reduced_ * x.toCoordinateVelocity() + feet_crossproduct_;
@@ -281,12 +346,14 @@ void ProjectedDynamics<RBD, NEE>::ResetJacobianStructure()
     Jc_.ee_indices_.clear();
     Jc_.c_size_ = 0;
     neec_ = 0;
+    contactMode_ = 0;
 
     for (size_t eeinc = 0; eeinc < NEE; eeinc++)
     {
         if (ee_in_contact_[eeinc])
         {
             neec_++;
+            contactMode_ |= size_t(1) << eeinc;
             Jc_.c_size_ += 3;
             Jc_.ee_indices_.push_back(eeinc);
 
@@ -303,9 +370,9 @@ void ProjectedDynamics<RBD, NEE>::setSizes()
     feet_crossproduct_.resize(3 * neec_);
 
     MJTJ0_.resize(NDOF + 3 * neec_, NDOF + 3 * neec_);
-    MJTJ0_.setZero();
     b_.resize(NDOF + 3 * neec_);
     qddlambda_.resize(NDOF + 3 * neec_);
+    gamma_.setZero();
 
     S_.template block<CONTROL_DIM, 6>(0, 0).setZero();
     S_.template block<CONTROL_DIM, NJOINTS>(0, 6).setIdentity();
@@ -26,6 +26,8 @@ public:
     typedef RBDState<NJOINTS, SCALAR> RBDState_t;
     typedef typename OperationalJacobianBase<OUTPUTS, NJOINTS, SCALAR>::jacobian_t jacobian_t;
     typedef Eigen::Matrix<SCALAR, 3, 3> Matrix3s;
+    typedef typename Kinematics::KinematicsCache_t KinematicsCache_t;
+    typedef OperationalJacobianBase<OUTPUTS, NJOINTS, SCALAR> Base;
 
     ConstraintJacobian(){};
 
@@ -38,6 +40,23 @@ public:
         this->J_.template block<3, NJOINTS + 6>(row, 0).setZero();
     }
 
+    using Base::updateState;
+
+    /**
+     * Sets the state like updateState(state), but takes the end-effector positions and Jacobians from a kinematics
+     * cache of the same joint configuration instead of recomputing them. The cache is referenced, it must not be
+     * updated before J() and dJdt() have been evaluated.
+     * @param state State of the RBD
+     * @param cache kinematics cache of state.joints().getPositions()
+     */
+    void updateState(const RBDState_t& state, const KinematicsCache_t& cache)
+    {
+        Base::updateState(state);
+        cache_ = &cache;
+    }
+
+    void resetUserUpdatedFlags() override { cache_ = nullptr; }
+
     static const size_t BASE_DOF = 6;
 
     size_t c_size_ = 0;
@@ -54,6 +73,10 @@ public:
 		 */
         jacobian_t Jc0, Jc1;
         RBDState_t state1 = state;
+
+        // the perturbed states are not covered by the cache
+        const KinematicsCache_t* cache = cache_;
+        cache_ = nullptr;
         getJacobianOrigin(state, Jc0);
 
         SCALAR eps_ = sqrt(Eigen::NumTraits<SCALAR>::epsilon());
@@ -68,6 +91,7 @@ public:
             dJdt += (Jc1 - Jc0) / h * state.joints().getVelocities()(i);
             state1.joints().getPositions()(i) = state.joints().getPositions()(i);
         }
+        cache_ = cache;
     }
 
     virtual void getJacobianOriginDerivative(const RBDState_t& state, jacobian_t& dJdt) override
@@ -91,8 +115,11 @@ public:
             if (eeInContact_[ee_indices_[ee]])
             {
                 // Collect current contact Jacobians
-                Jc_geometric =
-                    kinematics_.robcogen().getJacobianBaseEEbyId(ee_indices_[ee], state.joints().getPositions());
+                if (cache_)
+                    Jc_geometric = cache_->B_J_EE[ee_indices_[ee]];
+                else
+                    Jc_geometric =
+                        kinematics_.robcogen().getJacobianBaseEEbyId(ee_indices_[ee], state.joints().getPositions());
                 Jc_Rotational = Jc_geometric.template topRows<3>();
                 Jc_Translational = Jc_geometric.template bottomRows<3>();
 
@@ -140,14 +167,23 @@ public:
             if (eeInContact_[ee_indices_[ee]])
             {
                 Eigen::Matrix<SCALAR, 3, NJOINTS + 6> J_eeId;
-                kindr::Position<SCALAR, 3> eePosition =
-                    kinematics_.getEEPositionInBase(ee_indices_[ee], state.joints().getPositions());
-                Eigen::Matrix<SCALAR, 3, NJOINTS> J_single =
-                    kinematics_.robcogen()
-                        .getJacobianBaseEEbyId(ee_indices_[ee], state.joints().getPositions())
-                        .template bottomRows<3>();
+                Eigen::Matrix<SCALAR, 3, 1> eePosition;
+                Eigen::Matrix<SCALAR, 3, NJOINTS> J_single;
+                if (cache_)
+                {
+                    eePosition = cache_->B_x_EE[ee_indices_[ee]];
+                    J_single = cache_->B_J_EE[ee_indices_[ee]].template bottomRows<3>();
+                }
+                else
+                {
+                    eePosition = kinematics_.getEEPositionInBase(ee_indices_[ee], state.joints().getPositions())
+                                     .toImplementation();
+                    J_single = kinematics_.robcogen()
+                                   .getJacobianBaseEEbyId(ee_indices_[ee], state.joints().getPositions())
+                                   .template bottomRows<3>();
+                }
                 FrameJacobian<NJOINTS, SCALAR>::FromBaseJacToInertiaJacTranslation(
-                    Matrix3s::Identity(), eePosition.toImplementation(), J_single, J_eeId);
+                    Matrix3s::Identity(), eePosition, J_single, J_eeId);
                 Jc.template block<3, NJOINTS + 6>(ee_indices_[ee] * 3, 0) = J_eeId;
             }
         }
@@ -156,6 +192,7 @@ public:
 
 private:
     Kinematics kinematics_;
+    const KinematicsCache_t* cache_ = nullptr;  //!< cache of the current state, if set by updateState()
 };
 
 }  // namespace tpl
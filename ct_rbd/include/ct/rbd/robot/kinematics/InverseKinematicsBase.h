@@ -30,6 +30,7 @@ public:
     using JointPosition_t = typename JointState<NJOINTS, SCALAR>::Position;
     using JointPositionsVector_t = std::vector<JointPosition_t, Eigen::aligned_allocator<JointPosition_t>>;
     using RigidBodyPoseTpl = tpl::RigidBodyPose<SCALAR>;
+    using RigidBodyPoseVector_t = std::vector<RigidBodyPoseTpl, Eigen::aligned_allocator<RigidBodyPoseTpl>>;
 
     //! default constructor
     InverseKinematicsBase() = default;
@@ -119,6 +120,49 @@ public:
             ikSolution, eeBasePose, identityWorldPose, queryJointPositions, freeJoints);
     }
 
+    /*!
+     * @brief compute inverse kinematics for a trajectory of end-effector poses
+     *
+     * The poses are solved in sequence and every solve is warm-started from the previous solution, i.e. the solution
+     * closest to the previous solution is selected (analytic solvers) or the previous solution is used as initial guess
+     * (numerical solvers). If a pose cannot be solved, the last successful solution is kept as warm start and stored.
+     *
+     * @param ikSolutions one solution per pose
+     * @param success flags indicating which poses were solved successfully
+     * @param eeBasePoses end-effector poses in base coordinates
+     * @param initialGuess joint positions used to warm-start the first pose
+     * @param freeJoints vector of indices of the free joints
+     * @return the number of successfully solved poses
+     */
+    virtual size_t computeInverseKinematicsBatch(JointPositionsVector_t& ikSolutions,
+        std::vector<bool>& success,
+        const RigidBodyPoseVector_t& eeBasePoses,
+        const JointPosition_t& initialGuess,
+        const std::vector<size_t>& freeJoints = std::vector<size_t>())
+    {
+        ikSolutions.resize(eeBasePoses.size());
+        success.assign(eeBasePoses.size(), false);
+
+        size_t nSuccess = 0;
+        JointPosition_t warmStart = initialGuess;
+
+        for (size_t i = 0; i < eeBasePoses.size(); i++)
+        {
+            if (computeInverseKinematicsCloseTo(ikSolutions[i], eeBasePoses[i], warmStart, freeJoints))
+            {
+                warmStart = ikSolutions[i];
+                success[i] = true;
+                nSuccess++;
+            }
+            else
+            {
+                ikSolutions[i] = warmStart;
+            }
+        }
+
+        return nSuccess;
+    }
+
     const InverseKinematicsSettings& getSettings() const { return settings_; }
     void updateSettings(const InverseKinematicsSettings& settings) { settings_ = settings; }
 protected:
@@ -0,0 +1,131 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "InverseKinematicsBase.h"
+
+namespace ct {
+namespace rbd {
+
+/*!
+ * \brief Solves inverse kinematics for long pose trajectories in parallel
+ *
+ * The pose trajectory is split into as many contiguous segments as there are solver instances. Each segment is solved
+ * in its own thread by InverseKinematicsBase::computeInverseKinematicsBatch(), i.e. sequentially and warm-started from
+ * the previous solution of the same segment.
+ *
+ * Before the threads are started, the first poses of all segments are solved in sequence, each warm-started from the
+ * solution of the first pose of the previous segment. These solutions seed the segments, such that the segments follow
+ * the solution branch of a sequential solve instead of each starting from the initial guess.
+ *
+ * Every thread needs its own solver instance since inverse kinematics solvers carry internal state (e.g. the NLP).
+ *
+ * \tparam NJOINTS number of joints
+ * \tparam SCALAR scalar type
+ */
+template <size_t NJOINTS, typename SCALAR = double>
+class InverseKinematicsBatchSolver
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    using IKSolver_t = InverseKinematicsBase<NJOINTS, SCALAR>;
+    using JointPosition_t = typename IKSolver_t::JointPosition_t;
+    using JointPositionsVector_t = typename IKSolver_t::JointPositionsVector_t;
+    using RigidBodyPoseVector_t = typename IKSolver_t::RigidBodyPoseVector_t;
+
+    /*!
+     * @brief constructor
+     * @param solvers one independent solver instance per thread
+     * @param minSegmentLength minimum number of poses per thread, shorter trajectories use fewer threads
+     */
+    InverseKinematicsBatchSolver(const std::vector<std::shared_ptr<IKSolver_t>>& solvers, size_t minSegmentLength = 10)
+        : solvers_(solvers), minSegmentLength_(std::max(minSegmentLength, size_t(1)))
+    {
+        if (solvers_.empty())
+            throw std::runtime_error("InverseKinematicsBatchSolver: at least one solver instance required.");
+    }
+
+    /*!
+     * @brief solve inverse kinematics for all poses
+     * @param ikSolutions one solution per pose
+     * @param success flags indicating which poses were solved successfully
+     * @param eeBasePoses end-effector poses in base coordinates
+     * @param initialGuess initial guess for the first pose of the trajectory
+     * @param freeJoints vector of indices of the free joints
+     * @return the number of successfully solved poses
+     */
+    size_t solve(JointPositionsVector_t& ikSolutions,
+        std::vector<bool>& success,
+        const RigidBodyPoseVector_t& eeBasePoses,
+        const JointPosition_t& initialGuess,
+        const std::vector<size_t>& freeJoints = std::vector<size_t>())
+    {
+        const size_t nPoses = eeBasePoses.size();
+        const size_t nSegments = std::max(std::min(solvers_.size(), nPoses / minSegmentLength_), size_t(1));
+
+        ikSolutions.resize(nPoses);
+        success.assign(nPoses, false);
+
+        // per-segment results, std::vector<bool> must not be written concurrently
+        std::vector<JointPositionsVector_t> segmentSolutions(nSegments);
+        std::vector<std::vector<bool>> segmentSuccess(nSegments);
+        std::vector<size_t> segmentStart(nSegments + 1);
+        for (size_t k = 0; k <= nSegments; k++)
+            segmentStart[k] = k * nPoses / nSegments;
+
+        // seed every segment from a sequential solve of its first pose
+        JointPositionsVector_t seeds(nSegments, initialGuess);
+        for (size_t k = 0; nSegments > 1 && k < nSegments; k++)
+        {
+            const JointPosition_t& warmStart = (k > 0) ? seeds[k - 1] : initialGuess;
+            if (!solvers_[0]->computeInverseKinematicsCloseTo(
+                    seeds[k], eeBasePoses[segmentStart[k]], warmStart, freeJoints))
+                seeds[k] = warmStart;
+        }
+
+        auto solveSegment = [&](size_t k) {
+            RigidBodyPoseVector_t poses(
+                eeBasePoses.begin() + segmentStart[k], eeBasePoses.begin() + segmentStart[k + 1]);
+            solvers_[k]->computeInverseKinematicsBatch(
+                segmentSolutions[k], segmentSuccess[k], poses, seeds[k], freeJoints);
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t k = 1; k < nSegments; k++)
+            workers.push_back(std::thread(solveSegment, k));
+
+        solveSegment(0);
+
+        for (auto& worker : workers)
+            worker.join();
+
+        size_t nSuccess = 0;
+        for (size_t k = 0; k < nSegments; k++)
+        {
+            for (size_t i = 0; i < segmentSolutions[k].size(); i++)
+            {
+                ikSolutions[segmentStart[k] + i] = segmentSolutions[k][i];
+                success[segmentStart[k] + i] = segmentSuccess[k][i];
+                nSuccess += segmentSuccess[k][i];
+            }
+        }
+
+        return nSuccess;
+    }
+
+    size_t getNumThreads() const { return solvers_.size(); }
+private:
+    std::vector<std::shared_ptr<IKSolver_t>> solvers_;  //!< one solver instance per thread
+    size_t minSegmentLength_;                           //!< minimum number of poses per segment
+};
+
+} /* namespace rbd */
+} /* namespace ct */
@@ -0,0 +1,46 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <array>
+
+#include <ct/rbd/state/JointState.h>
+
+namespace ct {
+namespace rbd {
+
+/**
+ * \brief Kinematic quantities of all end-effectors for a single joint configuration
+ *
+ * The cache is filled by Kinematics::updateCache() with a single forward kinematics pass and then consumed by
+ * EEContactModel, FloatingBaseFDSystem and ProjectedDynamics, such that the transforms and Jacobians are not
+ * recomputed for every end-effector query of the same dynamics evaluation.
+ */
+template <typename SCALAR, size_t NJOINTS, size_t N_EE>
+struct KinematicsCache
+{
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<SCALAR, 3, 1> Vector3Tpl;
+    typedef Eigen::Matrix<SCALAR, 6, NJOINTS> Jacobian;
+    typedef Eigen::Matrix<SCALAR, 6, 6> ForceTransform;
+    typedef typename JointState<NJOINTS, SCALAR>::Position JointPosition;
+
+    KinematicsCache() : valid(false) {}
+    //! joint configuration the cache was computed for
+    JointPosition jointPosition;
+    //! link ids of the end-effectors the cache was computed for
+    std::array<size_t, N_EE> linkId;
+    //! true if the cache holds the quantities of jointPosition and linkId
+    bool valid;
+
+    std::array<Vector3Tpl, N_EE> B_x_EE;      //!< end-effector positions in base coordinates
+    std::array<Jacobian, N_EE> B_J_EE;        //!< end-effector Jacobians expressed in the base frame
+    std::array<ForceTransform, N_EE> L_X_B;  //!< force transforms from base to the link the end-effector sits on
+};
+
+}  // namespace rbd
+}  // namespace ct
@@ -37,6 +37,8 @@ public:
     using JointPositionsVector_t = typename InverseKinematicsBase::JointPositionsVector_t;
     using RigidBodyPoseTpl = typename InverseKinematicsBase::RigidBodyPoseTpl;
 
+    using InverseKinematicsBase::computeInverseKinematicsCloseTo;
+
     IKNLPSolverIpopt() = delete;
 
     //! constructor
@@ -129,9 +131,56 @@ public:
         return computeInverseKinematics(ikSolutions, eeWorldPose.inReferenceFrame(baseWorldPose), freeJoints);
     }
 
+    /*!
+     * @brief solve warm-started from the query joint positions
+     *
+     * The NLP is initialized with the query joint positions or, if a seed solver is set, with the seed solution
+     * closest to the query (e.g. the closest IKFast branch). The NLP solution is returned.
+     */
+    bool computeInverseKinematicsCloseTo(JointPosition_t& ikSolution,
+        const RigidBodyPoseTpl& eeWorldPose,
+        const RigidBodyPoseTpl& baseWorldPose,
+        const JointPosition_t& queryJointPositions,
+        const std::vector<size_t>& freeJoints = std::vector<size_t>()) override
+    {
+        JointPosition_t initialGuess = queryJointPositions;
+
+        if (seedSolver_)
+        {
+            JointPosition_t seed;
+            if (seedSolver_->computeInverseKinematicsCloseTo(
+                    seed, eeWorldPose, baseWorldPose, queryJointPositions, seedFreeJoints_))
+                initialGuess = seed;
+        }
+
+        setInitialGuess(initialGuess);
+
+        JointPositionsVector_t solutions;
+        if (!computeInverseKinematics(solutions, eeWorldPose, baseWorldPose, freeJoints))
+            return false;
+
+        ikSolution = solutions.front();
+        return true;
+    }
+
+    /*!
+     * @brief set a solver (typically analytic, e.g. IKFast) whose closest solution seeds the NLP
+     * @param seedSolver the seed solver, nullptr to disable seeding
+     * @param seedFreeJoints free joints passed to the seed solver
+     */
+    void setSeedSolver(std::shared_ptr<InverseKinematicsBase> seedSolver,
+        const std::vector<size_t>& seedFreeJoints = std::vector<size_t>())
+    {
+        seedSolver_ = seedSolver;
+        seedFreeJoints_ = seedFreeJoints;
+    }
+
 private:
     std::shared_ptr<IKNLP> iknlp_;
 
+    std::shared_ptr<InverseKinematicsBase> seedSolver_;  // optional solver providing the initial guess
+    std::vector<size_t> seedFreeJoints_;                 // free joints for the seed solver
+
     VALIDATION_KIN kinematics_;  // for validation (todo: need different way to include double-based kinematics
     size_t eeInd_;               // for validation
 
@@ -172,6 +221,11 @@ public:
     }
 
     void setInitialGuess(const JointPosition_t& q_init) {}
+    void setSeedSolver(std::shared_ptr<InverseKinematicsBase> seedSolver,
+        const std::vector<size_t>& seedFreeJoints = std::vector<size_t>())
+    {
+    }
+
     bool computeInverseKinematics(JointPositionsVector_t& ikSolutions,
         const RigidBodyPoseTpl& ee_W_base,
         const std::vector<size_t>& freeJoints = std::vector<size_t>()) override
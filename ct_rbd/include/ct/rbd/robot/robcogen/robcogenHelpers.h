@@ -598,6 +598,262 @@ public:
     }
 
 
+    //! index of the first joint in the kinematic chain from the base to the end-effector
+    static size_t eeIdToFirstJointId(size_t ee_id)
+    {
+        switch (ee_id)
+        {
+#ifdef CT_EE0
+            case 0:
+                return CT_EE0_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE1
+            case 1:
+                return CT_EE1_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE2
+            case 2:
+                return CT_EE2_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE3
+            case 3:
+                return CT_EE3_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE4
+            case 4:
+                return CT_EE4_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE5
+            case 5:
+                return CT_EE5_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE6
+            case 6:
+                return CT_EE6_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE7
+            case 7:
+                return CT_EE7_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE8
+            case 8:
+                return CT_EE8_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE9
+            case 9:
+                return CT_EE9_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE10
+            case 10:
+                return CT_EE10_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE11
+            case 11:
+                return CT_EE11_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE12
+            case 12:
+                return CT_EE12_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE13
+            case 13:
+                return CT_EE13_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE14
+            case 14:
+                return CT_EE14_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE15
+            case 15:
+                return CT_EE15_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE16
+            case 16:
+                return CT_EE16_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE17
+            case 17:
+                return CT_EE17_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE18
+            case 18:
+                return CT_EE18_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE19
+            case 19:
+                return CT_EE19_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE20
+            case 20:
+                return CT_EE20_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE21
+            case 21:
+                return CT_EE21_FIRST_JOINT;
+                break;
+#endif
+#ifdef CT_EE22
+            case 22:
+                return CT_EE22_FIRST_JOINT;
+                break;
+#endif
+
+            default:
+                std::cout << "eeIdToFirstJointId: requested end-effector does not exist, requested: " << ee_id << std::endl;
+                throw std::runtime_error("eeIdToFirstJointId: requested end-effector does not exist");
+                break;
+        }
+    }
+
+    //! index of the last joint in the kinematic chain from the base to the end-effector
+    static size_t eeIdToLastJointId(size_t ee_id)
+    {
+        switch (ee_id)
+        {
+#ifdef CT_EE0
+            case 0:
+                return CT_EE0_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE1
+            case 1:
+                return CT_EE1_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE2
+            case 2:
+                return CT_EE2_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE3
+            case 3:
+                return CT_EE3_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE4
+            case 4:
+                return CT_EE4_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE5
+            case 5:
+                return CT_EE5_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE6
+            case 6:
+                return CT_EE6_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE7
+            case 7:
+                return CT_EE7_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE8
+            case 8:
+                return CT_EE8_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE9
+            case 9:
+                return CT_EE9_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE10
+            case 10:
+                return CT_EE10_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE11
+            case 11:
+                return CT_EE11_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE12
+            case 12:
+                return CT_EE12_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE13
+            case 13:
+                return CT_EE13_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE14
+            case 14:
+                return CT_EE14_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE15
+            case 15:
+                return CT_EE15_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE16
+            case 16:
+                return CT_EE16_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE17
+            case 17:
+                return CT_EE17_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE18
+            case 18:
+                return CT_EE18_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE19
+            case 19:
+                return CT_EE19_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE20
+            case 20:
+                return CT_EE20_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE21
+            case 21:
+                return CT_EE21_LAST_JOINT;
+                break;
+#endif
+#ifdef CT_EE22
+            case 22:
+                return CT_EE22_LAST_JOINT;
+                break;
+#endif
+
+            default:
+                std::cout << "eeIdToLastJointId: requested end-effector does not exist, requested: " << ee_id << std::endl;
+                throw std::runtime_error("eeIdToLastJointId: requested end-effector does not exist");
+                break;
+        }
+    }
+
     // This defines a function to get the transform by ID
     template <class JACS>
     static typename Eigen::Matrix<SCALAR, 6, NJOINTS> getJacobianBaseEEbyId(JACS& jacobians,
@@ -47,7 +47,9 @@ public:
 
     FloatingBaseFDSystem() : Base(), dynamics_(), eeContactModel_(nullptr) {}
     FloatingBaseFDSystem(const FloatingBaseFDSystem<RBDDynamics, QUAT_INTEGRATION, EE_ARE_CONTROL_INPUTS>& other)
-        : Base(other), dynamics_(other.dynamics_), eeContactModel_(other.eeContactModel_->clone())
+        : Base(other),
+          dynamics_(other.dynamics_),
+          eeContactModel_(other.eeContactModel_ ? other.eeContactModel_->clone() : nullptr)
     {
     }
 
@@ -88,17 +90,21 @@ public:
         typename RBDDynamics::RBDState_t rbdCached = RBDStateFromVector(xLocal);
         typename RBDDynamics::ExtLinkForces_t linkForces(Eigen::Matrix<SCALAR, 6, 1>::Zero());
 
+        // single kinematics pass, shared by the contact model and the force mapping
+        const typename Kinematics::KinematicsCache_t& kinematicsCache =
+            dynamics_.kinematics().updateCache(rbdCached.jointPositions());
+
         std::array<typename Kinematics::EEForceLinear, N_EE> eeForcesW;
         eeForcesW.fill(Kinematics::EEForceLinear::Zero());
 
         if (eeContactModel_)
-            eeForcesW = eeContactModel_->computeContactForces(rbdCached);
+            eeForcesW = eeContactModel_->computeContactForces(rbdCached, kinematicsCache);
 
         if (EE_ARE_CONTROL_INPUTS)
             for (size_t i = 0; i < N_EE; i++)
                 eeForcesW[i] += control.template segment<3>(RBDDynamics::NJOINTS + i * 3);
 
-        mapEndeffectorForcesToLinkForces(rbdCached, eeForcesW, linkForces);
+        mapEndeffectorForcesToLinkForces(rbdCached, eeForcesW, linkForces, kinematicsCache);
 
         typename RBDDynamics::RBDAcceleration_t xd;
 
@@ -117,14 +123,30 @@ public:
     void mapEndeffectorForcesToLinkForces(const typename RBDDynamics::RBDState_t& state,
         const std::array<typename Kinematics::EEForceLinear, N_EE>& eeForcesW,
         typename RBDDynamics::ExtLinkForces_t& linkForces)
+    {
+        mapEndeffectorForcesToLinkForces(
+            state, eeForcesW, linkForces, dynamics_.kinematics().updateCache(state.jointPositions()));
+    }
+
+    /**
+	 * Maps the end-effector forces expressed in the world to the link frame as required by robcogen, using the
+	 * end-effector positions and force transforms of a kinematics cache.
+	 * @param state robot state
+	 * @param control end-effector forces expressed in the world
+	 * @param linkForces forces acting on the link expressed in the link frame
+	 * @param kinematicsCache kinematics cache, updated for the joint positions of the state
+	 */
+    void mapEndeffectorForcesToLinkForces(const typename RBDDynamics::RBDState_t& state,
+        const std::array<typename Kinematics::EEForceLinear, N_EE>& eeForcesW,
+        typename RBDDynamics::ExtLinkForces_t& linkForces,
+        const typename Kinematics::KinematicsCache_t& kinematicsCache)
     {
         for (size_t i = 0; i < N_EE; i++)
         {
             auto endEffector = dynamics_.kinematics().getEndEffector(i);
             size_t linkId = endEffector.getLinkId();
             linkForces[static_cast<typename RBDDynamics::ROBCOGEN::LinkIdentifiers>(linkId)] =
-                dynamics_.kinematics().mapForceFromWorldToLink3d(
-                    eeForcesW[i], state.basePose(), state.jointPositions(), i);
+                dynamics_.kinematics().mapForceFromWorldToLink3d(eeForcesW[i], state.basePose(), i, kinematicsCache);
         }
     }
 
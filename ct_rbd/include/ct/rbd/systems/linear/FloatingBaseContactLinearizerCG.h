@@ -0,0 +1,235 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include <ct/rbd/systems/FloatingBaseFDSystem.h>
+
+namespace ct {
+namespace rbd {
+
+/*!
+ * \brief Parameters of the soft contact model used inside FloatingBaseContactLinearizerCG
+ *
+ * The values are stored as doubles and are baked into the recorded operation graph as constants.
+ * Defaults correspond to the contact model used for the HyQ codegen linearization.
+ */
+struct ContactLinearizationParameters
+{
+    ContactLinearizationParameters(double k_ = 5000.0,
+        double d_ = 1000.0,
+        double alpha_ = 100.0,
+        double alpha_n_ = 100.0,
+        double zOffset_ = -0.02,
+        int smoothing_ = 1,
+        bool useContactModel_ = true)
+        : k(k_),
+          d(d_),
+          alpha(alpha_),
+          alpha_n(alpha_n_),
+          zOffset(zOffset_),
+          smoothing(smoothing_),
+          useContactModel(useContactModel_)
+    {
+    }
+
+    //! unique string representation, used as key for the JIT cache
+    std::string toString() const
+    {
+        std::stringstream ss;
+        ss.precision(17);
+        ss << k << "_" << d << "_" << alpha << "_" << alpha_n << "_" << zOffset << "_" << smoothing << "_"
+           << useContactModel;
+        return ss.str();
+    }
+
+    double k;              //!< stiffness of vertical spring
+    double d;              //!< damper coefficient
+    double alpha;          //!< velocity smoothing coefficient
+    double alpha_n;        //!< normal force smoothing coefficient
+    double zOffset;        //!< z offset of the contact plane
+    int smoothing;         //!< velocity smoothing, see EEContactModel::VELOCITY_SMOOTHING
+    bool useContactModel;  //!< if false, the bare floating base dynamics are linearized
+};
+
+
+/*!
+ * \brief Codegen linearization of a floating base system with end-effector contact model
+ *
+ * This linearizer works for any RobCoGen-based Dynamics<RBD, NEE>. It instantiates the FloatingBaseFDSystem
+ * together with an EEContactModel on the Auto-Diff codegen scalar, records the full forward dynamics (contact forces,
+ * force mapping and RobCoGen forward dynamics) once and
+ *
+ * - either compiles the Jacobians just-in-time (compileJIT()), in which case the recorded dynamics and the compiled
+ *   library are cached per process. Further instances with identical contact parameters neither record nor compile
+ *   again, they copy the cached recording and load the cached library.
+ * - or generates sparse source code for A and B (generateCode()), e.g. at build time through the CMake function
+ *   ct_rbd_add_contact_linearization() provided in ct_rbd/cmake/ct_rbdCodegen.cmake
+ *
+ * In contrast to RbdLinearizer no numerical differentiation is involved and the base rotation terms are part of the
+ * recorded graph, hence the result is exact.
+ *
+ * \tparam DYNAMICS_TPL scalar-templated dynamics of the robot, e.g. ct::rbd::HyQ::tpl::Dynamics
+ * \tparam QUAT_INTEGRATION use quaternion instead of Euler angle base orientation
+ */
+template <template <typename> class DYNAMICS_TPL, bool QUAT_INTEGRATION = false>
+class FloatingBaseContactLinearizerCG
+    : public ct::core::LinearSystem<FloatingBaseFDSystem<DYNAMICS_TPL<double>, QUAT_INTEGRATION>::STATE_DIM,
+          FloatingBaseFDSystem<DYNAMICS_TPL<double>, QUAT_INTEGRATION>::CONTROL_DIM,
+          double>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef CppAD::AD<CppAD::cg::CG<double>> ADCGScalar;
+
+    typedef FloatingBaseFDSystem<DYNAMICS_TPL<ADCGScalar>, QUAT_INTEGRATION> SystemAD;
+    typedef typename SystemAD::ContactModel ContactModelAD;
+
+    static const size_t STATE_DIM = SystemAD::STATE_DIM;
+    static const size_t CONTROL_DIM = SystemAD::CONTROL_DIM;
+
+    typedef ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, double> Base;
+    typedef ct::core::ADCodegenLinearizer<STATE_DIM, CONTROL_DIM> linearizer_t;
+
+    typedef typename Base::state_vector_t state_vector_t;
+    typedef typename Base::control_vector_t control_vector_t;
+    typedef typename Base::state_matrix_t state_matrix_t;
+    typedef typename Base::state_control_matrix_t state_control_matrix_t;
+
+    /*!
+     * \brief Constructor
+     *
+     * The forward dynamics are recorded on first use, i.e. not at all if compileJIT() finds them in the cache.
+     * @param params contact model parameters
+     */
+    FloatingBaseContactLinearizerCG(const ContactLinearizationParameters& params = ContactLinearizationParameters())
+        : Base(ct::core::SYSTEM_TYPE::GENERAL), params_(params)
+    {
+    }
+
+    //! copy constructor, copies the recorded dynamics and loads the compiled library again instead of recompiling
+    FloatingBaseContactLinearizerCG(const FloatingBaseContactLinearizerCG& arg)
+        : Base(arg), params_(arg.params_), linearizer_(arg.linearizer_ ? arg.linearizer_->clone() : nullptr)
+    {
+    }
+
+    virtual ~FloatingBaseContactLinearizerCG() {}
+    FloatingBaseContactLinearizerCG* clone() const override { return new FloatingBaseContactLinearizerCG(*this); }
+    /*!
+     * \brief compiles the Jacobians just-in-time.
+     *
+     * The first compilation for a given set of contact parameters is cached. Every further call with the same
+     * library name and parameters in the same process copies the cached recording and loads the cached library,
+     * without recording or compiling.
+     * @param libName base name of the library
+     */
+    void compileJIT(const std::string& libName = "FloatingBaseContactLinearizerCG")
+    {
+        const std::string key = libName + "_" + params_.toString();
+
+        std::lock_guard<std::mutex> lock(jitCacheMutex());
+        auto& cache = jitCache();
+        auto it = cache.find(key);
+        if (it == cache.end())
+        {
+            linearizer().compileJIT(libName);
+            cache[key] = std::shared_ptr<linearizer_t>(linearizer_->clone());
+        }
+        else
+        {
+            linearizer_ = std::shared_ptr<linearizer_t>(it->second->clone());
+        }
+    }
+
+    /*!
+     * \brief generates the source code of a LinearSystem which evaluates the sparse Jacobians A and B
+     *
+     * Zero entries of the Jacobians are not assigned in the generated code, so that only the non-zero
+     * pattern of the contact dynamics is evaluated at runtime.
+     *
+     * @param systemName name of the generated class
+     * @param outputDir output directory
+     * @param templateDir directory of the ct_core code generation templates, see ct_core_CODEGEN_TEMPLATE_DIR
+     * @param ns1 first layer namespace
+     * @param ns2 second layer namespace
+     * @param useReverse use reverse mode auto-diff
+     */
+    void generateCode(const std::string& systemName,
+        const std::string& outputDir,
+        const std::string& templateDir = ct::core::CODEGEN_TEMPLATE_DIR,
+        const std::string& ns1 = "rbd",
+        const std::string& ns2 = "generated",
+        bool useReverse = false)
+    {
+        linearizer().generateCode(systemName, outputDir, templateDir, ns1, ns2, useReverse, true);
+    }
+
+    const state_matrix_t& getDerivativeState(const state_vector_t& x,
+        const control_vector_t& u,
+        const double t = 0.0) override
+    {
+        return linearizer().getDerivativeState(x, u, t);
+    }
+
+    const state_control_matrix_t& getDerivativeControl(const state_vector_t& x,
+        const control_vector_t& u,
+        const double t = 0.0) override
+    {
+        return linearizer().getDerivativeControl(x, u, t);
+    }
+
+    const ContactLinearizationParameters& getParameters() const { return params_; }
+private:
+    //! the linearizer, recording the forward dynamics if this has not happened yet
+    linearizer_t& linearizer()
+    {
+        if (!linearizer_)
+            linearizer_ = createLinearizer(params_);
+        return *linearizer_;
+    }
+
+    //! creates the auto-diff system with contact model and the codegen linearizer wrapping it
+    static std::shared_ptr<linearizer_t> createLinearizer(const ContactLinearizationParameters& p)
+    {
+        std::shared_ptr<SystemAD> adSystem(new SystemAD);
+
+        if (p.useContactModel)
+        {
+            // share the kinematics between system and contact model, such that the recorded
+            // graph contains a single kinematics pass which the code generator can optimize
+            std::shared_ptr<ContactModelAD> contactModel(new ContactModelAD(ADCGScalar(p.k), ADCGScalar(p.d),
+                ADCGScalar(p.alpha), ADCGScalar(p.alpha_n), ADCGScalar(p.zOffset),
+                static_cast<typename ContactModelAD::VELOCITY_SMOOTHING>(p.smoothing),
+                adSystem->dynamics().kinematicsPtr()));
+            adSystem->setContactModel(contactModel);
+        }
+
+        return std::shared_ptr<linearizer_t>(new linearizer_t(adSystem));
+    }
+
+    static std::map<std::string, std::shared_ptr<linearizer_t>>& jitCache()
+    {
+        static std::map<std::string, std::shared_ptr<linearizer_t>> cache;
+        return cache;
+    }
+
+    static std::mutex& jitCacheMutex()
+    {
+        static std::mutex m;
+        return m;
+    }
+
+    ContactLinearizationParameters params_;
+    std::shared_ptr<linearizer_t> linearizer_;
+};
+
+}  // namespace rbd
+}  // namespace ct
@@ -0,0 +1,265 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/rbd/rbd.h>
+
+#include <chrono>
+#include <memory>
+#include <gtest/gtest.h>
+
+#include <ct/rbd/physics/EEContactModel.h>
+#include <ct/rbd/physics/terrain/HeightFieldTerrain.h>
+
+#include "../models/testhyq/RobCoGenTestHyQ.h"
+
+using namespace ct::rbd;
+
+// an inclined plane h = a * x + b * y is represented exactly by bilinear interpolation
+Eigen::MatrixXd inclinedPlane(size_t nx, size_t ny, double x0, double y0, double res, double a, double b)
+{
+    Eigen::MatrixXd heights(nx, ny);
+    for (size_t i = 0; i < nx; i++)
+        for (size_t j = 0; j < ny; j++)
+            heights(i, j) = a * (x0 + i * res) + b * (y0 + j * res);
+    return heights;
+}
+
+TEST(HeightFieldTerrainTest, inclinedPlaneTest)
+{
+    const double a = 0.3, b = -0.2, x0 = -1.0, y0 = -2.0, res = 0.05;
+    HeightFieldTerrain<double> terrain(inclinedPlane(41, 81, x0, y0, res, a, b), x0, y0, res);
+
+    Eigen::Vector3d expectedNormal(-a, -b, 1.0);
+    expectedNormal.normalize();
+
+    for (size_t k = 0; k < 1000; k++)
+    {
+        Eigen::Vector3d p = Eigen::Vector3d::Random();
+        p(1) *= 2.0;
+
+        ASSERT_NEAR(terrain.height(p(0), p(1)), a * p(0) + b * p(1), 1e-10);
+
+        double depth;
+        Eigen::Vector3d normal;
+        terrain.query(p, depth, normal);
+
+        ASSERT_LT((normal - expectedNormal).norm(), 1e-10);
+        ASSERT_NEAR(depth, (p(2) - a * p(0) - b * p(1)) * expectedNormal(2), 1e-10);
+    }
+
+    // queries outside of the grid are clamped to the border
+    ASSERT_NEAR(terrain.height(-10.0, 0.0), a * x0, 1e-10);
+}
+
+// records the penetration depth of a terrain once, such that the tape can be evaluated at different points
+CppAD::ADFun<double> recordDepth(const HeightFieldTerrain<CppAD::AD<double>>& terrainAD)
+{
+    typedef CppAD::AD<double> ADScalar;
+
+    std::vector<ADScalar> x(3), y(1);
+    x[0] = 0.6;
+    x[1] = -0.4;
+    x[2] = 0.0;
+    CppAD::Independent(x);
+    Eigen::Matrix<ADScalar, 3, 1> pAD(x[0], x[1], x[2]);
+    Eigen::Matrix<ADScalar, 3, 1> normalAD;
+    terrainAD.query(pAD, y[0], normalAD);
+    return CppAD::ADFun<double>(x, y);
+}
+
+TEST(HeightFieldTerrainTest, autoDiffTest)
+{
+    Eigen::MatrixXd heights = Eigen::MatrixXd::Random(12, 17);
+    HeightFieldTerrain<double> terrain(heights, 0.5, -0.5, 0.1);
+    HeightFieldTerrain<CppAD::AD<double>> terrainAD(heights, 0.5, -0.5, 0.1);
+
+    CppAD::ADFun<double> f = recordDepth(terrainAD);
+
+    for (size_t k = 0; k < 100; k++)
+    {
+        Eigen::Vector3d p = Eigen::Vector3d::Random();
+
+        double depth;
+        Eigen::Vector3d normal;
+        terrain.query(p, depth, normal);
+
+        std::vector<double> xd = {p(0), p(1), p(2)};
+        ASSERT_NEAR(f.Forward(0, xd)[0], depth, 1e-10);
+    }
+
+    // the tape stays valid after the copy it was recorded with is gone
+    std::unique_ptr<HeightFieldTerrain<CppAD::AD<double>>> copy(terrainAD.clone());
+    CppAD::ADFun<double> g = recordDepth(*copy);
+    copy.reset();
+    std::vector<double> xd = {0.7, -0.1, 0.2};
+    double depth;
+    Eigen::Vector3d normal;
+    terrain.query(Eigen::Vector3d(xd[0], xd[1], xd[2]), depth, normal);
+    ASSERT_NEAR(g.Forward(0, xd)[0], depth, 1e-10);
+}
+
+TEST(HeightFieldTerrainTest, autoDiffJacobianTest)
+{
+    const double a = 0.3, b = -0.2, x0 = -1.0, y0 = -2.0, res = 0.05;
+    HeightFieldTerrain<CppAD::AD<double>> terrainAD(inclinedPlane(41, 81, x0, y0, res, a, b), x0, y0, res);
+
+    CppAD::ADFun<double> f = recordDepth(terrainAD);
+
+    // on an inclined plane the depth is linear, (p_z - a p_x - b p_y) n_z
+    const double nz = 1.0 / std::sqrt(a * a + b * b + 1.0);
+
+    for (size_t k = 0; k < 100; k++)
+    {
+        Eigen::Vector3d p = 0.9 * Eigen::Vector3d::Random();
+        p(1) *= 2.0;
+
+        std::vector<double> xd = {p(0), p(1), p(2)};
+        std::vector<double> jac = f.Jacobian(xd);
+        ASSERT_NEAR(jac[0], -a * nz, 1e-10);
+        ASSERT_NEAR(jac[1], -b * nz, 1e-10);
+        ASSERT_NEAR(jac[2], nz, 1e-10);
+    }
+
+    // the depth depends on all coordinates
+    std::vector<std::set<size_t>> r(3);
+    for (size_t i = 0; i < 3; i++)
+        r[i].insert(i);
+    std::vector<std::set<size_t>> s = f.ForSparseJac(3, r);
+    ASSERT_EQ(s[0].size(), 3u);
+}
+
+TEST(HeightFieldTerrainTest, autoDiffTapeSizeTest)
+{
+    // the recorded lookup does not depend on the size of the grid
+    HeightFieldTerrain<CppAD::AD<double>> small(Eigen::MatrixXd::Random(4, 4), 0.0, 0.0, 0.1);
+    HeightFieldTerrain<CppAD::AD<double>> large(Eigen::MatrixXd::Random(256, 256), 0.0, 0.0, 0.1);
+
+    ASSERT_EQ(recordDepth(small).size_var(), recordDepth(large).size_var());
+}
+
+TEST(HeightFieldTerrainTest, tensorProductTest)
+{
+    // nested Auto-Diff scalars use the branch-free tensor product as for codegen
+    typedef CppAD::AD<CppAD::AD<double>> AD2Scalar;
+
+    Eigen::MatrixXd heights = Eigen::MatrixXd::Random(12, 17);
+    HeightFieldTerrain<double> terrain(heights, 0.5, -0.5, 0.1);
+    HeightFieldTerrain<AD2Scalar> terrainAD2(heights, 0.5, -0.5, 0.1);
+
+    for (size_t k = 0; k < 100; k++)
+    {
+        Eigen::Vector3d p = Eigen::Vector3d::Random();
+
+        double depth;
+        Eigen::Vector3d normal;
+        terrain.query(p, depth, normal);
+
+        AD2Scalar depthAD2;
+        Eigen::Matrix<AD2Scalar, 3, 1> normalAD2;
+        terrainAD2.query(p.cast<AD2Scalar>(), depthAD2, normalAD2);
+
+        ASSERT_NEAR(CppAD::Value(CppAD::Value(depthAD2)), depth, 1e-10);
+        for (size_t i = 0; i < 3; i++)
+            ASSERT_NEAR(CppAD::Value(CppAD::Value(normalAD2(i))), normal(i), 1e-10);
+    }
+}
+
+TEST(HeightFieldTerrainTest, timingTest)
+{
+    const size_t nQueries = 1000000;
+    FlatTerrain<double> flat(0.0);
+    HeightFieldTerrain<double> heightField(Eigen::MatrixXd::Random(512, 512), -12.8, -12.8, 0.05);
+
+    std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d>> points(1000);
+    for (auto& p : points)
+        p = 12.0 * Eigen::Vector3d::Random();
+
+    double sum = 0.0;
+    double depth;
+    Eigen::Vector3d normal;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t k = 0; k < nQueries; k++)
+    {
+        flat.query(points[k % points.size()], depth, normal);
+        sum += depth;
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (size_t k = 0; k < nQueries; k++)
+    {
+        heightField.query(points[k % points.size()], depth, normal);
+        sum += depth;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << "flat terrain:         "
+              << std::chrono::duration<double, std::nano>(mid - start).count() / nQueries << " ns/query" << std::endl;
+    std::cout << "height-field terrain: "
+              << std::chrono::duration<double, std::nano>(end - mid).count() / nQueries << " ns/query" << std::endl;
+
+    // recording a query with code generation scalars uses the tensor product, which is O(nx * ny) per query
+    typedef ct::core::ADCGScalar ADCGScalar;
+    for (size_t n : {8, 32, 128})
+    {
+        HeightFieldTerrain<ADCGScalar> terrainCG(Eigen::MatrixXd::Random(n, n), -0.5, -0.5, 1.0 / n);
+
+        const size_t nRecordings = 10;
+        size_t tapeSize = 0;
+        auto startCG = std::chrono::high_resolution_clock::now();
+        for (size_t k = 0; k < nRecordings; k++)
+        {
+            std::vector<ADCGScalar> x(3), y(1);
+            CppAD::Independent(x);
+            Eigen::Matrix<ADCGScalar, 3, 1> pCG(x[0], x[1], x[2]);
+            Eigen::Matrix<ADCGScalar, 3, 1> normalCG;
+            terrainCG.query(pCG, y[0], normalCG);
+            CppAD::ADFun<ct::core::ADCGValueType> f(x, y);
+            tapeSize = f.size_var();
+        }
+        auto endCG = std::chrono::high_resolution_clock::now();
+
+        std::cout << "height-field terrain, codegen recording, " << n << "x" << n << " grid: "
+                  << std::chrono::duration<double, std::micro>(endCG - startCG).count() / nRecordings
+                  << " us/query, " << tapeSize << " tape variables" << std::endl;
+    }
+
+    ASSERT_TRUE(std::isfinite(sum));
+}
+
+TEST(HeightFieldTerrainTest, contactModelFlatGroundTest)
+{
+    typedef TestHyQ::Kinematics HyqKinematics;
+    typedef EEContactModel<HyqKinematics> ContactModel;
+
+    ContactModel defaultModel(5000.0, 500.0, 100.0, -1.0, 0.0, ContactModel::SIGMOID);
+    ContactModel flatModel(defaultModel);
+    ContactModel heightFieldModel(defaultModel);
+
+    flatModel.setTerrain(std::shared_ptr<FlatTerrain<double>>(new FlatTerrain<double>(0.0)));
+    heightFieldModel.setTerrain(std::shared_ptr<HeightFieldTerrain<double>>(
+        new HeightFieldTerrain<double>(Eigen::MatrixXd::Zero(64, 64), -5.0, -5.0, 10.0 / 63.0)));
+
+    for (size_t k = 0; k < 100; k++)
+    {
+        RBDState<HyqKinematics::NJOINTS> state;
+        state.setRandom();
+
+        auto forcesDefault = defaultModel.computeContactForces(state);
+        auto forcesFlat = flatModel.computeContactForces(state);
+        auto forcesHeightField = heightFieldModel.computeContactForces(state);
+
+        for (size_t i = 0; i < forcesDefault.size(); i++)
+        {
+            ASSERT_TRUE(forcesDefault[i].isApprox(forcesFlat[i]));
+            ASSERT_TRUE(forcesDefault[i].isApprox(forcesHeightField[i]));
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
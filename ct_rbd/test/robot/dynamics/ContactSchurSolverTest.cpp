@@ -0,0 +1,176 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include <ct/core/core.h>
+#include <ct/rbd/robot/ContactSchurSolver.h>
+
+using namespace ct::rbd;
+
+// a quadruped like HyQ: 6 base coordinates and 4 legs with 3 joints each
+const size_t NDOF = 18;
+const size_t NEE = 4;
+typedef ContactSchurSolver<double, NDOF, NEE> Solver;
+
+Solver::parent_array_t quadrupedParents()
+{
+    Solver::parent_array_t parents = Solver::chainParents();
+    for (size_t leg = 0; leg < NEE; leg++)
+        parents[6 + 3 * leg] = 5;
+    return parents;
+}
+
+// M = L^T D L with L unit lower triangular and non-zero only for ancestors, hence M has the branch induced sparsity
+Solver::inertia_matrix_t randomInertia(const Solver::parent_array_t& parents)
+{
+    Solver::inertia_matrix_t L = Solver::inertia_matrix_t::Identity();
+    for (size_t i = 0; i < NDOF; i++)
+        for (int j = parents[i]; j >= 0; j = parents[j])
+            L(i, j) = Eigen::internal::random<double>(-1.0, 1.0);
+    Solver::g_coordinate_vector_t d = Solver::g_coordinate_vector_t::Random().array() + 1.5;
+    return L.transpose() * d.asDiagonal() * L;
+}
+
+// the reference, as previously in ProjectedDynamics: one dense KKT system of dynamic size
+void solveKKT(size_t mode,
+    const Solver::inertia_matrix_t& M,
+    const Solver::jacobian_t& J,
+    const Solver::contact_vector_t& gamma,
+    const Solver::g_coordinate_vector_t& tau,
+    Solver::g_coordinate_vector_t& qdd,
+    Solver::contact_vector_t& lambda)
+{
+    std::vector<size_t> contacts;
+    for (size_t ee = 0; ee < NEE; ee++)
+        if (mode & (size_t(1) << ee))
+            contacts.push_back(ee);
+    const int C = 3 * contacts.size();
+
+    Eigen::MatrixXd kkt = Eigen::MatrixXd::Zero(NDOF + C, NDOF + C);
+    Eigen::MatrixXd b(NDOF + C, 1);
+    kkt.topLeftCorner(NDOF, NDOF) = M;
+    b.topRows(NDOF) = tau;
+    for (size_t k = 0; k < contacts.size(); k++)
+    {
+        kkt.block(NDOF + 3 * k, 0, 3, NDOF) = -J.block<3, NDOF>(3 * contacts[k], 0);
+        kkt.block(0, NDOF + 3 * k, NDOF, 3) = -J.block<3, NDOF>(3 * contacts[k], 0).transpose();
+        b.block<3, 1>(NDOF + 3 * k, 0) = -gamma.segment<3>(3 * contacts[k]);
+    }
+
+    Eigen::MatrixXd x = ct::core::LDLTsolve<double>(kkt, b);
+
+    qdd = x.topRows(NDOF);
+    lambda.setZero();
+    for (size_t k = 0; k < contacts.size(); k++)
+        lambda.segment<3>(3 * contacts[k]) = x.block<3, 1>(NDOF + 3 * k, 0);
+}
+
+TEST(ContactSchurSolverTest, solveTest)
+{
+    const Solver::parent_array_t parents = quadrupedParents();
+    Solver treeSolver(parents);
+    Solver chainSolver;
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        Solver::inertia_matrix_t M = randomInertia(parents);
+        treeSolver.factorize(M);
+        chainSolver.factorize(M);
+
+        Solver::g_coordinate_vector_t b = Solver::g_coordinate_vector_t::Random();
+        Solver::g_coordinate_vector_t x = b;
+        treeSolver.solveInPlace(x);
+        ASSERT_LT((M * x - b).norm(), 1e-8);
+
+        // every contact configuration has its own kernel
+        for (size_t mode = 0; mode < Solver::NMODES; mode++)
+        {
+            Solver::jacobian_t J = Solver::jacobian_t::Random();
+            Solver::contact_vector_t gamma = Solver::contact_vector_t::Random();
+            Solver::g_coordinate_vector_t tau = Solver::g_coordinate_vector_t::Random();
+
+            Solver::g_coordinate_vector_t qdd, qddChain, qddKKT;
+            Solver::contact_vector_t lambda, lambdaChain, lambdaKKT;
+            treeSolver.solve(mode, J, gamma, tau, qdd, lambda);
+            chainSolver.solve(mode, J, gamma, tau, qddChain, lambdaChain);
+            solveKKT(mode, M, J, gamma, tau, qddKKT, lambdaKKT);
+
+            ASSERT_LT((qdd - qddKKT).norm(), 1e-8);
+            ASSERT_LT((lambda - lambdaKKT).norm(), 1e-8);
+            ASSERT_LT((qdd - qddChain).norm(), 1e-8);
+            ASSERT_LT((lambda - lambdaChain).norm(), 1e-8);
+        }
+    }
+
+    Solver::g_coordinate_vector_t qdd;
+    Solver::contact_vector_t lambda;
+    ASSERT_THROW(treeSolver.solve(Solver::NMODES, Solver::jacobian_t::Zero(), Solver::contact_vector_t::Zero(),
+                     Solver::g_coordinate_vector_t::Zero(), qdd, lambda),
+        std::runtime_error);
+}
+
+TEST(ContactSchurSolverTest, timingTest)
+{
+    const size_t nCalls = 10000;
+    const Solver::parent_array_t parents = quadrupedParents();
+    Solver treeSolver(parents);
+    Solver chainSolver;
+
+    Solver::inertia_matrix_t M = randomInertia(parents);
+    Solver::jacobian_t J = Solver::jacobian_t::Random();
+    Solver::contact_vector_t gamma = Solver::contact_vector_t::Random();
+    Solver::g_coordinate_vector_t tau = Solver::g_coordinate_vector_t::Random();
+    Solver::g_coordinate_vector_t qdd;
+    Solver::contact_vector_t lambda;
+    double sum = 0.0;
+
+    for (size_t nContacts = 0; nContacts <= NEE; nContacts++)
+    {
+        const size_t mode = (size_t(1) << nContacts) - 1;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < nCalls; i++)
+        {
+            treeSolver.factorize(M);
+            treeSolver.solve(mode, J, gamma, tau, qdd, lambda);
+            sum += qdd(0);
+        }
+        auto end = std::chrono::steady_clock::now();
+        const double tTree = std::chrono::duration<double, std::nano>(end - start).count() / nCalls;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < nCalls; i++)
+        {
+            chainSolver.factorize(M);
+            chainSolver.solve(mode, J, gamma, tau, qdd, lambda);
+            sum += qdd(0);
+        }
+        end = std::chrono::steady_clock::now();
+        const double tChain = std::chrono::duration<double, std::nano>(end - start).count() / nCalls;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < nCalls; i++)
+        {
+            solveKKT(mode, M, J, gamma, tau, qdd, lambda);
+            sum += qdd(0);
+        }
+        end = std::chrono::steady_clock::now();
+        const double tKKT = std::chrono::duration<double, std::nano>(end - start).count() / nCalls;
+
+        std::cout << nContacts << " contacts: Schur complement " << tTree << " ns/call, without sparsity " << tChain
+                  << " ns/call, dense KKT " << tKKT << " ns/call" << std::endl;
+    }
+
+    ASSERT_TRUE(std::isfinite(sum));
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
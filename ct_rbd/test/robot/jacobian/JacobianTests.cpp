@@ -40,6 +40,45 @@ TEST(JacobianTest, JacobianDerivativeTest)
     }
 }
 
+TEST(JacobianTest, CachedJacobianTest)
+{
+    int NTESTS = 100;
+
+    typedef double valType;
+    typedef TestHyQ::tpl::Kinematics<valType> Kinematics_t;
+    typedef tpl::ConstraintJacobian<Kinematics_t, 12, 12, valType> ConstraintJacobian_t;
+
+    ConstraintJacobian_t Jc_cached, Jc_uncached;
+    for (int ee = 0; ee < 4; ee++)
+    {
+        Jc_cached.ee_indices_.push_back(ee);
+        Jc_uncached.ee_indices_.push_back(ee);
+        Jc_cached.eeInContact_[ee] = true;
+        Jc_uncached.eeInContact_[ee] = true;
+    }
+
+    Kinematics_t kinematics;
+    TestHyQ::tpl::Dynamics<valType>::RBDState_t hyq_state;
+
+    for (int n = 0; n < NTESTS; n++)
+    {
+        hyq_state.setRandom();
+
+        Jc_cached.updateState(hyq_state, kinematics.updateCache(hyq_state.jointPositions()));
+        Jc_uncached.updateState(hyq_state);
+
+        ASSERT_LT((Jc_cached.J() - Jc_uncached.J()).cwiseAbs().maxCoeff(), 1e-12);
+        ASSERT_LT((Jc_cached.dJdt() - Jc_uncached.dJdt()).cwiseAbs().maxCoeff(), 1e-12);
+    }
+
+    // changing the link of an end-effector invalidates the cache of the same joint configuration
+    const size_t otherLink = kinematics.getEndEffector(1).getLinkId();
+    kinematics.getEndEffector(0).setLinkId(otherLink);
+    const auto& cache = kinematics.updateCache(hyq_state.jointPositions());
+    ASSERT_EQ(cache.linkId[0], otherLink);
+    ASSERT_EQ(cache.L_X_B[0], cache.L_X_B[1]);
+}
+
 
 int main(int argc, char** argv)
 {
@@ -6,6 +6,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <ct/rbd/rbd.h>
 #include "../../models/testIrb4600/RobCoGenTestIrb4600.h"
 
+#include <chrono>
 #include <gtest/gtest.h>
 
 
@@ -17,6 +18,51 @@ using IKProblem = ct::rbd::IKNLP<KinematicsAD_t>;
 using IKNLPSolver = ct::rbd::IKNLPSolverIpopt<IKProblem, Kinematics_t>;
 
 
+//! seed solver stub which returns a fixed solution and records the queries
+class SeedSolverStub : public ct::rbd::InverseKinematicsBase<njoints, double>
+{
+public:
+    using Base = ct::rbd::InverseKinematicsBase<njoints, double>;
+    using Base::computeInverseKinematicsCloseTo;
+
+    SeedSolverStub(const JointPosition_t& seed) : seed_(seed), nCalls_(0) {}
+
+    bool computeInverseKinematics(JointPositionsVector_t& ikSolutions,
+        const RigidBodyPoseTpl& eeBasePose,
+        const std::vector<size_t>& freeJoints) override
+    {
+        ikSolutions.assign(1, seed_);
+        return true;
+    }
+
+    bool computeInverseKinematics(JointPositionsVector_t& ikSolutions,
+        const RigidBodyPoseTpl& eeWorldPose,
+        const RigidBodyPoseTpl& baseWorldPose,
+        const std::vector<size_t>& freeJoints) override
+    {
+        return computeInverseKinematics(ikSolutions, eeWorldPose.inReferenceFrame(baseWorldPose), freeJoints);
+    }
+
+    bool computeInverseKinematicsCloseTo(JointPosition_t& ikSolution,
+        const RigidBodyPoseTpl& eeWorldPose,
+        const RigidBodyPoseTpl& baseWorldPose,
+        const JointPosition_t& queryJointPositions,
+        const std::vector<size_t>& freeJoints = std::vector<size_t>()) override
+    {
+        nCalls_++;
+        lastQuery_ = queryJointPositions;
+        lastFreeJoints_ = freeJoints;
+        ikSolution = seed_;
+        return true;
+    }
+
+    JointPosition_t seed_;
+    size_t nCalls_;
+    JointPosition_t lastQuery_;
+    std::vector<size_t> lastFreeJoints_;
+};
+
+
 TEST(FixBaseInverseKinematicsTest, NLPIKTest)
 {
     size_t eeInd = 0;
@@ -56,6 +102,107 @@ TEST(FixBaseInverseKinematicsTest, NLPIKTest)
 }
 
 
+TEST(FixBaseInverseKinematicsTest, NLPIKBatchTest)
+{
+    size_t eeInd = 0;
+
+    ct::rbd::JointState<njoints>::Position jointLowerLimit = ct::rbd::TestIrb4600::jointLowerLimit();
+    ct::rbd::JointState<njoints>::Position jointUpperLimit = ct::rbd::TestIrb4600::jointUpperLimit();
+
+    std::shared_ptr<ct::rbd::IKCostEvaluator<KinematicsAD_t>> ikCostEvaluator(
+        new ct::rbd::IKCostEvaluator<KinematicsAD_t>(eeInd));
+    std::shared_ptr<IKProblem> ik_problem(new IKProblem(ikCostEvaluator, jointLowerLimit, jointUpperLimit));
+
+    ct::optcon::NlpSolverSettings nlpSolverSettings;
+    nlpSolverSettings.solverType_ = ct::optcon::NlpSolverType::IPOPT;
+    nlpSolverSettings.ipoptSettings_.hessian_approximation_ = "exact";
+    nlpSolverSettings.ipoptSettings_.printLevel_ = 0;
+
+    ct::rbd::InverseKinematicsSettings ikSettings;
+    ikSettings.maxNumTrials_ = 10;
+    ikSettings.randomizeInitialGuess_ = true;
+
+    IKNLPSolver ikSolver(ik_problem, nlpSolverSettings, ikSettings, eeInd);
+
+    // a smooth joint trajectory and the corresponding end-effector poses
+    const size_t nPoses = 50;
+    Kinematics_t kinematics;
+    IKNLPSolver::JointPositionsVector_t jointTrajectory(nPoses);
+    IKNLPSolver::RigidBodyPoseVector_t poses(nPoses);
+    for (size_t k = 0; k < nPoses; k++)
+    {
+        for (size_t j = 0; j < njoints; j++)
+            jointTrajectory[k](j) = 0.3 * std::sin(0.05 * k + j);
+        poses[k] = kinematics.getEEPoseInBase(eeInd, jointTrajectory[k]);
+    }
+
+    IKNLPSolver::JointPositionsVector_t solutions;
+    std::vector<bool> success;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t nSuccess = ikSolver.computeInverseKinematicsBatch(solutions, success, poses, jointTrajectory[0]);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << "NLP warm-started batch: " << nPoses / std::chrono::duration<double>(end - start).count()
+              << " poses/s" << std::endl;
+
+    ASSERT_EQ(nSuccess, nPoses);
+}
+
+
+TEST(FixBaseInverseKinematicsTest, NLPIKSeedSolverTest)
+{
+    size_t eeInd = 0;
+
+    ct::rbd::JointState<njoints>::Position jointLowerLimit = ct::rbd::TestIrb4600::jointLowerLimit();
+    ct::rbd::JointState<njoints>::Position jointUpperLimit = ct::rbd::TestIrb4600::jointUpperLimit();
+
+    std::shared_ptr<ct::rbd::IKCostEvaluator<KinematicsAD_t>> ikCostEvaluator(
+        new ct::rbd::IKCostEvaluator<KinematicsAD_t>(eeInd));
+    std::shared_ptr<IKProblem> ik_problem(new IKProblem(ikCostEvaluator, jointLowerLimit, jointUpperLimit));
+
+    // without iterations, the NLP returns its initial guess, hence a valid solution can only come from the seed
+    ct::optcon::NlpSolverSettings nlpSolverSettings;
+    nlpSolverSettings.solverType_ = ct::optcon::NlpSolverType::IPOPT;
+    nlpSolverSettings.ipoptSettings_.hessian_approximation_ = "exact";
+    nlpSolverSettings.ipoptSettings_.max_iter_ = 0;
+    nlpSolverSettings.ipoptSettings_.printLevel_ = 0;
+
+    ct::rbd::InverseKinematicsSettings ikSettings;
+    ikSettings.maxNumTrials_ = 1;
+    ikSettings.randomizeInitialGuess_ = false;
+
+    IKNLPSolver ikSolver(ik_problem, nlpSolverSettings, ikSettings, eeInd);
+
+    IKNLPSolver::JointPosition_t qTarget, qQuery;
+    for (size_t j = 0; j < njoints; j++)
+        qTarget(j) = 0.3 * std::sin(1.0 + j);
+    qQuery.setZero();
+
+    Kinematics_t kinematics;
+    ct::rbd::RigidBodyPose eePose = kinematics.getEEPoseInBase(eeInd, qTarget);
+
+    IKNLPSolver::JointPosition_t solution;
+    ASSERT_FALSE(ikSolver.computeInverseKinematicsCloseTo(solution, eePose, qQuery));
+
+    // the seed solver provides the initial guess of the NLP
+    std::shared_ptr<SeedSolverStub> seedSolver(new SeedSolverStub(qTarget));
+    const std::vector<size_t> seedFreeJoints = {2};
+    ikSolver.setSeedSolver(seedSolver, seedFreeJoints);
+
+    ASSERT_TRUE(ikSolver.computeInverseKinematicsCloseTo(solution, eePose, qQuery));
+    ASSERT_TRUE(solution.isApprox(qTarget, 1e-6));
+    ASSERT_EQ(seedSolver->nCalls_, 1u);
+    ASSERT_TRUE(seedSolver->lastQuery_.isApprox(qQuery));
+    ASSERT_EQ(seedSolver->lastFreeJoints_, seedFreeJoints);
+
+    // removing the seed solver falls back to the query
+    ikSolver.setSeedSolver(nullptr);
+    ASSERT_FALSE(ikSolver.computeInverseKinematicsCloseTo(solution, eePose, qQuery));
+    ASSERT_EQ(seedSolver->nCalls_, 1u);
+}
+
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -7,6 +7,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <memory>
 #include <array>
+#include <chrono>
 
 #include <gtest/gtest.h>
 
@@ -46,6 +47,105 @@ TEST(FloatingBaseFDSystemTest, forward_dynamics_test)
     ASSERT_TRUE(finalQuat.isApprox(finalEuler, 1e-6));
 }
 
+TEST(FloatingBaseFDSystemTest, kinematics_cache_test)
+{
+    typedef FloatingBaseFDSystem<TestHyQ::Dynamics, false> System;
+    typedef TestHyQ::Kinematics Kinematics;
+    const size_t nTests = 100;
+
+    std::shared_ptr<Kinematics> kinematics(new Kinematics);
+
+    for (size_t i = 0; i < nTests; i++)
+    {
+        RBDState<12> state;
+        state.setRandom();
+
+        const Kinematics::KinematicsCache_t& cache = kinematics->updateCache(state.jointPositions());
+
+        for (size_t ee = 0; ee < Kinematics::NUM_EE; ee++)
+        {
+            ASSERT_TRUE(kinematics->getEEPositionInWorld(ee, state.basePose(), cache)
+                            .toImplementation()
+                            .isApprox(kinematics->getEEPositionInWorld(ee, state.basePose(), state.jointPositions())
+                                          .toImplementation()));
+            ASSERT_TRUE(kinematics->getEEVelocityInWorld(ee, state, cache)
+                            .toImplementation()
+                            .isApprox(kinematics->getEEVelocityInWorld(ee, state).toImplementation()));
+
+            Kinematics::EEForceLinear force = Kinematics::EEForceLinear::Random();
+            ASSERT_TRUE(kinematics->mapForceFromWorldToLink3d(force, state.basePose(), ee, cache)
+                            .isApprox(kinematics->mapForceFromWorldToLink3d(
+                                force, state.basePose(), state.jointPositions(), ee)));
+        }
+    }
+
+    // time the kinematics of one dynamics evaluation, once per query as before and once with the cache
+    const size_t nCalls = 10000;
+    RBDState<12> kinState;
+    kinState.setRandom();
+    Kinematics::EEForceLinear kinForce = Kinematics::EEForceLinear::Random();
+    double kinSum = 0.0;
+
+    auto kinStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nCalls; i++)
+    {
+        kinState.jointPositions()(0) += 1e-9;
+        for (size_t ee = 0; ee < Kinematics::NUM_EE; ee++)
+        {
+            kinSum += kinematics->getEEPositionInWorld(ee, kinState.basePose(), kinState.jointPositions())
+                          .toImplementation()(2);
+            kinSum += kinematics->getEEVelocityInWorld(ee, kinState).toImplementation()(2);
+            kinSum += kinematics->mapForceFromWorldToLink3d(
+                kinForce, kinState.basePose(), kinState.jointPositions(), ee)(5);
+        }
+    }
+    auto kinMid = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nCalls; i++)
+    {
+        kinState.jointPositions()(0) += 1e-9;
+        const Kinematics::KinematicsCache_t& cache = kinematics->updateCache(kinState.jointPositions());
+        for (size_t ee = 0; ee < Kinematics::NUM_EE; ee++)
+        {
+            kinSum += kinematics->getEEPositionInWorld(ee, kinState.basePose(), cache).toImplementation()(2);
+            kinSum += kinematics->getEEVelocityInWorld(ee, kinState, cache).toImplementation()(2);
+            kinSum += kinematics->mapForceFromWorldToLink3d(kinForce, kinState.basePose(), ee, cache)(5);
+        }
+    }
+    auto kinEnd = std::chrono::steady_clock::now();
+
+    std::cout << "HyQ end-effector kinematics per dynamics call, uncached: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(kinMid - kinStart).count() / nCalls
+              << " ns/call, cached: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(kinEnd - kinMid).count() / nCalls << " ns/call"
+              << std::endl;
+    ASSERT_TRUE(std::isfinite(kinSum));
+
+    // time one forward dynamics evaluation including contact forces
+    System system;
+    system.setContactModel(std::shared_ptr<System::ContactModel>(new System::ContactModel));
+
+    RBDState<12> state;
+    state.setRandom();
+    state.basePose().position().toImplementation()(2) = 0.0;  // feet in contact
+    System::StateVector x = state.toStateVectorEulerXyz();
+    System::ControlVector u = System::ControlVector::Random();
+    System::StateVector dx;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nCalls; i++)
+    {
+        x(6) += 1e-9;  // perturb a joint such that every call does one kinematics pass
+        system.computeControlledDynamics(x, 0.0, u, dx);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "HyQ forward dynamics with contact model: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / nCalls << " ns/call"
+              << std::endl;
+
+    ASSERT_TRUE(dx.allFinite());
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -4,6 +4,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 **********************************************************************************************************************/
 
 
+#include <chrono>
+
 #include <gtest/gtest.h>
 
 #include <ct/rbd/rbd.h>
@@ -111,6 +113,93 @@ TEST(ProjectedFDSystemTest, projected_forward_dynamics_test)
 }
 
 
+TEST(ProjectedFDSystemTest, schur_complement_contact_solve_test)
+{
+    typedef ProjectedDynamics<TestHyQ::RobCoGenContainer, 4> ProjectedDynamics_t;
+
+    std::shared_ptr<TestHyQ::Kinematics> kinematics(new TestHyQ::Kinematics);
+    ProjectedDynamics_t projectedDynamics(kinematics);
+
+    RBDState<12> state;
+    ProjectedDynamics_t::control_vector_t u;
+    ProjectedDynamics_t::RBDAcceleration_t qddSchur, qddKKT;
+    ProjectedDynamics_t::EE_contact_forces_t lambdaSchur, lambdaKKT;
+    ProjectedDynamics_t::EE_in_contact_t contactFlags;
+
+    // every contact configuration has its own kernel
+    for (size_t mode = 0; mode < 16; mode++)
+    {
+        for (size_t k = 0; k < 4; k++)
+            contactFlags[k] = mode & (1 << k);
+        projectedDynamics.setContactConfiguration(contactFlags);
+
+        for (size_t i = 0; i < 10; i++)
+        {
+            state.setRandom();
+            u.setRandom();
+
+            projectedDynamics.ProjectedForwardDynamics(state, u, qddSchur);
+            projectedDynamics.getContactForcesInBase(lambdaSchur);
+            projectedDynamics.ProjectedForwardDynamicsKKT(state, u, qddKKT);
+            projectedDynamics.getContactForcesInBase(lambdaKKT);
+
+            ASSERT_LT((qddSchur.toCoordinateAcceleration() - qddKKT.toCoordinateAcceleration()).norm(), 1e-8);
+            for (size_t k = 0; k < 4; k++)
+                ASSERT_LT((lambdaSchur[k] - lambdaKKT[k]).norm(), 1e-8);
+        }
+    }
+}
+
+TEST(ProjectedFDSystemTest, schur_complement_contact_solve_benchmark)
+{
+    typedef ProjectedDynamics<TestHyQ::RobCoGenContainer, 4> ProjectedDynamics_t;
+    typedef ProjectedFDSystem<TestHyQ::Dynamics, false> System;
+    const size_t nCalls = 10000;
+
+    std::shared_ptr<TestHyQ::Kinematics> kinematics(new TestHyQ::Kinematics);
+    ProjectedDynamics_t projectedDynamics(kinematics);
+
+    RBDState<12> state;
+    state.setRandom();
+    ProjectedDynamics_t::control_vector_t u = ProjectedDynamics_t::control_vector_t::Random();
+    ProjectedDynamics_t::RBDAcceleration_t qdd;
+    ProjectedDynamics_t::EE_in_contact_t contactFlags;
+
+    for (size_t nContacts = 0; nContacts <= 4; nContacts++)
+    {
+        for (size_t k = 0; k < 4; k++)
+            contactFlags[k] = k < nContacts;
+        projectedDynamics.setContactConfiguration(contactFlags);
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < nCalls; i++)
+            projectedDynamics.ProjectedForwardDynamics(state, u, qdd);
+        auto end = std::chrono::steady_clock::now();
+        const double tSchur = std::chrono::duration<double, std::nano>(end - start).count() / nCalls;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < nCalls; i++)
+            projectedDynamics.ProjectedForwardDynamicsKKT(state, u, qdd);
+        end = std::chrono::steady_clock::now();
+        const double tKKT = std::chrono::duration<double, std::nano>(end - start).count() / nCalls;
+
+        System system(contactFlags);
+        System::StateVector x = state.toStateVectorEulerXyz();
+        System::ControlVector control = u;
+        System::StateVector dx;
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < nCalls; i++)
+            system.computeControlledDynamics(x, 0.0, control, dx);
+        end = std::chrono::steady_clock::now();
+        const double tSystem = std::chrono::duration<double, std::nano>(end - start).count() / nCalls;
+
+        std::cout << nContacts << " contacts: Schur complement " << tSchur << " ns/call, KKT " << tKKT
+                  << " ns/call, ProjectedFDSystem " << tSystem << " ns/call" << std::endl;
+
+        ASSERT_TRUE(dx.allFinite());
+    }
+}
+
 TEST(ProjectedFDSystemTest, projected_forward_dynamics_autodiff_test)
 {
     constexpr bool VERBOSE = false;
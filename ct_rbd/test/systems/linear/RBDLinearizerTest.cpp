@@ -7,12 +7,14 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <memory>
 #include <array>
+#include <chrono>
 
 #include <iostream>
 
 #include <gtest/gtest.h>
 
 #include <ct/rbd/systems/linear/RbdLinearizer.h>
+#include <ct/rbd/systems/linear/FloatingBaseContactLinearizerCG.h>
 #include "ct/rbd/systems/FixBaseFDSystem.h"
 #include "ct/rbd/systems/FloatingBaseFDSystem.h"
 
@@ -107,6 +109,67 @@ TEST(RBDLinearizerTest, NumDiffComparisonFloatingBase)
     }
 }
 
+TEST(RBDLinearizerTest, CodegenContactModelFloatingBase)
+{
+    typedef FloatingBaseFDSystem<TestHyQ::Dynamics, false, false> HyQSystem;
+    typedef FloatingBaseContactLinearizerCG<TestHyQ::tpl::Dynamics> CGLinearizer;
+
+    const size_t STATE_DIM = HyQSystem::STATE_DIM;
+    const size_t CONTROL_DIM = HyQSystem::CONTROL_DIM;
+
+    ContactLinearizationParameters params;
+
+    // a double system with identical contact model for the numerical reference
+    std::shared_ptr<HyQSystem> hyqSystem(new HyQSystem);
+    std::shared_ptr<HyQSystem::ContactModel> contactModel(new HyQSystem::ContactModel(params.k, params.d,
+        params.alpha, params.alpha_n, params.zOffset,
+        static_cast<HyQSystem::ContactModel::VELOCITY_SMOOTHING>(params.smoothing),
+        hyqSystem->dynamics().kinematicsPtr()));
+    hyqSystem->setContactModel(contactModel);
+
+    core::SystemLinearizer<STATE_DIM, CONTROL_DIM> systemLinearizer(hyqSystem, true);
+
+    auto start = std::chrono::steady_clock::now();
+    CGLinearizer cgLinearizer(params);
+    cgLinearizer.compileJIT("RBDLinearizerTestHyQContact");
+    std::chrono::duration<double, std::milli> timeCompile = std::chrono::steady_clock::now() - start;
+
+    // a second instance with identical parameters is served from the JIT cache, without recording
+    start = std::chrono::steady_clock::now();
+    CGLinearizer cgLinearizerCached(params);
+    cgLinearizerCached.compileJIT("RBDLinearizerTestHyQContact");
+    std::chrono::duration<double, std::milli> timeCached = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    std::shared_ptr<CGLinearizer> cgLinearizerCloned(cgLinearizer.clone());
+    std::chrono::duration<double, std::milli> timeClone = std::chrono::steady_clock::now() - start;
+
+    std::cout << "HyQ contact linearization: record and compile " << timeCompile.count() << " ms, cached instance "
+              << timeCached.count() << " ms, clone " << timeClone.count() << " ms" << std::endl;
+
+    core::StateVector<STATE_DIM> x;
+    core::ControlVector<CONTROL_DIM> u;
+
+    size_t nTests = 50;
+    for (size_t i = 0; i < nTests; i++)
+    {
+        x.setRandom();
+        u.setRandom();
+
+        core::StateMatrix<STATE_DIM> A_cg = cgLinearizer.getDerivativeState(x, u, 0.0);
+        core::StateControlMatrix<STATE_DIM, CONTROL_DIM> B_cg = cgLinearizer.getDerivativeControl(x, u, 0.0);
+
+        auto A_system = systemLinearizer.getDerivativeState(x, u, 0.0);
+        auto B_system = systemLinearizer.getDerivativeControl(x, u, 0.0);
+
+        ASSERT_LT((A_cg - A_system).array().abs().maxCoeff(), 1e-3 * (1.0 + A_system.array().abs().maxCoeff()));
+        ASSERT_LT((B_cg - B_system).array().abs().maxCoeff(), 1e-4);
+
+        ASSERT_TRUE(A_cg.isApprox(cgLinearizerCached.getDerivativeState(x, u, 0.0)));
+        ASSERT_TRUE(B_cg.isApprox(cgLinearizerCloned->getDerivativeControl(x, u, 0.0)));
+    }
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);